@@ -239,34 +239,15 @@
 
 
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
-#include "threading/Consumer.hpp"
 #include "threading/Producer.hpp"
 
 
 int main()
 {
-    /**
-    Consumer C;
-
-    for (int i = 1; i <= 5; ++i)
-    {
-        while (!C.isAvailable())
-           std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-        C.execute([i]()
-        {
-            std::cout << "hello " << i << std::endl;
-        });
-    }
-
-    while (!C.isAvailable())
-       std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-    C.quit();
-    //*/
-
     /**/
     Producer    P;
 
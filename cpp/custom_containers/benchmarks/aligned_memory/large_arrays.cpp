@@ -0,0 +1,82 @@
+
+#include "dynamic_heap_array.hpp"
+#include "utils/aligned_memory.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+
+//
+// 1GB arrays with the default allocator, a 64 bytes aligned one and the huge page one
+// - streaming: auto vectorized sum over the whole array (bandwidth bound)
+// - random: dependent-free random reads (TLB bound with 4K pages)
+//
+
+namespace {
+
+constexpr std::size_t k_totalBytes = std::size_t(1) << 30;
+
+template <typename Allocator>
+using large_array = custom_containers::dynamic_heap_array<uint32_t, uint32_t, 0, Allocator>;
+
+template <typename Allocator>
+void fill_large_array(large_array<Allocator>& myArray, std::size_t totalValues) {
+  myArray.pre_allocate(totalValues);
+  for (std::size_t ii = 0; ii < totalValues; ++ii) {
+    myArray.push_back(uint32_t(ii & 0xff));
+  }
+}
+
+template <typename Allocator>
+void large_array_streaming_sum(benchmark::State& state) {
+  const std::size_t totalValues = k_totalBytes / sizeof(uint32_t);
+
+  large_array<Allocator> myArray;
+  fill_large_array(myArray, totalValues);
+
+  for (auto _ : state) {
+    const uint32_t* values = myArray.data();
+    uint32_t total = 0;
+    for (std::size_t ii = 0; ii < totalValues; ++ii) {
+      total += values[ii];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(k_totalBytes));
+}
+
+template <typename Allocator>
+void large_array_random_reads(benchmark::State& state) {
+  const std::size_t totalValues = k_totalBytes / sizeof(uint32_t);
+  const std::size_t totalReads = std::size_t(state.range(0));
+
+  large_array<Allocator> myArray;
+  fill_large_array(myArray, totalValues);
+
+  for (auto _ : state) {
+    const uint32_t* values = myArray.data();
+    uint32_t total = 0;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (std::size_t ii = 0; ii < totalReads; ++ii) {
+      // xorshift64 -> power of two size, the mask is enough
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      total += values[seed & (totalValues - 1)];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalReads));
+}
+
+}
+
+BENCHMARK(large_array_streaming_sum<std::allocator<uint32_t>>)->Unit(benchmark::kMillisecond);
+BENCHMARK(large_array_streaming_sum<custom_containers::cache_line_allocator<uint32_t>>)->Unit(benchmark::kMillisecond);
+BENCHMARK(large_array_streaming_sum<custom_containers::huge_page_allocator<uint32_t>>)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(large_array_random_reads<std::allocator<uint32_t>>)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(large_array_random_reads<custom_containers::cache_line_allocator<uint32_t>>)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(large_array_random_reads<custom_containers::huge_page_allocator<uint32_t>>)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,104 @@
+
+#include "dynamic_heap_array.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+//
+// hot read loops with the three checks policies
+// -> assert_only is measured without NDEBUG (asserts active)
+//
+
+namespace {
+
+template <typename Checks>
+using checks_array = custom_containers::dynamic_heap_array<
+  uint64_t, uint64_t, 0, std::allocator<uint64_t>, custom_containers::stats::default_policy, Checks>;
+
+template <typename Checks>
+void dynamic_heap_array_sum_at(benchmark::State& state) {
+  const std::size_t totalElements = std::size_t(state.range(0));
+
+  checks_array<Checks> myArray;
+  for (std::size_t ii = 0; ii < totalElements; ++ii) {
+    myArray.push_back(ii);
+  }
+
+  for (auto _ : state) {
+    uint64_t total = 0;
+    for (std::size_t ii = 0; ii < myArray.size(); ++ii) {
+      total += myArray.at(ii);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalElements));
+}
+
+template <typename Checks>
+void dynamic_heap_array_sum_iterator(benchmark::State& state) {
+  const std::size_t totalElements = std::size_t(state.range(0));
+
+  checks_array<Checks> myArray;
+  for (std::size_t ii = 0; ii < totalElements; ++ii) {
+    myArray.push_back(ii);
+  }
+
+  for (auto _ : state) {
+    uint64_t total = 0;
+    for (const uint64_t value : myArray) {
+      total += value;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalElements));
+}
+
+struct some_entity {
+  some_entity(int inValue) : value(inValue) {}
+  int value = 0;
+};
+
+template <typename Checks>
+void weak_ref_data_pool_sum_refs(benchmark::State& state) {
+  const std::size_t totalElements = std::size_t(state.range(0));
+
+  using pool_type = custom_containers::weak_ref_data_pool::pool_container<
+    some_entity, some_entity, 256, false, std::allocator, custom_containers::stats::default_policy, Checks>;
+
+  pool_type myPool;
+  std::vector<typename pool_type::weak_ref> allRefs;
+  allRefs.reserve(totalElements);
+  for (std::size_t ii = 0; ii < totalElements; ++ii) {
+    allRefs.push_back(myPool.acquire(int(ii)));
+  }
+
+  for (auto _ : state) {
+    int64_t total = 0;
+    for (auto& ref : allRefs) {
+      if (ref.is_valid()) {
+        total += ref->value;
+      }
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalElements));
+}
+
+}
+
+BENCHMARK(dynamic_heap_array_sum_at<custom_containers::checks::checked>)->Arg(1 << 16);
+BENCHMARK(dynamic_heap_array_sum_at<custom_containers::checks::assert_only>)->Arg(1 << 16);
+BENCHMARK(dynamic_heap_array_sum_at<custom_containers::checks::unchecked>)->Arg(1 << 16);
+
+BENCHMARK(dynamic_heap_array_sum_iterator<custom_containers::checks::checked>)->Arg(1 << 16);
+BENCHMARK(dynamic_heap_array_sum_iterator<custom_containers::checks::assert_only>)->Arg(1 << 16);
+BENCHMARK(dynamic_heap_array_sum_iterator<custom_containers::checks::unchecked>)->Arg(1 << 16);
+
+BENCHMARK(weak_ref_data_pool_sum_refs<custom_containers::checks::checked>)->Arg(1 << 16);
+BENCHMARK(weak_ref_data_pool_sum_refs<custom_containers::checks::assert_only>)->Arg(1 << 16);
+BENCHMARK(weak_ref_data_pool_sum_refs<custom_containers::checks::unchecked>)->Arg(1 << 16);
@@ -0,0 +1,67 @@
+
+#include "dynamic_heap_array.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+//
+// same workload with the stats disabled (default) and enabled
+// -> disabled must match the plain container (no size, no instruction)
+//
+
+namespace {
+
+template <typename Stats>
+void dynamic_heap_array_push_and_erase(benchmark::State& state) {
+  const std::size_t totalElements = std::size_t(state.range(0));
+
+  for (auto _ : state) {
+    custom_containers::dynamic_heap_array<uint64_t, uint64_t, 0, std::allocator<uint64_t>, Stats> myArray;
+
+    for (std::size_t ii = 0; ii < totalElements; ++ii) {
+      myArray.push_back(ii);
+    }
+    for (std::size_t ii = 0; ii < totalElements / 2; ++ii) {
+      myArray.unsorted_erase(ii);
+    }
+
+    benchmark::DoNotOptimize(myArray.data());
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalElements));
+}
+
+struct some_entity {
+  some_entity(int inValue) : value(inValue) {}
+  int value = 0;
+};
+
+template <typename Stats>
+void weak_ref_data_pool_churn(benchmark::State& state) {
+  const std::size_t totalElements = std::size_t(state.range(0));
+
+  using pool_type = custom_containers::weak_ref_data_pool::pool_container<
+    some_entity, some_entity, 256, false, std::allocator, Stats>;
+
+  for (auto _ : state) {
+    pool_type myPool;
+
+    for (std::size_t ii = 0; ii < totalElements; ++ii) {
+      auto ref = myPool.acquire(int(ii));
+      benchmark::DoNotOptimize(ref.get());
+    }
+
+    // unreferenced -> every element is released (swap with the back)
+    myPool.remove_unreferenced_items();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(totalElements));
+}
+
+}
+
+BENCHMARK(dynamic_heap_array_push_and_erase<custom_containers::stats::disabled>)->Arg(1 << 16);
+BENCHMARK(dynamic_heap_array_push_and_erase<custom_containers::stats::enabled>)->Arg(1 << 16);
+
+BENCHMARK(weak_ref_data_pool_churn<custom_containers::stats::disabled>)->Arg(1 << 12);
+BENCHMARK(weak_ref_data_pool_churn<custom_containers::stats::enabled>)->Arg(1 << 12);
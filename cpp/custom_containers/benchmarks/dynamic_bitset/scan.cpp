@@ -0,0 +1,122 @@
+
+#include "dynamic_bitset.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <random>
+#include <vector>
+
+//
+// 10M elements, 1% of them are valid
+//
+
+namespace {
+
+constexpr std::size_t k_totalElements = 10'000'000;
+constexpr uint32_t k_validPercent = 1;
+
+// the flag lives inside the object, like pool_internal_element::_is_valid
+struct entity_with_flag {
+  float payload[15];
+  bool _is_valid = false;
+};
+
+struct entity {
+  float payload[16];
+};
+
+template <typename Callback>
+void for_each_valid_index(Callback&& callback) {
+  std::mt19937 randomEngine(666);
+  for (std::size_t ii = 0; ii < k_totalElements; ++ii) {
+    if (randomEngine() % 100 < k_validPercent) {
+      callback(ii);
+    }
+  }
+}
+
+void bool_per_object_scan(benchmark::State& state) {
+  std::vector<entity_with_flag> entities(k_totalElements);
+  for_each_valid_index([&entities](std::size_t index) { entities[index]._is_valid = true; });
+
+  for (auto _ : state) {
+    float total = 0.0f;
+    for (const entity_with_flag& item : entities) {
+      if (item._is_valid) {
+        total += item.payload[0];
+      }
+    }
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+void bitset_for_each_set_scan(benchmark::State& state) {
+  std::vector<entity> entities(k_totalElements);
+  custom_containers::dynamic_bitset<> validMask(k_totalElements);
+  for_each_valid_index([&validMask](std::size_t index) { validMask.set(index); });
+
+  for (auto _ : state) {
+    float total = 0.0f;
+    validMask.for_each_set([&total, &entities](std::size_t index) { total += entities[index].payload[0]; });
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+void bitset_masked_range_scan(benchmark::State& state) {
+  std::vector<entity> entities(k_totalElements);
+  custom_containers::dynamic_bitset<> validMask(k_totalElements);
+  for_each_valid_index([&validMask](std::size_t index) { validMask.set(index); });
+
+  for (auto _ : state) {
+    float total = 0.0f;
+    for (const entity& item : custom_containers::make_masked_range(entities, validMask)) {
+      total += item.payload[0];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+//
+// count the valid elements only
+//
+
+void bool_per_object_count(benchmark::State& state) {
+  std::vector<entity_with_flag> entities(k_totalElements);
+  for_each_valid_index([&entities](std::size_t index) { entities[index]._is_valid = true; });
+
+  for (auto _ : state) {
+    std::size_t total = 0;
+    for (const entity_with_flag& item : entities) {
+      total += item._is_valid ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+void bitset_count_scalar(benchmark::State& state) {
+  custom_containers::dynamic_bitset<> validMask(k_totalElements);
+  for_each_valid_index([&validMask](std::size_t index) { validMask.set(index); });
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(custom_containers::popcount::count_words_scalar(validMask.words(), validMask.total_words()));
+  }
+}
+
+void bitset_count(benchmark::State& state) {
+  custom_containers::dynamic_bitset<> validMask(k_totalElements);
+  for_each_valid_index([&validMask](std::size_t index) { validMask.set(index); });
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(validMask.count());
+  }
+}
+
+}
+
+BENCHMARK(bool_per_object_scan)->Unit(benchmark::kMillisecond);
+BENCHMARK(bitset_for_each_set_scan)->Unit(benchmark::kMillisecond);
+BENCHMARK(bitset_masked_range_scan)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(bool_per_object_count)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bitset_count_scalar)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bitset_count)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,204 @@
+
+#include "flat_map.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//
+// lookups of existing keys, random order
+// -> state.range(0): total keys in the table
+//
+
+namespace {
+
+std::vector<uint64_t> make_keys(std::size_t totalKeys) {
+  std::mt19937_64 randomEngine(666);
+  std::vector<uint64_t> keys;
+  keys.reserve(totalKeys);
+  for (std::size_t ii = 0; ii < totalKeys; ++ii) {
+    keys.push_back(randomEngine());
+  }
+  return keys;
+}
+
+std::vector<uint64_t> make_queries(const std::vector<uint64_t>& keys) {
+  std::mt19937_64 randomEngine(777);
+  std::vector<uint64_t> queries;
+  queries.reserve(4096);
+  for (std::size_t ii = 0; ii < 4096; ++ii) {
+    queries.push_back(keys[randomEngine() % keys.size()]);
+  }
+  return queries;
+}
+
+template <custom_containers::search_layout layout>
+void flat_map_lookup(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+  const auto queries = make_queries(keys);
+
+  std::vector<std::pair<uint64_t, uint64_t>> values;
+  for (uint64_t key : keys) {
+    values.push_back({key, key});
+  }
+
+  custom_containers::flat_map<uint64_t, uint64_t, std::less<uint64_t>, std::allocator, layout> table;
+  table.build(values.begin(), values.end());
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(queries[queryIndex]));
+    queryIndex = (queryIndex + 1) % queries.size();
+  }
+}
+
+void std_map_lookup(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+  const auto queries = make_queries(keys);
+
+  std::map<uint64_t, uint64_t> table;
+  for (uint64_t key : keys) {
+    table.insert({key, key});
+  }
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(queries[queryIndex]));
+    queryIndex = (queryIndex + 1) % queries.size();
+  }
+}
+
+void std_unordered_map_lookup(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+  const auto queries = make_queries(keys);
+
+  std::unordered_map<uint64_t, uint64_t> table;
+  for (uint64_t key : keys) {
+    table.insert({key, key});
+  }
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(queries[queryIndex]));
+    queryIndex = (queryIndex + 1) % queries.size();
+  }
+}
+
+//
+// short string keys, like the attribute names of a parser
+//
+
+const std::vector<std::string> k_attributeNames = {
+  "length", "translation", "rotation", "scale", "color", "alpha", "position", "velocity",
+  "mass", "friction", "restitution", "name", "parent", "children", "visible", "layer",
+};
+
+void flat_map_string_lookup(benchmark::State& state) {
+  custom_containers::flat_map<std::string, int> table;
+  for (std::size_t ii = 0; ii < k_attributeNames.size(); ++ii) {
+    table.insert(k_attributeNames[ii], int(ii));
+  }
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(k_attributeNames[queryIndex]));
+    queryIndex = (queryIndex + 7) % k_attributeNames.size();
+  }
+}
+
+void std_map_string_lookup(benchmark::State& state) {
+  std::map<std::string, int> table;
+  for (std::size_t ii = 0; ii < k_attributeNames.size(); ++ii) {
+    table.insert({k_attributeNames[ii], int(ii)});
+  }
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(k_attributeNames[queryIndex]));
+    queryIndex = (queryIndex + 7) % k_attributeNames.size();
+  }
+}
+
+void std_unordered_map_string_lookup(benchmark::State& state) {
+  std::unordered_map<std::string, int> table;
+  for (std::size_t ii = 0; ii < k_attributeNames.size(); ++ii) {
+    table.insert({k_attributeNames[ii], int(ii)});
+  }
+
+  std::size_t queryIndex = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(k_attributeNames[queryIndex]));
+    queryIndex = (queryIndex + 7) % k_attributeNames.size();
+  }
+}
+
+//
+// bulk build vs one by one insertion
+//
+
+void flat_map_bulk_build(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+
+  std::vector<std::pair<uint64_t, uint64_t>> values;
+  for (uint64_t key : keys) {
+    values.push_back({key, key});
+  }
+
+  for (auto _ : state) {
+    custom_containers::flat_map<uint64_t, uint64_t> table;
+    table.build(values.begin(), values.end());
+    benchmark::DoNotOptimize(table.size());
+  }
+}
+
+void flat_map_insert_range_batches(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+
+  std::vector<std::pair<uint64_t, uint64_t>> values;
+  for (uint64_t key : keys) {
+    values.push_back({key, key});
+  }
+
+  constexpr std::size_t k_totalBatches = 8;
+  const std::size_t batchSize = (values.size() + k_totalBatches - 1) / k_totalBatches;
+
+  for (auto _ : state) {
+    custom_containers::flat_map<uint64_t, uint64_t> table;
+    for (std::size_t start = 0; start < values.size(); start += batchSize) {
+      const std::size_t stop = std::min(start + batchSize, values.size());
+      table.insert_range(values.begin() + std::ptrdiff_t(start), values.begin() + std::ptrdiff_t(stop));
+    }
+    benchmark::DoNotOptimize(table.size());
+  }
+}
+
+void std_map_build(benchmark::State& state) {
+  const auto keys = make_keys(std::size_t(state.range(0)));
+
+  for (auto _ : state) {
+    std::map<uint64_t, uint64_t> table;
+    for (uint64_t key : keys) {
+      table.insert({key, key});
+    }
+    benchmark::DoNotOptimize(table.size());
+  }
+}
+
+}
+
+BENCHMARK(flat_map_lookup<custom_containers::search_layout::branchless>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(flat_map_lookup<custom_containers::search_layout::eytzinger>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(std_map_lookup)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(std_unordered_map_lookup)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+BENCHMARK(flat_map_string_lookup);
+BENCHMARK(std_map_string_lookup);
+BENCHMARK(std_unordered_map_string_lookup);
+
+BENCHMARK(flat_map_bulk_build)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(flat_map_insert_range_batches)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(std_map_build)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
@@ -0,0 +1,124 @@
+
+#include "dynamic_heap_array.hpp"
+#include "mapped_file_array.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+//
+// 256MB of uint64_t
+// - build + persist: mapped_file_array (push_back + sync) vs dynamic_heap_array + ofstream per element
+// - reopen + scan: mapped_file_array (zero copy) vs ifstream read into a dynamic_heap_array
+// -> the file stay in the page cache (warm reopen)
+//
+
+namespace {
+
+constexpr std::size_t k_totalValues = (std::size_t(256) << 20) / sizeof(uint64_t);
+
+std::string get_benchmark_filepath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void mapped_file_array_build_and_persist(benchmark::State& state) {
+  const std::string filepath = get_benchmark_filepath("bench_mapped_file_array.bin");
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::filesystem::remove(filepath);
+    state.ResumeTiming();
+
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    for (std::size_t ii = 0; ii < k_totalValues; ++ii) {
+      myArray.push_back(ii);
+    }
+    myArray.sync();
+  }
+
+  std::filesystem::remove(filepath);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(k_totalValues * sizeof(uint64_t)));
+}
+
+void ofstream_build_and_persist(benchmark::State& state) {
+  const std::string filepath = get_benchmark_filepath("bench_ofstream.bin");
+
+  for (auto _ : state) {
+    custom_containers::dynamic_heap_array<uint64_t> myArray;
+    for (std::size_t ii = 0; ii < k_totalValues; ++ii) {
+      myArray.push_back(ii);
+    }
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    for (const uint64_t value : myArray) {
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    file.flush();
+  }
+
+  std::filesystem::remove(filepath);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(k_totalValues * sizeof(uint64_t)));
+}
+
+void mapped_file_array_reopen_and_scan(benchmark::State& state) {
+  const std::string filepath = get_benchmark_filepath("bench_mapped_file_array.bin");
+  std::filesystem::remove(filepath);
+  {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    myArray.pre_allocate(k_totalValues);
+    for (std::size_t ii = 0; ii < k_totalValues; ++ii) {
+      myArray.push_back(ii);
+    }
+  }
+
+  for (auto _ : state) {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    const uint64_t* values = myArray.data();
+    uint64_t total = 0;
+    for (std::size_t ii = 0; ii < myArray.size(); ++ii) {
+      total += values[ii];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  std::filesystem::remove(filepath);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(k_totalValues * sizeof(uint64_t)));
+}
+
+void ifstream_reopen_and_scan(benchmark::State& state) {
+  const std::string filepath = get_benchmark_filepath("bench_ofstream.bin");
+  {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    for (std::size_t ii = 0; ii < k_totalValues; ++ii) {
+      const uint64_t value = ii;
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+  }
+
+  for (auto _ : state) {
+    std::ifstream file(filepath, std::ios::binary);
+    custom_containers::dynamic_heap_array<uint64_t> myArray;
+    myArray.ensure_size(k_totalValues);
+    file.read(reinterpret_cast<char*>(myArray.data()), std::streamsize(k_totalValues * sizeof(uint64_t)));
+
+    const uint64_t* values = myArray.data();
+    uint64_t total = 0;
+    for (std::size_t ii = 0; ii < myArray.size(); ++ii) {
+      total += values[ii];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  std::filesystem::remove(filepath);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(k_totalValues * sizeof(uint64_t)));
+}
+
+}
+
+BENCHMARK(mapped_file_array_build_and_persist)->Unit(benchmark::kMillisecond);
+BENCHMARK(ofstream_build_and_persist)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(mapped_file_array_reopen_and_scan)->Unit(benchmark::kMillisecond);
+BENCHMARK(ifstream_reopen_and_scan)->Unit(benchmark::kMillisecond);
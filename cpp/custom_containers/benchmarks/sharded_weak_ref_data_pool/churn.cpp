@@ -0,0 +1,93 @@
+
+#include "sharded_weak_ref_data_pool.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// spawn/despawn churn from 1 to 16 threads
+// - one pool_container behind a mutex
+// - one sharded_pool (one shard per thread, no lock)
+//
+
+namespace {
+
+constexpr int k_spawnPerRound = 64;
+
+struct churn_entity {
+  churn_entity(int inValue) : value(inValue) {}
+  virtual ~churn_entity() = default;
+  int value = 0;
+};
+
+using locked_pool_type = custom_containers::weak_ref_data_pool::pool_container<churn_entity, churn_entity, 256, false>;
+using sharded_pool_type = custom_containers::weak_ref_data_pool::sharded_pool<churn_entity, churn_entity, 256, false>;
+
+std::unique_ptr<locked_pool_type> s_lockedPool;
+std::mutex s_lockedPoolMutex;
+
+std::unique_ptr<sharded_pool_type> s_shardedPool;
+
+void locked_pool_churn(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    s_lockedPool = std::make_unique<locked_pool_type>();
+  }
+
+  std::vector<locked_pool_type::weak_ref> allRefs;
+  allRefs.reserve(k_spawnPerRound);
+
+  for (auto _ : state) {
+    for (int ii = 0; ii < k_spawnPerRound; ++ii) {
+      std::unique_lock<std::mutex> lock(s_lockedPoolMutex);
+      allRefs.push_back(s_lockedPool->acquire(ii));
+    }
+    for (auto& ref : allRefs) {
+      std::unique_lock<std::mutex> lock(s_lockedPoolMutex);
+      s_lockedPool->release(ref);
+    }
+    {
+      // the weak_ref(s) are linked to the pool items
+      std::unique_lock<std::mutex> lock(s_lockedPoolMutex);
+      allRefs.clear();
+    }
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * k_spawnPerRound);
+
+  if (state.thread_index() == 0) {
+    s_lockedPool.reset();
+  }
+}
+
+void sharded_pool_churn(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    s_shardedPool = std::make_unique<sharded_pool_type>(16);
+  }
+
+  std::vector<custom_containers::weak_ref_data_pool::sharded_handle> allHandles;
+  allHandles.reserve(k_spawnPerRound);
+
+  for (auto _ : state) {
+    for (int ii = 0; ii < k_spawnPerRound; ++ii) {
+      allHandles.push_back(s_shardedPool->acquire(ii));
+    }
+    for (const auto& handle : allHandles) {
+      s_shardedPool->release(handle);
+    }
+    allHandles.clear();
+  }
+
+  state.SetItemsProcessed(int64_t(state.iterations()) * k_spawnPerRound);
+
+  if (state.thread_index() == 0) {
+    s_shardedPool.reset();
+  }
+}
+
+}
+
+BENCHMARK(locked_pool_churn)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(sharded_pool_churn)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+clear
+
+echo ""
+echo "############"
+echo "# BUILDING #"
+echo "############"
+echo ""
+
+cd ./benchmarks || exit 1
+
+cmake -B "./_cmake-build.release.native" -DCMAKE_BUILD_TYPE=Release
+cmake --build "./_cmake-build.release.native" --config Release --parallel 5 || exit 1
+
+echo ""
+echo "################"
+echo "# BENCHMARKING #"
+echo "################"
+echo ""
+
+# any argument is forwarded, example: sh sh_benchmark.sh --benchmark_filter=flat_map
+./_bin/custom-container-benchmarks "$@"
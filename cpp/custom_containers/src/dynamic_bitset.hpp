@@ -0,0 +1,316 @@
+#pragma once
+
+#include "dynamic_heap_array.hpp"
+#include "utils/popcount.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+namespace custom_containers {
+
+//MARK: dynamic_bitset
+/**
+ * dynamic_bitset
+ *
+ * one bit per element, packed in 64 bits words
+ * - the bits past size() are always zero (count/find can work per word)
+ * - find_first()/find_next() skip the empty words
+ * - bulk and/or/and_not work per word (auto vectorized)
+ */
+template <typename Allocator = std::allocator<uint64_t>>
+class dynamic_bitset {
+
+public:
+  using word_type = uint64_t;
+  static constexpr std::size_t bits_per_word = 64;
+
+private:
+  dynamic_heap_array<word_type, word_type, 0, Allocator> _words;
+  std::size_t _size = 0;
+
+public:
+  dynamic_bitset() = default;
+  explicit dynamic_bitset(std::size_t total_bits) { resize(total_bits); }
+
+  virtual ~dynamic_bitset() = default;
+
+  // disable copy
+  dynamic_bitset(const dynamic_bitset& other) = delete;
+  dynamic_bitset& operator=(const dynamic_bitset& other) = delete;
+  // disable copy
+
+public:
+  // the new bits are cleared
+  void resize(std::size_t total_bits) {
+    const std::size_t totalWords = _get_total_words(total_bits);
+
+    if (total_bits < _size) {
+      while (_words.size() > totalWords) {
+        _words.pop_back();
+      }
+      _size = total_bits;
+      _clear_unused_bits();
+      return;
+    }
+
+    // ensure_size value-initialize -> new words are zero
+    _words.ensure_size(totalWords);
+    _size = total_bits;
+  }
+
+  void clear() {
+    _words.clear();
+    _size = 0;
+  }
+
+  // total bits
+  std::size_t size() const { return _size; }
+  bool is_empty() const { return _size == 0; }
+  bool is_out_of_range(std::size_t index) const { return index >= _size; }
+
+  // npos -> returned by the find methods when nothing was found
+  std::size_t npos() const { return _size; }
+
+  std::size_t total_words() const { return _words.size(); }
+  const word_type* words() const { return _words.data(); }
+  word_type* words() { return _words.data(); }
+
+public:
+  bool test(std::size_t index) const {
+    _ensure_in_range(index);
+    return (_words.data()[index / bits_per_word] >> (index % bits_per_word)) & 1;
+  }
+
+  void set(std::size_t index) {
+    _ensure_in_range(index);
+    _words.data()[index / bits_per_word] |= (word_type(1) << (index % bits_per_word));
+  }
+
+  void reset(std::size_t index) {
+    _ensure_in_range(index);
+    _words.data()[index / bits_per_word] &= ~(word_type(1) << (index % bits_per_word));
+  }
+
+  void set(std::size_t index, bool value) {
+    if (value) {
+      set(index);
+    } else {
+      reset(index);
+    }
+  }
+
+  void flip(std::size_t index) {
+    _ensure_in_range(index);
+    _words.data()[index / bits_per_word] ^= (word_type(1) << (index % bits_per_word));
+  }
+
+  void set_all() {
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] = ~word_type(0);
+    }
+    _clear_unused_bits();
+  }
+
+  void reset_all() {
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] = 0;
+    }
+  }
+
+public:
+  std::size_t count() const { return popcount::count_words(_words.data(), _words.size()); }
+
+  bool any() const {
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      if (_words.data()[ii] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool none() const { return !any(); }
+
+public:
+  std::size_t find_first() const { return _find_from_word(0, ~word_type(0)); }
+
+  // first set bit strictly after "previous"
+  std::size_t find_next(std::size_t previous) const {
+    const std::size_t index = previous + 1;
+    if (index >= _size) {
+      return npos();
+    }
+    // ignore the bits before "index" in its word
+    return _find_from_word(index / bits_per_word, ~word_type(0) << (index % bits_per_word));
+  }
+
+  // callback(std::size_t index)
+  template <typename Callback>
+  void for_each_set(Callback&& callback) const {
+    const word_type* words = _words.data();
+    for (std::size_t wordIndex = 0; wordIndex < _words.size(); ++wordIndex) {
+      word_type currWord = words[wordIndex];
+      while (currWord != 0) {
+        const std::size_t bitIndex = std::size_t(std::countr_zero(currWord));
+        callback(wordIndex * bits_per_word + bitIndex);
+        currWord &= currWord - 1; // clear the lowest set bit
+      }
+    }
+  }
+
+public:
+  dynamic_bitset& operator&=(const dynamic_bitset& other) {
+    _ensure_same_size(other);
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] &= other._words.data()[ii];
+    }
+    return *this;
+  }
+
+  dynamic_bitset& operator|=(const dynamic_bitset& other) {
+    _ensure_same_size(other);
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] |= other._words.data()[ii];
+    }
+    return *this;
+  }
+
+  dynamic_bitset& operator^=(const dynamic_bitset& other) {
+    _ensure_same_size(other);
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] ^= other._words.data()[ii];
+    }
+    return *this;
+  }
+
+  // this = this & ~other
+  dynamic_bitset& and_not(const dynamic_bitset& other) {
+    _ensure_same_size(other);
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] &= ~other._words.data()[ii];
+    }
+    return *this;
+  }
+
+  void copy_from(const dynamic_bitset& other) {
+    resize(other._size);
+    for (std::size_t ii = 0; ii < _words.size(); ++ii) {
+      _words.data()[ii] = other._words.data()[ii];
+    }
+  }
+
+private:
+  static std::size_t _get_total_words(std::size_t total_bits) {
+    return (total_bits + bits_per_word - 1) / bits_per_word;
+  }
+
+  std::size_t _find_from_word(std::size_t wordIndex, word_type firstWordMask) const {
+    const word_type* words = _words.data();
+    if (wordIndex >= _words.size()) {
+      return npos();
+    }
+
+    word_type currWord = words[wordIndex] & firstWordMask;
+    while (currWord == 0) {
+      if (++wordIndex >= _words.size()) {
+        return npos();
+      }
+      currWord = words[wordIndex];
+    }
+
+    return wordIndex * bits_per_word + std::size_t(std::countr_zero(currWord));
+  }
+
+  void _clear_unused_bits() {
+    const std::size_t usedBits = _size % bits_per_word;
+    if (usedBits > 0 && _words.size() > 0) {
+      _words.data()[_words.size() - 1] &= (word_type(1) << usedBits) - 1;
+    }
+  }
+
+  void _ensure_in_range(std::size_t index) const {
+    if (is_out_of_range(index)) {
+      throw std::runtime_error("out of range");
+    }
+  }
+
+  void _ensure_same_size(const dynamic_bitset& other) const {
+    if (other._size != _size) {
+      throw std::runtime_error("size mismatch");
+    }
+  }
+};
+
+//
+//
+//
+
+//MARK: masked_range
+/**
+ * masked_range
+ *
+ * loop over the elements of a container whose bit is set in a mask
+ * - only the set bits are visited (empty words are skipped)
+ * - the container need a data() method (custom containers, std::vector, ...)
+ *
+ * for (auto& item : custom_containers::make_masked_range(myArray, myMask)) {}
+ */
+template <typename Container, typename Bitset>
+class masked_range {
+
+private:
+  Container& _container;
+  const Bitset& _mask;
+
+public:
+  class iterator {
+  private:
+    Container* _container;
+    const Bitset* _mask;
+    std::size_t _index;
+
+  public:
+    iterator(Container& container, const Bitset& mask, std::size_t index)
+      : _container(&container), _mask(&mask), _index(index) {}
+
+  public:
+    auto& operator*() const { return _container->data()[_index]; }
+    auto* operator->() const { return &_container->data()[_index]; }
+
+    std::size_t index() const { return _index; }
+
+    iterator& operator++() {
+      _index = _mask->find_next(_index);
+      return *this;
+    }
+
+    bool operator==(const iterator& rhs) const { return _index == rhs._index; }
+    bool operator!=(const iterator& rhs) const { return _index != rhs._index; }
+  };
+
+public:
+  masked_range(Container& container, const Bitset& mask) : _container(container), _mask(mask) {
+    if (_mask.size() > std::size_t(_container.size())) {
+      throw std::runtime_error("mask bigger than container");
+    }
+  }
+
+public:
+  iterator begin() const { return iterator(_container, _mask, _mask.find_first()); }
+  iterator end() const { return iterator(_container, _mask, _mask.npos()); }
+
+  // callback(value, std::size_t index)
+  template <typename Callback>
+  void for_each(Callback&& callback) const {
+    auto* data = _container.data();
+    _mask.for_each_set([data, &callback](std::size_t index) { callback(data[index], index); });
+  }
+};
+
+template <typename Container, typename Bitset>
+masked_range<Container, Bitset> make_masked_range(Container& container, const Bitset& mask) {
+  return masked_range<Container, Bitset>(container, mask);
+}
+
+} // namespace custom_containers
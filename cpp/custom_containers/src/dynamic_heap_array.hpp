@@ -2,30 +2,35 @@
 #pragma once
 
 #include "utils/generic_array_container.hpp"
+#include "utils/container_stats.hpp"
 
 namespace custom_containers {
 
 template <typename InternalType,
           typename PublicType = InternalType,
           std::size_t initial_size = 0,
-          typename Allocator = std::allocator<InternalType>>
-class dynamic_heap_array : public generic_array_container<InternalType, PublicType> {
+          typename Allocator = std::allocator<InternalType>,
+          typename Stats = stats::default_policy,
+          typename Checks = checks::default_policy>
+class dynamic_heap_array : public generic_array_container<InternalType, PublicType, Checks> {
 
   using value_type = PublicType;
   using internal_type = InternalType;
-  using base_class = generic_array_container<PublicType, InternalType>;
+  using base_class = generic_array_container<InternalType, PublicType, Checks>;
 
 protected:
   using traits_t = std::allocator_traits<Allocator>; // The matching trait
 
 protected:
   std::size_t _capacity = 0;
+  [[no_unique_address]] Stats _stats;
 
 protected:
   // allocate memory only, will not call any constructor
   internal_type* allocate_memory(std::size_t size) {
     Allocator alloc;
     internal_type* newData = alloc.allocate(size);
+    _stats.on_allocate(size * sizeof(internal_type));
     return newData;
   }
 
@@ -33,6 +38,9 @@ protected:
   void deallocate_memory(internal_type* data, std::size_t size) {
     Allocator alloc;
     alloc.deallocate(data, size);
+    if (data != nullptr) {
+      _stats.on_deallocate();
+    }
   }
 
   // call the move constructor only, do not allocate memory
@@ -68,6 +76,7 @@ protected:
 
 public:
   dynamic_heap_array() {
+    _stats.set_name("dynamic_heap_array");
     if (initial_size > 0) {
       pre_allocate(initial_size);
     }
@@ -107,6 +116,7 @@ public:
 
     call_copy_constructor(this->_data + this->_size, reinterpret_cast<const internal_type&>(value));
     ++this->_size;
+    _stats.on_size(this->_size);
   }
 
   // may reallocate
@@ -117,6 +127,7 @@ public:
 
     call_move_constructor(this->_data + this->_size, std::move(reinterpret_cast<internal_type&&>(value)));
     ++this->_size;
+    _stats.on_size(this->_size);
   }
 
   // may reallocate
@@ -127,6 +138,7 @@ public:
 
     value_type& result = emplace_move_constructor(this->_data + this->_size, std::forward<Args>(args)...);
     ++this->_size;
+    _stats.on_size(this->_size);
 
     return result;
   }
@@ -156,6 +168,8 @@ public:
       ++totalSwapped;
     }
 
+    _stats.on_swaps(totalSwapped);
+
     // remove the back
     pop_back();
     return totalSwapped;
@@ -178,6 +192,8 @@ public:
       }
     }
 
+    _stats.on_swaps(totalSwapped);
+
     // remove the back
     pop_back();
     return totalSwapped;
@@ -204,6 +220,7 @@ public:
     }
 
     this->_size = target_size;
+    _stats.on_size(this->_size);
   }
 
   void pre_allocate(std::size_t capacity) { _realloc(capacity); }
@@ -211,6 +228,9 @@ public:
 public:
   std::size_t capacity() const { return this->_capacity; }
 
+  Stats& stats() { return _stats; }
+  const Stats& stats() const { return _stats; }
+
 protected:
   void _realloc(std::size_t newCapacity) {
 
@@ -237,6 +257,7 @@ protected:
 
     // deallocate the old memory
     if (this->_capacity > 0) {
+      _stats.on_reallocate(this->_size);
       deallocate_memory(this->_data, this->_capacity);
     }
 
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "utils/generic_flat_container.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace custom_containers {
+
+//MARK: flat_map
+/**
+ * flat_map
+ *
+ * sorted map for read-mostly tables
+ * - keys and values live in two dynamic_heap_array (no node allocation)
+ * - build()/insert_range() sort the input once then merge it
+ * - insert()/erase() of a single key shift the tail: O(n)
+ * - a key already present is never overwritten (first one wins)
+ */
+template <typename Key,
+          typename Value,
+          typename Compare = std::less<Key>,
+          template <typename...> class Allocator = std::allocator,
+          search_layout layout = search_layout::branchless
+>
+class flat_map : public generic_flat_container<Key, Value, Compare, Allocator, layout> {
+
+public:
+  using base_class = generic_flat_container<Key, Value, Compare, Allocator, layout>;
+  using key_type = Key;
+  using mapped_type = Value;
+
+private:
+  using key_array = typename base_class::key_array;
+  using mapped_array = typename base_class::mapped_array;
+
+public:
+  flat_map() = default;
+  flat_map(std::initializer_list<std::pair<Key, Value>> values) { build(values); }
+
+  virtual ~flat_map() = default;
+
+public:
+  // replace the content, the input does not need to be sorted
+  template <typename InputIt>
+  void build(InputIt first, InputIt last) {
+    key_array keys;
+    mapped_array values;
+    _gather(first, last, keys, values);
+    this->_build_from(keys, values);
+  }
+  void build(std::initializer_list<std::pair<Key, Value>> values) { build(values.begin(), values.end()); }
+
+  // sort the input then merge it, the input does not need to be sorted
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    key_array keys;
+    mapped_array values;
+    _gather(first, last, keys, values);
+    this->_merge_from(keys, values);
+  }
+  void insert_range(std::initializer_list<std::pair<Key, Value>> values) {
+    insert_range(values.begin(), values.end());
+  }
+
+  // return false if the key was already stored
+  template <typename... Args>
+  bool insert(const Key& key, Args&&... args) {
+    return this->_insert_one(key, std::forward<Args>(args)...) >= 0;
+  }
+
+  bool erase(const Key& key) { return this->_erase_one(key); }
+
+public:
+  // nullptr if not found
+  Value* find(const Key& key) {
+    const int32_t index = this->index_of(key);
+    return index < 0 ? nullptr : this->_values.data() + index;
+  }
+  const Value* find(const Key& key) const {
+    const int32_t index = this->index_of(key);
+    return index < 0 ? nullptr : this->_values.data() + index;
+  }
+
+  Value& at(const Key& key) {
+    Value* value = find(key);
+    if (value == nullptr) {
+      throw std::runtime_error("key not found");
+    }
+    return *value;
+  }
+  const Value& at(const Key& key) const {
+    const Value* value = find(key);
+    if (value == nullptr) {
+      throw std::runtime_error("key not found");
+    }
+    return *value;
+  }
+
+  Value& value_at(std::size_t index) { return this->_values.at(index); }
+  const Value& value_at(std::size_t index) const { return this->_values.at(index); }
+
+  // values, in the same order as the keys
+  const mapped_array& values() const { return this->_values; }
+
+public:
+  template <typename Callback>
+  void for_each(Callback&& callback) {
+    for (std::size_t ii = 0; ii < this->_keys.size(); ++ii) {
+      callback(this->_keys.data()[ii], this->_values.data()[ii]);
+    }
+  }
+
+  template <typename Callback>
+  void for_each(Callback&& callback) const {
+    for (std::size_t ii = 0; ii < this->_keys.size(); ++ii) {
+      callback(this->_keys.data()[ii], static_cast<const Value&>(this->_values.data()[ii]));
+    }
+  }
+
+private:
+  template <typename InputIt>
+  static void _gather(InputIt first, InputIt last, key_array& keys, mapped_array& values) {
+    for (; first != last; ++first) {
+      keys.push_back(first->first);
+      values.push_back(first->second);
+    }
+  }
+};
+
+} // namespace custom_containers
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "utils/generic_flat_container.hpp"
+
+#include <functional>
+#include <initializer_list>
+
+namespace custom_containers {
+
+//MARK: flat_set
+/**
+ * flat_set
+ *
+ * sorted set for read-mostly tables
+ * - keys live in one dynamic_heap_array (no node allocation)
+ * - build()/insert_range() sort the input once then merge it
+ * - insert()/erase() of a single key shift the tail: O(n)
+ */
+template <typename Key,
+          typename Compare = std::less<Key>,
+          template <typename...> class Allocator = std::allocator,
+          search_layout layout = search_layout::branchless
+>
+class flat_set : public generic_flat_container<Key, void, Compare, Allocator, layout> {
+
+public:
+  using base_class = generic_flat_container<Key, void, Compare, Allocator, layout>;
+  using key_type = Key;
+
+private:
+  using key_array = typename base_class::key_array;
+  using mapped_array = typename base_class::mapped_array;
+
+public:
+  flat_set() = default;
+  flat_set(std::initializer_list<Key> keys) { build(keys); }
+
+  virtual ~flat_set() = default;
+
+public:
+  // replace the content, the input does not need to be sorted
+  template <typename InputIt>
+  void build(InputIt first, InputIt last) {
+    key_array keys;
+    mapped_array unused;
+    _gather(first, last, keys);
+    this->_build_from(keys, unused);
+  }
+  void build(std::initializer_list<Key> keys) { build(keys.begin(), keys.end()); }
+
+  // sort the input then merge it, the input does not need to be sorted
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    key_array keys;
+    mapped_array unused;
+    _gather(first, last, keys);
+    this->_merge_from(keys, unused);
+  }
+  void insert_range(std::initializer_list<Key> keys) { insert_range(keys.begin(), keys.end()); }
+
+  // return false if the key was already stored
+  bool insert(const Key& key) { return this->_insert_one(key) >= 0; }
+
+  bool erase(const Key& key) { return this->_erase_one(key); }
+
+public:
+  template <typename Callback>
+  void for_each(Callback&& callback) const {
+    for (std::size_t ii = 0; ii < this->_keys.size(); ++ii) {
+      callback(this->_keys.data()[ii]);
+    }
+  }
+
+private:
+  template <typename InputIt>
+  static void _gather(InputIt first, InputIt last, key_array& keys) {
+    for (; first != last; ++first) {
+      keys.push_back(*first);
+    }
+  }
+};
+
+} // namespace custom_containers
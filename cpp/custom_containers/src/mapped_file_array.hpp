@@ -0,0 +1,278 @@
+#pragma once
+
+#include "utils/generic_array_container.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace custom_containers {
+
+//MARK: mapped_file_array
+/**
+ * mapped_file_array
+ *
+ * dynamic array whose storage is a shared file mapping (linux only)
+ * - the page cache does the i/o, no write loop, no read loop
+ * - growth: ftruncate + mremap (the mapping may move, like a reallocation)
+ * - sync(): msync, explicit persistence point (also done by close())
+ * - open() on an existing file: zero copy, the values are paged in on access
+ * - trivially copyable values only (the bytes are the file content)
+ *
+ * file layout: 64 bytes header (magic, element size, size) + values
+ */
+template <typename InternalType, typename Checks = checks::default_policy>
+class mapped_file_array : public generic_array_container<InternalType, InternalType, Checks> {
+
+  static_assert(std::is_trivially_copyable_v<InternalType>, "mapped_file_array need trivially copyable values");
+
+public:
+  using value_type = InternalType;
+  using internal_type = InternalType;
+  using base_class = generic_array_container<InternalType, InternalType, Checks>;
+
+private:
+  struct file_header {
+    char magic[8];
+    uint64_t element_size;
+    uint64_t size;
+    uint64_t reserved[5];
+  };
+  static_assert(sizeof(file_header) == 64, "the values must stay cache line aligned");
+
+  static constexpr char k_magic[8] = {'C', 'C', 'A', 'R', 'R', 'A', 'Y', '1'};
+  static constexpr std::size_t k_minimumCapacityBytes = 64 * 1024;
+
+private:
+  std::string _filepath;
+  int _fileDescriptor = -1;
+  file_header* _header = nullptr;
+  std::size_t _mappedSize = 0; // the whole file (an existing file may end with a partial value)
+  std::size_t _capacity = 0;
+
+public:
+  mapped_file_array() = default;
+  explicit mapped_file_array(const std::string& filepath) { open(filepath); }
+
+  virtual ~mapped_file_array() { close(); }
+
+  // disable copy
+  mapped_file_array(const mapped_file_array& other) = delete;
+  mapped_file_array& operator=(const mapped_file_array& other) = delete;
+  // disable copy
+
+  // disable move
+  mapped_file_array(mapped_file_array&& other) = delete;
+  mapped_file_array& operator=(mapped_file_array&& other) = delete;
+  // disable move
+
+public:
+  // create the file, or map the existing one (zero copy)
+  void open(const std::string& filepath) {
+    close();
+
+    const int fileDescriptor = ::open(filepath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fileDescriptor < 0) {
+      throw std::runtime_error("mapped_file_array: cannot open file");
+    }
+
+    struct stat fileStat;
+    if (::fstat(fileDescriptor, &fileStat) != 0) {
+      ::close(fileDescriptor);
+      throw std::runtime_error("mapped_file_array: cannot stat file");
+    }
+
+    const std::size_t fileSize = std::size_t(fileStat.st_size);
+    const bool isNewFile = (fileSize == 0);
+
+    if (!isNewFile && fileSize < sizeof(file_header)) {
+      ::close(fileDescriptor);
+      throw std::runtime_error("mapped_file_array: invalid file");
+    }
+
+    // a file created here is removed again on failure (no empty file left behind)
+    auto closeOnFailure = [&filepath, fileDescriptor, isNewFile]() {
+      ::close(fileDescriptor);
+      if (isNewFile) {
+        ::unlink(filepath.c_str());
+      }
+    };
+
+    const std::size_t mappedSize = isNewFile ? _get_file_size(_get_initial_capacity()) : fileSize;
+    if (isNewFile && ::ftruncate(fileDescriptor, off_t(mappedSize)) != 0) {
+      closeOnFailure();
+      throw std::runtime_error("mapped_file_array: cannot resize file");
+    }
+
+    void* mappedData = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mappedData == MAP_FAILED) {
+      closeOnFailure();
+      throw std::runtime_error("mapped_file_array: cannot map file");
+    }
+
+    file_header* header = static_cast<file_header*>(mappedData);
+
+    if (isNewFile) {
+      std::memcpy(header->magic, k_magic, sizeof(k_magic));
+      header->element_size = sizeof(internal_type);
+      header->size = 0;
+    } else if (std::memcmp(header->magic, k_magic, sizeof(k_magic)) != 0 ||
+               header->element_size != sizeof(internal_type) ||
+               header->size > (mappedSize - sizeof(file_header)) / sizeof(internal_type)) {
+      ::munmap(mappedData, mappedSize);
+      ::close(fileDescriptor);
+      throw std::runtime_error("mapped_file_array: invalid file");
+    }
+
+    _filepath = filepath;
+    _fileDescriptor = fileDescriptor;
+    _header = header;
+    _mappedSize = mappedSize;
+    _capacity = (mappedSize - sizeof(file_header)) / sizeof(internal_type);
+    this->_data = _get_values(header);
+    this->_size = std::size_t(header->size);
+  }
+
+  // sync then unmap, the file keep its capacity (no shrink on close)
+  void close() {
+    if (!is_open()) {
+      return;
+    }
+
+    // no throw here (also called by the destructor)
+    _flush();
+
+    ::munmap(_header, _mappedSize);
+    ::close(_fileDescriptor);
+
+    _filepath.clear();
+    _fileDescriptor = -1;
+    _header = nullptr;
+    _mappedSize = 0;
+    _capacity = 0;
+    this->_data = nullptr;
+    this->_size = 0;
+  }
+
+  // persistence point: the size is written in the header then the pages are flushed
+  void sync() {
+    _ensure_is_open();
+    if (!_flush()) {
+      throw std::runtime_error("mapped_file_array: msync failed");
+    }
+  }
+
+  bool is_open() const { return _header != nullptr; }
+  const std::string& filepath() const { return _filepath; }
+
+public:
+  // may remap
+  void push_back(const value_type& value) {
+    if (this->_size == _capacity) {
+      _remap(_capacity * 2);
+    }
+
+    this->_data[this->_size] = value;
+    ++this->_size;
+  }
+
+  // may remap
+  template <typename... Args> value_type& emplace_back(Args&&... args) {
+    if (this->_size == _capacity) {
+      _remap(_capacity * 2);
+    }
+
+    value_type& result = this->_data[this->_size];
+    result = value_type{std::forward<Args>(args)...};
+    ++this->_size;
+
+    return result;
+  }
+
+  void pop_back() {
+    if (this->_size == 0) {
+      return;
+    }
+
+    --this->_size;
+  }
+
+  void clear() { this->_size = 0; }
+
+  // the new values are zero (new file pages) or keep their previous content (after a pop_back/clear)
+  void ensure_size(std::size_t target_size) {
+    if (target_size < this->_size) {
+      return;
+    }
+
+    pre_allocate(target_size);
+    this->_size = target_size;
+  }
+
+  void pre_allocate(std::size_t capacity) {
+    if (capacity > _capacity) {
+      _remap(capacity);
+    }
+  }
+
+public:
+  std::size_t capacity() const { return _capacity; }
+
+private:
+  static std::size_t _get_initial_capacity() {
+    return std::max<std::size_t>(1, k_minimumCapacityBytes / sizeof(internal_type));
+  }
+
+  static std::size_t _get_file_size(std::size_t capacity) {
+    return sizeof(file_header) + capacity * sizeof(internal_type);
+  }
+
+  static internal_type* _get_values(file_header* header) {
+    return reinterpret_cast<internal_type*>(reinterpret_cast<char*>(header) + sizeof(file_header));
+  }
+
+  void _ensure_is_open() const {
+    if (!is_open()) {
+      throw std::runtime_error("mapped_file_array: file not open");
+    }
+  }
+
+  bool _flush() {
+    _header->size = this->_size;
+    return ::msync(_header, _mappedSize, MS_SYNC) == 0;
+  }
+
+  void _remap(std::size_t newCapacity) {
+    _ensure_is_open();
+
+    newCapacity = std::max(newCapacity, _get_initial_capacity());
+
+    const std::size_t newFileSize = _get_file_size(newCapacity);
+
+    if (::ftruncate(_fileDescriptor, off_t(newFileSize)) != 0) {
+      throw std::runtime_error("mapped_file_array: cannot resize file");
+    }
+
+    // the kernel move the page table entries, no value is copied
+    void* mappedData = ::mremap(_header, _mappedSize, newFileSize, MREMAP_MAYMOVE);
+    if (mappedData == MAP_FAILED) {
+      throw std::runtime_error("mapped_file_array: cannot remap file");
+    }
+
+    _header = static_cast<file_header*>(mappedData);
+    _mappedSize = newFileSize;
+    _capacity = newCapacity;
+    this->_data = _get_values(_header);
+  }
+};
+
+} // namespace custom_containers
@@ -0,0 +1,365 @@
+#pragma once
+
+#include "utils/aligned_memory.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace custom_containers {
+namespace weak_ref_data_pool {
+
+//MARK: sharded_handle
+// global handle: owning shard + stable slot in that shard
+// -> the generation detect a stale handle (slot reused after a release)
+struct sharded_handle {
+  static constexpr uint32_t invalid_shard = UINT32_MAX;
+
+  uint32_t shard = invalid_shard;
+  uint32_t slot = 0;
+  uint32_t generation = 0;
+
+  bool is_valid() const { return shard != invalid_shard; }
+
+  bool operator==(const sharded_handle& other) const {
+    return shard == other.shard && slot == other.slot && generation == other.generation;
+  }
+  bool operator!=(const sharded_handle& other) const { return !sharded_handle::operator==(other); }
+};
+
+//
+//
+//
+
+//MARK: sharded_pool
+/**
+ * sharded_pool
+ *
+ * one pool_container per thread, no lock on the acquire/release path
+ * - a thread is bound to a shard on its first use (throw when no shard is left)
+ * - a thread release its shard when it exit, the next thread bound to it
+ *   apply the releases still queued there
+ * - acquire()/get() work on the shard of the calling thread
+ * - release() of a handle owned by another shard is queued, the owner
+ *   thread apply it on its next acquire()/release()/collect()
+ * - for_each() (global) and the per shard methods called from another thread
+ *   are not thread safe: the workers must be idle
+ */
+template <typename InternalBaseType,
+          typename PublicBaseType = InternalBaseType,
+          std::size_t initial_size = 256,
+          bool no_realloc = false,
+          template <typename...> class Allocator = std::allocator,
+          typename Stats = stats::default_policy,
+          typename Checks = checks::default_policy
+>
+class sharded_pool {
+
+public:
+  using pool_type = pool_container<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
+  using value_type = typename pool_type::value_type;
+  using weak_ref = typename pool_type::weak_ref;
+
+  static constexpr std::size_t npos = std::size_t(-1);
+
+private:
+  struct slot_entry {
+    weak_ref ref; // follow the item when the pool swap it
+    uint32_t generation = 0;
+  };
+
+  // one shard per cache line (at least), the owner threads do not share lines
+  struct alignas(cache_line_size) shard {
+    pool_type pool;
+    dynamic_heap_array<slot_entry> slots;
+    dynamic_heap_array<uint32_t> free_slots;
+
+    // releases from the other threads
+    std::mutex pending_mutex;
+    dynamic_heap_array<sharded_handle> pending_releases;
+    std::atomic<bool> has_pending{false};
+
+    dynamic_heap_array<sharded_handle> drain_buffer; // owner thread only
+  };
+
+  // shared with the bound threads: a thread can outlive the pool
+  struct binding_registry {
+    std::mutex mutex;
+    std::vector<bool> bound_shards;
+  };
+
+  struct thread_binding {
+    uint64_t pool_id = 0;
+    std::size_t shard_index = npos;
+    std::weak_ptr<binding_registry> registry;
+  };
+
+  // every pool the thread is bound to, released when the thread exit
+  struct thread_bindings {
+    thread_binding* last = nullptr; // last pool used -> no scan on the fast path
+    std::vector<thread_binding> bindings;
+
+    thread_bindings() = default;
+    thread_bindings(const thread_bindings& other) = delete;
+    thread_bindings& operator=(const thread_bindings& other) = delete;
+
+    ~thread_bindings() {
+      for (thread_binding& binding : bindings) {
+        if (std::shared_ptr<binding_registry> registry = binding.registry.lock()) {
+          std::unique_lock<std::mutex> lock(registry->mutex);
+          registry->bound_shards[binding.shard_index] = false;
+        }
+      }
+    }
+
+    thread_binding* find(uint64_t pool_id) {
+      if (last != nullptr && last->pool_id == pool_id) {
+        return last;
+      }
+      for (thread_binding& binding : bindings) {
+        if (binding.pool_id == pool_id) {
+          last = &binding;
+          return last;
+        }
+      }
+      return nullptr;
+    }
+  };
+
+private:
+  const uint64_t _poolId;
+  const std::size_t _totalShards;
+  std::unique_ptr<shard[]> _shards;
+
+  std::shared_ptr<binding_registry> _registry;
+
+public:
+  explicit sharded_pool(std::size_t total_shards)
+    : _poolId(_get_next_pool_id()), _totalShards(total_shards), _shards(std::make_unique<shard[]>(total_shards)),
+      _registry(std::make_shared<binding_registry>()) {
+    if (total_shards == 0) {
+      throw std::runtime_error("no shard");
+    }
+    _registry->bound_shards.resize(total_shards, false);
+  }
+
+  ~sharded_pool() = default;
+
+  // disable copy
+  sharded_pool(const sharded_pool& other) = delete;
+  sharded_pool& operator=(const sharded_pool& other) = delete;
+  // disable copy
+
+  // disable move
+  sharded_pool(sharded_pool&& other) = delete;
+  sharded_pool& operator=(sharded_pool&& other) = delete;
+  // disable move
+
+public:
+  std::size_t total_shards() const { return _totalShards; }
+
+  // bind the calling thread to a shard on its first use
+  std::size_t local_shard_index() {
+    thread_bindings& tlBindings = _get_thread_bindings();
+    if (const thread_binding* binding = tlBindings.find(_poolId)) {
+      return binding->shard_index;
+    }
+
+    std::size_t shardIndex = 0;
+    {
+      std::unique_lock<std::mutex> lock(_registry->mutex);
+
+      while (shardIndex < _totalShards && _registry->bound_shards[shardIndex]) {
+        ++shardIndex;
+      }
+      if (shardIndex == _totalShards) {
+        throw std::runtime_error("no shard left");
+      }
+      _registry->bound_shards[shardIndex] = true;
+    }
+
+    // the bindings of the destroyed pools are dropped here
+    std::erase_if(tlBindings.bindings, [](const thread_binding& binding) { return binding.registry.expired(); });
+    tlBindings.bindings.push_back(thread_binding{_poolId, shardIndex, _registry});
+    tlBindings.last = &tlBindings.bindings.back();
+
+    // a previous owner may have exited with releases still queued
+    _collect(_shards[shardIndex]);
+    return shardIndex;
+  }
+
+public:
+  // on the shard of the calling thread, invalid handle when a no_realloc shard is full
+  template <typename... Args>
+  sharded_handle acquire(Args&&... args) {
+    const std::size_t shardIndex = local_shard_index();
+    shard& currShard = _shards[shardIndex];
+    _collect(currShard);
+
+    weak_ref newRef = currShard.pool.acquire(std::forward<Args>(args)...);
+    if (!newRef.is_valid()) {
+      return sharded_handle{};
+    }
+
+    uint32_t slotIndex = 0;
+    if (!currShard.free_slots.is_empty()) {
+      slotIndex = currShard.free_slots.back();
+      currShard.free_slots.pop_back();
+    } else {
+      slotIndex = uint32_t(currShard.slots.size());
+      currShard.slots.emplace_back();
+    }
+
+    slot_entry& entry = currShard.slots.at(slotIndex);
+    entry.ref = std::move(newRef);
+
+    return sharded_handle{uint32_t(shardIndex), slotIndex, entry.generation};
+  }
+
+  // immediate on the owner thread, queued to the owner shard otherwise
+  void release(const sharded_handle& handle) {
+    if (!handle.is_valid() || handle.shard >= _totalShards) {
+      return;
+    }
+
+    if (_find_local_shard_index() == handle.shard) {
+      shard& currShard = _shards[handle.shard];
+      _collect(currShard);
+      _release_local(currShard, handle);
+      return;
+    }
+
+    shard& ownerShard = _shards[handle.shard];
+    {
+      std::unique_lock<std::mutex> lock(ownerShard.pending_mutex);
+      ownerShard.pending_releases.push_back(handle);
+    }
+    ownerShard.has_pending.store(true, std::memory_order_release);
+  }
+
+  // apply the releases queued by the other threads
+  void collect() { _collect(_shards[local_shard_index()]); }
+
+public:
+  // owner thread only (or idle workers), nullptr when released
+  value_type* get(const sharded_handle& handle) {
+    slot_entry* entry = _find_entry(handle);
+    return entry != nullptr ? entry->ref.get() : nullptr;
+  }
+
+  bool is_valid(const sharded_handle& handle) { return _find_entry(handle) != nullptr; }
+
+public:
+  std::size_t size(std::size_t shard_index) const {
+    _ensure_shard_index(shard_index);
+    return _shards[shard_index].pool.size();
+  }
+
+  std::size_t size() const {
+    std::size_t total = 0;
+    for (std::size_t ii = 0; ii < _totalShards; ++ii) {
+      total += _shards[ii].pool.size();
+    }
+    return total;
+  }
+
+  std::size_t pending_releases(std::size_t shard_index) {
+    _ensure_shard_index(shard_index);
+    std::unique_lock<std::mutex> lock(_shards[shard_index].pending_mutex);
+    return _shards[shard_index].pending_releases.size();
+  }
+
+public:
+  void for_each_in_shard(std::size_t shard_index, std::function<void(value_type&)> callback) {
+    _ensure_shard_index(shard_index);
+    _shards[shard_index].pool.for_each(callback);
+  }
+
+  // callback(value, shard index)
+  void for_each(std::function<void(value_type&, std::size_t)> callback) {
+    for (std::size_t shardIndex = 0; shardIndex < _totalShards; ++shardIndex) {
+      _shards[shardIndex].pool.for_each([&callback, shardIndex](value_type& item) { callback(item, shardIndex); });
+    }
+  }
+
+private:
+  static uint64_t _get_next_pool_id() {
+    static std::atomic<uint64_t> s_nextPoolId{1};
+    return s_nextPoolId.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // no lock on the fast path, destroyed (shards released) when the thread exit
+  static thread_bindings& _get_thread_bindings() {
+    static thread_local thread_bindings tl_bindings;
+    return tl_bindings;
+  }
+
+  // same as local_shard_index() but never bind the thread (npos)
+  std::size_t _find_local_shard_index() {
+    const thread_binding* binding = _get_thread_bindings().find(_poolId);
+    return binding != nullptr ? binding->shard_index : npos;
+  }
+
+  void _ensure_shard_index(std::size_t shard_index) const {
+    if (shard_index >= _totalShards) {
+      throw std::runtime_error("out of range");
+    }
+  }
+
+  slot_entry* _find_entry(const sharded_handle& handle) {
+    if (!handle.is_valid() || handle.shard >= _totalShards) {
+      return nullptr;
+    }
+
+    shard& currShard = _shards[handle.shard];
+    if (handle.slot >= currShard.slots.size()) {
+      return nullptr;
+    }
+
+    slot_entry& entry = currShard.slots.at(handle.slot);
+    if (entry.generation != handle.generation || !entry.ref.is_valid()) {
+      return nullptr;
+    }
+    return &entry;
+  }
+
+  void _release_local(shard& currShard, const sharded_handle& handle) {
+    slot_entry* entry = _find_entry(handle);
+    if (entry == nullptr) {
+      return; // stale handle or double release
+    }
+
+    currShard.pool.release(entry->ref);
+    entry->ref.invalidate();
+    ++entry->generation;
+    currShard.free_slots.push_back(handle.slot);
+  }
+
+  void _collect(shard& currShard) {
+    if (!currShard.has_pending.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(currShard.pending_mutex);
+      currShard.has_pending.store(false, std::memory_order_relaxed);
+      for (const sharded_handle& handle : currShard.pending_releases) {
+        currShard.drain_buffer.push_back(handle);
+      }
+      currShard.pending_releases.clear();
+    }
+
+    for (const sharded_handle& handle : currShard.drain_buffer) {
+      _release_local(currShard, handle);
+    }
+    currShard.drain_buffer.clear();
+  }
+};
+
+} // namespace weak_ref_data_pool
+} // namespace custom_containers
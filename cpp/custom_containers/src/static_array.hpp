@@ -4,12 +4,15 @@
 
 namespace custom_containers {
 
-template <typename InternalType, std::size_t _Size, typename PublicType = InternalType>
-class static_array : public generic_array_container<InternalType, PublicType> {
+template <typename InternalType,
+          std::size_t _Size,
+          typename PublicType = InternalType,
+          typename Checks = checks::default_policy>
+class static_array : public generic_array_container<InternalType, PublicType, Checks> {
 
   using value_type = PublicType;
 
-  using base_class = generic_array_container<InternalType, PublicType>;
+  using base_class = generic_array_container<InternalType, PublicType, Checks>;
 
 private:
   InternalType _static_data[_Size];
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+//
+// allocators for the "Allocator" template argument of the containers
+// - aligned_allocator: 64/128 bytes aligned buffer (cache line, simd)
+// - huge_page_allocator: mmap backed, 2MB pages when available (less TLB misses)
+// and a padding helper against false sharing: cache_line_padded
+//
+
+namespace custom_containers {
+
+constexpr std::size_t cache_line_size = 64;
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+//MARK: aligned_allocator
+template <typename T, std::size_t Alignment = cache_line_size>
+struct aligned_allocator {
+
+  static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "alignment smaller than the type alignment");
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment>&) {}
+
+  T* allocate(std::size_t total) {
+    return static_cast<T*>(::operator new(total * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* data, std::size_t) {
+    if (data == nullptr) {
+      return;
+    }
+    ::operator delete(data, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const aligned_allocator<U, Alignment>&) const { return true; }
+  template <typename U>
+  bool operator!=(const aligned_allocator<U, Alignment>&) const { return false; }
+};
+
+// usable as a "template <typename...> class Allocator" argument (weak_ref_data_pool)
+template <typename T>
+using cache_line_allocator = aligned_allocator<T, cache_line_size>;
+// 128 -> the adjacent line prefetcher work per pair of lines
+template <typename T>
+using double_cache_line_allocator = aligned_allocator<T, 2 * cache_line_size>;
+
+//
+//
+//
+
+//MARK: huge_page_allocator
+/**
+ * huge_page_allocator
+ *
+ * anonymous mmap, always page aligned (so also cache line aligned)
+ * - buffer >= 2MB: explicit huge pages first (MAP_HUGETLB, need reserved pages)
+ *   then transparent huge pages (2MB aligned mapping + madvise(MADV_HUGEPAGE))
+ * - smaller buffer: plain mmap
+ * - not linux: aligned operator new fallback
+ */
+template <typename T>
+struct huge_page_allocator {
+
+  using value_type = T;
+
+  huge_page_allocator() = default;
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U>&) {}
+
+  T* allocate(std::size_t total) { return static_cast<T*>(allocate_bytes(total * sizeof(T))); }
+
+  void deallocate(T* data, std::size_t total) {
+    if (data == nullptr) {
+      return;
+    }
+    deallocate_bytes(data, total * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const huge_page_allocator<U>&) const { return true; }
+  template <typename U>
+  bool operator!=(const huge_page_allocator<U>&) const { return false; }
+
+public:
+  // the mapping length only depend on the requested size -> deallocate can recompute it
+  static std::size_t get_mapped_size(std::size_t bytes) {
+    const std::size_t granularity = bytes >= huge_page_size ? huge_page_size : std::size_t(4096);
+    return (bytes + granularity - 1) / granularity * granularity;
+  }
+
+#if defined(__linux__)
+
+  static void* allocate_bytes(std::size_t bytes) {
+    const std::size_t mappedSize = get_mapped_size(bytes);
+    constexpr int protection = PROT_READ | PROT_WRITE;
+    constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (mappedSize < huge_page_size) {
+      void* data = ::mmap(nullptr, mappedSize, protection, flags, -1, 0);
+      if (data == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      return data;
+    }
+
+    // explicit huge pages (fail when none are reserved: /proc/sys/vm/nr_hugepages)
+    void* data = ::mmap(nullptr, mappedSize, protection, flags | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED) {
+      return data;
+    }
+
+    // transparent huge pages -> the mapping must be 2MB aligned, over map then trim
+    void* rawData = ::mmap(nullptr, mappedSize + huge_page_size, protection, flags, -1, 0);
+    if (rawData == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    const uintptr_t rawAddress = reinterpret_cast<uintptr_t>(rawData);
+    const uintptr_t alignedAddress = (rawAddress + huge_page_size - 1) & ~uintptr_t(huge_page_size - 1);
+    const std::size_t headSize = alignedAddress - rawAddress;
+    const std::size_t tailSize = huge_page_size - headSize;
+    if (headSize > 0) {
+      ::munmap(rawData, headSize);
+    }
+    if (tailSize > 0) {
+      ::munmap(reinterpret_cast<void*>(alignedAddress + mappedSize), tailSize);
+    }
+
+    data = reinterpret_cast<void*>(alignedAddress);
+    ::madvise(data, mappedSize, MADV_HUGEPAGE); // only a hint, ignored when disabled
+    return data;
+  }
+
+  static void deallocate_bytes(void* data, std::size_t bytes) { ::munmap(data, get_mapped_size(bytes)); }
+
+#else
+
+  static void* allocate_bytes(std::size_t bytes) {
+    return ::operator new(get_mapped_size(bytes), std::align_val_t(4096));
+  }
+
+  static void deallocate_bytes(void* data, std::size_t) { ::operator delete(data, std::align_val_t(4096)); }
+
+#endif
+};
+
+//
+//
+//
+
+//MARK: cache_line_padded
+/**
+ * cache_line_padded
+ *
+ * one value per cache line: threads writing neighbouring elements
+ * (per thread counters, per worker states...) do not share a line
+ *
+ * custom_containers::static_array<cache_line_padded<uint64_t>, 8> perThreadCounters;
+ * ++perThreadCounters.at(threadIndex).value;
+ */
+template <typename T, std::size_t Alignment = cache_line_size>
+struct alignas(Alignment) cache_line_padded {
+  T value{};
+
+  cache_line_padded() = default;
+  cache_line_padded(const T& inValue) : value(inValue) {}
+
+  T& operator*() { return value; }
+  const T& operator*() const { return value; }
+  T* operator->() { return &value; }
+  const T* operator->() const { return &value; }
+};
+
+} // namespace custom_containers
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cassert>
+#include <stdexcept>
+
+//
+// define (before any include) one of those to change the default policy:
+// - D_CUSTOM_CONTAINERS_ASSERT_ONLY -> assert(), removed by NDEBUG
+// - D_CUSTOM_CONTAINERS_UNCHECKED   -> no check at all
+// a container can also use its own policy with the "checks::xxx" template argument
+//
+
+namespace custom_containers {
+namespace checks {
+
+enum class mode {
+  checked,     // throw std::runtime_error (default)
+  assert_only, // assert(), removed by NDEBUG
+  unchecked,   // nothing, an invalid access is undefined behavior
+};
+
+struct checked {
+  static constexpr mode value = mode::checked;
+};
+
+struct assert_only {
+  static constexpr mode value = mode::assert_only;
+};
+
+struct unchecked {
+  static constexpr mode value = mode::unchecked;
+};
+
+#if defined(D_CUSTOM_CONTAINERS_UNCHECKED)
+using default_policy = unchecked;
+#elif defined(D_CUSTOM_CONTAINERS_ASSERT_ONLY)
+using default_policy = assert_only;
+#else
+using default_policy = checked;
+#endif
+
+} // namespace checks
+} // namespace custom_containers
+
+// one line check macro, the condition is not evaluated when the policy remove the check
+#define D_CONTAINER_CHECK(policy, condition, message) \
+{ \
+  if constexpr (policy::value == custom_containers::checks::mode::checked) { \
+    if (!(condition)) { \
+      throw std::runtime_error(message); \
+    } \
+  } else if constexpr (policy::value == custom_containers::checks::mode::assert_only) { \
+    assert((condition) && message); \
+  } \
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//
+// define D_CUSTOM_CONTAINERS_STATS (before any include) to record the stats
+// of every container using the default policy, a container can also opt-in
+// on its own with the "stats::enabled" template argument
+//
+
+namespace custom_containers {
+namespace stats {
+
+//MARK: counters
+struct counters {
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  uint64_t bytes_allocated = 0;
+  uint64_t reallocations = 0;
+  uint64_t element_moves = 0;
+  uint64_t element_swaps = 0;
+  uint64_t ref_syncs = 0;
+  uint64_t peak_size = 0;
+
+  void merge(const counters& other) {
+    allocations += other.allocations;
+    deallocations += other.deallocations;
+    bytes_allocated += other.bytes_allocated;
+    reallocations += other.reallocations;
+    element_moves += other.element_moves;
+    element_swaps += other.element_swaps;
+    ref_syncs += other.ref_syncs;
+    peak_size = std::max(peak_size, other.peak_size);
+  }
+};
+
+//
+//
+//
+
+//MARK: disabled
+// every hook is empty and the policy has no data member
+// -> [[no_unique_address]] + inlining: no size and no instruction left
+struct disabled {
+  static constexpr bool is_enabled = false;
+
+  void set_name(const char*) {}
+
+  void on_allocate(std::size_t) {}
+  void on_deallocate() {}
+  void on_reallocate(std::size_t) {}
+  void on_swaps(std::size_t) {}
+  void on_ref_syncs(std::size_t) {}
+  void on_size(std::size_t) {}
+};
+
+//
+//
+//
+
+class enabled;
+
+//MARK: registry
+// list the live containers with stats enabled, the destroyed ones are merged by name
+// -> dump_json() from any thread, the live counters are a snapshot (see enabled)
+class registry {
+
+private:
+  struct retired_counters {
+    std::string name;
+    counters values;
+  };
+
+private:
+  mutable std::mutex _mutex;
+  std::vector<const enabled*> _live;
+  std::vector<retired_counters> _retired;
+
+public:
+  static registry& get() {
+    static registry s_instance;
+    return s_instance;
+  }
+
+public:
+  void add(const enabled* stats) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _live.push_back(stats);
+  }
+
+  inline void remove(const enabled* stats);
+
+  void reset() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _retired.clear();
+  }
+
+public:
+  inline void dump_json(std::ostream& stream) const;
+
+  std::string to_json() const {
+    std::stringstream sstr;
+    dump_json(sstr);
+    return sstr.str();
+  }
+
+private:
+  static void _dump_counters(std::ostream& stream, const std::string& name, const counters& values, bool live) {
+    stream
+      << "{\"name\":\"" << name << "\""
+      << ",\"live\":" << (live ? "true" : "false")
+      << ",\"allocations\":" << values.allocations
+      << ",\"deallocations\":" << values.deallocations
+      << ",\"bytes_allocated\":" << values.bytes_allocated
+      << ",\"reallocations\":" << values.reallocations
+      << ",\"element_moves\":" << values.element_moves
+      << ",\"element_swaps\":" << values.element_swaps
+      << ",\"ref_syncs\":" << values.ref_syncs
+      << ",\"peak_size\":" << values.peak_size
+      << "}";
+  }
+};
+
+//
+//
+//
+
+//MARK: enabled
+// the container's thread write, registry::dump_json() may read from any other thread
+// -> relaxed atomics, written with a load and a store (one writer, no locked instruction)
+class enabled {
+
+public:
+  static constexpr bool is_enabled = true;
+
+private:
+  struct atomic_counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> reallocations{0};
+    std::atomic<uint64_t> element_moves{0};
+    std::atomic<uint64_t> element_swaps{0};
+    std::atomic<uint64_t> ref_syncs{0};
+    std::atomic<uint64_t> peak_size{0};
+  };
+
+private:
+  std::atomic<const char*> _name{"container"};
+  atomic_counters _values;
+
+public:
+  enabled() { registry::get().add(this); }
+  ~enabled() { registry::get().remove(this); }
+
+  // the stats are tied to their container
+  enabled(const enabled& other) = delete;
+  enabled& operator=(const enabled& other) = delete;
+  enabled(enabled&& other) = delete;
+  enabled& operator=(enabled&& other) = delete;
+
+public:
+  void set_name(const char* name) { _name.store(name, std::memory_order_relaxed); }
+  const char* name() const { return _name.load(std::memory_order_relaxed); }
+
+  // snapshot (the counters are read one by one)
+  counters values() const {
+    counters snapshot;
+    snapshot.allocations = _values.allocations.load(std::memory_order_relaxed);
+    snapshot.deallocations = _values.deallocations.load(std::memory_order_relaxed);
+    snapshot.bytes_allocated = _values.bytes_allocated.load(std::memory_order_relaxed);
+    snapshot.reallocations = _values.reallocations.load(std::memory_order_relaxed);
+    snapshot.element_moves = _values.element_moves.load(std::memory_order_relaxed);
+    snapshot.element_swaps = _values.element_swaps.load(std::memory_order_relaxed);
+    snapshot.ref_syncs = _values.ref_syncs.load(std::memory_order_relaxed);
+    snapshot.peak_size = _values.peak_size.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+public:
+  void on_allocate(std::size_t bytes) {
+    _add(_values.allocations, 1);
+    _add(_values.bytes_allocated, bytes);
+  }
+  void on_deallocate() { _add(_values.deallocations, 1); }
+  void on_reallocate(std::size_t total_moved) {
+    _add(_values.reallocations, 1);
+    _add(_values.element_moves, total_moved);
+  }
+  void on_swaps(std::size_t total_swapped) { _add(_values.element_swaps, total_swapped); }
+  void on_ref_syncs(std::size_t total_synced) { _add(_values.ref_syncs, total_synced); }
+  void on_size(std::size_t size) {
+    if (size > _values.peak_size.load(std::memory_order_relaxed)) {
+      _values.peak_size.store(size, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static void _add(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+};
+
+//
+//
+//
+
+void registry::remove(const enabled* stats) {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  auto itLive = std::find(_live.begin(), _live.end(), stats);
+  if (itLive != _live.end()) {
+    _live.erase(itLive);
+  }
+
+  auto itRetired = std::find_if(_retired.begin(), _retired.end(), [stats](const retired_counters& retired) {
+    return retired.name == stats->name();
+  });
+  if (itRetired == _retired.end()) {
+    _retired.push_back({stats->name(), stats->values()});
+  } else {
+    itRetired->values.merge(stats->values());
+  }
+}
+
+void registry::dump_json(std::ostream& stream) const {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  stream << "{\"containers\":[";
+
+  bool isFirst = true;
+  for (const enabled* stats : _live) {
+    stream << (isFirst ? "" : ",");
+    _dump_counters(stream, stats->name(), stats->values(), true);
+    isFirst = false;
+  }
+  for (const retired_counters& retired : _retired) {
+    stream << (isFirst ? "" : ",");
+    _dump_counters(stream, retired.name, retired.values, false);
+    isFirst = false;
+  }
+
+  stream << "]}";
+}
+
+//
+//
+//
+
+#if defined(D_CUSTOM_CONTAINERS_STATS)
+using default_policy = enabled;
+#else
+using default_policy = disabled;
+#endif
+
+} // namespace stats
+} // namespace custom_containers
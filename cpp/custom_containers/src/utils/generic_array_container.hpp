@@ -3,6 +3,8 @@
 
 // #include "utils/basic_double_linked_list.hpp"
 
+#include "container_checks.hpp"
+
 #include <functional>
 #include <memory>
 #include <string>
@@ -56,6 +58,7 @@ public:
   // -> https://www.fluentcpp.com/2018/05/08/std-iterator-deprecated/
 
   using value_type = typename generic_array_container::value_type;
+  using checks_policy = typename generic_array_container::checks_policy;
 
   using iterator_category = std::random_access_iterator_tag;
   // using value_type = int;
@@ -126,10 +129,16 @@ public:
   bool is_valid() const { return _container != nullptr; }
 
 protected:
-  void _ensure_is_valid() const {
-    if (!is_valid()) {
-      throw std::runtime_error("invalid iterator");
+  void _ensure_is_valid() const { D_CONTAINER_CHECK(checks_policy, is_valid(), "invalid iterator"); }
+
+  // same as the container operator[] in every mode (loop back on out of range index)
+  // -> the policy only decide if its check fire
+  // -> in range: at(), the same element without the loop back arithmetic
+  value_type& _get(int index) const {
+    if (index >= 0 && !_container->is_out_of_range(std::size_t(index))) {
+      return _container->at(std::size_t(index));
     }
+    return (*_container)[index];
   }
 
 public:
@@ -207,27 +216,27 @@ public:
 public:
   value_type& operator[](int index) {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index + index];
+    return base_type::_get(base_type::_index + index);
   }
   const value_type& operator[](int index) const {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index + index];
+    return base_type::_get(base_type::_index + index);
   }
   value_type* operator->() {
     base_type::_ensure_is_valid();
-    return &((*base_type::_container)[base_type::_index]);
+    return &(base_type::_get(base_type::_index));
   }
   const value_type* operator->() const {
     base_type::_ensure_is_valid();
-    return &((*base_type::_container)[base_type::_index]);
+    return &(base_type::_get(base_type::_index));
   }
   value_type& operator*() {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index];
+    return base_type::_get(base_type::_index);
   }
   const value_type& operator*() const {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index];
+    return base_type::_get(base_type::_index);
   }
 
 public:
@@ -352,15 +361,15 @@ public:
 public:
   const value_type& operator[](int index) const {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index + index];
+    return base_type::_get(base_type::_index + index);
   }
   const value_type* operator->() const {
     base_type::_ensure_is_valid();
-    return &((*base_type::_container)[base_type::_index]);
+    return &(base_type::_get(base_type::_index));
   }
   const value_type& operator*() const {
     base_type::_ensure_is_valid();
-    return (*base_type::_container)[base_type::_index];
+    return base_type::_get(base_type::_index);
   }
 
 public:
@@ -458,14 +467,15 @@ public:
 //
 
 //MARK: interface
-template <typename PublicType>
+template <typename PublicType, typename Checks = checks::default_policy>
 class interface_generic_array_container {
 
 public:
   using value_type = PublicType;
-  using base_iterator = generic_array_container_base_iterator<interface_generic_array_container<value_type>>;
-  using iterator = generic_array_container_iterator<interface_generic_array_container<value_type>>;
-  using const_iterator = generic_array_container_const_iterator<interface_generic_array_container<value_type>>;
+  using checks_policy = Checks;
+  using base_iterator = generic_array_container_base_iterator<interface_generic_array_container<value_type, Checks>>;
+  using iterator = generic_array_container_iterator<interface_generic_array_container<value_type, Checks>>;
+  using const_iterator = generic_array_container_const_iterator<interface_generic_array_container<value_type, Checks>>;
 
 public:
   virtual ~interface_generic_array_container() = default;
@@ -516,15 +526,16 @@ public:
 //
 
 //MARK: implementation
-template <typename InternalType, typename PublicType = InternalType>
-class generic_array_container : public interface_generic_array_container<PublicType> {
+template <typename InternalType, typename PublicType = InternalType, typename Checks = checks::default_policy>
+class generic_array_container : public interface_generic_array_container<PublicType, Checks> {
 
 public:
   using value_type = PublicType;
   using internal_type = InternalType;
-  using base_iterator = generic_array_container_base_iterator<interface_generic_array_container<value_type>>;
-  using iterator = generic_array_container_iterator<interface_generic_array_container<value_type>>;
-  using const_iterator = generic_array_container_const_iterator<interface_generic_array_container<value_type>>;
+  using checks_policy = Checks;
+  using base_iterator = generic_array_container_base_iterator<interface_generic_array_container<value_type, Checks>>;
+  using iterator = generic_array_container_iterator<interface_generic_array_container<value_type, Checks>>;
+  using const_iterator = generic_array_container_const_iterator<interface_generic_array_container<value_type, Checks>>;
 
 protected:
   friend base_iterator;
@@ -557,11 +568,7 @@ public:
   virtual ~generic_array_container() = default;
 
 protected:
-  void _ensure_not_empty() const {
-    if (_size == 0) {
-      throw std::runtime_error("empty array");
-    }
-  }
+  void _ensure_not_empty() const { D_CONTAINER_CHECK(checks_policy, _size > 0, "empty array"); }
 
   std::size_t _get_index(int index) const {
     _ensure_not_empty();
@@ -604,15 +611,11 @@ public:
   value_type& operator[](int index) override { return _data[_get_index(index)]; }
 
   const value_type& at(std::size_t index) const override {
-    if (is_out_of_range(index)) {
-      throw std::runtime_error("out of range");
-    }
+    D_CONTAINER_CHECK(checks_policy, index < _size, "out of range");
     return _data[index];
   }
   value_type& at(std::size_t index) override {
-    if (is_out_of_range(index)) {
-      throw std::runtime_error("out of range");
-    }
+    D_CONTAINER_CHECK(checks_policy, index < _size, "out of range");
     return _data[index];
   }
 
@@ -634,6 +637,11 @@ public:
     return _data[_size - 1];
   }
 
+public:
+  // raw contiguous storage, no check (nullptr when nothing was allocated)
+  const internal_type* data() const { return _data; }
+  internal_type* data() { return _data; }
+
 public:
   bool operator==(const generic_array_container& other) const { return this == &other; }
   bool operator!=(const generic_array_container& other) const { return !(*this == other); }
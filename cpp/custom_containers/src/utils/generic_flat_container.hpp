@@ -0,0 +1,264 @@
+#pragma once
+
+#include "../dynamic_heap_array.hpp"
+#include "sorted_search.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace custom_containers {
+
+//MARK: generic_flat_container
+/**
+ * generic_flat_container
+ *
+ * sorted keys (and optional mapped values) in contiguous memory
+ * - the keys and the values are stored in two separate arrays
+ * - bulk build/merge in O(n log n), single insert/erase in O(n)
+ * - Mapped = void -> no value array (set)
+ * - both keys and values must be default constructible (used by the merge)
+ * - eytzinger layout: a single insert/erase only mark the index dirty, the next search rebuild it
+ *   (that first search write: not concurrent with other searches, like any change)
+ */
+template <typename Key,
+          typename Mapped,
+          typename Compare,
+          template <typename...> class Allocator,
+          search_layout layout
+>
+class generic_flat_container {
+
+public:
+  using key_type = Key;
+
+protected:
+  static constexpr bool has_mapped = !std::is_void_v<Mapped>;
+
+  // the "char" array of a set is never used, it is only there to keep one code path
+  using mapped_storage = std::conditional_t<has_mapped, Mapped, char>;
+
+  using key_array = dynamic_heap_array<Key, Key, 0, Allocator<Key>>;
+  using mapped_array = dynamic_heap_array<mapped_storage, mapped_storage, 0, Allocator<mapped_storage>>;
+  using index_array = dynamic_heap_array<uint32_t, uint32_t, 0, Allocator<uint32_t>>;
+
+protected:
+  key_array _keys;
+  mapped_array _values;
+  mutable eytzinger_index<Key, Allocator> _eytzinger;
+  mutable bool _isEytzingerDirty = false;
+  Compare _comp;
+
+public:
+  generic_flat_container() = default;
+  virtual ~generic_flat_container() = default;
+
+  // disable copy
+  generic_flat_container(const generic_flat_container& other) = delete;
+  generic_flat_container& operator=(const generic_flat_container& other) = delete;
+  // disable copy
+
+public:
+  std::size_t size() const { return _keys.size(); }
+  bool is_empty() const { return _keys.is_empty(); }
+  std::size_t capacity() const { return _keys.capacity(); }
+
+  void pre_allocate(std::size_t capacity) {
+    _keys.pre_allocate(capacity);
+    if constexpr (has_mapped) {
+      _values.pre_allocate(capacity);
+    }
+  }
+
+  void clear() {
+    _keys.clear();
+    _values.clear();
+    _eytzinger.clear();
+    _isEytzingerDirty = false;
+  }
+
+public:
+  // index of the first key that is not less than "key" (size() if none)
+  std::size_t lower_bound_index(const Key& key) const {
+    if constexpr (layout == search_layout::eytzinger) {
+      if (_isEytzingerDirty) {
+        _eytzinger.build(_keys.data(), _keys.size());
+        _isEytzingerDirty = false;
+      }
+      return _eytzinger.lower_bound(key, _comp);
+    } else {
+      return _sorted_lower_bound(key);
+    }
+  }
+
+  // index of "key" (-1 if not found)
+  int32_t index_of(const Key& key) const {
+    const std::size_t index = lower_bound_index(key);
+    if (index < _keys.size() && !_comp(key, _keys.data()[index])) {
+      return int32_t(index);
+    }
+    return -1;
+  }
+
+  bool contains(const Key& key) const { return index_of(key) >= 0; }
+
+  const Key& key_at(std::size_t index) const { return _keys.at(index); }
+
+  // sorted keys, can be looped over
+  const key_array& keys() const { return _keys; }
+
+protected:
+  // "keys"/"values" -> unsorted input, duplicated keys allowed (first one is kept)
+  void _build_from(key_array& keys, mapped_array& values) {
+    clear();
+    _merge_from(keys, values);
+  }
+
+  // "keys"/"values" -> unsorted input, keys already stored are ignored
+  void _merge_from(key_array& keys, mapped_array& values) {
+
+    //
+    // sort the input (indirectly, only the indices get moved)
+
+    index_array order;
+    order.ensure_size(keys.size());
+    for (std::size_t ii = 0; ii < keys.size(); ++ii) {
+      order.data()[ii] = uint32_t(ii);
+    }
+
+    const Key* inputKeys = keys.data();
+    std::stable_sort(order.data(), order.data() + order.size(), [this, inputKeys](uint32_t lhs, uint32_t rhs) {
+      return _comp(inputKeys[lhs], inputKeys[rhs]);
+    });
+
+    //
+    // keep only the new and unique keys (existing keys are walked in the same order)
+
+    std::size_t totalSelected = 0;
+    std::size_t existingIndex = 0;
+    const std::size_t totalExisting = _keys.size();
+    const Key* existingKeys = _keys.data();
+    for (std::size_t ii = 0; ii < order.size(); ++ii) {
+      const Key& currKey = inputKeys[order.data()[ii]];
+
+      // duplicated input key (sorted -> only the previous selected one can match)
+      if (totalSelected > 0 && !_comp(inputKeys[order.data()[totalSelected - 1]], currKey)) {
+        continue;
+      }
+
+      while (existingIndex < totalExisting && _comp(existingKeys[existingIndex], currKey)) {
+        ++existingIndex;
+      }
+
+      // already stored
+      if (existingIndex < totalExisting && !_comp(currKey, existingKeys[existingIndex])) {
+        continue;
+      }
+
+      order.data()[totalSelected++] = order.data()[ii];
+    }
+
+    if (totalSelected == 0) {
+      return;
+    }
+
+    //
+    // merge from the back, every element is moved at most once
+
+    _keys.ensure_size(totalExisting + totalSelected);
+    if constexpr (has_mapped) {
+      _values.ensure_size(totalExisting + totalSelected);
+    }
+
+    Key* allKeys = _keys.data();
+    mapped_storage* allValues = _values.data();
+    mapped_storage* inputValues = values.data();
+
+    std::ptrdiff_t readExisting = std::ptrdiff_t(totalExisting) - 1;
+    std::ptrdiff_t readSelected = std::ptrdiff_t(totalSelected) - 1;
+    std::ptrdiff_t writeIndex = std::ptrdiff_t(totalExisting + totalSelected) - 1;
+
+    while (readSelected >= 0) {
+      const uint32_t inputIndex = order.data()[readSelected];
+
+      if (readExisting >= 0 && _comp(inputKeys[inputIndex], allKeys[readExisting])) {
+        allKeys[writeIndex] = std::move(allKeys[readExisting]);
+        if constexpr (has_mapped) {
+          allValues[writeIndex] = std::move(allValues[readExisting]);
+        }
+        --readExisting;
+      } else {
+        allKeys[writeIndex] = std::move(keys.data()[inputIndex]);
+        if constexpr (has_mapped) {
+          allValues[writeIndex] = std::move(inputValues[inputIndex]);
+        }
+        --readSelected;
+      }
+
+      --writeIndex;
+    }
+
+    _sync_search_layout();
+  }
+
+  // return the index of the inserted key (-1 if already stored)
+  template <typename... MappedArgs>
+  int32_t _insert_one(Key key, MappedArgs&&... value) {
+    const std::size_t index = _sorted_lower_bound(key); // the index may be dirty already
+    if (index < _keys.size() && !_comp(key, _keys.data()[index])) {
+      return -1;
+    }
+
+    const std::size_t oldSize = _keys.size();
+
+    _keys.push_back(std::move(key));
+    std::rotate(_keys.data() + index, _keys.data() + oldSize, _keys.data() + oldSize + 1);
+
+    if constexpr (has_mapped) {
+      _values.emplace_back(std::forward<MappedArgs>(value)...);
+      std::rotate(_values.data() + index, _values.data() + oldSize, _values.data() + oldSize + 1);
+    }
+
+    _invalidate_search_layout();
+    return int32_t(index);
+  }
+
+  bool _erase_one(const Key& key) {
+    const std::size_t index = _sorted_lower_bound(key); // the index may be dirty already
+    if (index >= _keys.size() || _comp(key, _keys.data()[index])) {
+      return false;
+    }
+
+    std::move(_keys.data() + index + 1, _keys.data() + _keys.size(), _keys.data() + index);
+    _keys.pop_back();
+
+    if constexpr (has_mapped) {
+      std::move(_values.data() + index + 1, _values.data() + _values.size(), _values.data() + index);
+      _values.pop_back();
+    }
+
+    _invalidate_search_layout();
+    return true;
+  }
+
+  std::size_t _sorted_lower_bound(const Key& key) const {
+    return branchless_lower_bound(_keys.data(), _keys.size(), key, _comp);
+  }
+
+  // bulk operations: rebuilt once at the end
+  void _sync_search_layout() {
+    if constexpr (layout == search_layout::eytzinger) {
+      _eytzinger.build(_keys.data(), _keys.size());
+      _isEytzingerDirty = false;
+    }
+  }
+
+  // single insert/erase: rebuilt by the next search
+  void _invalidate_search_layout() {
+    if constexpr (layout == search_layout::eytzinger) {
+      _isEytzingerDirty = true;
+    }
+  }
+};
+
+} // namespace custom_containers
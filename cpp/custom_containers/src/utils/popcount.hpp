@@ -0,0 +1,82 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace custom_containers {
+namespace popcount {
+
+//MARK: scalar
+// one popcnt instruction per word (when the cpu target allows it)
+inline std::size_t count_words_scalar(const uint64_t* words, std::size_t total_words) {
+  std::size_t total = 0;
+  for (std::size_t ii = 0; ii < total_words; ++ii) {
+    total += std::size_t(std::popcount(words[ii]));
+  }
+  return total;
+}
+
+#if defined(__AVX2__)
+
+//MARK: avx2
+// nibble lookup table (vpshufb) + horizontal byte sums (vpsadbw)
+// -> the per-byte counts (max 8 per block) are summed for 31 blocks before
+//    the (slower) horizontal sum, 31 * 8 = 248 still fits in a byte
+inline std::size_t count_words_avx2(const uint64_t* words, std::size_t total_words) {
+
+  const __m256i lookup = _mm256_setr_epi8(
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+  );
+  const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+  __m256i accumulator = _mm256_setzero_si256();
+
+  std::size_t index = 0;
+  while (index + 4 <= total_words) {
+
+    __m256i byteAccumulator = _mm256_setzero_si256();
+
+    for (int batch = 0; batch < 31 && index + 4 <= total_words; ++batch, index += 4) {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + index));
+      const __m256i lowNibbles = _mm256_and_si256(block, lowMask);
+      const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), lowMask);
+      byteAccumulator = _mm256_add_epi8(byteAccumulator, _mm256_shuffle_epi8(lookup, lowNibbles));
+      byteAccumulator = _mm256_add_epi8(byteAccumulator, _mm256_shuffle_epi8(lookup, highNibbles));
+    }
+
+    accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(byteAccumulator, _mm256_setzero_si256()));
+  }
+
+  std::size_t total = std::size_t(_mm256_extract_epi64(accumulator, 0)) +
+                      std::size_t(_mm256_extract_epi64(accumulator, 1)) +
+                      std::size_t(_mm256_extract_epi64(accumulator, 2)) +
+                      std::size_t(_mm256_extract_epi64(accumulator, 3));
+
+  // remaining words
+  total += count_words_scalar(words + index, total_words - index);
+
+  return total;
+}
+
+#endif
+
+//MARK: count_words
+// best implementation available for the compilation target
+// -> with avx512 vpopcntdq the compiler vectorize the scalar loop (vpopcntq)
+//    and it beat the avx2 lookup table
+inline std::size_t count_words(const uint64_t* words, std::size_t total_words) {
+#if defined(__AVX2__) && !defined(__AVX512VPOPCNTDQ__)
+  return count_words_avx2(words, total_words);
+#else
+  return count_words_scalar(words, total_words);
+#endif
+}
+
+} // namespace popcount
+} // namespace custom_containers
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../dynamic_heap_array.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace custom_containers {
+
+//
+//
+//
+
+enum class search_layout {
+  // binary search on the sorted keys, no extra memory
+  branchless,
+  // binary search on an extra copy of the keys stored in breadth-first order
+  // -> costs one extra copy of the keys, faster on big tables (cache friendly)
+  eytzinger,
+};
+
+//
+//
+//
+
+//MARK: branchless_lower_bound
+// same result as std::lower_bound but the loop has no data dependent branch
+// -> the comparison result is turned into a conditional move by the compiler
+template <typename Key, typename Compare>
+std::size_t branchless_lower_bound(const Key* data, std::size_t size, const Key& key, const Compare& comp) {
+  if (size == 0) {
+    return 0;
+  }
+
+  const Key* base = data;
+  std::size_t length = size;
+  while (length > 1) {
+    const std::size_t half = length / 2;
+    base = comp(base[half], key) ? base + half : base;
+    length -= half;
+  }
+
+  return std::size_t(base - data) + std::size_t(comp(*base, key));
+}
+
+//
+//
+//
+
+//MARK: eytzinger_index
+/**
+ * eytzinger_index
+ *
+ * copy of some sorted keys stored in breadth-first (heap like) order
+ * - index 0 is unused, the children of "k" are "2k" and "2k+1"
+ * - the first levels of the tree share the same cache lines
+ * - lower_bound return the index in the original sorted keys
+ */
+template <typename Key, template <typename...> class Allocator = std::allocator>
+class eytzinger_index {
+
+private:
+  dynamic_heap_array<Key, Key, 0, Allocator<Key>> _tree;
+  dynamic_heap_array<uint32_t, uint32_t, 0, Allocator<uint32_t>> _ranks;
+  std::size_t _size = 0;
+
+public:
+  eytzinger_index() = default;
+
+  // disable copy
+  eytzinger_index(const eytzinger_index& other) = delete;
+  eytzinger_index& operator=(const eytzinger_index& other) = delete;
+  // disable copy
+
+public:
+  void build(const Key* sorted_keys, std::size_t size) {
+    _tree.clear();
+    _ranks.clear();
+    _size = size;
+
+    if (size == 0) {
+      return;
+    }
+
+    _tree.ensure_size(size + 1);
+    _ranks.ensure_size(size + 1);
+
+    std::size_t sorted_index = 0;
+    _fill(sorted_keys, sorted_index, 1);
+  }
+
+  void clear() {
+    _tree.clear();
+    _ranks.clear();
+    _size = 0;
+  }
+
+  std::size_t size() const { return _size; }
+
+public:
+  template <typename Compare>
+  std::size_t lower_bound(const Key& key, const Compare& comp) const {
+    const Key* tree = _tree.data();
+
+    std::size_t k = 1;
+    while (k <= _size) {
+      if constexpr (std::is_trivially_copyable_v<Key>) {
+        // the 16th descendant is 4 levels down -> one cache line ahead of us
+        // (a prefetch never faults, even past the end of the tree)
+        __builtin_prefetch(tree + k * 16);
+      }
+      k = 2 * k + std::size_t(comp(tree[k], key));
+    }
+
+    // remove the trailing right turns (and the last left turn)
+    k >>= std::countr_one(k) + 1;
+
+    return k == 0 ? _size : std::size_t(_ranks.data()[k]);
+  }
+
+private:
+  void _fill(const Key* sorted_keys, std::size_t& sorted_index, std::size_t k) {
+    // in-order traversal of the implicit tree
+    if (k > _size) {
+      return;
+    }
+    _fill(sorted_keys, sorted_index, 2 * k);
+    _tree.data()[k] = sorted_keys[sorted_index];
+    _ranks.data()[k] = uint32_t(sorted_index);
+    ++sorted_index;
+    _fill(sorted_keys, sorted_index, 2 * k + 1);
+  }
+};
+
+} // namespace custom_containers
@@ -22,7 +22,9 @@ template <typename InternalBaseType,
           typename PublicBaseType = InternalBaseType,
           std::size_t initial_size = 256,
           bool no_realloc = true,
-          template <typename...> class Allocator = std::allocator
+          template <typename...> class Allocator = std::allocator,
+          typename Stats = stats::default_policy,
+          typename Checks = checks::default_policy
 >
 class pool_container;
 
@@ -72,7 +74,9 @@ template <typename InternalBaseType,
           typename PublicBaseType /*= InternalBaseType*/,
           std::size_t initial_size /*= 256*/,
           bool no_realloc /*= true*/,
-          template <typename...> class Allocator /*= std::allocator*/
+          template <typename...> class Allocator /*= std::allocator*/,
+          typename Stats /*= stats::default_policy*/,
+          typename Checks /*= checks::default_policy*/
 >
 struct pool_internal_element
   : public InternalBaseType
@@ -80,7 +84,7 @@ struct pool_internal_element
 {
 public:
 
-  using pool_type = pool_container<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator>;
+  using pool_type = pool_container<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
   using weak_ref = pool_type::weak_ref;
 
   friend weak_ref;
@@ -172,12 +176,14 @@ template <typename InternalBaseType,
           typename PublicBaseType /*= InternalBaseType*/,
           std::size_t initial_size /*= 256*/,
           bool no_realloc /*= true*/,
-          template <typename...> class Allocator /*= std::allocator*/
+          template <typename...> class Allocator /*= std::allocator*/,
+          typename Stats /*= stats::default_policy*/,
+          typename Checks /*= checks::default_policy*/
 >
 struct pool_weak_ref {
   using value_type = internals::base_class::non_movable<PublicBaseType>;
-  using pool_type = pool_container<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator>;
-  using internal_data = internals::pool_internal_element<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator>;
+  using pool_type = pool_container<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
+  using internal_data = internals::pool_internal_element<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
 
   friend pool_type;
   friend internal_data;
@@ -398,37 +404,41 @@ template <typename InternalBaseType,
           typename PublicBaseType /*= InternalBaseType*/,
           std::size_t initial_size /*= 256*/,
           bool no_realloc /*= true*/,
-          template <typename...> class Allocator /*= std::allocator*/
+          template <typename...> class Allocator /*= std::allocator*/,
+          typename Stats /*= stats::default_policy*/,
+          typename Checks /*= checks::default_policy*/
 >
 class pool_container
 {
 public:
   using value_type = internals::base_class::non_movable<PublicBaseType>;
-  using weak_ref = pool_weak_ref<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator>;
+  using weak_ref = pool_weak_ref<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
   friend weak_ref;
 
 private:
-  using internal_data = internals::pool_internal_element<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator>;
+  using internal_data = internals::pool_internal_element<InternalBaseType, PublicBaseType, initial_size, no_realloc, Allocator, Stats, Checks>;
   using allocator_type = Allocator<internal_data>;
   friend internal_data;
 
 private:
-  dynamic_heap_array<internal_data, internal_data, initial_size, allocator_type> _itemsPool;
+  dynamic_heap_array<internal_data, internal_data, initial_size, allocator_type, Stats, Checks> _itemsPool;
 
 private:
-  virtual internal_data& _get_itemsPool_data_by_index(std::size_t inIndex) {
+  // used by weak_ref get()/is_valid() -> not virtual so it can be inlined,
+  // the bound check of at() depend on the Checks policy
+  internal_data& _get_itemsPool_data_by_index(std::size_t inIndex) {
     return _itemsPool.at(inIndex);
   }
-  virtual PublicBaseType& _get_itemsPool_public_data_by_index(std::size_t inIndex) {
+  PublicBaseType& _get_itemsPool_public_data_by_index(std::size_t inIndex) {
     return _itemsPool.at(inIndex);
   }
-  virtual const PublicBaseType& _get_itemsPool_public_data_by_index(std::size_t inIndex) const {
+  const PublicBaseType& _get_itemsPool_public_data_by_index(std::size_t inIndex) const {
     return _itemsPool.at(inIndex);
   }
-  virtual bool _is_out_of_range(std::size_t inIndex) { return _itemsPool.is_out_of_range(inIndex); }
+  bool _is_out_of_range(std::size_t inIndex) { return _itemsPool.is_out_of_range(inIndex); }
 
 public:
-  pool_container() = default;
+  pool_container() { _itemsPool.stats().set_name("weak_ref_data_pool"); }
   ~pool_container() { clear(); }
 
   // disable copy
@@ -467,9 +477,17 @@ public:
     }
 
     const int32_t index = int32_t(_itemsPool.size());
+    const std::size_t oldCapacity = _itemsPool.capacity();
 
     internal_data& currData = _itemsPool.emplace_back(std::forward<Args>(args)...);
 
+    if constexpr (Stats::is_enabled) {
+      if (oldCapacity > 0 && oldCapacity != _itemsPool.capacity()) {
+        // every moved element did sync its weak_ref(s)
+        _itemsPool.stats().on_ref_syncs(_get_total_refs());
+      }
+    }
+
     currData._index = index;
     currData._is_valid = true;
 
@@ -490,6 +508,8 @@ public:
   std::size_t capacity() const { return _itemsPool.capacity(); }
   bool is_empty() const { return _itemsPool.is_empty(); }
 
+  const Stats& stats() const { return _itemsPool.stats(); }
+
 public:
   uint32_t get_ref_count(uint32_t index) const {
     if (_itemsPool.is_out_of_range(index)) {
@@ -538,7 +558,16 @@ private:
       auto& item = _itemsPool.at(std::size_t(index));
       item._index = index;
       item.sync_all_ref_index();
+      _itemsPool.stats().on_ref_syncs(item._weak_ref_list.size);
+    }
+  }
+
+  std::size_t _get_total_refs() const {
+    std::size_t totalRefs = 0;
+    for (std::size_t index = 0; index < _itemsPool.size(); ++index) {
+      totalRefs += _itemsPool.at(index)._weak_ref_list.size;
     }
+    return totalRefs;
   }
 
 public:
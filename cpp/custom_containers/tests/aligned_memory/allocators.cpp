@@ -0,0 +1,88 @@
+#include "headers.hpp"
+
+TEST_F(aligned_memory, aligned_allocator) {
+
+  custom_containers::dynamic_heap_array<uint8_t, uint8_t, 0, custom_containers::aligned_allocator<uint8_t, 64>> myArray;
+
+  for (int ii = 0; ii < 1000; ++ii) {
+    myArray.push_back(uint8_t(ii));
+
+    // still aligned after every reallocation
+    ASSERT_TRUE(is_aligned(myArray.data(), 64));
+  }
+
+  ASSERT_EQ(myArray.size(), 1000);
+  ASSERT_EQ(myArray.at(999), uint8_t(999));
+
+  custom_containers::dynamic_heap_array<float, float, 3, custom_containers::aligned_allocator<float, 128>> mySimdArray;
+  ASSERT_TRUE(is_aligned(mySimdArray.data(), 128));
+}
+
+TEST_F(aligned_memory, aligned_weak_ref_data_pool) {
+
+  custom_containers::weak_ref_data_pool::pool_container<
+    common::TestStructureNonCopyable,
+    common::ITestStructure,
+    10,
+    true,
+    custom_containers::cache_line_allocator
+  > myPool;
+
+  auto ref1 = myPool.acquire(1, "1");
+  auto ref2 = myPool.acquire(2, "2");
+
+  ASSERT_TRUE(is_aligned(ref1.get(), 64));
+  ASSERT_EQ(ref2->get_value(), 2);
+}
+
+TEST_F(aligned_memory, huge_page_allocator) {
+
+  using allocator_type = custom_containers::huge_page_allocator<uint64_t>;
+
+  ASSERT_EQ(allocator_type::get_mapped_size(1), 4096);
+  ASSERT_EQ(allocator_type::get_mapped_size(4097), 2 * 4096);
+  ASSERT_EQ(allocator_type::get_mapped_size(custom_containers::huge_page_size + 1), 2 * custom_containers::huge_page_size);
+
+  // small -> page aligned
+  custom_containers::dynamic_heap_array<uint64_t, uint64_t, 16, allocator_type> mySmallArray;
+  ASSERT_TRUE(is_aligned(mySmallArray.data(), 4096));
+
+  // big -> huge page aligned (explicit or transparent)
+  constexpr std::size_t totalValues = 3 * custom_containers::huge_page_size / sizeof(uint64_t);
+
+  custom_containers::dynamic_heap_array<uint64_t, uint64_t, 0, allocator_type> myBigArray;
+  myBigArray.pre_allocate(totalValues);
+  ASSERT_TRUE(is_aligned(myBigArray.data(), custom_containers::huge_page_size));
+
+  for (std::size_t ii = 0; ii < totalValues; ++ii) {
+    myBigArray.push_back(ii);
+  }
+  ASSERT_EQ(myBigArray.back(), totalValues - 1);
+
+  // realloc -> new mapping, values moved
+  myBigArray.push_back(666);
+  ASSERT_TRUE(is_aligned(myBigArray.data(), custom_containers::huge_page_size));
+  ASSERT_EQ(myBigArray.at(totalValues / 2), totalValues / 2);
+  ASSERT_EQ(myBigArray.back(), 666);
+}
+
+TEST_F(aligned_memory, cache_line_padded) {
+
+  static_assert(sizeof(custom_containers::cache_line_padded<uint64_t>) == 64);
+  static_assert(alignof(custom_containers::cache_line_padded<uint64_t>) == 64);
+  static_assert(sizeof(custom_containers::cache_line_padded<uint64_t, 128>) == 128);
+
+  custom_containers::static_array<custom_containers::cache_line_padded<uint64_t>, 4> perThreadCounters;
+
+  for (std::size_t ii = 0; ii < perThreadCounters.size(); ++ii) {
+    ASSERT_TRUE(is_aligned(&perThreadCounters.at(ii), 64));
+    ASSERT_EQ(*perThreadCounters.at(ii), 0);
+  }
+
+  ++perThreadCounters.at(1).value;
+  ++*perThreadCounters.at(1);
+
+  ASSERT_EQ(perThreadCounters.at(0).value, 0);
+  ASSERT_EQ(perThreadCounters.at(1).value, 2);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(&perThreadCounters.at(1)) - reinterpret_cast<uintptr_t>(&perThreadCounters.at(0)), 64);
+}
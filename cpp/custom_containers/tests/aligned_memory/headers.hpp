@@ -0,0 +1,21 @@
+#pragma once
+
+#include "dynamic_heap_array.hpp"
+#include "static_array.hpp"
+#include "utils/aligned_memory.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+template <typename T>
+bool is_aligned(const T* data, std::size_t alignment) {
+  return reinterpret_cast<uintptr_t>(data) % alignment == 0;
+}
+
+struct aligned_memory : public common::threadsafe_fixture {};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "dynamic_heap_array.hpp"
+#include "static_array.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <typename Checks>
+using shorthand_checks_dynamic_heap_array =
+custom_containers::dynamic_heap_array<
+  common::TestStructureCopyable,
+  common::ITestStructure,
+  0,
+  common::MyAllocator<common::TestStructureCopyable>,
+  custom_containers::stats::default_policy,
+  Checks
+>;
+
+template <typename Checks>
+using shorthand_checks_static_array =
+custom_containers::static_array<
+  common::TestStructureCopyable,
+  5,
+  common::ITestStructure,
+  Checks
+>;
+
+template <typename Checks>
+using shorthand_checks_weak_ref_data_pool =
+custom_containers::weak_ref_data_pool::pool_container<
+  common::TestStructureNonCopyable,
+  common::ITestStructure,
+  10, // initial size
+  true, // no realloc
+  common::MyAllocator,
+  custom_containers::stats::default_policy,
+  Checks
+>;
+
+struct container_checks : public common::threadsafe_fixture {};
@@ -0,0 +1,120 @@
+#include "headers.hpp"
+
+// the tests run with the default policy
+static_assert(std::is_same_v<custom_containers::checks::default_policy, custom_containers::checks::checked>);
+
+TEST_F(container_checks, checked_throw) {
+
+  shorthand_checks_dynamic_heap_array<custom_containers::checks::checked> myArray;
+
+  ASSERT_THROW(myArray.front(), std::runtime_error);
+  ASSERT_THROW(myArray.back(), std::runtime_error);
+  ASSERT_THROW(myArray[0], std::runtime_error);
+
+  myArray.push_back(common::TestStructureCopyable(1, "1"));
+  myArray.push_back(common::TestStructureCopyable(2, "2"));
+
+  ASSERT_EQ(myArray.at(1).get_value(), 2);
+  ASSERT_THROW(myArray.at(2), std::runtime_error);
+
+  // loop back on out of range index
+  ASSERT_EQ(myArray[2].get_value(), 1);
+  ASSERT_EQ(myArray[-1].get_value(), 2);
+}
+
+TEST_F(container_checks, unchecked_valid_access) {
+
+  shorthand_checks_static_array<custom_containers::checks::unchecked> myArray;
+
+  for (std::size_t ii = 0; ii < myArray.size(); ++ii) {
+    myArray.at(ii).set_value(int(ii));
+  }
+
+  ASSERT_EQ(myArray.front().get_value(), 0);
+  ASSERT_EQ(myArray.back().get_value(), 4);
+  ASSERT_EQ(myArray[1].get_value(), 1);
+  ASSERT_EQ(myArray[-1].get_value(), 4); // the loop back is kept
+
+  int index = 0;
+  for (auto& item : myArray) {
+    ASSERT_EQ(item.get_value(), index++);
+  }
+  ASSERT_EQ(index, 5);
+
+  index = 4;
+  for (auto it = myArray.rbegin(); it != myArray.rend(); ++it) {
+    ASSERT_EQ(it->get_value(), index--);
+  }
+  ASSERT_EQ(index, -1);
+
+  const auto& myConstArray = myArray;
+  index = 0;
+  for (const auto& item : myConstArray) {
+    ASSERT_EQ(item.get_value(), index++);
+  }
+  ASSERT_EQ(index, 5);
+}
+
+TEST_F(container_checks, unchecked_pool_weak_ref) {
+
+  using my_pool_type = shorthand_checks_weak_ref_data_pool<custom_containers::checks::unchecked>;
+
+  my_pool_type myPool;
+
+  auto ref0 = myPool.acquire(0, "0");
+  auto ref1 = myPool.acquire(1, "1");
+  auto ref2 = myPool.acquire(2, "2");
+
+  ASSERT_TRUE(ref1.is_valid());
+  ASSERT_EQ(ref1->get_value(), 1);
+
+  myPool.release(ref0);
+
+  ASSERT_FALSE(ref0.is_valid());
+  ASSERT_EQ(ref2.index(), 0);
+  ASSERT_EQ(ref2->get_value(), 2);
+
+  int total = 0;
+  myPool.for_each([&total](my_pool_type::value_type& inItem) -> void { total += inItem.get_value(); });
+  ASSERT_EQ(total, 1 + 2);
+}
+
+namespace {
+
+template <typename Checks>
+void expect_iterator_loop_back() {
+  shorthand_checks_static_array<Checks> myArray;
+  for (std::size_t ii = 0; ii < myArray.size(); ++ii) {
+    myArray.at(ii).set_value(int(ii));
+  }
+
+  // the iterators and operator[] read the same element in every mode
+  auto it = myArray.begin();
+  for (int index = -7; index < 12; ++index) {
+    ASSERT_EQ(it[index].get_value(), myArray[index].get_value());
+  }
+  ASSERT_EQ((it + 6)->get_value(), 1);
+  ASSERT_EQ((it - 1)->get_value(), 4);
+}
+
+} // namespace
+
+TEST_F(container_checks, iterator_same_as_operator_in_all_modes) {
+  expect_iterator_loop_back<custom_containers::checks::checked>();
+  expect_iterator_loop_back<custom_containers::checks::assert_only>();
+  expect_iterator_loop_back<custom_containers::checks::unchecked>();
+}
+
+#if !defined(NDEBUG)
+
+TEST_F(container_checks, assert_only_abort) {
+
+  shorthand_checks_dynamic_heap_array<custom_containers::checks::assert_only> myArray;
+
+  myArray.push_back(common::TestStructureCopyable(1, "1"));
+
+  ASSERT_EQ(myArray.at(0).get_value(), 1);
+  ASSERT_DEATH(myArray.at(1), "out of range");
+}
+
+#endif
@@ -0,0 +1,66 @@
+
+#include "headers.hpp"
+
+// disabled stats -> no extra byte
+static_assert(
+  sizeof(shorthand_stats_dynamic_heap_array<0, custom_containers::stats::disabled>) ==
+  sizeof(custom_containers::generic_array_container<common::TestStructureCopyable, common::ITestStructure>) + sizeof(std::size_t)
+);
+
+TEST_F(container_stats, dynamic_heap_array_counters) {
+
+  shorthand_stats_dynamic_heap_array<0, custom_containers::stats::enabled> myArray;
+
+  // a snapshot per read
+  auto values = [&myArray]() { return myArray.stats().values(); };
+
+  ASSERT_EQ(values().allocations, 0);
+  ASSERT_EQ(values().reallocations, 0);
+
+  myArray.push_back(common::TestStructureCopyable(1, "1")); // capacity 1 (allocation)
+  myArray.push_back(common::TestStructureCopyable(2, "2")); // capacity 2 (reallocation, 1 move)
+  myArray.push_back(common::TestStructureCopyable(3, "3")); // capacity 4 (reallocation, 2 moves)
+  myArray.push_back(common::TestStructureCopyable(4, "4"));
+
+  ASSERT_EQ(values().allocations, 3);
+  ASSERT_EQ(values().deallocations, 2);
+  ASSERT_EQ(values().bytes_allocated, (1 + 2 + 4) * sizeof(common::TestStructureCopyable));
+  ASSERT_EQ(values().reallocations, 2);
+  ASSERT_EQ(values().element_moves, 1 + 2);
+  ASSERT_EQ(values().peak_size, 4);
+  ASSERT_EQ(common::getTotalAlloc(), 3); // the allocator sees the same thing
+
+  ASSERT_EQ(myArray.unsorted_erase(0), 1);
+  ASSERT_EQ(values().element_swaps, 1);
+
+  ASSERT_EQ(myArray.sorted_erase(0), 2);
+  ASSERT_EQ(values().element_swaps, 3);
+
+  ASSERT_EQ(myArray.size(), 2);
+  ASSERT_EQ(values().peak_size, 4);
+}
+
+TEST_F(container_stats, weak_ref_data_pool_ref_syncs) {
+
+  shorthand_stats_weak_ref_data_pool<2, false> myPool;
+
+  auto ref1 = myPool.acquire(111, "111");
+  auto ref1_copy = ref1;
+  auto ref2 = myPool.acquire(222, "222");
+
+  ASSERT_EQ(myPool.stats().values().ref_syncs, 0);
+
+  // reallocation -> 3 weak_ref(s) are relinked to the moved elements
+  auto ref3 = myPool.acquire(333, "333");
+
+  ASSERT_EQ(myPool.stats().values().reallocations, 1);
+  ASSERT_EQ(myPool.stats().values().ref_syncs, 3);
+
+  // the last element is swapped in place of the first one -> 1 weak_ref relinked
+  myPool.release(ref1);
+
+  ASSERT_EQ(myPool.stats().values().element_swaps, 1);
+  ASSERT_EQ(myPool.stats().values().ref_syncs, 4);
+  ASSERT_EQ(ref3->get_value(), 333);
+  ASSERT_EQ(ref1_copy.is_valid(), false);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "dynamic_heap_array.hpp"
+#include "weak_ref_data_pool.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <std::size_t N, typename Stats>
+using shorthand_stats_dynamic_heap_array =
+custom_containers::dynamic_heap_array<
+  common::TestStructureCopyable,
+  common::ITestStructure,
+  N,
+  common::MyAllocator<common::TestStructureCopyable>,
+  Stats
+>;
+
+template <std::size_t N, bool no_realloc>
+using shorthand_stats_weak_ref_data_pool =
+custom_containers::weak_ref_data_pool::pool_container<
+  common::TestStructureNonCopyable,
+  common::ITestStructure,
+  N, // initial size
+  no_realloc, // no realloc
+  common::MyAllocator,
+  custom_containers::stats::enabled
+>;
+
+struct container_stats : public common::threadsafe_fixture {};
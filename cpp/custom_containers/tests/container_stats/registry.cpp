@@ -0,0 +1,79 @@
+
+#include "headers.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST_F(container_stats, registry_dump_json) {
+
+  auto& registry = custom_containers::stats::registry::get();
+  registry.reset();
+
+  {
+    shorthand_stats_dynamic_heap_array<4, custom_containers::stats::enabled> myArray;
+    myArray.stats().set_name("my_array");
+    myArray.push_back(common::TestStructureCopyable(1, "1"));
+
+    ASSERT_EQ(
+      registry.to_json(),
+      "{\"containers\":[{\"name\":\"my_array\",\"live\":true"
+      ",\"allocations\":1,\"deallocations\":0"
+      ",\"bytes_allocated\":" + std::to_string(4 * sizeof(common::TestStructureCopyable)) +
+      ",\"reallocations\":0,\"element_moves\":0,\"element_swaps\":0,\"ref_syncs\":0,\"peak_size\":1}]}"
+    );
+  }
+
+  {
+    shorthand_stats_dynamic_heap_array<0, custom_containers::stats::enabled> myArray;
+    myArray.stats().set_name("my_array");
+    myArray.push_back(common::TestStructureCopyable(1, "1"));
+    myArray.push_back(common::TestStructureCopyable(2, "2"));
+  }
+
+  // destroyed -> merged by name
+  ASSERT_EQ(
+    registry.to_json(),
+    "{\"containers\":[{\"name\":\"my_array\",\"live\":false"
+    ",\"allocations\":3,\"deallocations\":3"
+    ",\"bytes_allocated\":" + std::to_string((4 + 1 + 2) * sizeof(common::TestStructureCopyable)) +
+    ",\"reallocations\":1,\"element_moves\":1,\"element_swaps\":0,\"ref_syncs\":0,\"peak_size\":2}]}"
+  );
+
+  registry.reset();
+  ASSERT_EQ(registry.to_json(), "{\"containers\":[]}");
+}
+
+TEST_F(container_stats, registry_dump_json_while_a_container_change) {
+
+  auto& registry = custom_containers::stats::registry::get();
+  registry.reset();
+
+  shorthand_stats_dynamic_heap_array<0, custom_containers::stats::enabled> myArray;
+  myArray.stats().set_name("busy_array");
+
+  std::atomic<bool> isDone{false};
+
+  // the counters are read while the owner thread write them
+  std::thread owner([&myArray, &isDone]() {
+    for (int ii = 0; ii < 2000; ++ii) {
+      myArray.push_back(common::TestStructureCopyable(ii, "value"));
+      if (ii % 16 == 15) {
+        myArray.unsorted_erase(0);
+      }
+    }
+    isDone.store(true);
+  });
+
+  std::size_t totalInvalid = 0;
+  while (!isDone.load()) {
+    if (registry.to_json().rfind("{\"containers\":[{\"name\":\"busy_array\",\"live\":true", 0) != 0) {
+      ++totalInvalid;
+    }
+  }
+  owner.join();
+  ASSERT_EQ(totalInvalid, 0);
+
+  const custom_containers::stats::counters values = myArray.stats().values();
+  ASSERT_EQ(values.peak_size, myArray.size() + 1); // the last push_back is followed by an erase
+  ASSERT_EQ(values.allocations, values.deallocations + 1);
+}
@@ -0,0 +1,94 @@
+
+#include "headers.hpp"
+
+TEST_F(dynamic_bitset, set_reset_and_test_bits) {
+
+  {
+    shorthand_dynamic_bitset myBitset(130);
+
+    ASSERT_EQ(myBitset.size(), 130);
+    ASSERT_EQ(myBitset.total_words(), 3);
+    ASSERT_EQ(myBitset.count(), 0);
+    ASSERT_EQ(myBitset.any(), false);
+    ASSERT_EQ(myBitset.none(), true);
+    ASSERT_EQ(common::getTotalAlloc(), 1);
+
+    myBitset.set(0);
+    myBitset.set(63);
+    myBitset.set(64);
+    myBitset.set(129);
+
+    ASSERT_EQ(myBitset.test(0), true);
+    ASSERT_EQ(myBitset.test(1), false);
+    ASSERT_EQ(myBitset.test(63), true);
+    ASSERT_EQ(myBitset.test(64), true);
+    ASSERT_EQ(myBitset.test(129), true);
+    ASSERT_EQ(myBitset.count(), 4);
+    ASSERT_EQ(myBitset.any(), true);
+
+    myBitset.reset(63);
+    myBitset.flip(64);
+    myBitset.flip(65);
+    myBitset.set(1, true);
+    myBitset.set(0, false);
+
+    ASSERT_EQ(myBitset.test(0), false);
+    ASSERT_EQ(myBitset.test(1), true);
+    ASSERT_EQ(myBitset.test(63), false);
+    ASSERT_EQ(myBitset.test(64), false);
+    ASSERT_EQ(myBitset.test(65), true);
+    ASSERT_EQ(myBitset.count(), 3);
+
+    ASSERT_THROW(myBitset.test(130), std::runtime_error);
+    ASSERT_THROW(myBitset.set(130), std::runtime_error);
+  }
+
+  ASSERT_EQ(common::getTotalAlloc(), common::getTotalDealloc());
+}
+
+TEST_F(dynamic_bitset, set_all_and_resize_keep_unused_bits_cleared) {
+
+  shorthand_dynamic_bitset myBitset(70);
+
+  myBitset.set_all();
+  ASSERT_EQ(myBitset.count(), 70);
+
+  // the new bits are cleared
+  myBitset.resize(140);
+  ASSERT_EQ(myBitset.size(), 140);
+  ASSERT_EQ(myBitset.count(), 70);
+  ASSERT_EQ(myBitset.test(69), true);
+  ASSERT_EQ(myBitset.test(70), false);
+
+  // shrink then grow again -> the removed bits are not back
+  myBitset.resize(10);
+  ASSERT_EQ(myBitset.count(), 10);
+  myBitset.resize(70);
+  ASSERT_EQ(myBitset.count(), 10);
+  ASSERT_EQ(myBitset.test(10), false);
+
+  myBitset.reset_all();
+  ASSERT_EQ(myBitset.count(), 0);
+
+  myBitset.clear();
+  ASSERT_EQ(myBitset.is_empty(), true);
+  ASSERT_EQ(myBitset.count(), 0);
+}
+
+TEST_F(dynamic_bitset, popcount_implementations_agree) {
+
+  std::vector<uint64_t> words;
+  for (uint64_t ii = 0; ii < 37; ++ii) {
+    words.push_back(ii * 0x9E3779B97F4A7C15ull);
+  }
+
+  const std::size_t expected = custom_containers::popcount::count_words_scalar(words.data(), words.size());
+
+  for (std::size_t totalWords = 0; totalWords <= words.size(); ++totalWords) {
+    ASSERT_EQ(
+      custom_containers::popcount::count_words(words.data(), totalWords),
+      custom_containers::popcount::count_words_scalar(words.data(), totalWords));
+  }
+
+  ASSERT_EQ(custom_containers::popcount::count_words(words.data(), words.size()), expected);
+}
@@ -0,0 +1,39 @@
+
+#include "headers.hpp"
+
+TEST_F(dynamic_bitset, bulk_and_or_and_not) {
+
+  shorthand_dynamic_bitset maskA(200);
+  shorthand_dynamic_bitset maskB(200);
+  shorthand_dynamic_bitset result;
+
+  for (std::size_t ii = 0; ii < 200; ii += 2) {
+    maskA.set(ii); // even
+  }
+  for (std::size_t ii = 0; ii < 200; ii += 3) {
+    maskB.set(ii); // multiple of 3
+  }
+
+  result.copy_from(maskA);
+  result &= maskB;
+  ASSERT_EQ(result.count(), 34); // multiple of 6
+  ASSERT_EQ(result.test(6), true);
+  ASSERT_EQ(result.test(4), false);
+
+  result.copy_from(maskA);
+  result |= maskB;
+  ASSERT_EQ(result.count(), 100 + 67 - 34);
+
+  result.copy_from(maskA);
+  result.and_not(maskB);
+  ASSERT_EQ(result.count(), 100 - 34);
+  ASSERT_EQ(result.test(4), true);
+  ASSERT_EQ(result.test(6), false);
+
+  result.copy_from(maskA);
+  result ^= maskB;
+  ASSERT_EQ(result.count(), 100 + 67 - 2 * 34);
+
+  shorthand_dynamic_bitset wrongSize(100);
+  ASSERT_THROW(result &= wrongSize, std::runtime_error);
+}
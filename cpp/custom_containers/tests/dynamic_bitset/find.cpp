@@ -0,0 +1,30 @@
+
+#include "headers.hpp"
+
+#include <set>
+
+TEST_F(dynamic_bitset, find_first_and_next) {
+
+  shorthand_dynamic_bitset myBitset(300);
+
+  ASSERT_EQ(myBitset.find_first(), myBitset.npos());
+
+  const std::set<std::size_t> expected = {3, 63, 64, 200, 299};
+  for (std::size_t index : expected) {
+    myBitset.set(index);
+  }
+
+  std::vector<std::size_t> found;
+  for (std::size_t index = myBitset.find_first(); index != myBitset.npos(); index = myBitset.find_next(index)) {
+    found.push_back(index);
+  }
+  ASSERT_EQ(found, std::vector<std::size_t>(expected.begin(), expected.end()));
+
+  ASSERT_EQ(myBitset.find_next(299), myBitset.npos());
+  ASSERT_EQ(myBitset.find_next(64), 200);
+  ASSERT_EQ(myBitset.find_next(62), 63);
+
+  std::vector<std::size_t> looped;
+  myBitset.for_each_set([&looped](std::size_t index) { looped.push_back(index); });
+  ASSERT_EQ(looped, found);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "dynamic_bitset.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using shorthand_dynamic_bitset =
+custom_containers::dynamic_bitset<
+  common::MyAllocator<uint64_t>
+>;
+
+struct dynamic_bitset : public common::threadsafe_fixture {};
@@ -0,0 +1,57 @@
+
+#include "headers.hpp"
+
+#include "dynamic_heap_array.hpp"
+
+TEST_F(dynamic_bitset, masked_range_over_dynamic_heap_array) {
+
+  custom_containers::dynamic_heap_array<int> myArray;
+  for (int ii = 0; ii < 100; ++ii) {
+    myArray.push_back(ii * 10);
+  }
+
+  custom_containers::dynamic_bitset<> validMask(100);
+  validMask.set(1);
+  validMask.set(50);
+  validMask.set(99);
+
+  std::vector<int> looped;
+  for (int& value : custom_containers::make_masked_range(myArray, validMask)) {
+    looped.push_back(value);
+    value = -1;
+  }
+  ASSERT_EQ(looped, std::vector<int>({10, 500, 990}));
+  ASSERT_EQ(myArray[50], -1);
+  ASSERT_EQ(myArray[51], 510);
+
+  std::vector<std::size_t> indices;
+  custom_containers::make_masked_range(myArray, validMask).for_each([&indices](int& value, std::size_t index) {
+    ASSERT_EQ(value, -1);
+    indices.push_back(index);
+  });
+  ASSERT_EQ(indices, std::vector<std::size_t>({1, 50, 99}));
+
+  custom_containers::dynamic_bitset<> tooBigMask(101);
+  ASSERT_THROW(custom_containers::make_masked_range(myArray, tooBigMask), std::runtime_error);
+}
+
+TEST_F(dynamic_bitset, masked_range_over_std_vector) {
+
+  std::vector<int> myVector(10, 7);
+
+  custom_containers::dynamic_bitset<> validMask(10);
+
+  int totalLooped = 0;
+  for (const int& value : custom_containers::make_masked_range(myVector, validMask)) {
+    static_cast<void>(value);
+    ++totalLooped;
+  }
+  ASSERT_EQ(totalLooped, 0);
+
+  validMask.set_all();
+  for (const int& value : custom_containers::make_masked_range(myVector, validMask)) {
+    ASSERT_EQ(value, 7);
+    ++totalLooped;
+  }
+  ASSERT_EQ(totalLooped, 10);
+}
@@ -0,0 +1,102 @@
+
+#include "headers.hpp"
+
+namespace {
+
+template <custom_containers::search_layout layout>
+void test_build_from_unsorted_input() {
+
+  shorthand_flat_map<layout> myMap;
+
+  ASSERT_EQ(myMap.is_empty(), true);
+  ASSERT_EQ(myMap.size(), 0);
+  ASSERT_EQ(myMap.contains("length"), false);
+  ASSERT_EQ(myMap.find("length"), nullptr);
+
+  myMap.build({
+    {"translation", 1},
+    {"length", 2},
+    {"rotation", 3},
+    {"length", 666}, // duplicated key -> ignored (first one is kept)
+    {"color", 4},
+  });
+
+  ASSERT_EQ(myMap.is_empty(), false);
+  ASSERT_EQ(myMap.size(), 4);
+
+  // sorted
+  ASSERT_EQ(myMap.key_at(0), "color");
+  ASSERT_EQ(myMap.key_at(1), "length");
+  ASSERT_EQ(myMap.key_at(2), "rotation");
+  ASSERT_EQ(myMap.key_at(3), "translation");
+  ASSERT_EQ(myMap.value_at(0), 4);
+  ASSERT_EQ(myMap.value_at(1), 2);
+  ASSERT_EQ(myMap.value_at(2), 3);
+  ASSERT_EQ(myMap.value_at(3), 1);
+
+  ASSERT_EQ(myMap.at("translation"), 1);
+  ASSERT_EQ(myMap.at("length"), 2);
+  ASSERT_EQ(myMap.at("rotation"), 3);
+  ASSERT_EQ(myMap.at("color"), 4);
+  ASSERT_THROW(myMap.at("scale"), std::runtime_error);
+
+  ASSERT_EQ(myMap.index_of("color"), 0);
+  ASSERT_EQ(myMap.index_of("translation"), 3);
+  ASSERT_EQ(myMap.index_of("scale"), -1);
+
+  ASSERT_EQ(myMap.lower_bound_index("a"), 0);
+  ASSERT_EQ(myMap.lower_bound_index("m"), 2);
+  ASSERT_EQ(myMap.lower_bound_index("z"), 4);
+
+  *myMap.find("length") = 777;
+  ASSERT_EQ(myMap.at("length"), 777);
+
+  // rebuild -> replace the content
+  myMap.build({{"scale", 5}});
+
+  ASSERT_EQ(myMap.size(), 1);
+  ASSERT_EQ(myMap.contains("length"), false);
+  ASSERT_EQ(myMap.at("scale"), 5);
+
+  myMap.clear();
+
+  ASSERT_EQ(myMap.is_empty(), true);
+  ASSERT_EQ(myMap.contains("scale"), false);
+}
+
+}
+
+TEST_F(flat_map, build_from_unsorted_input__branchless) {
+  test_build_from_unsorted_input<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_map, build_from_unsorted_input__eytzinger) {
+  test_build_from_unsorted_input<custom_containers::search_layout::eytzinger>();
+}
+
+TEST_F(flat_map, build_all_memory_released) {
+
+  {
+    shorthand_flat_map<custom_containers::search_layout::eytzinger> myMap;
+
+    std::vector<std::pair<std::string, int>> values;
+    for (int ii = 0; ii < 100; ++ii) {
+      values.push_back({std::to_string(ii * 7919 % 100), ii});
+    }
+
+    myMap.build(values.begin(), values.end());
+
+    ASSERT_EQ(myMap.size(), 100);
+
+    int totalLooped = 0;
+    myMap.for_each([&totalLooped, &myMap](const std::string& key, int& value) {
+      ASSERT_EQ(myMap.index_of(key), totalLooped);
+      ASSERT_EQ(key, std::to_string(value * 7919 % 100));
+      ++totalLooped;
+    });
+    ASSERT_EQ(totalLooped, 100);
+  }
+
+  ASSERT_GT(common::getTotalAlloc(), 0);
+  ASSERT_EQ(common::getTotalAlloc(), common::getTotalDealloc());
+}
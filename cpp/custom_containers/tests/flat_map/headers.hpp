@@ -0,0 +1,24 @@
+#pragma once
+
+#include "flat_map.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <custom_containers::search_layout layout>
+using shorthand_flat_map =
+custom_containers::flat_map<
+  std::string,
+  int,
+  std::less<std::string>,
+  common::MyAllocator,
+  layout
+>;
+
+struct flat_map : public common::threadsafe_fixture {};
@@ -0,0 +1,93 @@
+
+#include "headers.hpp"
+
+#include <map>
+#include <string>
+
+namespace {
+
+template <custom_containers::search_layout layout>
+void test_insert_and_erase() {
+
+  shorthand_flat_map<layout> myMap;
+
+  ASSERT_EQ(myMap.insert("length", 1), true);
+  ASSERT_EQ(myMap.insert("translation", 2), true);
+  ASSERT_EQ(myMap.insert("color", 3), true);
+  ASSERT_EQ(myMap.insert("length", 666), false); // already stored
+
+  ASSERT_EQ(myMap.size(), 3);
+  ASSERT_EQ(myMap.key_at(0), "color");
+  ASSERT_EQ(myMap.key_at(1), "length");
+  ASSERT_EQ(myMap.key_at(2), "translation");
+  ASSERT_EQ(myMap.at("length"), 1);
+
+  ASSERT_EQ(myMap.erase("length"), true);
+  ASSERT_EQ(myMap.erase("length"), false); // already erased
+
+  ASSERT_EQ(myMap.size(), 2);
+  ASSERT_EQ(myMap.contains("length"), false);
+  ASSERT_EQ(myMap.key_at(0), "color");
+  ASSERT_EQ(myMap.key_at(1), "translation");
+  ASSERT_EQ(myMap.at("color"), 3);
+  ASSERT_EQ(myMap.at("translation"), 2);
+
+  ASSERT_EQ(myMap.erase("color"), true);
+  ASSERT_EQ(myMap.erase("translation"), true);
+
+  ASSERT_EQ(myMap.is_empty(), true);
+  ASSERT_EQ(myMap.contains("translation"), false);
+}
+
+template <custom_containers::search_layout layout>
+void test_single_changes_between_searches() {
+
+  shorthand_flat_map<layout> myMap;
+  std::map<std::string, int> reference;
+
+  // several changes in a row, then searches (the eytzinger index is rebuilt once, by the first one)
+  for (int round = 0; round < 20; ++round) {
+    for (int ii = 0; ii < 10; ++ii) {
+      const int value = (round * 37 + ii * 11) % 97;
+      const std::string key = std::to_string(value);
+      if ((round + ii) % 3 == 0) {
+        ASSERT_EQ(myMap.erase(key), reference.erase(key) == 1);
+      } else {
+        ASSERT_EQ(myMap.insert(key, value), reference.emplace(key, value).second);
+      }
+    }
+
+    ASSERT_EQ(myMap.size(), reference.size());
+    for (int value = 0; value < 97; ++value) {
+      const std::string key = std::to_string(value);
+      const auto it = reference.find(key);
+      ASSERT_EQ(myMap.contains(key), it != reference.end());
+      if (it != reference.end()) {
+        ASSERT_EQ(myMap.at(key), it->second);
+      }
+    }
+  }
+
+  myMap.clear();
+  ASSERT_EQ(myMap.contains("1"), false);
+  ASSERT_EQ(myMap.insert("1", 1), true);
+  ASSERT_EQ(myMap.at("1"), 1);
+}
+
+}
+
+TEST_F(flat_map, insert_and_erase__branchless) {
+  test_insert_and_erase<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_map, insert_and_erase__eytzinger) {
+  test_insert_and_erase<custom_containers::search_layout::eytzinger>();
+}
+
+TEST_F(flat_map, single_changes_between_searches__branchless) {
+  test_single_changes_between_searches<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_map, single_changes_between_searches__eytzinger) {
+  test_single_changes_between_searches<custom_containers::search_layout::eytzinger>();
+}
@@ -0,0 +1,96 @@
+
+#include "headers.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace {
+
+template <custom_containers::search_layout layout>
+void test_insert_range_merge() {
+
+  shorthand_flat_map<layout> myMap;
+
+  myMap.build({
+    {"b", 2},
+    {"d", 4},
+    {"f", 6},
+  });
+
+  myMap.insert_range({
+    {"g", 7},
+    {"a", 1},
+    {"d", 666}, // already stored -> ignored
+    {"c", 3},
+    {"a", 666}, // duplicated key -> ignored (first one is kept)
+  });
+
+  ASSERT_EQ(myMap.size(), 6);
+  ASSERT_EQ(myMap.key_at(0), "a");
+  ASSERT_EQ(myMap.key_at(1), "b");
+  ASSERT_EQ(myMap.key_at(2), "c");
+  ASSERT_EQ(myMap.key_at(3), "d");
+  ASSERT_EQ(myMap.key_at(4), "f");
+  ASSERT_EQ(myMap.key_at(5), "g");
+  ASSERT_EQ(myMap.at("a"), 1);
+  ASSERT_EQ(myMap.at("b"), 2);
+  ASSERT_EQ(myMap.at("c"), 3);
+  ASSERT_EQ(myMap.at("d"), 4);
+  ASSERT_EQ(myMap.at("f"), 6);
+  ASSERT_EQ(myMap.at("g"), 7);
+
+  // nothing new
+  myMap.insert_range({{"a", 666}, {"g", 666}});
+  ASSERT_EQ(myMap.size(), 6);
+  ASSERT_EQ(myMap.at("a"), 1);
+  ASSERT_EQ(myMap.at("g"), 7);
+}
+
+template <custom_containers::search_layout layout>
+void test_insert_range_against_std_map() {
+
+  shorthand_flat_map<layout> myMap;
+  std::map<std::string, int> expectedMap;
+
+  std::mt19937 randomEngine(666);
+
+  for (int batchIndex = 0; batchIndex < 10; ++batchIndex) {
+    std::vector<std::pair<std::string, int>> batch;
+    for (int ii = 0; ii < 50; ++ii) {
+      const int value = int(randomEngine() % 300);
+      batch.push_back({std::to_string(value), value});
+      expectedMap.insert({std::to_string(value), value});
+    }
+
+    myMap.insert_range(batch.begin(), batch.end());
+
+    ASSERT_EQ(myMap.size(), expectedMap.size());
+
+    std::size_t index = 0;
+    for (const auto& [key, value] : expectedMap) {
+      ASSERT_EQ(myMap.key_at(index), key);
+      ASSERT_EQ(myMap.value_at(index), value);
+      ASSERT_EQ(myMap.index_of(key), int32_t(index));
+      ++index;
+    }
+  }
+}
+
+}
+
+TEST_F(flat_map, insert_range_merge__branchless) {
+  test_insert_range_merge<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_map, insert_range_merge__eytzinger) {
+  test_insert_range_merge<custom_containers::search_layout::eytzinger>();
+}
+
+TEST_F(flat_map, insert_range_against_std_map__branchless) {
+  test_insert_range_against_std_map<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_map, insert_range_against_std_map__eytzinger) {
+  test_insert_range_against_std_map<custom_containers::search_layout::eytzinger>();
+}
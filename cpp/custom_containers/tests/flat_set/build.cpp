@@ -0,0 +1,88 @@
+
+#include "headers.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+namespace {
+
+template <custom_containers::search_layout layout>
+void test_build_and_search() {
+
+  shorthand_flat_set<layout> mySet;
+
+  mySet.build({5, 3, 9, 3, 1});
+
+  ASSERT_EQ(mySet.size(), 4);
+  ASSERT_EQ(mySet.key_at(0), 1);
+  ASSERT_EQ(mySet.key_at(1), 3);
+  ASSERT_EQ(mySet.key_at(2), 5);
+  ASSERT_EQ(mySet.key_at(3), 9);
+
+  ASSERT_EQ(mySet.contains(3), true);
+  ASSERT_EQ(mySet.contains(4), false);
+  ASSERT_EQ(mySet.lower_bound_index(0), 0);
+  ASSERT_EQ(mySet.lower_bound_index(4), 2);
+  ASSERT_EQ(mySet.lower_bound_index(10), 4);
+
+  mySet.insert_range({4, 10, 1});
+
+  ASSERT_EQ(mySet.size(), 6);
+  ASSERT_EQ(mySet.index_of(4), 2);
+  ASSERT_EQ(mySet.index_of(10), 5);
+
+  ASSERT_EQ(mySet.insert(0), true);
+  ASSERT_EQ(mySet.insert(0), false);
+  ASSERT_EQ(mySet.erase(5), true);
+
+  std::vector<int> looped;
+  mySet.for_each([&looped](int key) { looped.push_back(key); });
+  ASSERT_EQ(looped, std::vector<int>({0, 1, 3, 4, 9, 10}));
+}
+
+template <custom_containers::search_layout layout>
+void test_lower_bound_against_std() {
+
+  std::mt19937 randomEngine(777);
+
+  // all the sizes around the power of 2 (complete/incomplete trees)
+  for (int totalKeys = 0; totalKeys < 70; ++totalKeys) {
+    std::vector<int> keys;
+    for (int ii = 0; ii < totalKeys; ++ii) {
+      keys.push_back(int(randomEngine() % 200));
+    }
+
+    shorthand_flat_set<layout> mySet;
+    mySet.build(keys.begin(), keys.end());
+
+    std::set<int> expectedSet(keys.begin(), keys.end());
+    std::vector<int> expectedKeys(expectedSet.begin(), expectedSet.end());
+
+    ASSERT_EQ(mySet.size(), expectedKeys.size());
+
+    for (int toSearch = -1; toSearch <= 201; ++toSearch) {
+      const auto it = std::lower_bound(expectedKeys.begin(), expectedKeys.end(), toSearch);
+      ASSERT_EQ(mySet.lower_bound_index(toSearch), std::size_t(it - expectedKeys.begin()));
+      ASSERT_EQ(mySet.contains(toSearch), expectedSet.count(toSearch) > 0);
+    }
+  }
+}
+
+}
+
+TEST_F(flat_set, build_and_search__branchless) {
+  test_build_and_search<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_set, build_and_search__eytzinger) {
+  test_build_and_search<custom_containers::search_layout::eytzinger>();
+}
+
+TEST_F(flat_set, lower_bound_against_std__branchless) {
+  test_lower_bound_against_std<custom_containers::search_layout::branchless>();
+}
+
+TEST_F(flat_set, lower_bound_against_std__eytzinger) {
+  test_lower_bound_against_std<custom_containers::search_layout::eytzinger>();
+}
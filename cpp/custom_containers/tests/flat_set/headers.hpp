@@ -0,0 +1,22 @@
+#pragma once
+
+#include "flat_set.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <custom_containers::search_layout layout>
+using shorthand_flat_set =
+custom_containers::flat_set<
+  int,
+  std::less<int>,
+  common::MyAllocator,
+  layout
+>;
+
+struct flat_set : public common::threadsafe_fixture {};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "mapped_file_array.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <sys/resource.h>
+
+#include "gtest/gtest.h"
+
+struct mapped_file_array : public common::threadsafe_fixture {
+
+  std::string filepath;
+
+  void SetUp() override {
+    common::threadsafe_fixture::SetUp();
+    const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    filepath = (std::filesystem::temp_directory_path() / (std::string("mapped_file_array_") + testInfo->name() + ".bin")).string();
+    std::filesystem::remove(filepath);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(filepath);
+    common::threadsafe_fixture::TearDown();
+  }
+};
@@ -0,0 +1,165 @@
+#include "headers.hpp"
+
+namespace {
+
+struct sample {
+  float position[3];
+  uint32_t label;
+};
+
+}
+
+TEST_F(mapped_file_array, create_and_reopen) {
+
+  {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+
+    ASSERT_EQ(myArray.is_open(), true);
+    ASSERT_EQ(myArray.filepath(), filepath);
+    ASSERT_EQ(myArray.size(), 0);
+    ASSERT_GT(myArray.capacity(), 0);
+
+    for (uint64_t ii = 0; ii < 100000; ++ii) {
+      myArray.push_back(ii * 3);
+    }
+
+    ASSERT_EQ(myArray.size(), 100000);
+    ASSERT_GE(myArray.capacity(), 100000);
+    ASSERT_EQ(myArray.at(99999), 99999 * 3);
+
+    myArray.sync();
+  } // closed -> synced
+
+  ASSERT_GE(std::filesystem::file_size(filepath), 64 + 100000 * sizeof(uint64_t));
+
+  custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+
+  ASSERT_EQ(myArray.size(), 100000);
+  uint64_t expected = 0;
+  for (uint64_t value : myArray) {
+    ASSERT_EQ(value, expected);
+    expected += 3;
+  }
+
+  // the values are cache line aligned
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(myArray.data()) % 64, 0);
+}
+
+TEST_F(mapped_file_array, modify_after_reopen) {
+
+  {
+    custom_containers::mapped_file_array<sample> myArray(filepath);
+    myArray.emplace_back(sample{{1.0f, 2.0f, 3.0f}, 1});
+    myArray.emplace_back(sample{{4.0f, 5.0f, 6.0f}, 2});
+    myArray.emplace_back(sample{{7.0f, 8.0f, 9.0f}, 3});
+  }
+
+  {
+    custom_containers::mapped_file_array<sample> myArray(filepath);
+    ASSERT_EQ(myArray.size(), 3);
+
+    myArray.at(1).label = 666;
+    myArray.pop_back();
+  }
+
+  custom_containers::mapped_file_array<sample> myArray(filepath);
+  ASSERT_EQ(myArray.size(), 2);
+  ASSERT_EQ(myArray.front().label, 1);
+  ASSERT_EQ(myArray.back().label, 666);
+  ASSERT_EQ(myArray.back().position[2], 6.0f);
+
+  myArray.clear();
+  ASSERT_EQ(myArray.size(), 0);
+  ASSERT_EQ(myArray.is_empty(), true);
+}
+
+TEST_F(mapped_file_array, ensure_size_and_pre_allocate) {
+
+  custom_containers::mapped_file_array<uint32_t> myArray(filepath);
+
+  myArray.pre_allocate(1000000);
+  ASSERT_EQ(myArray.capacity(), 1000000);
+  ASSERT_EQ(myArray.size(), 0);
+
+  myArray.ensure_size(2000000);
+  ASSERT_EQ(myArray.size(), 2000000);
+  ASSERT_EQ(myArray.capacity(), 2000000);
+
+  // new file pages are zero
+  ASSERT_EQ(myArray.at(0), 0);
+  ASSERT_EQ(myArray.at(1999999), 0);
+}
+
+TEST_F(mapped_file_array, invalid_file) {
+
+  {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    myArray.push_back(1);
+  }
+
+  // different element size
+  ASSERT_THROW(custom_containers::mapped_file_array<uint32_t> myArray(filepath), std::runtime_error);
+
+  custom_containers::mapped_file_array<uint64_t> myArray;
+  ASSERT_EQ(myArray.is_open(), false);
+  ASSERT_THROW(myArray.sync(), std::runtime_error);
+  ASSERT_THROW(myArray.push_back(1), std::runtime_error);
+  ASSERT_THROW(myArray.open("/non/existing/directory/file.bin"), std::runtime_error);
+}
+
+TEST_F(mapped_file_array, reopen_file_ending_with_partial_value) {
+
+  {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    myArray.push_back(7);
+  }
+
+  // capacity * value size + 3 bytes: the whole file is mapped, synced and unmapped
+  const auto fileSize = std::filesystem::file_size(filepath);
+  std::filesystem::resize_file(filepath, fileSize + 3);
+
+  {
+    custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+    ASSERT_EQ(myArray.size(), 1);
+    ASSERT_EQ(myArray.capacity(), (fileSize - 64) / sizeof(uint64_t));
+
+    const std::size_t capacity = myArray.capacity();
+    for (std::size_t ii = 0; ii < capacity; ++ii) {
+      myArray.push_back(ii);
+    }
+    ASSERT_GT(myArray.capacity(), capacity); // remapped from the whole file
+  }
+
+  custom_containers::mapped_file_array<uint64_t> myArray(filepath);
+  ASSERT_EQ(myArray.at(0), 7);
+  ASSERT_EQ(myArray.at(myArray.size() - 1), myArray.size() - 2);
+}
+
+TEST_F(mapped_file_array, failed_creation_remove_the_file) {
+
+  // the initial ftruncate() is over the file size limit (EFBIG instead of SIGXFSZ)
+  struct rlimit previousLimit;
+  ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &previousLimit), 0);
+  const auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+
+  struct rlimit limit = previousLimit;
+  limit.rlim_cur = 1024;
+  ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+  custom_containers::mapped_file_array<uint64_t> myArray;
+  const bool isThrown = [&]() {
+    try {
+      myArray.open(filepath);
+    } catch (const std::runtime_error&) {
+      return true;
+    }
+    return false;
+  }();
+
+  ::setrlimit(RLIMIT_FSIZE, &previousLimit);
+  std::signal(SIGXFSZ, previousHandler);
+
+  ASSERT_TRUE(isThrown);
+  ASSERT_FALSE(myArray.is_open());
+  ASSERT_FALSE(std::filesystem::exists(filepath));
+}
@@ -0,0 +1,106 @@
+#include "headers.hpp"
+
+#include <atomic>
+
+TEST_F(sharded_weak_ref_data_pool, acquire_release_local) {
+
+  shorthand_sharded_pool myPool(4);
+
+  ASSERT_EQ(myPool.total_shards(), 4);
+  ASSERT_EQ(myPool.local_shard_index(), 0);
+  ASSERT_EQ(myPool.local_shard_index(), 0); // same thread -> same shard
+
+  std::vector<custom_containers::weak_ref_data_pool::sharded_handle> allHandles;
+  for (int ii = 0; ii < 100; ++ii) {
+    allHandles.push_back(myPool.acquire(ii));
+  }
+
+  ASSERT_EQ(myPool.size(0), 100);
+  ASSERT_EQ(myPool.size(), 100);
+
+  for (int ii = 0; ii < 100; ++ii) {
+    ASSERT_EQ(allHandles[std::size_t(ii)].shard, 0);
+    ASSERT_EQ(myPool.get(allHandles[std::size_t(ii)])->value, ii);
+  }
+
+  // the pool swap the items on release, the handles keep pointing at the right one
+  for (int ii = 0; ii < 100; ii += 2) {
+    myPool.release(allHandles[std::size_t(ii)]);
+  }
+
+  ASSERT_EQ(myPool.size(), 50);
+  for (int ii = 0; ii < 100; ++ii) {
+    if (ii % 2 == 0) {
+      ASSERT_EQ(myPool.is_valid(allHandles[std::size_t(ii)]), false);
+      ASSERT_EQ(myPool.get(allHandles[std::size_t(ii)]), nullptr);
+    } else {
+      ASSERT_EQ(myPool.get(allHandles[std::size_t(ii)])->value, ii);
+    }
+  }
+
+  // double release -> ignored
+  myPool.release(allHandles[0]);
+  ASSERT_EQ(myPool.size(), 50);
+}
+
+TEST_F(sharded_weak_ref_data_pool, stale_handle_after_slot_reuse) {
+
+  shorthand_sharded_pool myPool(1);
+
+  auto handleA = myPool.acquire(1);
+  myPool.release(handleA);
+
+  auto handleB = myPool.acquire(2);
+
+  ASSERT_EQ(handleB.slot, handleA.slot); // slot reused
+  ASSERT_NE(handleB, handleA); // new generation
+  ASSERT_EQ(myPool.get(handleA), nullptr);
+  ASSERT_EQ(myPool.get(handleB)->value, 2);
+
+  myPool.release(handleA); // stale -> ignored
+  ASSERT_EQ(myPool.size(), 1);
+
+  ASSERT_EQ(myPool.get(custom_containers::weak_ref_data_pool::sharded_handle{}), nullptr);
+}
+
+TEST_F(sharded_weak_ref_data_pool, one_shard_per_thread) {
+
+  shorthand_sharded_pool myPool(2);
+
+  ASSERT_EQ(myPool.local_shard_index(), 0);
+
+  // the worker stay alive (a joined one release its shard)
+  std::size_t workerShard = shorthand_sharded_pool::npos;
+  std::atomic<bool> canExit{false};
+  std::thread worker([&myPool, &workerShard, &canExit]() {
+    workerShard = myPool.local_shard_index();
+    myPool.acquire(666);
+    while (!canExit.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  while (workerShard == shorthand_sharded_pool::npos) {
+    std::this_thread::yield();
+  }
+
+  bool didThrow = false;
+  std::thread extraWorker([&myPool, &didThrow]() {
+    try {
+      myPool.acquire(777);
+    } catch (const std::runtime_error&) {
+      didThrow = true;
+    }
+  });
+  extraWorker.join();
+
+  canExit.store(true);
+  worker.join();
+
+  ASSERT_EQ(workerShard, 1);
+  ASSERT_EQ(myPool.size(0), 0);
+  ASSERT_EQ(myPool.size(1), 1);
+
+  ASSERT_EQ(didThrow, true); // no shard left
+  ASSERT_THROW(myPool.size(2), std::runtime_error);
+}
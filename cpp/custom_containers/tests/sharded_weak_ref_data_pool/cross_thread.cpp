@@ -0,0 +1,153 @@
+#include "headers.hpp"
+
+#include <atomic>
+
+TEST_F(sharded_weak_ref_data_pool, cross_thread_release_is_queued) {
+
+  shorthand_sharded_pool myPool(2);
+
+  ASSERT_EQ(myPool.local_shard_index(), 0);
+
+  std::vector<custom_containers::weak_ref_data_pool::sharded_handle> workerHandles;
+  std::atomic<int> step{0};
+
+  std::thread worker([&]() {
+    for (int ii = 0; ii < 50; ++ii) {
+      workerHandles.push_back(myPool.acquire(ii));
+    }
+    step.store(1);
+
+    // wait for the main thread releases
+    while (step.load() != 2) {
+      std::this_thread::yield();
+    }
+
+    myPool.collect();
+    step.store(3);
+  });
+
+  while (step.load() != 1) {
+    std::this_thread::yield();
+  }
+
+  // owned by the worker shard -> queued
+  for (const auto& handle : workerHandles) {
+    ASSERT_EQ(handle.shard, 1);
+    myPool.release(handle);
+  }
+
+  ASSERT_EQ(myPool.size(1), 50);
+  ASSERT_EQ(myPool.pending_releases(1), 50);
+
+  step.store(2);
+  worker.join();
+
+  ASSERT_EQ(step.load(), 3);
+  ASSERT_EQ(myPool.size(1), 0);
+  ASSERT_EQ(myPool.pending_releases(1), 0);
+}
+
+TEST_F(sharded_weak_ref_data_pool, iteration) {
+
+  shorthand_sharded_pool myPool(3);
+
+  for (int ii = 0; ii < 10; ++ii) {
+    myPool.acquire(ii);
+  }
+
+  std::thread worker([&myPool]() {
+    for (int ii = 0; ii < 5; ++ii) {
+      myPool.acquire(100 + ii);
+    }
+  });
+  worker.join();
+
+  int totalShard0 = 0;
+  myPool.for_each_in_shard(0, [&totalShard0](shorthand_sharded_pool::value_type& item) { totalShard0 += item.value; });
+  ASSERT_EQ(totalShard0, 45);
+
+  int totalItems = 0;
+  int totalValues = 0;
+  std::size_t totalInShard1 = 0;
+  myPool.for_each([&](shorthand_sharded_pool::value_type& item, std::size_t shardIndex) {
+    ++totalItems;
+    totalValues += item.value;
+    if (shardIndex == 1) {
+      ++totalInShard1;
+    }
+  });
+
+  ASSERT_EQ(totalItems, 15);
+  ASSERT_EQ(totalValues, 45 + 100 * 5 + 10);
+  ASSERT_EQ(totalInShard1, 5);
+  ASSERT_EQ(myPool.size(2), 0);
+}
+
+TEST_F(sharded_weak_ref_data_pool, concurrent_churn) {
+
+  constexpr std::size_t totalThreads = 4;
+  shorthand_sharded_pool myPool(totalThreads);
+
+  // every thread release half of its handles and hand the other half to the next thread
+  std::vector<custom_containers::weak_ref_data_pool::sharded_handle> mailboxes[totalThreads];
+  std::mutex mailboxMutex;
+  std::atomic<std::size_t> totalDone{0};
+
+  std::vector<std::thread> allThreads;
+  for (std::size_t threadIndex = 0; threadIndex < totalThreads; ++threadIndex) {
+    allThreads.emplace_back([&, threadIndex]() {
+      for (int round = 0; round < 100; ++round) {
+        std::vector<custom_containers::weak_ref_data_pool::sharded_handle> myHandles;
+        for (int ii = 0; ii < 20; ++ii) {
+          myHandles.push_back(myPool.acquire(ii));
+        }
+        for (std::size_t ii = 0; ii < myHandles.size(); ii += 2) {
+          myPool.release(myHandles[ii]);
+        }
+        {
+          std::unique_lock<std::mutex> lock(mailboxMutex);
+          auto& nextMailbox = mailboxes[(threadIndex + 1) % totalThreads];
+          for (std::size_t ii = 1; ii < myHandles.size(); ii += 2) {
+            nextMailbox.push_back(myHandles[ii]);
+          }
+        }
+
+        std::vector<custom_containers::weak_ref_data_pool::sharded_handle> received;
+        {
+          std::unique_lock<std::mutex> lock(mailboxMutex);
+          std::swap(received, mailboxes[threadIndex]);
+        }
+        for (const auto& handle : received) {
+          myPool.release(handle); // cross thread
+        }
+      }
+
+      totalDone.fetch_add(1);
+      while (totalDone.load() < totalThreads) {
+        std::this_thread::yield();
+      }
+
+      // the last handles still in the mailboxes
+      std::vector<custom_containers::weak_ref_data_pool::sharded_handle> received;
+      {
+        std::unique_lock<std::mutex> lock(mailboxMutex);
+        std::swap(received, mailboxes[threadIndex]);
+      }
+      for (const auto& handle : received) {
+        myPool.release(handle);
+      }
+      totalDone.fetch_add(1);
+      while (totalDone.load() < totalThreads * 2) {
+        std::this_thread::yield();
+      }
+
+      myPool.collect();
+    });
+  }
+
+  for (auto& currThread : allThreads) {
+    currThread.join();
+  }
+
+  ASSERT_EQ(myPool.size(), 0);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "sharded_weak_ref_data_pool.hpp"
+
+#include "../utils/generic_array_container_commons/common.tests.hpp"
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// std::allocator -> the common:: allocation counters are not thread safe
+// polymorphic like ITestStructure (the pool weak_ref share the vtable pointer offset)
+struct test_entity {
+  test_entity(int inValue) : value(inValue) {}
+  virtual ~test_entity() = default;
+  int value = 0;
+};
+
+using shorthand_sharded_pool = custom_containers::weak_ref_data_pool::sharded_pool<test_entity, test_entity, 16>;
+
+struct sharded_weak_ref_data_pool : public common::threadsafe_fixture {};
@@ -0,0 +1,89 @@
+#include "headers.hpp"
+
+#include <atomic>
+
+TEST_F(sharded_weak_ref_data_pool, shard_released_on_thread_exit) {
+
+  shorthand_sharded_pool myPool(2);
+
+  ASSERT_EQ(myPool.local_shard_index(), 0);
+
+  // more threads than shards, one after the other -> the same shard each time
+  std::vector<std::size_t> workerShards;
+  for (int ii = 0; ii < 5; ++ii) {
+    std::size_t workerShard = shorthand_sharded_pool::npos;
+    std::thread worker([&myPool, &workerShard, ii]() {
+      workerShard = myPool.local_shard_index();
+      myPool.acquire(ii);
+    });
+    worker.join();
+    workerShards.push_back(workerShard);
+  }
+
+  for (std::size_t workerShard : workerShards) {
+    ASSERT_EQ(workerShard, 1);
+  }
+  ASSERT_EQ(myPool.size(1), 5); // the items stay in the shard
+}
+
+TEST_F(sharded_weak_ref_data_pool, dead_owner_releases_applied_by_next_owner) {
+
+  shorthand_sharded_pool myPool(2);
+
+  ASSERT_EQ(myPool.local_shard_index(), 0);
+
+  std::vector<custom_containers::weak_ref_data_pool::sharded_handle> allHandles;
+  std::thread deadOwner([&myPool, &allHandles]() {
+    for (int ii = 0; ii < 10; ++ii) {
+      allHandles.push_back(myPool.acquire(ii));
+    }
+  });
+  deadOwner.join();
+
+  ASSERT_EQ(myPool.size(1), 10);
+
+  // the owner is gone -> queued
+  for (const auto& handle : allHandles) {
+    myPool.release(handle);
+  }
+  ASSERT_EQ(myPool.pending_releases(1), 10);
+  ASSERT_EQ(myPool.size(1), 10);
+
+  std::size_t nextShard = shorthand_sharded_pool::npos;
+  std::thread nextOwner([&myPool, &nextShard]() { nextShard = myPool.local_shard_index(); });
+  nextOwner.join();
+
+  ASSERT_EQ(nextShard, 1);
+  ASSERT_EQ(myPool.pending_releases(1), 0);
+  ASSERT_EQ(myPool.size(1), 0);
+  for (const auto& handle : allHandles) {
+    ASSERT_EQ(myPool.is_valid(handle), false);
+  }
+}
+
+TEST_F(sharded_weak_ref_data_pool, thread_outliving_the_pool) {
+
+  std::atomic<bool> canExit{false};
+  std::atomic<bool> isBound{false};
+  std::unique_ptr<shorthand_sharded_pool> myPool = std::make_unique<shorthand_sharded_pool>(1);
+
+  std::thread worker([&myPool, &canExit, &isBound]() {
+    myPool->acquire(1);
+    isBound.store(true);
+    while (!canExit.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  while (!isBound.load()) {
+    std::this_thread::yield();
+  }
+
+  myPool.reset(); // the worker binding must not touch the destroyed pool on exit
+  canExit.store(true);
+  worker.join();
+
+  // a new pool, the (joined) worker never bound to it
+  shorthand_sharded_pool otherPool(1);
+  ASSERT_EQ(otherPool.local_shard_index(), 0);
+}
@@ -0,0 +1,3 @@
+reset
+
+make build_mode=release benchmark -j7 && ./bin/benchmark
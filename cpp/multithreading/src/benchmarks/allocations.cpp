@@ -0,0 +1,128 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+//
+//
+// counting allocator (benchmark binary only)
+
+namespace
+{
+    std::atomic<uint64_t> s_totalAllocations{0};
+};
+
+void* operator new(std::size_t size)
+{
+    s_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* data = std::malloc(size == 0 ? 1 : size))
+        return data;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept
+{
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept
+{
+    std::free(data);
+}
+
+// counting allocator (benchmark binary only)
+//
+//
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalTasks = 100000;
+        constexpr unsigned int k_totalWorkers = 4;
+
+        // warm up (slabs, queues), then count the allocations of a second identical run
+        template<typename PushCallback>
+        void countAllocations(const std::string& name, PushCallback&& pushAll)
+        {
+            multithreading::Producer producer;
+            producer.initialise(k_totalWorkers);
+
+            pushAll(producer);
+            producer.waitUntilAllCompleted();
+
+            const uint64_t totalBefore = s_totalAllocations.load();
+
+            pushAll(producer);
+            producer.waitUntilAllCompleted();
+
+            const uint64_t totalAllocations = s_totalAllocations.load() - totalBefore;
+
+            std::cout
+                << std::left << std::setw(40) << name
+                << std::right << std::setw(10) << k_totalWorkers
+                << std::setw(16) << totalAllocations
+                << std::setw(16) << std::fixed << std::setprecision(3) << double(totalAllocations) / k_totalTasks
+                << std::endl;
+        }
+    }
+
+    void runAllocations()
+    {
+        std::cout << std::endl;
+        std::cout << "### allocations (steady state)" << std::endl;
+        std::cout
+            << std::left << std::setw(40) << "name"
+            << std::right << std::setw(10) << "workers"
+            << std::setw(16) << "allocations"
+            << std::setw(16) << "per task"
+            << std::endl;
+
+        std::atomic<uint64_t> counter{0};
+
+        countAllocations("8 bytes captures", [&counter](multithreading::Producer& producer)
+        {
+            for (int ii = 0; ii < k_totalTasks; ++ii)
+                producer.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        });
+
+        countAllocations("56 bytes captures", [&counter](multithreading::Producer& producer)
+        {
+            std::array<uint64_t, 6> values = { 1, 2, 3, 4, 5, 6 };
+            for (int ii = 0; ii < k_totalTasks; ++ii)
+                producer.push([&counter, values]() { counter.fetch_add(values[5], std::memory_order_relaxed); });
+        });
+
+        countAllocations("nested 8 bytes captures", [&counter](multithreading::Producer& producer)
+        {
+            for (int ii = 0; ii < k_totalTasks / 100; ++ii)
+            {
+                producer.push([&producer, &counter]()
+                {
+                    for (int jj = 0; jj < 99; ++jj)
+                        producer.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                });
+            }
+        });
+
+        // over the inline storage -> one heap allocation per task (expected)
+        countAllocations("128 bytes captures (heap fallback)", [&counter](multithreading::Producer& producer)
+        {
+            std::array<uint64_t, 16> values = {};
+            for (int ii = 0; ii < k_totalTasks; ++ii)
+                producer.push([&counter, values]() { counter.fetch_add(values[0] + 1, std::memory_order_relaxed); });
+        });
+    }
+
+};
@@ -0,0 +1,34 @@
+
+#include "benchmarks.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace benchmarks
+{
+
+    void printHeader(const std::string& title)
+    {
+        std::cout << std::endl;
+        std::cout << "### " << title << std::endl;
+        std::cout
+            << std::left << std::setw(40) << "name"
+            << std::right << std::setw(10) << "workers"
+            << std::setw(16) << "time (us)"
+            << std::setw(16) << "items/s"
+            << std::endl;
+    }
+
+    void printResult(const std::string& name, unsigned int totalWorkers, double microseconds, double totalItems)
+    {
+        const double itemsPerSecond = microseconds > 0.0 ? totalItems / (microseconds / 1000000.0) : 0.0;
+
+        std::cout
+            << std::left << std::setw(40) << name
+            << std::right << std::setw(10) << totalWorkers
+            << std::setw(16) << std::fixed << std::setprecision(1) << microseconds
+            << std::setw(16) << std::fixed << std::setprecision(0) << itemsPerSecond
+            << std::endl;
+    }
+
+};
@@ -0,0 +1,55 @@
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+    // worker counts used by the scaling benchmarks
+    const std::vector<unsigned int> k_workerCounts = { 1, 2, 4, 8, 16 };
+
+    // run the callback "totalRuns" times, return the best duration (microseconds)
+    template<typename Callback>
+    double measureBestMicroseconds(int totalRuns, Callback&& callback)
+    {
+        double bestDuration = -1.0;
+        for (int ii = 0; ii < totalRuns; ++ii)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            callback();
+            const auto stop = std::chrono::steady_clock::now();
+
+            const double duration = std::chrono::duration<double, std::micro>(stop - start).count();
+            if (bestDuration < 0.0 || duration < bestDuration)
+                bestDuration = duration;
+        }
+        return bestDuration;
+    }
+
+    void printHeader(const std::string& title);
+    void printResult(const std::string& name, unsigned int totalWorkers, double microseconds, double totalItems);
+
+    //
+    //
+
+    void runTinyTasks();
+    void runSubmission();
+    void runAllocations();
+    void runFutures();
+    void runTaskGraph();
+    void runParallelAlgorithms();
+    void runParallelSort();
+    void runTopology();
+    void runCoroutines();
+    void runTaskGroups();
+    void runPriorities();
+    void runWaitStrategies();
+    void runMetrics();
+    void runLogging();
+    void runCancellation();
+    void runCompletions();
+    void runElastic();
+};
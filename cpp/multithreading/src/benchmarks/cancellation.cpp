@@ -0,0 +1,95 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <stop_token>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalTasks = 2000;
+        constexpr int k_totalLoops = 27 * 27 * 27;
+        constexpr int k_pollInterval = 1024; // loops between two stop_requested()
+
+        void busyLoop()
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < k_totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+        }
+
+        // stop at the first poll after the cancellation
+        void pollingBusyLoop(const multithreading::CancellationToken& token)
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < k_totalLoops; ++ii)
+            {
+                if (ii % k_pollInterval == 0 && token.stop_requested())
+                    return;
+                sink = ii;
+            }
+            static_cast<void>(sink); // only there to keep the loop
+        }
+
+        // every other task on a source cancelled once all are pushed (superseded requests)
+        template<typename Callable>
+        double measureHalfCancelled(multithreading::Producer& producer, Callable&& callable)
+        {
+            return measureBestMicroseconds(5, [&producer, &callable]()
+            {
+                std::stop_source keptSource;
+                std::stop_source cancelledSource;
+
+                for (int ii = 0; ii < k_totalTasks; ++ii)
+                    producer.push(ii % 2 == 0 ? keptSource.get_token() : cancelledSource.get_token(), callable);
+
+                cancelledSource.request_stop();
+
+                producer.waitUntilAllCompleted();
+            });
+        }
+    }
+
+    void runCancellation()
+    {
+        printHeader("cancellation (2000 x 27^3 loop, half of them cancelled)");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            const double allDuration = measureBestMicroseconds(5, [&producer]()
+            {
+                for (int ii = 0; ii < k_totalTasks; ++ii)
+                    producer.push(busyLoop);
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("run all", totalWorkers, allDuration, k_totalTasks);
+
+            // the check when dequeued, never cancelled
+            const double tokenDuration = measureBestMicroseconds(5, [&producer]()
+            {
+                std::stop_source source;
+
+                for (int ii = 0; ii < k_totalTasks; ++ii)
+                    producer.push(source.get_token(), busyLoop);
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("run all, with a token", totalWorkers, tokenDuration, k_totalTasks);
+
+            const double droppedDuration = measureHalfCancelled(producer, busyLoop);
+            printResult("50% cancelled (dropped when queued)", totalWorkers, droppedDuration, k_totalTasks);
+
+            const double pollingDuration = measureHalfCancelled(producer, pollingBusyLoop);
+            printResult("50% cancelled (+ running ones poll)", totalWorkers, pollingDuration, k_totalTasks);
+        }
+    }
+
+};
@@ -0,0 +1,150 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // 1M tasks per second for half a second
+        constexpr int k_tasksPerTick = 1000;
+        constexpr auto k_tickDuration = std::chrono::milliseconds(1);
+        constexpr int k_totalTicks = 500;
+        constexpr int k_totalTasks = k_tasksPerTick * k_totalTicks;
+
+        using Clock = std::chrono::steady_clock;
+
+        // the former async/threading/Producer (before its adapter): a locked std::list, update() lock twice per completion
+        class LegacyCompletions
+        {
+        private:
+            std::mutex _mutex;
+            std::list<std::function<void()>> _doneList;
+
+        public:
+            void post(std::function<void()> oncomplete)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _doneList.push_back(std::move(oncomplete));
+            }
+
+            void update()
+            {
+                while (true)
+                {
+                    std::function<void()>* current = nullptr;
+
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (_doneList.empty())
+                            return;
+                        current = &_doneList.front();
+                    }
+
+                    // must not be locked as it might push a task
+                    (*current)();
+
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _doneList.pop_front();
+                    }
+                }
+            }
+        };
+
+        struct Durations
+        {
+            double update = 0.0; // in update() only, all the calls
+            double worstUpdate = 0.0; // longest update() call (a frame spike)
+        };
+
+        // one tick per millisecond: push k_tasksPerTick, update() once, sleep until the next tick
+        // => then update() until all are delivered
+        template<typename PushCallback, typename UpdateCallback>
+        Durations measure(int& totalCompleted, PushCallback&& pushCallback, UpdateCallback&& updateCallback)
+        {
+            Durations bestDurations;
+
+            for (int run = 0; run < 2; ++run)
+            {
+                totalCompleted = 0;
+                Durations durations;
+
+                auto timedUpdate = [&updateCallback, &durations]()
+                {
+                    const Clock::time_point start = Clock::now();
+                    updateCallback();
+                    const double duration = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+                    durations.update += duration;
+                    durations.worstUpdate = std::max(durations.worstUpdate, duration);
+                };
+
+                Clock::time_point nextTick = Clock::now();
+                for (int tick = 0; tick < k_totalTicks; ++tick)
+                {
+                    for (int ii = 0; ii < k_tasksPerTick; ++ii)
+                        pushCallback();
+
+                    timedUpdate();
+
+                    nextTick += k_tickDuration;
+                    std::this_thread::sleep_until(nextTick);
+                }
+
+                while (totalCompleted < k_totalTasks)
+                    timedUpdate();
+
+                if (run == 0 || durations.update < bestDurations.update)
+                    bestDurations = durations;
+            }
+
+            return bestDurations;
+        }
+    }
+
+    void runCompletions()
+    {
+        printHeader("completion delivery at 1M tasks/s (owner thread cost)");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            int totalCompleted = 0;
+
+            LegacyCompletions legacy;
+            const Durations legacyDurations = measure(totalCompleted, [&producer, &legacy, &totalCompleted]()
+            {
+                producer.push([&legacy, &totalCompleted]()
+                {
+                    legacy.post([&totalCompleted]() { ++totalCompleted; });
+                });
+            }, [&legacy]() { legacy.update(); });
+
+            printResult("locked list (m_list_done), update()", totalWorkers, legacyDurations.update, k_totalTasks);
+            printResult("locked list, worst update()", totalWorkers, legacyDurations.worstUpdate, 1);
+
+            const Durations queueDurations = measure(totalCompleted, [&producer, &totalCompleted]()
+            {
+                producer.pushWithCompletion([]() {}, [&totalCompleted]() { ++totalCompleted; });
+            }, [&producer]() { producer.update(); });
+
+            printResult("lock free queue, update()", totalWorkers, queueDurations.update, k_totalTasks);
+            printResult("lock free queue, worst update()", totalWorkers, queueDurations.worstUpdate, 1);
+
+            producer.waitUntilAllCompleted();
+        }
+    }
+
+};
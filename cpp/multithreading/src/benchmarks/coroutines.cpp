@@ -0,0 +1,115 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalHops = 1000000;
+
+        //
+        // push-callback chain: each callback push the next one
+
+        struct CallbackChain
+        {
+            multithreading::Producer& producer;
+            int totalRemaining;
+            uint64_t total = 0;
+        };
+
+        void pushNextHop(CallbackChain& chain)
+        {
+            chain.producer.push([&chain]()
+            {
+                chain.total += uint64_t(chain.totalRemaining);
+                if (--chain.totalRemaining > 0)
+                    pushNextHop(chain);
+            });
+        }
+
+        //
+        // the same chain as a coroutine
+
+        multithreading::CoroutineTask<uint64_t> runHops(multithreading::Producer& producer, int totalHops)
+        {
+            uint64_t total = 0;
+            for (int ii = totalHops; ii > 0; --ii)
+            {
+                co_await producer.schedule();
+                total += uint64_t(ii);
+            }
+            co_return total;
+        }
+
+        //
+        // awaited sub-coroutines completing at once (symmetric transfer, pooled frames)
+
+        multithreading::CoroutineTask<uint64_t> getValue(int value)
+        {
+            co_return uint64_t(value);
+        }
+
+        multithreading::CoroutineTask<uint64_t> sumValues(int totalValues)
+        {
+            uint64_t total = 0;
+            for (int ii = 0; ii < totalValues; ++ii)
+                total += co_await getValue(ii);
+            co_return total;
+        }
+
+        // 1M nested frames alive at once, no stack growth
+        multithreading::CoroutineTask<uint64_t> recurse(int depth)
+        {
+            if (depth == 0)
+                co_return 0;
+            co_return 1 + co_await recurse(depth - 1);
+        }
+    }
+
+    void runCoroutines()
+    {
+        printHeader("coroutines (1M hops)");
+
+        volatile uint64_t sink = 0;
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            const double callbackDuration = measureBestMicroseconds(3, [&producer, &sink]()
+            {
+                CallbackChain chain{ producer, k_totalHops };
+                pushNextHop(chain);
+                producer.waitUntilAllCompleted();
+                sink = chain.total;
+            });
+            printResult("push-callback chain", totalWorkers, callbackDuration, k_totalHops);
+
+            const double coroutineDuration = measureBestMicroseconds(3, [&producer, &sink]()
+            {
+                sink = multithreading::syncWait(runHops(producer, k_totalHops));
+            });
+            printResult("co_await schedule() chain", totalWorkers, coroutineDuration, k_totalHops);
+        }
+
+        const double awaitDuration = measureBestMicroseconds(3, [&sink]()
+        {
+            sink = multithreading::syncWait(sumValues(k_totalHops));
+        });
+        printResult("co_await ready sub-task (no pool)", 1, awaitDuration, k_totalHops);
+
+        const double recurseDuration = measureBestMicroseconds(3, [&sink]()
+        {
+            sink = multithreading::syncWait(recurse(k_totalHops));
+        });
+        printResult("1M deep co_await recursion (no pool)", 1, recurseDuration, k_totalHops);
+    }
+
+};
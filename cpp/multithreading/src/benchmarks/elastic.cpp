@@ -0,0 +1,222 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalBurstTasks = 400;
+        constexpr int k_totalBursts = 3;
+        constexpr auto k_blockingDuration = std::chrono::microseconds(250); // a blocking call (i/o)
+        constexpr int k_totalLoops = 27 * 27 * 27;
+
+        constexpr auto k_retireTimeout = std::chrono::milliseconds(50);
+        constexpr auto k_idleDuration = std::chrono::milliseconds(200);
+
+        using Clock = std::chrono::steady_clock;
+
+        struct PoolConfig
+        {
+            const char* name;
+            unsigned int totalConsumers;
+            unsigned int minConsumers; // 0: fixed
+        };
+
+        const PoolConfig k_configs[] = {
+            { "fixed, 1 consumer", 1, 0 },
+            { "fixed, 8 consumers", 8, 0 },
+            { "elastic, 1 to 8 consumers", 8, 1 },
+        };
+
+        struct BurstResult
+        {
+            double duration = 0.0; // us, push of the first task -> last task done
+            double p50 = 0.0; // us, push -> start
+            double p99 = 0.0;
+        };
+
+        struct IdleResult
+        {
+            std::size_t activeConsumers = 0;
+            long totalThreads = 0; // whole process
+            long rssKilobytes = 0;
+            double cpuMicrosecondsPerSecond = 0.0;
+        };
+
+        void blockingTask()
+        {
+            std::this_thread::sleep_for(k_blockingDuration);
+        }
+
+        void busyLoop()
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < k_totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+        }
+
+        // each burst start from an idle pool: an elastic one is back to its minimum
+        BurstResult measureBursts(multithreading::Producer& producer, void (*work)())
+        {
+            BurstResult bestResult;
+            std::vector<double> latencies(k_totalBurstTasks, 0.0);
+
+            for (int burst = 0; burst < k_totalBursts; ++burst)
+            {
+                std::this_thread::sleep_for(k_retireTimeout * 3);
+
+                const Clock::time_point start = Clock::now();
+
+                for (int ii = 0; ii < k_totalBurstTasks; ++ii)
+                {
+                    producer.push([&latencies, ii, work, pushTime = Clock::now()]()
+                    {
+                        latencies[std::size_t(ii)] = std::chrono::duration<double, std::micro>(Clock::now() - pushTime).count();
+                        work();
+                    });
+                }
+
+                producer.waitUntilAllCompleted();
+
+                BurstResult result;
+                result.duration = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+                std::sort(latencies.begin(), latencies.end());
+                result.p50 = latencies[latencies.size() / 2];
+                result.p99 = latencies[latencies.size() * 99 / 100];
+
+                if (burst == 0 || result.duration < bestResult.duration)
+                    bestResult = result;
+            }
+
+            return bestResult;
+        }
+
+        // "Threads:" and "VmRSS:" of /proc/self/status (0 when not available)
+        void readProcessStatus(IdleResult& result)
+        {
+            std::ifstream status("/proc/self/status");
+
+            std::string key;
+            while (status >> key)
+            {
+                if (key == "Threads:")
+                    status >> result.totalThreads;
+                else if (key == "VmRSS:")
+                    status >> result.rssKilobytes;
+
+                status.ignore(256, '\n');
+            }
+        }
+
+        double getProcessCpuMicroseconds()
+        {
+            rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+
+            return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 + double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+        }
+
+        // after the bursts, past the retire timeout
+        IdleResult measureIdle(multithreading::Producer& producer)
+        {
+            std::this_thread::sleep_for(k_retireTimeout * 3);
+
+            IdleResult result;
+
+            const double cpuBefore = getProcessCpuMicroseconds();
+            std::this_thread::sleep_for(k_idleDuration);
+            const double cpuAfter = getProcessCpuMicroseconds();
+
+            result.cpuMicrosecondsPerSecond = (cpuAfter - cpuBefore) / std::chrono::duration<double>(k_idleDuration).count();
+            result.activeConsumers = producer.totalActiveConsumers();
+            readProcessStatus(result);
+
+            return result;
+        }
+
+        void printBurst(const std::string& name, unsigned int totalWorkers, const BurstResult& result)
+        {
+            std::cout
+                << std::left << std::setw(40) << name
+                << std::right << std::setw(10) << totalWorkers
+                << std::setw(16) << std::fixed << std::setprecision(1) << result.duration
+                << std::setw(16) << result.p50
+                << std::setw(16) << result.p99
+                << std::endl;
+        }
+    }
+
+    void runElastic()
+    {
+        std::cout << std::endl;
+        std::cout << "### elastic worker count: bursts of 400 tasks from an idle pool" << std::endl;
+        std::cout
+            << std::left << std::setw(40) << "name"
+            << std::right << std::setw(10) << "workers"
+            << std::setw(16) << "time (us)"
+            << std::setw(16) << "p50 wait (us)"
+            << std::setw(16) << "p99 wait (us)"
+            << std::endl;
+
+        std::vector<IdleResult> idleResults;
+
+        for (const PoolConfig& config : k_configs)
+        {
+            multithreading::ProducerSettings settings;
+            settings.totalConsumers = config.totalConsumers;
+            settings.minConsumers = config.minConsumers;
+            settings.retireTimeout = k_retireTimeout;
+
+            multithreading::Producer producer;
+            producer.initialise(settings);
+
+            printBurst(std::string(config.name) + ", blocking", config.totalConsumers, measureBursts(producer, blockingTask));
+            printBurst(std::string(config.name) + ", 27^3 loop", config.totalConsumers, measureBursts(producer, busyLoop));
+
+            idleResults.push_back(measureIdle(producer));
+        }
+
+        std::cout << std::endl;
+        std::cout << "### elastic worker count: idle pool (after the bursts)" << std::endl;
+        std::cout
+            << std::left << std::setw(40) << "name"
+            << std::right << std::setw(10) << "workers"
+            << std::setw(16) << "active"
+            << std::setw(16) << "threads"
+            << std::setw(16) << "rss (KB)"
+            << std::setw(16) << "cpu (us/s)"
+            << std::endl;
+
+        for (std::size_t ii = 0; ii < idleResults.size(); ++ii)
+        {
+            const IdleResult& result = idleResults[ii];
+
+            std::cout
+                << std::left << std::setw(40) << k_configs[ii].name
+                << std::right << std::setw(10) << k_configs[ii].totalConsumers
+                << std::setw(16) << result.activeConsumers
+                << std::setw(16) << result.totalThreads
+                << std::setw(16) << result.rssKilobytes
+                << std::setw(16) << std::fixed << std::setprecision(1) << result.cpuMicrosecondsPerSecond
+                << std::endl;
+        }
+    }
+
+};
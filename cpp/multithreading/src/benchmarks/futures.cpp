@@ -0,0 +1,105 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <cstdint>
+#include <future>
+#include <vector>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalComputations = 10000;
+
+        uint64_t smallComputation(uint64_t seed)
+        {
+            uint64_t result = seed;
+            for (uint64_t ii = 0; ii < 100; ++ii)
+                result = result * 6364136223846793005ull + ii;
+            return result;
+        }
+    }
+
+    void runFutures()
+    {
+        printHeader("futures (10k fan-out/fan-in)");
+
+        volatile uint64_t sink = 0;
+
+        // one thread per task (workers = 0)
+        const double asyncDuration = measureBestMicroseconds(3, [&sink]()
+        {
+            std::vector<std::future<uint64_t>> futures;
+            futures.reserve(k_totalComputations);
+
+            for (int ii = 0; ii < k_totalComputations; ++ii)
+                futures.push_back(std::async(std::launch::async, smallComputation, uint64_t(ii)));
+
+            uint64_t total = 0;
+            for (auto& future : futures)
+                total += future.get();
+            sink = total;
+        });
+        printResult("std::async + std::future", 0, asyncDuration, k_totalComputations);
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            const double getDuration = measureBestMicroseconds(5, [&producer, &sink]()
+            {
+                std::vector<multithreading::TaskFuture<uint64_t>> futures;
+                futures.reserve(k_totalComputations);
+
+                for (int ii = 0; ii < k_totalComputations; ++ii)
+                    futures.push_back(producer.submit([ii]() { return smallComputation(uint64_t(ii)); }));
+
+                uint64_t total = 0;
+                for (auto& future : futures)
+                    total += future.get();
+                sink = total;
+            });
+            printResult("submit + get", totalWorkers, getDuration, k_totalComputations);
+
+            const double whenAllDuration = measureBestMicroseconds(5, [&producer, &sink]()
+            {
+                std::vector<multithreading::TaskFuture<uint64_t>> futures;
+                futures.reserve(k_totalComputations);
+
+                for (int ii = 0; ii < k_totalComputations; ++ii)
+                    futures.push_back(producer.submit([ii]() { return smallComputation(uint64_t(ii)); }));
+
+                // the sum is a continuation, the main thread only wait for the final value
+                auto totalFuture = multithreading::whenAll(std::move(futures)).then([](std::vector<uint64_t> values)
+                {
+                    uint64_t total = 0;
+                    for (uint64_t value : values)
+                        total += value;
+                    return total;
+                });
+                sink = totalFuture.get();
+            });
+            printResult("submit + whenAll + then", totalWorkers, whenAllDuration, k_totalComputations);
+
+            const double thenDuration = measureBestMicroseconds(5, [&producer, &sink]()
+            {
+                std::vector<multithreading::TaskFuture<uint64_t>> futures;
+                futures.reserve(k_totalComputations);
+
+                for (int ii = 0; ii < k_totalComputations; ++ii)
+                {
+                    futures.push_back(producer.submit([ii]() { return smallComputation(uint64_t(ii)); })
+                        .then([](uint64_t value) { return smallComputation(value); }));
+                }
+
+                sink = multithreading::whenAll(std::move(futures)).get().size();
+            });
+            printResult("submit + then (2 steps) + whenAll", totalWorkers, thenDuration, k_totalComputations * 2);
+        }
+    }
+
+};
@@ -0,0 +1,173 @@
+
+#include "benchmarks.hpp"
+
+#include "utilities/AsyncLogger.hpp"
+#include "utilities/TraceLogger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // latency: bursts that fit in a ring buffer, flushed between the bursts
+        constexpr int k_totalBursts = 20;
+        constexpr int k_totalBurstCalls = 1000;
+
+        constexpr int k_totalThreadCalls = 20000;
+
+        using Clock = std::chrono::steady_clock;
+
+        // both loggers write in the void: only their own cost is measured
+        class NullBuffer
+            : public std::streambuf
+        {
+        protected:
+            int overflow(int character) override
+            {
+                return character;
+            }
+
+            std::streamsize xsputn(const char*, std::streamsize size) override
+            {
+                return size;
+            }
+        };
+
+        // D_SYNC_LOG write in std::cout
+        class ScopedCoutRedirect
+        {
+        private:
+            std::streambuf* _previousBuffer;
+
+        public:
+            explicit ScopedCoutRedirect(std::streambuf* buffer)
+                : _previousBuffer(std::cout.rdbuf(buffer))
+            {}
+
+            ~ScopedCoutRedirect()
+            {
+                std::cout.rdbuf(_previousBuffer);
+            }
+        };
+
+        void logSync(int index, double value)
+        {
+            D_SYNC_LOG("task " << index << " of " << k_totalThreadCalls << " value " << value);
+        }
+
+        void logAsync(int index, double value)
+        {
+            D_ASYNC_LOG("task {} of {} value {}", index, k_totalThreadCalls, value);
+        }
+
+        // per call latencies (microseconds, sorted)
+        template<typename LogCallback, typename FlushCallback>
+        std::vector<double> measureLatencies(LogCallback&& logCallback, FlushCallback&& flushCallback)
+        {
+            std::vector<double> latencies;
+            latencies.reserve(k_totalBursts * k_totalBurstCalls);
+
+            for (int burst = 0; burst < k_totalBursts; ++burst)
+            {
+                for (int ii = 0; ii < k_totalBurstCalls; ++ii)
+                {
+                    const Clock::time_point start = Clock::now();
+                    logCallback(ii, ii * 0.5);
+                    latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                }
+
+                flushCallback();
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+            return latencies;
+        }
+
+        void printLatencies(const std::string& name, const std::vector<double>& latencies)
+        {
+            const double p50 = latencies[latencies.size() / 2];
+            const double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+            printResult(name + ", p50", 1, p50, 1);
+            printResult(name + ", p99", 1, p99, 1);
+        }
+
+        // every thread log k_totalThreadCalls lines, until written
+        template<typename ThreadCallback, typename FlushCallback>
+        double measureThroughput(unsigned int totalThreads, ThreadCallback&& threadCallback, FlushCallback&& flushCallback)
+        {
+            return measureBestMicroseconds(3, [totalThreads, &threadCallback, &flushCallback]()
+            {
+                std::vector<std::thread> threads;
+                threads.reserve(totalThreads);
+
+                for (unsigned int ii = 0; ii < totalThreads; ++ii)
+                    threads.emplace_back(threadCallback);
+
+                for (std::thread& thread : threads)
+                    thread.join();
+
+                flushCallback();
+            });
+        }
+    }
+
+    void runLogging()
+    {
+        printHeader("logging (D_SYNC_LOG vs D_ASYNC_LOG, null output)");
+
+        NullBuffer nullBuffer;
+        std::ostream nullStream(&nullBuffer);
+
+        AsyncLogger& asyncLogger = AsyncLogger::get();
+        asyncLogger.setOutput(nullStream);
+
+        std::vector<double> syncLatencies;
+        {
+            ScopedCoutRedirect redirect(&nullBuffer);
+            syncLatencies = measureLatencies(logSync, []() {});
+        }
+        const std::vector<double> asyncLatencies = measureLatencies(logAsync, [&asyncLogger]() { asyncLogger.flush(); });
+
+        printLatencies("D_SYNC_LOG per call", syncLatencies);
+        printLatencies("D_ASYNC_LOG per call", asyncLatencies);
+
+        for (unsigned int totalThreads : k_workerCounts)
+        {
+            // as main.cpp used to: one mutex around the logging
+            std::mutex loggerMutex;
+
+            double syncDuration;
+            {
+                ScopedCoutRedirect redirect(&nullBuffer);
+                syncDuration = measureThroughput(totalThreads, [&loggerMutex]()
+                {
+                    for (int ii = 0; ii < k_totalThreadCalls; ++ii)
+                    {
+                        std::unique_lock<std::mutex> lock(loggerMutex);
+                        logSync(ii, ii * 0.5);
+                    }
+                }, []() {});
+            }
+            printResult("D_SYNC_LOG + mutex", totalThreads, syncDuration, double(totalThreads) * k_totalThreadCalls);
+
+            const double asyncDuration = measureThroughput(totalThreads, []()
+            {
+                for (int ii = 0; ii < k_totalThreadCalls; ++ii)
+                    logAsync(ii, ii * 0.5);
+            }, [&asyncLogger]() { asyncLogger.flush(); });
+            printResult("D_ASYNC_LOG (until written)", totalThreads, asyncDuration, double(totalThreads) * k_totalThreadCalls);
+        }
+
+        asyncLogger.setOutput(std::cout);
+    }
+
+};
@@ -0,0 +1,27 @@
+
+#include "benchmarks.hpp"
+
+#include <cstdlib> // EXIT_SUCCESS
+
+int main()
+{
+    benchmarks::runTinyTasks();
+    benchmarks::runSubmission();
+    benchmarks::runAllocations();
+    benchmarks::runFutures();
+    benchmarks::runTaskGraph();
+    benchmarks::runParallelAlgorithms();
+    benchmarks::runParallelSort();
+    benchmarks::runTopology();
+    benchmarks::runCoroutines();
+    benchmarks::runTaskGroups();
+    benchmarks::runPriorities();
+    benchmarks::runWaitStrategies();
+    benchmarks::runMetrics();
+    benchmarks::runLogging();
+    benchmarks::runCancellation();
+    benchmarks::runCompletions();
+    benchmarks::runElastic();
+
+    return EXIT_SUCCESS;
+}
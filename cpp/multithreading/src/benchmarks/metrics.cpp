@@ -0,0 +1,124 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalRepeat = 200;
+        constexpr int k_totalLoops = 27 * 27 * 27;
+        constexpr int k_totalEmptyTasks = 100000;
+
+        struct MetricsConfig
+        {
+            const char* name;
+            bool enableMetrics;
+            unsigned int samplingInterval;
+            std::size_t traceCapacity;
+        };
+
+        const MetricsConfig k_configs[] = {
+            { "off", false, 64, 0 },
+            { "on, 1/64 sampled", true, 64, 0 },
+            { "on, all sampled", true, 1, 0 },
+            { "on, all sampled + trace", true, 1, 65536 },
+        };
+
+        struct Durations
+        {
+            double busyLoop = 0.0;
+            double emptyTasks = 0.0;
+        };
+
+        Durations measure(multithreading::Producer& producer)
+        {
+            Durations durations;
+
+            // same workloads as the tiny tasks benchmark
+            durations.busyLoop = measureBestMicroseconds(5, [&producer]()
+            {
+                for (int ii = 0; ii < k_totalRepeat; ++ii)
+                {
+                    producer.push([]()
+                    {
+                        volatile int sink = 0;
+                        for (int jj = 0; jj < k_totalLoops; ++jj)
+                            sink = jj;
+                        static_cast<void>(sink); // only there to keep the loop
+                    });
+                }
+
+                producer.waitUntilAllCompleted();
+            });
+
+            std::atomic<int> counter{0};
+            durations.emptyTasks = measureBestMicroseconds(5, [&producer, &counter]()
+            {
+                for (int ii = 0; ii < k_totalEmptyTasks; ++ii)
+                    producer.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+
+                producer.waitUntilAllCompleted();
+            });
+
+            return durations;
+        }
+
+        std::string makeName(const std::string& name, double duration, double reference)
+        {
+            std::stringstream stream;
+            stream << name;
+            if (reference > 0.0)
+                stream << " (" << (duration >= reference ? "+" : "") << int((duration / reference - 1.0) * 1000.0) / 10.0 << "%)";
+            return stream.str();
+        }
+    }
+
+    void runMetrics()
+    {
+        printHeader("metrics overhead");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            Durations reference;
+
+            for (const MetricsConfig& config : k_configs)
+            {
+                multithreading::ProducerSettings settings;
+                settings.totalConsumers = totalWorkers;
+                settings.enableMetrics = config.enableMetrics;
+                settings.metricsSamplingInterval = config.samplingInterval;
+                settings.traceCapacity = config.traceCapacity;
+
+                multithreading::Producer producer;
+                producer.initialise(settings);
+
+                const Durations durations = measure(producer);
+                if (!config.enableMetrics)
+                    reference = durations;
+
+                printResult(makeName(std::string("loop, ") + config.name, durations.busyLoop, config.enableMetrics ? reference.busyLoop : 0.0), totalWorkers, durations.busyLoop, k_totalRepeat);
+                printResult(makeName(std::string("empty, ") + config.name, durations.emptyTasks, config.enableMetrics ? reference.emptyTasks : 0.0), totalWorkers, durations.emptyTasks, k_totalEmptyTasks);
+
+                // one example of the exports
+                if (totalWorkers == 4 && config.traceCapacity > 0)
+                {
+                    std::cout << std::endl;
+                    producer.getStats().print(std::cout);
+
+                    std::stringstream trace;
+                    producer.writeChromeTrace(trace);
+                    std::cout << "  chrome trace: " << trace.str().size() / 1024 << " KB" << std::endl << std::endl;
+                }
+            }
+        }
+    }
+
+};
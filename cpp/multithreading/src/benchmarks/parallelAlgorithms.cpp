@@ -0,0 +1,166 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/ParallelAlgorithms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(D_BENCHMARK_WITH_TBB)
+#include <execution>
+#endif
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // 1B doubles (8GB + the scan output) do not fit the benchmark machines
+        const std::vector<std::size_t> k_totalElements = { 10000000, 100000000 };
+
+        // async/main.cpp "async_sum", with a bigger split threshold
+        // (1000 elements -> 100k threads at 100M elements)
+        template<typename Iterator>
+        double asyncSum(Iterator begin, Iterator end)
+        {
+            const auto length = end - begin;
+            if (length < 1000000)
+                return std::accumulate(begin, end, 0.0);
+
+            Iterator middle = begin + length / 3 * 2;
+            auto handle = std::async(std::launch::async, asyncSum<Iterator>, middle, end);
+            const double sum = asyncSum(begin, middle);
+            return sum + handle.get();
+        }
+
+        // one std::async per hardware thread
+        void asyncMap(const std::vector<double>& input, std::vector<double>& output)
+        {
+            const std::size_t totalThreads = std::max(1u, std::thread::hardware_concurrency());
+            std::vector<std::future<void>> futures;
+
+            for (std::size_t ii = 0; ii < totalThreads; ++ii)
+            {
+                const std::size_t first = input.size() * ii / totalThreads;
+                const std::size_t last = input.size() * (ii + 1) / totalThreads;
+                futures.push_back(std::async(std::launch::async, [&input, &output, first, last]()
+                {
+                    for (std::size_t index = first; index < last; ++index)
+                        output[index] = std::sqrt(input[index]) * 2.0;
+                }));
+            }
+
+            for (auto& future : futures)
+                future.get();
+        }
+
+        std::string makeName(const std::string& name, std::size_t totalElements)
+        {
+            std::stringstream stream;
+            stream << name << " " << (totalElements / 1000000) << "M";
+            return stream.str();
+        }
+    }
+
+    void runParallelAlgorithms()
+    {
+        printHeader("parallel algorithms (doubles)");
+
+        const unsigned int totalWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+        multithreading::Producer producer;
+        producer.initialise(totalWorkers);
+
+        for (std::size_t totalElements : k_totalElements)
+        {
+            std::vector<double> input(totalElements);
+            for (std::size_t ii = 0; ii < totalElements; ++ii)
+                input[ii] = double(ii % 1000) * 0.5;
+            std::vector<double> output(totalElements);
+
+            volatile double sink = 0.0;
+
+            //
+            // sum
+
+            printResult(makeName("sum serial", totalElements), 1, measureBestMicroseconds(3, [&]()
+            {
+                sink = std::accumulate(input.begin(), input.end(), 0.0);
+            }), double(totalElements));
+
+            printResult(makeName("sum std::async", totalElements), 0, measureBestMicroseconds(3, [&]()
+            {
+                sink = asyncSum(input.begin(), input.end());
+            }), double(totalElements));
+
+#if defined(D_BENCHMARK_WITH_TBB)
+            printResult(makeName("sum std::execution::par", totalElements), 0, measureBestMicroseconds(3, [&]()
+            {
+                sink = std::reduce(std::execution::par, input.begin(), input.end(), 0.0);
+            }), double(totalElements));
+#endif
+
+            printResult(makeName("sum parallelReduce static", totalElements), totalWorkers, measureBestMicroseconds(3, [&]()
+            {
+                sink = multithreading::parallelReduce(producer, input.begin(), input.end(), 0, 0.0, std::plus<double>(), multithreading::ChunkingMode::Static);
+            }), double(totalElements));
+
+            printResult(makeName("sum parallelReduce adaptive", totalElements), totalWorkers, measureBestMicroseconds(3, [&]()
+            {
+                sink = multithreading::parallelReduce(producer, input.begin(), input.end(), 0, 0.0, std::plus<double>());
+            }), double(totalElements));
+
+            //
+            // map
+
+            printResult(makeName("map std::async", totalElements), 0, measureBestMicroseconds(3, [&]()
+            {
+                asyncMap(input, output);
+            }), double(totalElements));
+
+#if defined(D_BENCHMARK_WITH_TBB)
+            printResult(makeName("map std::execution::par", totalElements), 0, measureBestMicroseconds(3, [&]()
+            {
+                std::transform(std::execution::par, input.begin(), input.end(), output.begin(), [](double value) { return std::sqrt(value) * 2.0; });
+            }), double(totalElements));
+#endif
+
+            printResult(makeName("map parallelForIndex", totalElements), totalWorkers, measureBestMicroseconds(3, [&]()
+            {
+                multithreading::parallelForIndex(producer, 0, totalElements, 0, [&input, &output](std::size_t index)
+                {
+                    output[index] = std::sqrt(input[index]) * 2.0;
+                });
+            }), double(totalElements));
+
+            //
+            // scan
+
+            printResult(makeName("scan serial", totalElements), 1, measureBestMicroseconds(3, [&]()
+            {
+                std::inclusive_scan(input.begin(), input.end(), output.begin());
+            }), double(totalElements));
+
+#if defined(D_BENCHMARK_WITH_TBB)
+            printResult(makeName("scan std::execution::par", totalElements), 0, measureBestMicroseconds(3, [&]()
+            {
+                std::inclusive_scan(std::execution::par, input.begin(), input.end(), output.begin());
+            }), double(totalElements));
+#endif
+
+            printResult(makeName("scan parallelInclusiveScan", totalElements), totalWorkers, measureBestMicroseconds(3, [&]()
+            {
+                multithreading::parallelInclusiveScan(producer, input.begin(), input.end(), output.begin(), 0, std::plus<double>());
+            }), double(totalElements));
+
+            static_cast<void>(sink);
+        }
+    }
+
+};
@@ -0,0 +1,175 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/ParallelSort.hpp"
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(D_BENCHMARK_WITH_TBB)
+#include <execution>
+#endif
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        const std::vector<std::size_t> k_totalElements = { 1000000, 10000000, 100000000 };
+
+        // async/main2.cpp "run_tests_thread": 8 std::async sorts, then rounds of std::async inplace_merge
+        void asyncPartsSort(std::vector<double>& values)
+        {
+            std::size_t totalParts = 8;
+
+            std::vector<std::size_t> bounds(totalParts + 1);
+            for (std::size_t ii = 0; ii <= totalParts; ++ii)
+                bounds[ii] = values.size() * ii / totalParts;
+
+            std::vector<std::future<void>> futures;
+            for (std::size_t ii = 0; ii < totalParts; ++ii)
+                futures.push_back(std::async(std::launch::async, [&values, &bounds, ii]()
+                {
+                    std::sort(values.begin() + bounds[ii], values.begin() + bounds[ii + 1]);
+                }));
+            for (auto& future : futures)
+                future.get();
+
+            while (totalParts >= 2)
+            {
+                std::vector<std::size_t> newBounds;
+                futures.clear();
+
+                for (std::size_t ii = 0; ii + 1 < totalParts; ii += 2)
+                {
+                    futures.push_back(std::async(std::launch::async, [&values, &bounds, ii]()
+                    {
+                        std::inplace_merge(values.begin() + bounds[ii], values.begin() + bounds[ii + 1], values.begin() + bounds[ii + 2]);
+                    }));
+
+                    if (newBounds.empty())
+                        newBounds.push_back(bounds[ii]);
+                    newBounds.push_back(bounds[ii + 2]);
+                }
+                for (auto& future : futures)
+                    future.get();
+
+                totalParts /= 2;
+                bounds = newBounds;
+            }
+        }
+
+        // async/main.cpp "quicksort": one std::async per partition above 1000 elements (unbounded threads)
+        template<typename Iterator>
+        void asyncQuicksort(Iterator begin, Iterator end)
+        {
+            const auto length = end - begin;
+            if (length < 1000)
+            {
+                std::sort(begin, end);
+                return;
+            }
+
+            const double pivot = *(begin + length / 2);
+            Iterator middle1 = std::partition(begin, end, [pivot](double value) { return value < pivot; });
+
+            auto handle = std::async(std::launch::async, asyncQuicksort<Iterator>, begin, middle1);
+            Iterator middle2 = std::partition(middle1, end, [pivot](double value) { return !(pivot < value); });
+            asyncQuicksort(middle2, end);
+            handle.get();
+        }
+
+        std::string makeName(const std::string& name, std::size_t totalElements)
+        {
+            std::stringstream stream;
+            stream << name << " " << (totalElements / 1000000) << "M";
+            return stream.str();
+        }
+
+        // the copy of the unsorted values is not timed
+        template<typename SortCallback>
+        void runSort(const std::string& name, unsigned int totalWorkers, int totalRuns, const std::vector<double>& source, std::vector<double>& values, SortCallback&& sortCallback)
+        {
+            double bestDuration = -1.0;
+            for (int ii = 0; ii < totalRuns; ++ii)
+            {
+                values = source;
+
+                const double duration = measureBestMicroseconds(1, [&]() { sortCallback(values); });
+                if (bestDuration < 0.0 || duration < bestDuration)
+                    bestDuration = duration;
+            }
+
+            if (!std::is_sorted(values.begin(), values.end()))
+                std::cout << "/!\\ " << name << ": not sorted" << std::endl;
+
+            printResult(makeName(name, source.size()), totalWorkers, bestDuration, double(source.size()));
+        }
+    }
+
+    void runParallelSort()
+    {
+        printHeader("parallel sort (random doubles)");
+
+        const unsigned int totalWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+        multithreading::Producer producer;
+        producer.initialise(totalWorkers);
+
+        for (std::size_t totalElements : k_totalElements)
+        {
+            const int totalRuns = totalElements >= 100000000 ? 1 : 3;
+
+            std::vector<double> source(totalElements);
+            std::mt19937_64 randomEngine(totalElements);
+            std::uniform_real_distribution<double> distribution(0.0, 100.0);
+            for (double& value : source)
+                value = distribution(randomEngine);
+
+            std::vector<double> values;
+
+            runSort("std::sort", 1, totalRuns, source, values, [](std::vector<double>& currValues)
+            {
+                std::sort(currValues.begin(), currValues.end());
+            });
+
+            runSort("async 8 parts + inplace_merge", 0, totalRuns, source, values, [](std::vector<double>& currValues)
+            {
+                asyncPartsSort(currValues);
+            });
+
+            runSort("async quicksort", 0, totalRuns, source, values, [](std::vector<double>& currValues)
+            {
+                asyncQuicksort(currValues.begin(), currValues.end());
+            });
+
+#if defined(D_BENCHMARK_WITH_TBB)
+            runSort("std::sort std::execution::par", 0, totalRuns, source, values, [](std::vector<double>& currValues)
+            {
+                std::sort(std::execution::par, currValues.begin(), currValues.end());
+            });
+#endif
+
+            runSort("parallelSort (radix)", totalWorkers, totalRuns, source, values, [&producer](std::vector<double>& currValues)
+            {
+                multithreading::parallelSort(producer, currValues.begin(), currValues.end());
+            });
+
+            runSort("parallelSampleSort", totalWorkers, totalRuns, source, values, [&producer](std::vector<double>& currValues)
+            {
+                multithreading::parallelSampleSort(producer, currValues.begin(), currValues.end());
+            });
+
+            runSort("parallelStableSort (merge path)", totalWorkers, totalRuns, source, values, [&producer](std::vector<double>& currValues)
+            {
+                multithreading::parallelStableSort(producer, currValues.begin(), currValues.end());
+            });
+        }
+    }
+
+};
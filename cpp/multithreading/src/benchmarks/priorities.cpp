@@ -0,0 +1,117 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // a saturating background load (~150ms of work), probes pushed while it run (~50ms)
+        constexpr int k_totalBackgroundTasks = 20000;
+        constexpr int k_backgroundLoops = 20000;
+        constexpr int k_totalProbes = 200;
+        constexpr auto k_probeInterval = std::chrono::microseconds(250);
+
+        using Clock = std::chrono::steady_clock;
+
+        enum class Variant
+        {
+            Fifo, // everything in the normal lane
+            Lanes, // background low, probes high
+            Deadlines, // everything in the normal lane, the probes with a deadline
+        };
+
+        void busyLoop(int totalLoops)
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+        }
+
+        // push to run latencies of the probes (microseconds, sorted)
+        std::vector<double> measureProbes(multithreading::Producer& producer, Variant variant)
+        {
+            using multithreading::TaskPriority;
+
+            const TaskPriority backgroundPriority = (variant == Variant::Lanes ? TaskPriority::Low : TaskPriority::Normal);
+
+            for (int ii = 0; ii < k_totalBackgroundTasks; ++ii)
+                producer.push(backgroundPriority, []() { busyLoop(k_backgroundLoops); });
+
+            std::vector<double> latencies(k_totalProbes, 0.0);
+
+            auto nextProbe = Clock::now();
+            for (int ii = 0; ii < k_totalProbes; ++ii)
+            {
+                std::this_thread::sleep_until(nextProbe);
+                nextProbe += k_probeInterval;
+
+                const Clock::time_point pushTime = Clock::now();
+                auto probe = [&latencies, ii, pushTime]()
+                {
+                    latencies[ii] = std::chrono::duration<double, std::micro>(Clock::now() - pushTime).count();
+                };
+
+                if (variant == Variant::Lanes)
+                    producer.push(TaskPriority::High, probe);
+                else if (variant == Variant::Deadlines)
+                    producer.pushWithDeadline(TaskPriority::Normal, pushTime + std::chrono::milliseconds(1), probe);
+                else
+                    producer.push(probe);
+            }
+
+            producer.waitUntilAllCompleted();
+
+            std::sort(latencies.begin(), latencies.end());
+            return latencies;
+        }
+
+        void printLatencies(const std::string& name, unsigned int totalWorkers, const std::vector<double>& latencies)
+        {
+            const double p50 = latencies[latencies.size() / 2];
+            const double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+            printResult(name + ", p50", totalWorkers, p50, 1);
+            printResult(name + ", p99", totalWorkers, p99, 1);
+        }
+    }
+
+    void runPriorities()
+    {
+        printHeader("high priority latency under a saturating low priority load");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::ProducerSettings strictSettings;
+            strictSettings.totalConsumers = totalWorkers;
+
+            multithreading::ProducerSettings weightedSettings = strictSettings;
+            weightedSettings.lanePolicy = multithreading::LanePolicy::Weighted;
+
+            {
+                multithreading::Producer producer;
+                producer.initialise(strictSettings);
+
+                printLatencies("fifo (one lane)", totalWorkers, measureProbes(producer, Variant::Fifo));
+                printLatencies("strict lanes", totalWorkers, measureProbes(producer, Variant::Lanes));
+                printLatencies("deadlines (one lane)", totalWorkers, measureProbes(producer, Variant::Deadlines));
+            }
+
+            {
+                multithreading::Producer producer;
+                producer.initialise(weightedSettings);
+
+                printLatencies("weighted lanes 8/4/1", totalWorkers, measureProbes(producer, Variant::Lanes));
+            }
+        }
+    }
+
+};
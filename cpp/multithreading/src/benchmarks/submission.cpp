@@ -0,0 +1,141 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/internals/MpmcTaskQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalItems = 200000;
+
+        // the previous Producer::push path: mutex + list node + notify under the lock
+        struct LockedListQueue
+        {
+            std::mutex mutex;
+            std::condition_variable condVar;
+            std::list<multithreading::Task*> tasks;
+
+            void push(multithreading::Task* task)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                tasks.push_back(task);
+                condVar.notify_one();
+            }
+
+            multithreading::Task* tryPop()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (tasks.empty())
+                    return nullptr;
+
+                multithreading::Task* task = tasks.front();
+                tasks.pop_front();
+                return task;
+            }
+        };
+
+        // "totalSubmitters" threads push k_totalItems tasks, one thread drain them
+        template<typename PushCallback, typename PopCallback>
+        void runFanIn(unsigned int totalSubmitters, PushCallback&& push, PopCallback&& tryPop)
+        {
+            std::atomic<bool> started{false};
+            std::vector<std::thread> submitters;
+            submitters.reserve(totalSubmitters);
+
+            const int totalPerSubmitter = k_totalItems / int(totalSubmitters);
+
+            for (unsigned int ii = 0; ii < totalSubmitters; ++ii)
+            {
+                submitters.emplace_back([&started, &push, totalPerSubmitter]()
+                {
+                    while (!started.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+
+                    for (int jj = 0; jj < totalPerSubmitter; ++jj)
+                        push();
+                });
+            }
+
+            started.store(true, std::memory_order_release);
+
+            const int totalToPop = totalPerSubmitter * int(totalSubmitters);
+            for (int totalPopped = 0; totalPopped < totalToPop; )
+            {
+                if (tryPop())
+                    ++totalPopped;
+                else
+                    std::this_thread::yield();
+            }
+
+            for (auto& submitter : submitters)
+                submitter.join();
+        }
+    }
+
+    void runSubmission()
+    {
+        printHeader("submission (fan-in)");
+
+        multithreading::Task dummyTask;
+
+        for (unsigned int totalSubmitters : k_workerCounts)
+        {
+            LockedListQueue lockedQueue;
+            const double lockedDuration = measureBestMicroseconds(5, [&]()
+            {
+                runFanIn(totalSubmitters,
+                    [&]() { lockedQueue.push(&dummyTask); },
+                    [&]() { return lockedQueue.tryPop() != nullptr; });
+            });
+            printResult("mutex + list push", totalSubmitters, lockedDuration, k_totalItems);
+
+            multithreading::MpmcTaskQueue mpmcQueue;
+            const double mpmcDuration = measureBestMicroseconds(5, [&]()
+            {
+                runFanIn(totalSubmitters,
+                    [&]()
+                    {
+                        while (!mpmcQueue.tryPush(&dummyTask))
+                            std::this_thread::yield(); // full
+                    },
+                    [&]() { return mpmcQueue.tryPop() != nullptr; });
+            });
+            printResult("mpmc queue push", totalSubmitters, mpmcDuration, k_totalItems);
+
+            // end to end: external threads pushing empty tasks into 4 consumers
+            multithreading::Producer producer;
+            producer.initialise(4);
+
+            const double producerDuration = measureBestMicroseconds(5, [&]()
+            {
+                std::vector<std::thread> submitters;
+                const int totalPerSubmitter = k_totalItems / int(totalSubmitters);
+
+                for (unsigned int ii = 0; ii < totalSubmitters; ++ii)
+                {
+                    submitters.emplace_back([&producer, totalPerSubmitter]()
+                    {
+                        for (int jj = 0; jj < totalPerSubmitter; ++jj)
+                            producer.push([]() {});
+                    });
+                }
+
+                for (auto& submitter : submitters)
+                    submitter.join();
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("Producer::push (4 consumers)", totalSubmitters, producerDuration, k_totalItems);
+        }
+    }
+
+};
@@ -0,0 +1,131 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskGraph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // physics -> ai -> render prep, uneven chunks
+        constexpr int k_totalPhases = 3;
+        constexpr int k_totalChunks = 16;
+        constexpr int k_baseLoops = 20000;
+        constexpr int k_totalFrames = 50;
+
+        struct FrameStats
+        {
+            double frameMicroseconds = 0.0;
+            double idleRatio = 0.0;
+        };
+
+        std::atomic<int64_t> s_busyNanoseconds{0};
+
+        void runChunk(int phase, int chunk)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            const int totalLoops = k_baseLoops * (1 + (chunk * 7 + phase * 3) % 4);
+            volatile int sink = 0;
+            for (int ii = 0; ii < totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+
+            const auto stop = std::chrono::steady_clock::now();
+            s_busyNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count(), std::memory_order_relaxed);
+        }
+
+        // idle = worker time not spent in a chunk (at most one worker per hardware thread)
+        template<typename FrameCallback>
+        FrameStats measureFrames(unsigned int totalWorkers, FrameCallback&& runFrame)
+        {
+            const unsigned int totalHardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+            const double effectiveWorkers = double(std::min(std::min(totalWorkers, 8u), totalHardwareThreads));
+
+            FrameStats bestStats;
+            for (int run = 0; run < 3; ++run)
+            {
+                s_busyNanoseconds.store(0);
+
+                const auto start = std::chrono::steady_clock::now();
+                for (int frame = 0; frame < k_totalFrames; ++frame)
+                    runFrame();
+                const auto stop = std::chrono::steady_clock::now();
+
+                const double totalMicroseconds = std::chrono::duration<double, std::micro>(stop - start).count();
+                const double busyMicroseconds = double(s_busyNanoseconds.load()) / 1000.0;
+
+                FrameStats stats;
+                stats.frameMicroseconds = totalMicroseconds / k_totalFrames;
+                stats.idleRatio = std::max(0.0, 1.0 - busyMicroseconds / (totalMicroseconds * effectiveWorkers));
+
+                if (run == 0 || stats.frameMicroseconds < bestStats.frameMicroseconds)
+                    bestStats = stats;
+            }
+            return bestStats;
+        }
+
+        std::string makeName(const std::string& name, double idleRatio)
+        {
+            std::stringstream stream;
+            stream << name << " (idle " << int(idleRatio * 100.0 + 0.5) << "%)";
+            return stream.str();
+        }
+    }
+
+    void runTaskGraph()
+    {
+        printHeader("frame pipeline (3 phases x 16 chunks, per frame)");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            // waitUntilAllCompleted() between the phases
+            const FrameStats barrierStats = measureFrames(totalWorkers, [&producer]()
+            {
+                for (int phase = 0; phase < k_totalPhases; ++phase)
+                {
+                    for (int chunk = 0; chunk < k_totalChunks; ++chunk)
+                        producer.push([phase, chunk]() { runChunk(phase, chunk); });
+
+                    producer.waitUntilAllCompleted();
+                }
+            });
+            printResult(makeName("barriers", barrierStats.idleRatio), totalWorkers, barrierStats.frameMicroseconds, 1);
+
+            // ai[i] need physics[i-1..i+1], render[i] need ai[i]
+            multithreading::TaskGraph graph;
+            multithreading::TaskGraph::NodeId nodes[k_totalPhases][k_totalChunks];
+
+            for (int phase = 0; phase < k_totalPhases; ++phase)
+                for (int chunk = 0; chunk < k_totalChunks; ++chunk)
+                    nodes[phase][chunk] = graph.addNode([phase, chunk]() { runChunk(phase, chunk); });
+
+            for (int chunk = 0; chunk < k_totalChunks; ++chunk)
+            {
+                for (int neighbour = std::max(0, chunk - 1); neighbour <= std::min(k_totalChunks - 1, chunk + 1); ++neighbour)
+                    graph.addDependency(nodes[0][neighbour], nodes[1][chunk]);
+
+                graph.addDependency(nodes[1][chunk], nodes[2][chunk]);
+            }
+
+            const FrameStats graphStats = measureFrames(totalWorkers, [&producer, &graph]()
+            {
+                graph.run(producer);
+            });
+            printResult(makeName("task graph", graphStats.idleRatio), totalWorkers, graphStats.frameMicroseconds, 1);
+        }
+    }
+
+};
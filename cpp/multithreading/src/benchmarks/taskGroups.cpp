@@ -0,0 +1,126 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskGroup.hpp"
+
+#include <atomic>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalEmptyTasks = 100000;
+
+        // two subsystems sharing the producer
+        constexpr int k_totalShortTasks = 64;
+        constexpr int k_totalLongTasks = 8;
+        constexpr int k_shortLoops = 1000;
+        constexpr int k_longLoops = 2000000;
+
+        void busyLoop(int totalLoops)
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+        }
+    }
+
+    void runTaskGroups()
+    {
+        printHeader("bulk submission and task groups");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            std::atomic<int> counter{0};
+            auto emptyTask = [&counter]() { counter.fetch_add(1, std::memory_order_relaxed); };
+
+            // one claim + one wake up per task
+            const double oneByOneDuration = measureBestMicroseconds(5, [&producer, &emptyTask]()
+            {
+                for (int ii = 0; ii < k_totalEmptyTasks; ++ii)
+                    producer.push(emptyTask);
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("100k empty tasks, push", totalWorkers, oneByOneDuration, k_totalEmptyTasks);
+
+            // one claim + one wake up per batch
+            const double bulkDuration = measureBestMicroseconds(5, [&producer, &emptyTask]()
+            {
+                producer.pushBulk(k_totalEmptyTasks, [&emptyTask](std::size_t) { return emptyTask; });
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("100k empty tasks, pushBulk", totalWorkers, bulkDuration, k_totalEmptyTasks);
+
+            const double groupDuration = measureBestMicroseconds(5, [&producer, &emptyTask]()
+            {
+                multithreading::TaskGroup group(producer);
+                for (int ii = 0; ii < k_totalEmptyTasks; ++ii)
+                    group.push(emptyTask);
+
+                group.wait();
+            });
+            printResult("100k empty tasks, group push", totalWorkers, groupDuration, k_totalEmptyTasks);
+
+            // the callables already built (the vector fill is not timed)
+            std::vector<std::function<void()>> callables;
+            double groupBulkDuration = -1.0;
+            for (int run = 0; run < 5; ++run)
+            {
+                callables.assign(k_totalEmptyTasks, emptyTask);
+
+                const double duration = measureBestMicroseconds(1, [&producer, &callables]()
+                {
+                    multithreading::TaskGroup group(producer);
+                    group.pushBulk(std::span(callables));
+
+                    group.wait();
+                });
+                if (groupBulkDuration < 0.0 || duration < groupBulkDuration)
+                    groupBulkDuration = duration;
+            }
+            printResult("100k empty tasks, group pushBulk", totalWorkers, groupBulkDuration, k_totalEmptyTasks);
+
+            // subsystem A (short tasks) waits while subsystem B (long tasks) is still running
+            const double barrierDuration = measureBestMicroseconds(3, [&producer]()
+            {
+                for (int ii = 0; ii < k_totalLongTasks; ++ii)
+                    producer.push([]() { busyLoop(k_longLoops); });
+                for (int ii = 0; ii < k_totalShortTasks; ++ii)
+                    producer.push([]() { busyLoop(k_shortLoops); });
+
+                producer.waitUntilAllCompleted(); // A also wait for B
+            });
+            printResult("A waits (waitUntilAllCompleted)", totalWorkers, barrierDuration, k_totalShortTasks);
+
+            // only A's latency is timed, B is drained after
+            multithreading::TaskGroup groupB(producer);
+            const double scopedDuration = measureBestMicroseconds(3, [&producer, &groupB]()
+            {
+                groupB.wait(); // the previous run
+
+                for (int ii = 0; ii < k_totalLongTasks; ++ii)
+                    groupB.push([]() { busyLoop(k_longLoops); });
+
+                multithreading::TaskGroup groupA(producer);
+                for (int ii = 0; ii < k_totalShortTasks; ++ii)
+                    groupA.push([]() { busyLoop(k_shortLoops); });
+
+                groupA.wait(); // B is still running
+            });
+            groupB.wait();
+            printResult("A waits (TaskGroup)", totalWorkers, scopedDuration, k_totalShortTasks);
+        }
+    }
+
+};
@@ -0,0 +1,78 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <atomic>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalRepeat = 200;
+        constexpr int k_totalLoops = 27 * 27 * 27;
+
+        constexpr int k_totalEmptyTasks = 100000;
+
+        constexpr int k_totalParents = 1000;
+        constexpr int k_totalChildren = 100;
+    }
+
+    void runTinyTasks()
+    {
+        printHeader("tiny tasks");
+
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            multithreading::Producer producer;
+            producer.initialise(totalWorkers);
+
+            // same workload as main.cpp: 200 tasks of 27^3 empty loops
+            const double busyLoopDuration = measureBestMicroseconds(5, [&producer]()
+            {
+                for (int ii = 0; ii < k_totalRepeat; ++ii)
+                {
+                    producer.push([]()
+                    {
+                        volatile int sink = 0;
+                        for (int jj = 0; jj < k_totalLoops; ++jj)
+                            sink = jj;
+                        static_cast<void>(sink); // only there to keep the loop
+                    });
+                }
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("200 x 27^3 loop", totalWorkers, busyLoopDuration, k_totalRepeat);
+
+            // scheduling cost only
+            std::atomic<int> counter{0};
+            const double emptyDuration = measureBestMicroseconds(5, [&producer, &counter]()
+            {
+                for (int ii = 0; ii < k_totalEmptyTasks; ++ii)
+                    producer.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("100k empty tasks", totalWorkers, emptyDuration, k_totalEmptyTasks);
+
+            // tasks pushed from inside a task
+            const double nestedDuration = measureBestMicroseconds(5, [&producer, &counter]()
+            {
+                for (int ii = 0; ii < k_totalParents; ++ii)
+                {
+                    producer.push([&producer, &counter]()
+                    {
+                        for (int jj = 0; jj < k_totalChildren; ++jj)
+                            producer.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                    });
+                }
+
+                producer.waitUntilAllCompleted();
+            });
+            printResult("1000 x 100 nested tasks", totalWorkers, nestedDuration, k_totalParents * (k_totalChildren + 1));
+        }
+    }
+
+};
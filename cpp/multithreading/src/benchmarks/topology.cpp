@@ -0,0 +1,128 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+
+#include <iostream>
+#include <string>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        // bigger than a core's share of the last level cache -> memory bound
+        constexpr std::size_t k_bufferSize = 2 * 1024 * 1024; // doubles (16MB)
+        constexpr int k_totalReads = 8;
+        constexpr std::size_t k_tasksPerConsumer = 4;
+
+        const std::vector<std::pair<const char*, multithreading::PinningStrategy>> k_strategies = {
+            { "none", multithreading::PinningStrategy::None },
+            { "compact", multithreading::PinningStrategy::Compact },
+            { "scatter", multithreading::PinningStrategy::Scatter },
+            { "physical cores", multithreading::PinningStrategy::PhysicalCores },
+        };
+
+        double streamBuffer(const std::vector<double>& buffer)
+        {
+            double sum = 0.0;
+            for (int ii = 0; ii < k_totalReads; ++ii)
+                sum += std::accumulate(buffer.begin(), buffer.end(), 0.0);
+            return sum;
+        }
+
+        void printTopology(const multithreading::Topology& topology)
+        {
+            std::cout
+                << "logical cpus: " << topology.totalLogicalCpus()
+                << ", physical cores: " << topology.totalPhysicalCores()
+                << ", packages: " << topology.totalPackages()
+                << ", numa nodes: " << topology.totalNumaNodes()
+                << std::endl;
+        }
+    }
+
+    void runTopology()
+    {
+        printHeader("topology, memory bound tasks (bytes/s)");
+        printTopology(multithreading::Topology::detect());
+
+        const double bytesPerTask = double(k_bufferSize * sizeof(double) * k_totalReads);
+
+        //
+        // each task first touch its buffer then stream it: a consumer moved
+        // to another core (or node) in between lose its cache (or its local memory)
+
+        for (const auto& strategy : k_strategies)
+        {
+            multithreading::ProducerSettings settings;
+            settings.pinning = strategy.second;
+
+            multithreading::Producer producer;
+            producer.initialise(settings);
+
+            const std::size_t totalTasks = producer.totalConsumers() * k_tasksPerConsumer;
+            std::vector<double> results(totalTasks);
+
+            const double duration = measureBestMicroseconds(3, [&]()
+            {
+                for (std::size_t ii = 0; ii < totalTasks; ++ii)
+                {
+                    producer.push([&results, ii]()
+                    {
+                        std::vector<double> buffer(k_bufferSize, 1.0);
+                        results[ii] = streamBuffer(buffer);
+                    });
+                }
+                producer.waitUntilAllCompleted();
+            });
+
+            printResult(std::string("touch + stream, pinning ") + strategy.first, unsigned(producer.totalConsumers()), duration, bytesPerTask * double(totalTasks));
+        }
+
+        //
+        // buffers allocated on each node, then streamed with or without the node hint
+
+        multithreading::ProducerSettings settings;
+        settings.pinning = multithreading::PinningStrategy::Scatter;
+
+        multithreading::Producer producer;
+        producer.initialise(settings);
+
+        const std::size_t totalNodes = producer.totalNumaNodes();
+        const std::size_t totalTasks = producer.totalConsumers() * k_tasksPerConsumer;
+
+        std::vector<std::vector<double>> buffers(totalTasks);
+        std::vector<double> results(totalTasks);
+
+        for (std::size_t ii = 0; ii < totalTasks; ++ii)
+        {
+            producer.pushToNumaNode(unsigned(ii % totalNodes), [&buffers, ii]()
+            {
+                buffers[ii].assign(k_bufferSize, 1.0);
+            });
+        }
+        producer.waitUntilAllCompleted();
+
+        const double durationPush = measureBestMicroseconds(3, [&]()
+        {
+            for (std::size_t ii = 0; ii < totalTasks; ++ii)
+                producer.push([&buffers, &results, ii]() { results[ii] = streamBuffer(buffers[ii]); });
+            producer.waitUntilAllCompleted();
+        });
+
+        const double durationHint = measureBestMicroseconds(3, [&]()
+        {
+            for (std::size_t ii = 0; ii < totalTasks; ++ii)
+                producer.pushToNumaNode(unsigned(ii % totalNodes), [&buffers, &results, ii]() { results[ii] = streamBuffer(buffers[ii]); });
+            producer.waitUntilAllCompleted();
+        });
+
+        printResult("node buffers, push", unsigned(producer.totalConsumers()), durationPush, bytesPerTask * double(totalTasks));
+        printResult("node buffers, pushToNumaNode", unsigned(producer.totalConsumers()), durationHint, bytesPerTask * double(totalTasks));
+    }
+
+};
@@ -0,0 +1,150 @@
+
+#include "benchmarks.hpp"
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/internals/ThreadSynchroniser.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <thread>
+
+namespace benchmarks
+{
+
+    namespace
+    {
+        constexpr int k_totalRoundTrips = 20000;
+        constexpr int k_totalPoolRoundTrips = 2000;
+
+        using multithreading::WaitStrategy;
+
+        struct StrategyName
+        {
+            WaitStrategy strategy;
+            const char* name;
+        };
+
+        const StrategyName k_strategies[] = {
+            { WaitStrategy::Blocking, "blocking" },
+            { WaitStrategy::Spin, "spin" },
+            { WaitStrategy::Hybrid, "hybrid" },
+            { WaitStrategy::Futex, "futex" },
+        };
+
+        // one direction of the ping-pong
+        struct Channel
+        {
+            multithreading::ThreadSynchroniser synchroniser;
+            int64_t value = 0; // locked by the synchroniser
+
+            explicit Channel(WaitStrategy strategy)
+                : synchroniser(strategy)
+            {}
+
+            void send(int64_t inValue)
+            {
+                auto notifier = synchroniser.makeScopedLockNotifier();
+                value = inValue;
+            }
+
+            void receive(int64_t expected)
+            {
+                auto lock = synchroniser.makeScopedLock();
+                synchroniser.waitUntil(lock, [this, expected]() { return value == expected; });
+            }
+        };
+
+        struct Measure
+        {
+            double microseconds = 0.0; // per round trip
+            double cpuRatio = 0.0; // process cpu time / wall time
+        };
+
+        template<typename Callback>
+        Measure measureRoundTrips(int totalRoundTrips, Callback&& callback)
+        {
+            const std::clock_t cpuStart = std::clock();
+            const auto start = std::chrono::steady_clock::now();
+
+            callback();
+
+            const auto stop = std::chrono::steady_clock::now();
+            const std::clock_t cpuStop = std::clock();
+
+            const double wallSeconds = std::chrono::duration<double>(stop - start).count();
+            const double cpuSeconds = double(cpuStop - cpuStart) / CLOCKS_PER_SEC;
+
+            Measure measure;
+            measure.microseconds = wallSeconds * 1000000.0 / totalRoundTrips;
+            measure.cpuRatio = wallSeconds > 0.0 ? cpuSeconds / wallSeconds : 0.0;
+            return measure;
+        }
+
+        std::string makeName(const std::string& name, double cpuRatio)
+        {
+            std::stringstream stream;
+            stream << name << " (cpu " << int(cpuRatio * 100.0 + 0.5) << "%)";
+            return stream.str();
+        }
+    }
+
+    void runWaitStrategies()
+    {
+        printHeader("wait strategies (per round trip)");
+
+        // two threads handing a value back and forth
+        for (const StrategyName& strategy : k_strategies)
+        {
+            Channel ping(strategy.strategy);
+            Channel pong(strategy.strategy);
+
+            const Measure measure = measureRoundTrips(k_totalRoundTrips, [&ping, &pong]()
+            {
+                std::thread echoThread([&ping, &pong]()
+                {
+                    for (int64_t ii = 1; ii <= k_totalRoundTrips; ++ii)
+                    {
+                        ping.receive(ii);
+                        pong.send(ii);
+                    }
+                });
+
+                for (int64_t ii = 1; ii <= k_totalRoundTrips; ++ii)
+                {
+                    ping.send(ii);
+                    pong.receive(ii);
+                }
+
+                echoThread.join();
+            });
+            printResult(makeName(std::string("ping-pong ") + strategy.name, measure.cpuRatio), 2, measure.microseconds, 1);
+        }
+
+        // one empty task then waitUntilAllCompleted(), the strategy set on the pool
+        for (unsigned int totalWorkers : k_workerCounts)
+        {
+            for (const StrategyName& strategy : k_strategies)
+            {
+                multithreading::ProducerSettings settings;
+                settings.totalConsumers = totalWorkers;
+                settings.waitStrategy = strategy.strategy;
+
+                multithreading::Producer producer;
+                producer.initialise(settings);
+
+                const Measure measure = measureRoundTrips(k_totalPoolRoundTrips, [&producer]()
+                {
+                    for (int ii = 0; ii < k_totalPoolRoundTrips; ++ii)
+                    {
+                        producer.push([]() {});
+                        producer.waitUntilAllCompleted();
+                    }
+                });
+                printResult(makeName(std::string("push + wait ") + strategy.name, measure.cpuRatio), totalWorkers, measure.microseconds, 1);
+            }
+        }
+    }
+
+};
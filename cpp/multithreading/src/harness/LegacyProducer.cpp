@@ -0,0 +1,214 @@
+
+#include "LegacyProducer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace harness
+{
+
+    LegacyProducer::Consumer::Consumer(LegacyProducer& producer)
+        : _producer(producer)
+    {
+        _thread = std::thread(&Consumer::_run, this);
+        while (_notified)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    LegacyProducer::Consumer::~Consumer()
+    {
+        quit();
+    }
+
+    void LegacyProducer::Consumer::execute(const std::function<void()>& work)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _work = work;
+
+        _notified = true;
+        _condition.notify_one();
+    }
+
+    void LegacyProducer::Consumer::quit()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done = true;
+            _notified = true;
+            _condition.notify_one();
+        }
+
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    bool LegacyProducer::Consumer::isAvailable() const
+    {
+        return !_notified;
+    }
+
+    void LegacyProducer::Consumer::_run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_done)
+        {
+            _notified = false;
+
+            while (!_notified) // loop to avoid spurious wakeups
+                _condition.wait(lock);
+
+            if (_done)
+                break;
+
+            if (_work)
+                _work();
+
+            _producer._notifyWorkDone(this);
+        }
+    }
+
+    //
+    //
+
+    LegacyProducer::LegacyProducer()
+    {
+        for (unsigned int ii = 0; ii < k_totalConsumers; ++ii)
+            _consumers.push_back(std::make_unique<Consumer>(*this));
+
+        _thread = std::thread(&LegacyProducer::_run, this);
+
+        // the dispatcher is waiting once it reset the flag
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (!_notified)
+                    break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    LegacyProducer::~LegacyProducer()
+    {
+        quit();
+
+        // after the dispatcher: no task is handed to a consumer anymore
+        for (auto& consumer : _consumers)
+            consumer->quit();
+    }
+
+    void LegacyProducer::push(const std::function<void()>& work, const std::function<void()>& oncomplete)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _todoList.push_back(Task{ work, oncomplete, nullptr });
+
+        _notified = true;
+        _condition.notify_one();
+    }
+
+    void LegacyProducer::update()
+    {
+        while (true)
+        {
+            Task* current = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_doneList.empty())
+                    return;
+                current = &_doneList.front();
+            }
+
+            // must not be locked as it might push a task
+            if (current->oncomplete)
+                current->oncomplete();
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _doneList.pop_front();
+            }
+        }
+    }
+
+    void LegacyProducer::quit()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            _todoList.clear();
+            _done = true;
+
+            _notified = true;
+            _condition.notify_one();
+        }
+
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    //
+    //
+
+    void LegacyProducer::_notifyWorkDone(const Consumer* consumer)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // from "doing" to "done"
+        auto it = std::find_if(_doingList.begin(), _doingList.end(), [consumer](const Task& task)
+        {
+            return task.consumer == consumer;
+        });
+
+        if (it != _doingList.end())
+            _doneList.splice(_doneList.end(), _doingList, it);
+
+        // the dispatcher check the tasks again
+        _notified = true;
+        _condition.notify_one();
+    }
+
+    void LegacyProducer::_run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_done)
+        {
+            _notified = false;
+
+            while (!_notified) // loop to avoid spurious wakeups
+            {
+                if (_todoList.empty())
+                {
+                    _condition.wait(lock);
+                    continue;
+                }
+
+                // a consumer is flagged available after its notification: looked at again (the original could stall)
+                if (_condition.wait_for(lock, std::chrono::milliseconds(1)) == std::cv_status::timeout)
+                    break;
+            }
+
+            if (_done)
+                break;
+
+            while (!_todoList.empty())
+            {
+                // any available consumer
+                auto itConsumer = std::find_if(_consumers.begin(), _consumers.end(), [](const std::unique_ptr<Consumer>& consumer)
+                {
+                    return consumer->isAvailable();
+                });
+
+                if (itConsumer == _consumers.end()) // none available
+                    break;
+
+                Task& task = _todoList.front();
+                task.consumer = itConsumer->get();
+                (*itConsumer)->execute(task.work);
+
+                _doingList.splice(_doingList.end(), _todoList, _todoList.begin());
+            }
+        }
+    }
+
+};
@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace harness
+{
+    // frozen copy of the former async/threading/Producer (before it became an adapter), the harness baseline
+    // => one dispatcher thread handing the tasks to 4 consumers, one task per consumer at a time
+    // => locked std::list todo/doing/done, update() run the completions on the owner thread
+    // => fixed in the copy only: its data races (done list read under the lock, atomic availability),
+    //    a dispatcher stall (a consumer flagged available after its notification) and the leaked consumers
+    class LegacyProducer
+    {
+    public:
+        static constexpr unsigned int k_totalConsumers = 4;
+
+    private:
+        class Consumer
+        {
+        private:
+            std::thread _thread;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+
+            bool _done = false;
+            std::atomic<bool> _notified{true}; // true: not available until the thread is running
+
+            std::function<void()> _work;
+            LegacyProducer& _producer;
+
+        public:
+            explicit Consumer(LegacyProducer& producer);
+            ~Consumer();
+
+        public:
+            void execute(const std::function<void()>& work);
+            void quit();
+            bool isAvailable() const;
+
+        private:
+            void _run();
+        };
+
+        struct Task
+        {
+            std::function<void()> work;
+            std::function<void()> oncomplete;
+            const Consumer* consumer = nullptr;
+        };
+
+    private:
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+
+        bool _done = false;
+        bool _notified = true;
+
+        std::list<Task> _todoList;
+        std::list<Task> _doingList;
+        std::list<Task> _doneList;
+
+        std::vector<std::unique_ptr<Consumer>> _consumers;
+
+    public:
+        LegacyProducer();
+        ~LegacyProducer();
+
+    public:
+        void push(const std::function<void()>& work, const std::function<void()>& oncomplete);
+        void update();
+        void quit();
+
+    private:
+        void _notifyWorkDone(const Consumer* consumer);
+        void _run();
+    };
+
+};
@@ -0,0 +1,143 @@
+
+#include "StealingPool.hpp"
+
+#include <algorithm>
+
+namespace harness
+{
+
+    namespace
+    {
+        // the pool and deque of the current worker thread (several pools are alive at once)
+        thread_local const StealingPool* t_pool = nullptr;
+        thread_local std::size_t t_workerIndex = 0;
+    };
+
+    //
+    //
+
+    StealingPool::StealingPool(unsigned int totalThreads)
+    {
+        const std::size_t totalWorkers = std::max(1u, totalThreads);
+
+        for (std::size_t ii = 0; ii < totalWorkers; ++ii)
+            _workers.push_back(std::make_unique<Worker>());
+
+        for (std::size_t ii = 0; ii < totalWorkers; ++ii)
+            _threads.emplace_back(&StealingPool::_run, this, ii);
+    }
+
+    StealingPool::~StealingPool()
+    {
+        waitAll();
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _sleepCondition.notify_all();
+
+        for (std::thread& thread : _threads)
+            thread.join();
+    }
+
+    void StealingPool::waitAll()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this]() { return _totalPending.load() == 0; });
+    }
+
+    //
+    //
+
+    void StealingPool::_push(std::function<void()>&& task)
+    {
+        // a worker push on its own deque
+        const std::size_t workerIndex = t_pool == this ? t_workerIndex : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+
+        // counted first: never below the tasks taken
+        _totalPending.fetch_add(1);
+        _totalQueued.fetch_add(1);
+
+        {
+            Worker& worker = *_workers[workerIndex];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+
+        // seq_cst: either a sleeping worker is seen here, or it see the queued task before sleeping
+        if (_totalSleeping.load() > 0)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+            }
+            _sleepCondition.notify_one();
+        }
+    }
+
+    bool StealingPool::_runOne()
+    {
+        const std::size_t totalWorkers = _workers.size();
+        const bool isWorker = t_pool == this;
+        const std::size_t firstIndex = isWorker ? t_workerIndex : 0;
+
+        std::function<void()> task;
+
+        for (std::size_t ii = 0; ii < totalWorkers && !task; ++ii)
+        {
+            Worker& worker = *_workers[(firstIndex + ii) % totalWorkers];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            if (worker.tasks.empty())
+                continue;
+
+            // own deque: the latest (still in cache), an other one: the oldest
+            if (isWorker && ii == 0)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+        }
+
+        if (!task)
+            return false;
+
+        _totalQueued.fetch_sub(1);
+        task();
+
+        if (_totalPending.fetch_sub(1) == 1)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+            }
+            _doneCondition.notify_all();
+        }
+
+        return true;
+    }
+
+    void StealingPool::_run(std::size_t workerIndex)
+    {
+        t_pool = this;
+        t_workerIndex = workerIndex;
+
+        while (true)
+        {
+            if (_runOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _totalSleeping.fetch_add(1);
+            _sleepCondition.wait(lock, [this]() { return _done || _totalQueued.load() > 0; });
+            _totalSleeping.fetch_sub(1);
+
+            if (_done)
+                break;
+        }
+    }
+
+};
@@ -0,0 +1,89 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace harness
+{
+    // small reference work stealing pool, runs without TBB
+    // => one locked deque per worker: the owner push/pop at the back, the thieves steal at the front
+    // => submit() from outside a worker: the deques in turn
+    // => invokeBoth(): the waiting worker run the queued tasks meanwhile
+    class StealingPool
+    {
+    public:
+        static constexpr const char* k_name = "reference work stealing";
+        static constexpr bool k_hasThreadCount = true;
+        static constexpr bool k_supportsNesting = true;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+    private:
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::vector<std::thread> _threads;
+
+        std::mutex _mutex;
+        std::condition_variable _sleepCondition;
+        std::condition_variable _doneCondition;
+        bool _done = false;
+
+        std::atomic<std::size_t> _totalQueued{0};
+        std::atomic<std::size_t> _totalPending{0};
+        std::atomic<std::size_t> _totalSleeping{0};
+        std::atomic<std::size_t> _nextWorker{0};
+
+    public:
+        explicit StealingPool(unsigned int totalThreads);
+        ~StealingPool();
+
+        // disable copy
+        StealingPool(const StealingPool& other) = delete;
+        StealingPool& operator=(const StealingPool& other) = delete;
+        // disable copy
+
+    public:
+        template<typename Callable>
+        void submit(Callable&& callable)
+        {
+            _push(std::function<void()>(std::forward<Callable>(callable)));
+        }
+
+        void waitAll();
+
+        template<typename CallableA, typename CallableB>
+        void invokeBoth(CallableA&& callableA, CallableB&& callableB)
+        {
+            std::atomic<bool> isDone{false};
+            _push([&callableA, &isDone]()
+            {
+                callableA();
+                isDone.store(true, std::memory_order_release);
+            });
+
+            callableB();
+
+            while (!isDone.load(std::memory_order_acquire))
+                if (!_runOne())
+                    std::this_thread::yield();
+        }
+
+    private:
+        void _push(std::function<void()>&& task);
+        bool _runOne();
+        void _run(std::size_t workerIndex);
+    };
+
+};
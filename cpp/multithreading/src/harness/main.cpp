@@ -0,0 +1,144 @@
+
+#include "pools.hpp"
+#include "report.hpp"
+#include "scenarios.hpp"
+
+#include <algorithm>
+#include <cstdlib> // EXIT_SUCCESS, EXIT_FAILURE
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    void printUsage(const char* programName)
+    {
+        std::cerr
+            << "usage: " << programName << " [--threads N] [--csv path] [--json path]" << std::endl
+            << "  --threads N   largest thread count (1, 2, 4, ... up to N), default: hardware threads" << std::endl
+            << "  --csv path    write the results as CSV" << std::endl
+            << "  --json path   write the results as JSON" << std::endl;
+    }
+
+    template<typename Pool>
+    using Pools = std::vector<std::pair<unsigned int, std::unique_ptr<Pool>>>;
+
+    template<typename Pool>
+    Pools<Pool> makePools(const std::vector<unsigned int>& threadCounts)
+    {
+        Pools<Pool> pools;
+        for (unsigned int totalThreads : threadCounts)
+            pools.emplace_back(totalThreads, std::make_unique<Pool>(totalThreads));
+        return pools;
+    }
+
+    template<typename Callable>
+    bool writeFile(const std::string& path, Callable&& callable)
+    {
+        std::ofstream stream(path);
+        if (!stream)
+        {
+            std::cerr << "cannot write: " << path << std::endl;
+            return false;
+        }
+
+        callable(stream);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string csvPath;
+    std::string jsonPath;
+
+    for (int ii = 1; ii < argc; ++ii)
+    {
+        const std::string argument = argv[ii];
+
+        if (ii + 1 >= argc)
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        const std::string value = argv[++ii];
+
+        if (argument == "--threads")
+        {
+            const int totalThreads = std::atoi(value.c_str());
+            if (totalThreads <= 0)
+            {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            maxThreads = unsigned(totalThreads);
+        }
+        else if (argument == "--csv")
+        {
+            csvPath = value;
+        }
+        else if (argument == "--json")
+        {
+            jsonPath = value;
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int totalThreads = 1; totalThreads < maxThreads; totalThreads *= 2)
+        threadCounts.push_back(totalThreads);
+    threadCounts.push_back(maxThreads);
+
+    const harness::Baselines baselines = harness::measureBaselines();
+
+    // all alive for the whole run
+    Pools<harness::ProducerPool> producerPools = makePools<harness::ProducerPool>(threadCounts);
+    Pools<harness::StealingPool> stealingPools = makePools<harness::StealingPool>(threadCounts);
+#if defined(D_BENCHMARK_WITH_TBB)
+    const tbb::global_control tbbControl = harness::TbbPool::allowTbbWorkers(maxThreads);
+    Pools<harness::TbbPool> tbbPools = makePools<harness::TbbPool>(threadCounts);
+#endif
+    harness::LegacyPool legacyPool(harness::LegacyPool::k_totalThreads);
+    harness::StdAsyncPool stdAsyncPool(harness::StdAsyncPool::k_totalThreads);
+
+    harness::Report report(std::cout);
+
+    // one benchmark at a time, over every pool
+    const auto runOverPools = [&](auto&& scenario)
+    {
+        for (auto& [totalThreads, pool] : producerPools)
+            scenario(*pool, totalThreads);
+        for (auto& [totalThreads, pool] : stealingPools)
+            scenario(*pool, totalThreads);
+#if defined(D_BENCHMARK_WITH_TBB)
+        for (auto& [totalThreads, pool] : tbbPools)
+            scenario(*pool, totalThreads);
+#endif
+        scenario(legacyPool, harness::LegacyPool::k_totalThreads);
+        scenario(stdAsyncPool, harness::StdAsyncPool::k_totalThreads);
+    };
+
+    runOverPools([&report](auto& pool, unsigned int totalThreads) { harness::runEmptyTasks(pool, totalThreads, report); });
+    runOverPools([&report](auto& pool, unsigned int totalThreads) { harness::runLatency(pool, totalThreads, report); });
+    runOverPools([&baselines, &report](auto& pool, unsigned int totalThreads) { harness::runForkJoin(pool, totalThreads, baselines, report); });
+    runOverPools([&baselines, &report](auto& pool, unsigned int totalThreads) { harness::runNested(pool, totalThreads, baselines, report); });
+    runOverPools([&baselines, &report](auto& pool, unsigned int totalThreads) { harness::runImbalanced(pool, totalThreads, baselines, report); });
+
+    if (!csvPath.empty() && !writeFile(csvPath, [&report](std::ostream& stream) { report.writeCsv(stream); }))
+        return EXIT_FAILURE;
+
+    if (!jsonPath.empty() && !writeFile(jsonPath, [&report](std::ostream& stream) { report.writeJson(stream); }))
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
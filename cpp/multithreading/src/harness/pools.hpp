@@ -0,0 +1,201 @@
+
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskGroup.hpp"
+
+#include "LegacyProducer.hpp"
+#include "StealingPool.hpp"
+
+#include <functional>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(D_BENCHMARK_WITH_TBB)
+#include <tbb/global_control.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
+//
+// the same operations over every compared pool
+// => submit(callable): fire and forget, from the owner thread (or from a task with k_supportsNesting)
+// => waitAll(): until all the submitted tasks are done, owner thread only
+// => invokeBoth(a, b): run both in parallel and wait, from inside a task (k_supportsNesting only)
+//
+
+namespace harness
+{
+    class ProducerPool
+    {
+    public:
+        static constexpr const char* k_name = "multithreading::Producer";
+        static constexpr bool k_hasThreadCount = true;
+        static constexpr bool k_supportsNesting = true;
+
+    private:
+        multithreading::Producer _producer;
+
+    public:
+        explicit ProducerPool(unsigned int totalThreads)
+        {
+            _producer.initialise(totalThreads);
+        }
+
+    public:
+        template<typename Callable>
+        void submit(Callable&& callable)
+        {
+            _producer.push(std::forward<Callable>(callable));
+        }
+
+        void waitAll()
+        {
+            _producer.waitUntilAllCompleted();
+        }
+
+        // the waiting task run queued tasks meanwhile
+        template<typename CallableA, typename CallableB>
+        void invokeBoth(CallableA&& callableA, CallableB&& callableB)
+        {
+            multithreading::TaskGroup group(_producer);
+            group.push(std::forward<CallableA>(callableA));
+            callableB();
+            group.wait();
+        }
+    };
+
+    // the former async/threading/Producer (frozen copy, see LegacyProducer.hpp), 4 consumers (fixed)
+    // => done on the owner thread: the completions are counted by update()
+    // => a task blocking on an other one may deadlock the 4 consumers: no nesting
+    class LegacyPool
+    {
+    public:
+        static constexpr const char* k_name = "async/threading (legacy)";
+        static constexpr bool k_hasThreadCount = false;
+        static constexpr bool k_supportsNesting = false;
+        static constexpr unsigned int k_totalThreads = LegacyProducer::k_totalConsumers;
+
+    private:
+        LegacyProducer _producer;
+        int _totalPending = 0; // owner thread only
+
+    public:
+        explicit LegacyPool(unsigned int)
+        {}
+
+    public:
+        template<typename Callable>
+        void submit(Callable&& callable)
+        {
+            ++_totalPending;
+            _producer.push(std::forward<Callable>(callable), [this]() { --_totalPending; });
+        }
+
+        void waitAll()
+        {
+            while (_totalPending > 0)
+            {
+                _producer.update();
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    // one thread per task (std::launch::async)
+    class StdAsyncPool
+    {
+    public:
+        static constexpr const char* k_name = "std::async";
+        static constexpr bool k_hasThreadCount = false;
+        static constexpr bool k_supportsNesting = true;
+        static constexpr unsigned int k_totalThreads = 0;
+
+    private:
+        std::vector<std::future<void>> _futures; // owner thread only
+
+    public:
+        explicit StdAsyncPool(unsigned int)
+        {}
+
+    public:
+        template<typename Callable>
+        void submit(Callable&& callable)
+        {
+            _futures.push_back(std::async(std::launch::async, std::forward<Callable>(callable)));
+        }
+
+        void waitAll()
+        {
+            for (std::future<void>& future : _futures)
+                future.get();
+            _futures.clear();
+        }
+
+        template<typename CallableA, typename CallableB>
+        void invokeBoth(CallableA&& callableA, CallableB&& callableB)
+        {
+            std::future<void> future = std::async(std::launch::async, std::forward<CallableA>(callableA));
+            callableB();
+            future.get();
+        }
+    };
+
+#if defined(D_BENCHMARK_WITH_TBB)
+
+    // reference work stealing scheduler (oneTBB), one arena of the thread count
+    // => no slot reserved for the owner thread: the tasks start without waiting for waitAll()
+    // => TBB default to hardware threads - 1 workers: see allowTbbWorkers()
+    class TbbPool
+    {
+    public:
+        static constexpr const char* k_name = "oneTBB task_group";
+        static constexpr bool k_hasThreadCount = true;
+        static constexpr bool k_supportsNesting = true;
+
+    private:
+        tbb::task_arena _arena;
+        tbb::task_group _group;
+
+    public:
+        explicit TbbPool(unsigned int totalThreads)
+            : _arena(int(totalThreads), 0)
+        {}
+
+        ~TbbPool()
+        {
+            waitAll();
+        }
+
+    public:
+        template<typename Callable>
+        void submit(Callable&& callable)
+        {
+            _arena.execute([this, &callable]() { _group.run(std::forward<Callable>(callable)); });
+        }
+
+        void waitAll()
+        {
+            _arena.execute([this]() { _group.wait(); });
+        }
+
+        template<typename CallableA, typename CallableB>
+        void invokeBoth(CallableA&& callableA, CallableB&& callableB)
+        {
+            tbb::parallel_invoke(std::forward<CallableA>(callableA), std::forward<CallableB>(callableB));
+        }
+
+    public:
+        // alive for as long as the pools: the same thread counts as the other pools
+        static tbb::global_control allowTbbWorkers(unsigned int maxThreads)
+        {
+            return tbb::global_control(tbb::global_control::max_allowed_parallelism, maxThreads + 1);
+        }
+    };
+
+#endif
+
+};
@@ -0,0 +1,118 @@
+
+#include "report.hpp"
+
+#include <iomanip>
+
+namespace harness
+{
+
+    namespace
+    {
+        // the names are ours: only quotes and backslashes to escape
+        std::string escapeJson(const std::string& text)
+        {
+            std::string escaped;
+            for (char character : text)
+            {
+                if (character == '"' || character == '\\')
+                    escaped.push_back('\\');
+                escaped.push_back(character);
+            }
+            return escaped;
+        }
+
+        std::string quoteCsv(const std::string& text)
+        {
+            if (text.find_first_of(",\"") == std::string::npos)
+                return text;
+
+            std::string quoted = "\"";
+            for (char character : text)
+            {
+                if (character == '"')
+                    quoted.push_back('"');
+                quoted.push_back(character);
+            }
+            quoted.push_back('"');
+            return quoted;
+        }
+    };
+
+    //
+    //
+
+    Report::Report(std::ostream& console)
+        : _console(console)
+    {}
+
+    void Report::add(const std::string& benchmark, const std::string& pool, unsigned int totalThreads, const std::string& metric, double value, const std::string& unit)
+    {
+        if (benchmark != _lastBenchmark)
+        {
+            _console << std::endl;
+            _console << "### " << benchmark << std::endl;
+            _console
+                << std::left << std::setw(28) << "pool"
+                << std::right << std::setw(8) << "threads"
+                << "  " << std::left << std::setw(16) << "metric"
+                << std::right << std::setw(16) << "value"
+                << "  " << "unit"
+                << std::endl;
+
+            _lastBenchmark = benchmark;
+        }
+
+        _console
+            << std::left << std::setw(28) << pool
+            << std::right << std::setw(8) << totalThreads
+            << "  " << std::left << std::setw(16) << metric
+            << std::right << std::setw(16) << std::fixed << std::setprecision(2) << value
+            << "  " << unit
+            << std::endl;
+
+        _records.push_back(Record{ benchmark, pool, totalThreads, metric, value, unit });
+    }
+
+    //
+    //
+
+    void Report::writeCsv(std::ostream& stream) const
+    {
+        stream << "benchmark,pool,threads,metric,value,unit" << std::endl;
+
+        for (const Record& record : _records)
+        {
+            stream
+                << quoteCsv(record.benchmark) << ","
+                << quoteCsv(record.pool) << ","
+                << record.totalThreads << ","
+                << quoteCsv(record.metric) << ","
+                << std::setprecision(6) << std::defaultfloat << record.value << ","
+                << quoteCsv(record.unit)
+                << std::endl;
+        }
+    }
+
+    void Report::writeJson(std::ostream& stream) const
+    {
+        stream << "[" << std::endl;
+
+        for (std::size_t ii = 0; ii < _records.size(); ++ii)
+        {
+            const Record& record = _records[ii];
+
+            stream
+                << "  { \"benchmark\": \"" << escapeJson(record.benchmark)
+                << "\", \"pool\": \"" << escapeJson(record.pool)
+                << "\", \"threads\": " << record.totalThreads
+                << ", \"metric\": \"" << escapeJson(record.metric)
+                << "\", \"value\": " << std::setprecision(6) << std::defaultfloat << record.value
+                << ", \"unit\": \"" << escapeJson(record.unit)
+                << "\" }" << (ii + 1 < _records.size() ? "," : "")
+                << std::endl;
+        }
+
+        stream << "]" << std::endl;
+    }
+
+};
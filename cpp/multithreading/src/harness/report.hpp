@@ -0,0 +1,43 @@
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace harness
+{
+    // one measured value
+    struct Record
+    {
+    public:
+        std::string benchmark;
+        std::string pool;
+        unsigned int totalThreads = 0; // 0: one thread per task (std::async)
+        std::string metric;
+        double value = 0.0;
+        std::string unit;
+    };
+
+    // the records are printed as they come, then written as CSV and/or JSON
+    class Report
+    {
+    private:
+        std::ostream& _console;
+        std::vector<Record> _records;
+        std::string _lastBenchmark;
+
+    public:
+        explicit Report(std::ostream& console);
+
+    public:
+        void add(const std::string& benchmark, const std::string& pool, unsigned int totalThreads, const std::string& metric, double value, const std::string& unit);
+
+    public:
+        // benchmark,pool,threads,metric,value,unit
+        void writeCsv(std::ostream& stream) const;
+        // [ { "benchmark": ..., "pool": ..., "threads": ..., "metric": ..., "value": ..., "unit": ... }, ... ]
+        void writeJson(std::ostream& stream) const;
+    };
+
+};
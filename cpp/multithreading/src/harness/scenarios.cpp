@@ -0,0 +1,16 @@
+
+#include "scenarios.hpp"
+
+namespace harness
+{
+    namespace detail
+    {
+        void busyLoop(int totalLoops)
+        {
+            volatile int sink = 0;
+            for (int ii = 0; ii < totalLoops; ++ii)
+                sink = ii;
+            static_cast<void>(sink); // only there to keep the loop
+        }
+    };
+};
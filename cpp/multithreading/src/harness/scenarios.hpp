@@ -0,0 +1,248 @@
+
+#pragma once
+
+#include "report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//
+// the measured workloads, one function per benchmark, any pool of pools.hpp
+// => "threads" is the pool's thread count as reported (0: one thread per task)
+// => the overheads compare to the same work run on one thread (Baselines), split over the usable threads
+//
+
+namespace harness
+{
+    namespace detail
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr int k_totalRuns = 3;
+
+        constexpr int k_totalEmptyTasks = 20000;
+
+        constexpr int k_totalProbes = 1000;
+        constexpr auto k_probeInterval = std::chrono::microseconds(100);
+
+        constexpr int k_totalRounds = 500;
+        constexpr int k_tasksPerRound = 16;
+        constexpr int k_roundTaskLoops = 2000;
+
+        constexpr int k_nestedDepth = 10; // 1024 leaves, 1023 forks
+        constexpr int k_leafLoops = 2000;
+
+        constexpr int k_totalImbalancedTasks = 1000;
+        constexpr int k_lightLoops = 2000;
+        constexpr int k_heavyFactor = 50; // one task in 10
+
+        // out of line: the baselines and the tasks run the same code
+        void busyLoop(int totalLoops);
+
+        inline int getImbalancedLoops(int taskIndex)
+        {
+            return taskIndex % 10 == 0 ? k_lightLoops * k_heavyFactor : k_lightLoops;
+        }
+
+        // best of k_totalRuns (microseconds)
+        template<typename Callback>
+        double measureBestMicroseconds(Callback&& callback)
+        {
+            double bestDuration = -1.0;
+            for (int run = 0; run < k_totalRuns; ++run)
+            {
+                const Clock::time_point start = Clock::now();
+                callback();
+                const double duration = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+                if (bestDuration < 0.0 || duration < bestDuration)
+                    bestDuration = duration;
+            }
+            return bestDuration;
+        }
+
+        // threads that can run at once: no more than the hardware ones (0: one per task)
+        inline double getUsableThreads(unsigned int totalThreads)
+        {
+            const unsigned int totalHardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+            return double(totalThreads == 0 ? totalHardwareThreads : std::min(totalThreads, totalHardwareThreads));
+        }
+
+        template<typename Pool>
+        void runNode(Pool& pool, int depth)
+        {
+            if (depth == 0)
+            {
+                busyLoop(k_leafLoops);
+                return;
+            }
+
+            pool.invokeBoth(
+                [&pool, depth]() { runNode(pool, depth - 1); },
+                [&pool, depth]() { runNode(pool, depth - 1); });
+        }
+
+        template<typename Pool>
+        const char* getName()
+        {
+            return std::decay_t<Pool>::k_name;
+        }
+    };
+
+    // the workloads run on the calling thread, measured before any pool exist (no spinning worker around)
+    struct Baselines
+    {
+    public:
+        double forkJoinRound = 0.0; // us
+        double nestedLeaves = 0.0; // us
+        double imbalancedTasks = 0.0; // us
+    };
+
+    inline Baselines measureBaselines()
+    {
+        Baselines baselines;
+
+        baselines.forkJoinRound = detail::measureBestMicroseconds([]()
+        {
+            for (int ii = 0; ii < detail::k_tasksPerRound; ++ii)
+                detail::busyLoop(detail::k_roundTaskLoops);
+        });
+
+        baselines.nestedLeaves = detail::measureBestMicroseconds([]()
+        {
+            for (int ii = 0; ii < (1 << detail::k_nestedDepth); ++ii)
+                detail::busyLoop(detail::k_leafLoops);
+        });
+
+        baselines.imbalancedTasks = detail::measureBestMicroseconds([]()
+        {
+            for (int ii = 0; ii < detail::k_totalImbalancedTasks; ++ii)
+                detail::busyLoop(detail::getImbalancedLoops(ii));
+        });
+
+        return baselines;
+    }
+
+    //
+    //
+
+    // scheduling cost only
+    template<typename Pool>
+    void runEmptyTasks(Pool& pool, unsigned int totalThreads, Report& report)
+    {
+        const double duration = detail::measureBestMicroseconds([&pool]()
+        {
+            for (int ii = 0; ii < detail::k_totalEmptyTasks; ++ii)
+                pool.submit([]() {});
+
+            pool.waitAll();
+        });
+
+        report.add("empty tasks (20k)", detail::getName<Pool>(), totalThreads, "time", duration, "us");
+        report.add("empty tasks (20k)", detail::getName<Pool>(), totalThreads, "throughput", detail::k_totalEmptyTasks / (duration / 1e6), "tasks/s");
+    }
+
+    // spaced submits: no queueing, the wake up path
+    template<typename Pool>
+    void runLatency(Pool& pool, unsigned int totalThreads, Report& report)
+    {
+        std::vector<double> latencies(detail::k_totalProbes, 0.0);
+
+        detail::Clock::time_point nextProbe = detail::Clock::now();
+        for (int ii = 0; ii < detail::k_totalProbes; ++ii)
+        {
+            std::this_thread::sleep_until(nextProbe);
+            nextProbe += detail::k_probeInterval;
+
+            const detail::Clock::time_point submitTime = detail::Clock::now();
+            pool.submit([&latencies, ii, submitTime]()
+            {
+                latencies[ii] = std::chrono::duration<double, std::micro>(detail::Clock::now() - submitTime).count();
+            });
+        }
+
+        pool.waitAll();
+
+        std::sort(latencies.begin(), latencies.end());
+
+        const auto getPercentile = [&latencies](double percentile)
+        {
+            return latencies[std::min(latencies.size() - 1, std::size_t(double(latencies.size()) * percentile / 100.0))];
+        };
+
+        report.add("submit to start latency", detail::getName<Pool>(), totalThreads, "p50", getPercentile(50.0), "us");
+        report.add("submit to start latency", detail::getName<Pool>(), totalThreads, "p90", getPercentile(90.0), "us");
+        report.add("submit to start latency", detail::getName<Pool>(), totalThreads, "p99", getPercentile(99.0), "us");
+        report.add("submit to start latency", detail::getName<Pool>(), totalThreads, "max", latencies.back(), "us");
+    }
+
+    // rounds of 16 small tasks and a join
+    template<typename Pool>
+    void runForkJoin(Pool& pool, unsigned int totalThreads, const Baselines& baselines, Report& report)
+    {
+        const double duration = detail::measureBestMicroseconds([&pool]()
+        {
+            for (int round = 0; round < detail::k_totalRounds; ++round)
+            {
+                for (int ii = 0; ii < detail::k_tasksPerRound; ++ii)
+                    pool.submit([]() { detail::busyLoop(detail::k_roundTaskLoops); });
+
+                pool.waitAll();
+            }
+        });
+
+        const double roundDuration = duration / detail::k_totalRounds;
+        const double idealDuration = baselines.forkJoinRound / detail::getUsableThreads(totalThreads);
+
+        report.add("fork-join (16 tasks)", detail::getName<Pool>(), totalThreads, "round", roundDuration, "us");
+        report.add("fork-join (16 tasks)", detail::getName<Pool>(), totalThreads, "overhead", roundDuration - idealDuration, "us");
+    }
+
+    // binary tree of forks, each inner task wait for its two children
+    template<typename Pool>
+    void runNested(Pool& pool, unsigned int totalThreads, const Baselines& baselines, Report& report)
+    {
+        if constexpr (!std::decay_t<Pool>::k_supportsNesting)
+        {
+            static_cast<void>(pool); // unused
+            static_cast<void>(totalThreads); // unused
+            static_cast<void>(baselines); // unused
+            static_cast<void>(report); // unused
+        }
+        else
+        {
+            const double duration = detail::measureBestMicroseconds([&pool]()
+            {
+                pool.submit([&pool]() { detail::runNode(pool, detail::k_nestedDepth); });
+                pool.waitAll();
+            });
+
+            const double idealDuration = baselines.nestedLeaves / detail::getUsableThreads(totalThreads);
+
+            report.add("nested fork-join (depth 10)", detail::getName<Pool>(), totalThreads, "time", duration, "us");
+            report.add("nested fork-join (depth 10)", detail::getName<Pool>(), totalThreads, "overhead", (duration - idealDuration) / ((1 << detail::k_nestedDepth) - 1), "us/fork");
+        }
+    }
+
+    // one task in 10 is 50 times longer
+    template<typename Pool>
+    void runImbalanced(Pool& pool, unsigned int totalThreads, const Baselines& baselines, Report& report)
+    {
+        const double duration = detail::measureBestMicroseconds([&pool]()
+        {
+            for (int ii = 0; ii < detail::k_totalImbalancedTasks; ++ii)
+                pool.submit([ii]() { detail::busyLoop(detail::getImbalancedLoops(ii)); });
+
+            pool.waitAll();
+        });
+
+        const double idealDuration = baselines.imbalancedTasks / detail::getUsableThreads(totalThreads);
+
+        report.add("imbalanced tasks (1000)", detail::getName<Pool>(), totalThreads, "time", duration, "us");
+        report.add("imbalanced tasks (1000)", detail::getName<Pool>(), totalThreads, "efficiency", 100.0 * idealDuration / duration, "%");
+    }
+
+};
@@ -1,44 +1,34 @@
 
 #include "multithreading/Producer.hpp"
 
-#include "utilities/TraceLogger.hpp"
+#include "utilities/AsyncLogger.hpp"
 
 #include <cstdlib> // EXIT_SUCCESS
 #include <iostream>
-#include <mutex>
 
 int main()
 {
-    D_MYLOG("start");
+    D_ASYNC_LOG("start");
 
     {
-        std::mutex loggerMutex;
-
         multithreading::Producer producer;
 
         producer.initialise(3);
 
         for (int ii = 0; ii < 20; ++ii)
         {
-            producer.push([ii, &loggerMutex]()
+            producer.push([ii]()
             {
-                // thread safe logging
-                std::unique_lock<std::mutex> lock(loggerMutex);
-
-                D_MYLOG("task " << ii);
+                // thread safe logging, the consumers do not wait on each other
+                D_ASYNC_LOG("task {}", ii);
             });
         }
 
-        {
-            // thread safe logging
-            std::unique_lock<std::mutex> lock(loggerMutex);
-
-            D_MYLOG("main waiting");
-        }
+        D_ASYNC_LOG("main waiting");
 
         producer.waitUntilAllCompleted();
 
-        D_MYLOG("main done");
+        D_ASYNC_LOG("main done");
     }
 
     { // test
@@ -52,10 +42,12 @@ int main()
         {
             auto start = std::chrono::steady_clock::now();
             {
-                for (volatile int ii = 0; ii < totalRepeat; ++ii)
+                for (int ii = 0; ii < totalRepeat; ++ii)
                 {
-                    for (volatile int jj = 0; jj < totalTasks; ++jj)
-                        ;
+                    volatile int sink = 0;
+                    for (int jj = 0; jj < totalTasks; ++jj)
+                        sink = jj;
+                    static_cast<void>(sink); // only there to keep the loop
                     // producer.push([ii]()
                     // {
                     // });
@@ -66,18 +58,20 @@ int main()
             auto stop = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
 
-            D_MYLOG("duration=" << duration << "ms");
+            D_ASYNC_LOG("duration={}us", duration);
         }
 
         {
             auto start = std::chrono::steady_clock::now();
             {
-                for (volatile int ii = 0; ii < totalRepeat; ++ii)
+                for (int ii = 0; ii < totalRepeat; ++ii)
                 {
                     producer.push([]()
                     {
-                        for (volatile int jj = 0; jj < totalTasks; ++jj)
-                            ;
+                        volatile int sink = 0;
+                        for (int jj = 0; jj < totalTasks; ++jj)
+                            sink = jj;
+                        static_cast<void>(sink); // only there to keep the loop
                     });
                 }
 
@@ -86,12 +80,12 @@ int main()
             auto stop = std::chrono::steady_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
 
-            D_MYLOG("duration=" << duration << "ms");
+            D_ASYNC_LOG("duration={}us", duration);
         }
 
     } // test
 
-    D_MYLOG("stop");
+    D_ASYNC_LOG("stop");
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,70 @@
+
+#pragma once
+
+#include <chrono>
+#include <stop_token>
+
+namespace multithreading
+{
+    // cancellation of a pushed task: a std::stop_token and/or a deadline (stop requested once past)
+    // => still queued when cancelled: dropped when dequeued, without running (no scan of the queues)
+    // => already running: the task poll stop_requested() (a callable taking a CancellationToken receive it)
+    // => same stop_requested()/stop_possible() as std::stop_token, built from one implicitly
+    class CancellationToken
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        std::stop_token _stopToken;
+        Clock::time_point _deadline = Clock::time_point::max();
+
+    public:
+        CancellationToken() = default; // never cancelled
+
+        CancellationToken(std::stop_token stopToken)
+            : _stopToken(std::move(stopToken))
+        {}
+
+        CancellationToken(std::stop_token stopToken, Clock::time_point deadline)
+            : _stopToken(std::move(stopToken))
+            , _deadline(deadline)
+        {}
+
+        static CancellationToken withDeadline(Clock::time_point deadline)
+        {
+            return CancellationToken(std::stop_token(), deadline);
+        }
+
+        static CancellationToken withTimeout(Clock::duration timeout)
+        {
+            return CancellationToken(std::stop_token(), Clock::now() + timeout);
+        }
+
+    public:
+        // a clock read only with a deadline
+        bool stop_requested() const noexcept
+        {
+            if (_stopToken.stop_requested())
+                return true;
+
+            return _deadline != Clock::time_point::max() && Clock::now() >= _deadline;
+        }
+
+        bool stop_possible() const noexcept
+        {
+            return _stopToken.stop_possible() || _deadline != Clock::time_point::max();
+        }
+
+        const std::stop_token& getStopToken() const
+        {
+            return _stopToken;
+        }
+
+        Clock::time_point getDeadline() const
+        {
+            return _deadline;
+        }
+    };
+
+};
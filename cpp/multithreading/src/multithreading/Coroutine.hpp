@@ -0,0 +1,513 @@
+
+#pragma once
+
+#include "Producer.hpp"
+
+#include "internals/CoroutineFrameAllocator.hpp"
+#include "internals/ThreadSynchroniser.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// C++20 coroutines over a Producer
+// => CoroutineTask<R>: lazy, started when awaited (or by syncWait()), move only
+// => co_await producer.schedule(): continue on one of the producer's consumers
+// => co_await future (TaskFuture): no consumer blocked while the task run
+// => co_await whenAll(tasks): join, the tasks run concurrently once they schedule themselves
+// => symmetric transfer: a chain of awaited coroutines do not grow the stack
+//    (a tail call only with optimisations: gcc -O0 grow the stack on long synchronous chains)
+// => the frames come from the CoroutineFrameAllocator (no malloc in steady state)
+//
+
+namespace multithreading
+{
+    template<typename Result>
+    class CoroutineTask;
+
+    namespace detail
+    {
+        // pooled frames for every coroutine type of this file
+        struct PooledCoroutineFrame
+        {
+            static void* operator new(std::size_t size)
+            {
+                return CoroutineFrameAllocator::allocate(size);
+            }
+
+            static void operator delete(void* frame, std::size_t size)
+            {
+                CoroutineFrameAllocator::deallocate(frame, size);
+            }
+        };
+
+        template<typename Promise>
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            // symmetric transfer to the awaiting coroutine (tail call, no stack growth)
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                if (std::coroutine_handle<> continuation = handle.promise().continuation)
+                    return continuation;
+
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+
+        struct CoroutinePromiseBase
+            : public PooledCoroutineFrame
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr exception;
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+        };
+
+        template<typename Result>
+        struct CoroutinePromise
+            : public CoroutinePromiseBase
+        {
+            std::optional<Result> value;
+
+            CoroutineTask<Result> get_return_object() noexcept;
+
+            FinalAwaiter<CoroutinePromise> final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            template<typename Value>
+            void return_value(Value&& inValue)
+            {
+                value.emplace(std::forward<Value>(inValue));
+            }
+
+            Result takeResult()
+            {
+                if (exception)
+                    std::rethrow_exception(exception);
+
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct CoroutinePromise<void>
+            : public CoroutinePromiseBase
+        {
+            CoroutineTask<void> get_return_object() noexcept;
+
+            FinalAwaiter<CoroutinePromise> final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            {}
+
+            void takeResult()
+            {
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+        };
+    };
+
+    //
+    //
+
+    // the coroutine frame is owned (destroyed with the task)
+    template<typename Result>
+    class CoroutineTask
+    {
+    public:
+        using promise_type = detail::CoroutinePromise<Result>;
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+
+    private:
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept
+            {
+                return handle.done();
+            }
+
+            // start the task, it come back to the awaiting coroutine on its final suspend
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            Result await_resume()
+            {
+                return handle.promise().takeResult();
+            }
+        };
+
+    public:
+        CoroutineTask() = default;
+
+        explicit CoroutineTask(std::coroutine_handle<promise_type> handle)
+            : _handle(handle)
+        {}
+
+        CoroutineTask(CoroutineTask&& other) noexcept
+            : _handle(std::exchange(other._handle, nullptr))
+        {}
+
+        CoroutineTask& operator=(CoroutineTask&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _destroy();
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+
+        // move only
+        CoroutineTask(const CoroutineTask& other) = delete;
+        CoroutineTask& operator=(const CoroutineTask& other) = delete;
+
+        ~CoroutineTask()
+        {
+            _destroy();
+        }
+
+    public:
+        bool isValid() const
+        {
+            return bool(_handle);
+        }
+
+        bool isDone() const
+        {
+            return _handle && _handle.done();
+        }
+
+        // the task must stay alive until the awaiting coroutine is resumed
+        Awaiter operator co_await() const& noexcept
+        {
+            return Awaiter{ _handle };
+        }
+
+        Awaiter operator co_await() const&& noexcept
+        {
+            return Awaiter{ _handle };
+        }
+
+    private:
+        void _destroy()
+        {
+            if (_handle)
+                std::exchange(_handle, nullptr).destroy();
+        }
+    };
+
+    namespace detail
+    {
+        template<typename Result>
+        CoroutineTask<Result> CoroutinePromise<Result>::get_return_object() noexcept
+        {
+            return CoroutineTask<Result>(std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+        }
+
+        inline CoroutineTask<void> CoroutinePromise<void>::get_return_object() noexcept
+        {
+            return CoroutineTask<void>(std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+        }
+    };
+
+    //
+    //
+
+    // co_await producer.schedule() -> the coroutine continue on a consumer
+    // => from a consumer of the same producer: its local queue (likely the same thread)
+    class ScheduleAwaiter
+    {
+    private:
+        Producer& _producer;
+
+    public:
+        explicit ScheduleAwaiter(Producer& producer)
+            : _producer(producer)
+        {}
+
+    public:
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // the coroutine may already run on a consumer when push() return
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            _producer.push([handle]() { handle.resume(); });
+        }
+
+        void await_resume() const noexcept
+        {}
+    };
+
+    inline ScheduleAwaiter Producer::schedule()
+    {
+        if (!_running)
+            D_THROW(std::runtime_error, "producer not running");
+
+        return ScheduleAwaiter(*this);
+    }
+
+    //
+    //
+
+    namespace detail
+    {
+        // co_await future: the coroutine is resumed by the thread fulfilling the future
+        template<typename Result>
+        class FutureAwaiter
+        {
+        private:
+            TaskFuture<Result> _future;
+
+        public:
+            explicit FutureAwaiter(TaskFuture<Result>&& future)
+                : _future(std::move(future))
+            {
+                _future._ensureIsValid();
+            }
+
+        public:
+            bool await_ready() const
+            {
+                return _future.isReady();
+            }
+
+            // called at once if the future became ready in between:
+            // nothing is touched after setContinuation()
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                _future._state->setContinuation([handle]() { handle.resume(); });
+            }
+
+            Result await_resume()
+            {
+                return _future.get();
+            }
+        };
+    };
+
+    template<typename Result>
+    detail::FutureAwaiter<Result> operator co_await(TaskFuture<Result>&& future)
+    {
+        return detail::FutureAwaiter<Result>(std::move(future));
+    }
+
+    //
+    //
+
+    namespace detail
+    {
+        // started at once, destroy itself at the end, the body handle the signaling
+        struct DetachedCoroutine
+        {
+            struct promise_type
+                : public PooledCoroutineFrame
+            {
+                DetachedCoroutine get_return_object() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                void return_void() const noexcept
+                {}
+
+                // the bodies catch everything themselves
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        struct JoinState
+        {
+            std::atomic<std::size_t> totalRemaining;
+            std::coroutine_handle<> waiting;
+            std::atomic<bool> hasException{false};
+            std::exception_ptr exception;
+        };
+
+        // the last one to finish (a joined task or the awaiting coroutine) resume the awaiting coroutine
+        struct JoinAwaiter
+        {
+            JoinState& state;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                state.waiting = handle;
+                return state.totalRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1; // false: all done, no suspension
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+
+        template<typename Result, typename Store>
+        DetachedCoroutine runJoined(const CoroutineTask<Result>& task, JoinState& state, Store store)
+        {
+            try
+            {
+                if constexpr (std::is_void<Result>::value)
+                {
+                    co_await task;
+                    store();
+                }
+                else
+                {
+                    store(co_await task);
+                }
+            }
+            catch (...)
+            {
+                if (!state.hasException.exchange(true, std::memory_order_acq_rel))
+                    state.exception = std::current_exception();
+            }
+
+            if (state.totalRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                state.waiting.resume();
+        }
+    };
+
+    // wait for all the tasks (values in the input order), the first exception is rethrown
+    template<typename Result>
+    CoroutineTask<WhenAllResult<Result>> whenAll(std::vector<CoroutineTask<Result>> tasks)
+    {
+        detail::JoinState state{ {tasks.size() + 1}, nullptr, {false}, nullptr }; // + this coroutine
+
+        std::vector<std::optional<std::conditional_t<std::is_void<Result>::value, bool, Result>>> values(tasks.size());
+
+        for (std::size_t ii = 0; ii < tasks.size(); ++ii)
+        {
+            if constexpr (std::is_void<Result>::value)
+                detail::runJoined(tasks[ii], state, [&values, ii]() { values[ii].emplace(true); });
+            else
+                detail::runJoined(tasks[ii], state, [&values, ii](Result&& value) { values[ii].emplace(std::move(value)); });
+        }
+
+        co_await detail::JoinAwaiter{ state };
+
+        if (state.exception)
+            std::rethrow_exception(state.exception);
+
+        if constexpr (!std::is_void<Result>::value)
+        {
+            std::vector<Result> results;
+            results.reserve(values.size());
+            for (auto& value : values)
+                results.push_back(std::move(*value));
+            co_return results;
+        }
+    }
+
+    namespace detail
+    {
+        template<typename Result>
+        struct SyncWaitState
+        {
+            ThreadSynchroniser synchroniser;
+            bool isDone = false; // locked by the synchroniser
+            std::exception_ptr exception;
+            std::optional<std::conditional_t<std::is_void<Result>::value, bool, Result>> value;
+        };
+
+        template<typename Result>
+        DetachedCoroutine runSyncWait(const CoroutineTask<Result>& task, SyncWaitState<Result>& state)
+        {
+            try
+            {
+                if constexpr (std::is_void<Result>::value)
+                {
+                    co_await task;
+                    state.value.emplace(true);
+                }
+                else
+                {
+                    state.value.emplace(co_await task);
+                }
+            }
+            catch (...)
+            {
+                state.exception = std::current_exception();
+            }
+
+            // notified under the lock: the waiting thread cannot return (and destroy the state) before the unlock
+            auto lock = state.synchroniser.makeScopedLock();
+            state.isDone = true;
+            state.synchroniser.notifyAll();
+        }
+    };
+
+    // block the calling thread until the task is done
+    // => not from a consumer of a single consumer producer the task need
+    template<typename Result>
+    Result syncWait(CoroutineTask<Result>&& task)
+    {
+        detail::SyncWaitState<Result> state;
+
+        detail::runSyncWait(task, state);
+
+        {
+            auto lock = state.synchroniser.makeScopedLock();
+            state.synchroniser.waitUntil(lock, [&state]() { return state.isDone; });
+        }
+
+        if (state.exception)
+            std::rethrow_exception(state.exception);
+
+        if constexpr (!std::is_void<Result>::value)
+            return std::move(*state.value);
+    }
+
+};
@@ -0,0 +1,310 @@
+
+#pragma once
+
+#include "Producer.hpp"
+
+#include "internals/Consumer.hpp"
+#include "internals/EventCount.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// parallel algorithms over a Producer (the calling thread also work)
+// => random access iterators only: "it + n", "end - begin", "*it", "++it", "!="
+//    (std::vector and the custom_containers arrays)
+// => grain: elements per chunk (adaptive) or minimum elements per chunk (static), 0 -> automatic
+// => called from one of the producer's consumers: the waiting consumer run other tasks (no deadlock)
+// => the helper tasks dropped by quit() (or a stopped producer) leave their chunks to the calling thread
+// => the callbacks must not throw
+//
+
+namespace multithreading
+{
+    enum class ChunkingMode
+    {
+        Static, // one even chunk per thread, lowest overhead for uniform work
+        Adaptive, // many small chunks claimed on demand, balance uneven work
+    };
+
+    namespace detail
+    {
+        struct ChunkLayout
+        {
+            std::size_t totalElements = 0;
+            std::size_t totalChunks = 0;
+            std::size_t chunkSize = 0; // adaptive only
+            bool isEven = false; // static
+
+            std::pair<std::size_t, std::size_t> getBounds(std::size_t chunkIndex) const
+            {
+                if (isEven)
+                    return { totalElements * chunkIndex / totalChunks, totalElements * (chunkIndex + 1) / totalChunks };
+
+                const std::size_t first = chunkIndex * chunkSize;
+                return { first, std::min(first + chunkSize, totalElements) };
+            }
+        };
+
+        inline ChunkLayout makeChunkLayout(const Producer& producer, std::size_t totalElements, std::size_t grain, ChunkingMode mode)
+        {
+            const std::size_t totalThreads = producer.totalConsumers() + 1; // + the calling thread
+
+            ChunkLayout layout;
+            layout.totalElements = totalElements;
+
+            if (totalElements == 0)
+                return layout;
+
+            if (mode == ChunkingMode::Static)
+            {
+                const std::size_t minimumSize = std::max<std::size_t>(grain, 1);
+                layout.isEven = true;
+                layout.totalChunks = std::max<std::size_t>(1, std::min(totalThreads, totalElements / minimumSize));
+                return layout;
+            }
+
+            // automatic: ~8 chunks per thread
+            layout.chunkSize = grain > 0 ? grain : std::max<std::size_t>(1, totalElements / (totalThreads * 8));
+            layout.totalChunks = (totalElements + layout.chunkSize - 1) / layout.chunkSize;
+            return layout;
+        }
+
+        // shared with the helper tasks, alive until the last one is done
+        struct ChunkRun
+        {
+            std::atomic<std::size_t> nextChunk{0};
+            std::atomic<std::size_t> remainingHelpers{0};
+            EventCount helpersDone;
+
+            // a helper is done, or dropped without running (quit(), failed push)
+            // => the caller may return as soon as the counter reach 0, only the run is used after
+            void onHelperDone()
+            {
+                if (remainingHelpers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    helpersDone.notifyAll();
+            }
+        };
+
+        inline void waitForHelpers(Producer& producer, ChunkRun& run)
+        {
+            Consumer* currConsumer = Consumer::getCurrent();
+            const bool isOwnConsumer = (currConsumer != nullptr && currConsumer->belongsTo(producer));
+
+            while (run.remainingHelpers.load(std::memory_order_acquire) > 0)
+            {
+                // a consumer must not block: its helpers may be in its own queue
+                if (isOwnConsumer)
+                {
+                    if (!currConsumer->runOneTask())
+                        std::this_thread::yield();
+                    continue;
+                }
+
+                const uint32_t key = run.helpersDone.prepareWait();
+                if (run.remainingHelpers.load(std::memory_order_acquire) == 0)
+                {
+                    run.helpersDone.cancelWait();
+                    break;
+                }
+                run.helpersDone.commitWait(key);
+            }
+        }
+
+        // callback(chunkIndex, firstIndex, lastIndex), return when all the chunks are done
+        template<typename ChunkCallback>
+        void forEachChunk(Producer& producer, const ChunkLayout& layout, ChunkCallback& callback)
+        {
+            if (layout.totalChunks == 0)
+                return;
+
+            if (layout.totalChunks == 1)
+            {
+                callback(std::size_t(0), std::size_t(0), layout.totalElements);
+                return;
+            }
+
+            auto run = std::make_shared<ChunkRun>();
+
+            auto processChunks = [&layout, &callback](ChunkRun& currRun)
+            {
+                for (std::size_t chunkIndex = currRun.nextChunk.fetch_add(1, std::memory_order_relaxed);
+                     chunkIndex < layout.totalChunks;
+                     chunkIndex = currRun.nextChunk.fetch_add(1, std::memory_order_relaxed))
+                {
+                    const auto bounds = layout.getBounds(chunkIndex);
+                    callback(chunkIndex, bounds.first, bounds.second);
+                }
+            };
+
+            const std::size_t totalHelpers = std::min(producer.totalConsumers(), layout.totalChunks - 1);
+            run->remainingHelpers.store(totalHelpers, std::memory_order_relaxed);
+
+            for (std::size_t ii = 0; ii < totalHelpers; ++ii)
+            {
+                try
+                {
+                    producer.pushWithDrop(
+                        [run, &processChunks]()
+                        {
+                            processChunks(*run);
+                            run->onHelperDone();
+                        },
+                        [run]()
+                        {
+                            run->onHelperDone();
+                        });
+                }
+                catch (...)
+                {
+                    // not running (that helper is already dropped): the calling thread run the chunks left
+                    for (std::size_t jj = ii + 1; jj < totalHelpers; ++jj)
+                        run->onHelperDone();
+                    break;
+                }
+            }
+
+            processChunks(*run);
+
+            waitForHelpers(producer, *run);
+        }
+    };
+
+    //
+    //
+
+    // callable(index) for every index of [first, last)
+    template<typename Callable>
+    void parallelForIndex(Producer& producer, std::size_t first, std::size_t last, std::size_t grain, Callable&& callable, ChunkingMode mode = ChunkingMode::Adaptive)
+    {
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, last > first ? last - first : 0, grain, mode);
+
+        auto chunkCallback = [first, &callable](std::size_t, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            for (std::size_t index = first + chunkFirst; index < first + chunkLast; ++index)
+                callable(index);
+        };
+
+        detail::forEachChunk(producer, layout, chunkCallback);
+    }
+
+    // callable(value) for every value of [begin, end)
+    template<typename Iterator, typename Callable>
+    void parallelFor(Producer& producer, Iterator begin, Iterator end, std::size_t grain, Callable&& callable, ChunkingMode mode = ChunkingMode::Adaptive)
+    {
+        const std::size_t totalElements = std::size_t(end - begin);
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, grain, mode);
+
+        auto chunkCallback = [&begin, &callable](std::size_t, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            Iterator it = begin + chunkFirst;
+            for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+                callable(*it);
+        };
+
+        detail::forEachChunk(producer, layout, chunkCallback);
+    }
+
+    // reduceOp must be associative, the chunks are combined in order (deterministic result)
+    template<typename Iterator, typename Value, typename ReduceOp, typename TransformOp>
+    Value parallelTransformReduce(Producer& producer, Iterator begin, Iterator end, std::size_t grain, Value init, ReduceOp&& reduceOp, TransformOp&& transformOp, ChunkingMode mode = ChunkingMode::Adaptive)
+    {
+        const std::size_t totalElements = std::size_t(end - begin);
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, grain, mode);
+
+        std::vector<std::optional<Value>> partials(layout.totalChunks);
+
+        auto chunkCallback = [&begin, &partials, &reduceOp, &transformOp](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            Iterator it = begin + chunkFirst;
+            Value accumulator = transformOp(*it);
+            ++it;
+            for (std::size_t index = chunkFirst + 1; index < chunkLast; ++index, ++it)
+                accumulator = reduceOp(std::move(accumulator), transformOp(*it));
+
+            partials[chunkIndex].emplace(std::move(accumulator));
+        };
+
+        detail::forEachChunk(producer, layout, chunkCallback);
+
+        Value result = std::move(init);
+        for (auto& partial : partials)
+            result = reduceOp(std::move(result), std::move(*partial));
+        return result;
+    }
+
+    template<typename Iterator, typename Value, typename ReduceOp>
+    Value parallelReduce(Producer& producer, Iterator begin, Iterator end, std::size_t grain, Value init, ReduceOp&& reduceOp, ChunkingMode mode = ChunkingMode::Adaptive)
+    {
+        return parallelTransformReduce(
+            producer, begin, end, grain, std::move(init), std::forward<ReduceOp>(reduceOp),
+            [](const auto& value) -> const auto& { return value; },
+            mode);
+    }
+
+    // out[i] = in[0] op ... op in[i], return the end of the output
+    // => 3 passes: chunk totals, (serial) chunk offsets, chunk scans
+    template<typename InputIterator, typename OutputIterator, typename ScanOp>
+    OutputIterator parallelInclusiveScan(Producer& producer, InputIterator begin, InputIterator end, OutputIterator out, std::size_t grain, ScanOp&& scanOp, ChunkingMode mode = ChunkingMode::Static)
+    {
+        using Value = std::decay_t<decltype(*begin)>;
+
+        const std::size_t totalElements = std::size_t(end - begin);
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, grain, mode);
+
+        if (layout.totalChunks == 0)
+            return out;
+
+        // chunk totals (the last chunk total is never needed)
+        std::vector<std::optional<Value>> offsets(layout.totalChunks);
+
+        auto totalCallback = [&begin, &offsets, &scanOp, &layout](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            if (chunkIndex + 1 == layout.totalChunks)
+                return;
+
+            InputIterator it = begin + chunkFirst;
+            Value accumulator = *it;
+            ++it;
+            for (std::size_t index = chunkFirst + 1; index < chunkLast; ++index, ++it)
+                accumulator = scanOp(std::move(accumulator), *it);
+
+            offsets[chunkIndex + 1].emplace(std::move(accumulator));
+        };
+
+        detail::forEachChunk(producer, layout, totalCallback);
+
+        // offsets[i] = total of the chunks before i
+        for (std::size_t ii = 2; ii < layout.totalChunks; ++ii)
+            offsets[ii].emplace(scanOp(*offsets[ii - 1], std::move(*offsets[ii])));
+
+        auto scanCallback = [&begin, &out, &offsets, &scanOp](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            InputIterator itIn = begin + chunkFirst;
+            OutputIterator itOut = out + chunkFirst;
+
+            Value accumulator = offsets[chunkIndex] ? scanOp(*offsets[chunkIndex], *itIn) : Value(*itIn);
+            *itOut = accumulator;
+
+            ++itIn;
+            ++itOut;
+            for (std::size_t index = chunkFirst + 1; index < chunkLast; ++index, ++itIn, ++itOut)
+            {
+                accumulator = scanOp(std::move(accumulator), *itIn);
+                *itOut = accumulator;
+            }
+        };
+
+        detail::forEachChunk(producer, layout, scanCallback);
+
+        return out + totalElements;
+    }
+
+};
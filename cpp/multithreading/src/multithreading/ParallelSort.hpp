@@ -0,0 +1,593 @@
+
+#pragma once
+
+#include "ParallelAlgorithms.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// parallel sorts over a Producer (the calling thread also work)
+// => same iterator requirements as std::sort
+// => the values must be default constructible and movable (one temporary buffer of the input size)
+// => parallelSort: LSD radix sort for the integer/float keys with the default order, sample sort otherwise
+// => parallelStableSort: chunk stable sorts then rounds of merge-path merges
+// => the comparators must not throw
+//
+
+namespace multithreading
+{
+    namespace detail
+    {
+        // below this size the pool costs more than it gives
+        constexpr std::size_t k_sortSequentialThreshold = 1 << 14;
+
+        // sample sort: buckets per thread and samples per bucket
+        constexpr std::size_t k_sortBucketsPerThread = 8;
+        constexpr std::size_t k_sortOversampling = 16;
+
+        // merges: output segments per thread
+        constexpr std::size_t k_mergeSegmentsPerThread = 4;
+
+        inline std::size_t getTotalSortThreads(const Producer& producer)
+        {
+            return producer.totalConsumers() + 1; // + the calling thread
+        }
+
+        // move [srcBegin, srcBegin + totalElements) to dstBegin, in parallel
+        template<typename SrcIterator, typename DstIterator>
+        void parallelMove(Producer& producer, SrcIterator srcBegin, DstIterator dstBegin, std::size_t totalElements)
+        {
+            const ChunkLayout layout = makeChunkLayout(producer, totalElements, k_sortSequentialThreshold, ChunkingMode::Static);
+
+            auto chunkCallback = [&srcBegin, &dstBegin](std::size_t, std::size_t chunkFirst, std::size_t chunkLast)
+            {
+                std::move(srcBegin + chunkFirst, srcBegin + chunkLast, dstBegin + chunkFirst);
+            };
+
+            forEachChunk(producer, layout, chunkCallback);
+        }
+
+        //
+        //
+
+        //
+        // merge path: the "diagonal" (output index) d of the merge of a and b
+        // is reached after taking i elements of a and d - i elements of b
+        // => binary search of i, a first on equal values (stable, like std::merge)
+
+        template<typename Iterator1, typename Iterator2, typename Compare>
+        std::size_t findMergePath(Iterator1 first1, std::size_t size1, Iterator2 first2, std::size_t size2, std::size_t diagonal, Compare& comp)
+        {
+            std::size_t low = diagonal > size2 ? diagonal - size2 : 0;
+            std::size_t high = std::min(diagonal, size1);
+
+            while (low < high)
+            {
+                const std::size_t middle = low + (high - low) / 2;
+
+                if (!comp(*(first2 + (diagonal - middle - 1)), *(first1 + middle)))
+                    low = middle + 1; // a[middle] come before b[diagonal - middle - 1]
+                else
+                    high = middle;
+            }
+
+            return low;
+        }
+
+        struct MergeSegment
+        {
+            std::size_t mergeIndex;
+            std::size_t firstDiagonal;
+            std::size_t lastDiagonal;
+        };
+
+        // offsets in the src (inputs) and dst (output) ranges
+        struct MergeJob
+        {
+            std::size_t first1;
+            std::size_t size1;
+            std::size_t first2;
+            std::size_t size2;
+            std::size_t outFirst;
+        };
+
+        // run all the merges at once, every merge is cut in segments of similar size
+        // => the last merge of a sort is as parallel as the first ones
+        // => the values are moved
+        template<typename SrcIterator, typename DstIterator, typename Compare>
+        void runMergeJobs(Producer& producer, const std::vector<MergeJob>& jobs, SrcIterator src, DstIterator dst, Compare& comp)
+        {
+            std::size_t totalElements = 0;
+            for (const MergeJob& job : jobs)
+                totalElements += job.size1 + job.size2;
+
+            const std::size_t totalSegments = getTotalSortThreads(producer) * k_mergeSegmentsPerThread;
+            const std::size_t segmentSize = std::max(k_sortSequentialThreshold, (totalElements + totalSegments - 1) / totalSegments);
+
+            std::vector<MergeSegment> segments;
+            for (std::size_t mergeIndex = 0; mergeIndex < jobs.size(); ++mergeIndex)
+            {
+                const std::size_t mergeSize = jobs[mergeIndex].size1 + jobs[mergeIndex].size2;
+                for (std::size_t diagonal = 0; diagonal < mergeSize; diagonal += segmentSize)
+                    segments.push_back({ mergeIndex, diagonal, std::min(diagonal + segmentSize, mergeSize) });
+            }
+
+            parallelForIndex(producer, 0, segments.size(), 1, [&](std::size_t segmentIndex)
+            {
+                const MergeSegment& segment = segments[segmentIndex];
+                const MergeJob& job = jobs[segment.mergeIndex];
+
+                const SrcIterator first1 = src + job.first1;
+                const SrcIterator first2 = src + job.first2;
+
+                const std::size_t firstIndex1 = findMergePath(first1, job.size1, first2, job.size2, segment.firstDiagonal, comp);
+                const std::size_t lastIndex1 = findMergePath(first1, job.size1, first2, job.size2, segment.lastDiagonal, comp);
+
+                std::merge(
+                    std::make_move_iterator(first1 + firstIndex1), std::make_move_iterator(first1 + lastIndex1),
+                    std::make_move_iterator(first2 + (segment.firstDiagonal - firstIndex1)), std::make_move_iterator(first2 + (segment.lastDiagonal - lastIndex1)),
+                    dst + (job.outFirst + segment.firstDiagonal),
+                    comp);
+            });
+        }
+
+        // one merge round: runs (bounds) 2k and 2k + 1 are merged from src to dst
+        // => an odd last run is only moved, return the bounds of the new runs
+        template<typename SrcIterator, typename DstIterator, typename Compare>
+        std::vector<std::size_t> mergeRunsRound(Producer& producer, const std::vector<std::size_t>& runBounds, SrcIterator src, DstIterator dst, Compare& comp)
+        {
+            const std::size_t totalRuns = runBounds.size() - 1;
+
+            std::vector<MergeJob> jobs;
+            std::vector<std::size_t> newBounds;
+            newBounds.push_back(0);
+
+            for (std::size_t runIndex = 0; runIndex < totalRuns; runIndex += 2)
+            {
+                const std::size_t first = runBounds[runIndex];
+                const std::size_t middle = runBounds[runIndex + 1];
+                const std::size_t last = runIndex + 2 <= totalRuns ? runBounds[runIndex + 2] : middle;
+
+                // an empty second run: merged with nothing, still moved to dst
+                jobs.push_back({ first, middle - first, middle, last - middle, first });
+                newBounds.push_back(last);
+            }
+
+            runMergeJobs(producer, jobs, src, dst, comp);
+
+            return newBounds;
+        }
+
+        //
+        //
+
+        //
+        // radix sort keys: unsigned integers with the same order as the values
+        // => signed integers: flip the sign bit
+        // => iec559 floats: flip all the bits of the negatives, the sign bit of the positives
+
+        template<typename Value, typename Enable = void>
+        struct RadixTraits
+        {
+            static constexpr bool isSupported = false;
+        };
+
+        template<typename Value>
+        struct RadixTraits<Value, std::enable_if_t<std::is_integral_v<Value> && !std::is_same_v<Value, bool>>>
+        {
+            static constexpr bool isSupported = true;
+
+            using Key = std::make_unsigned_t<Value>;
+
+            static Key toKey(Value value)
+            {
+                Key key = Key(value);
+                if constexpr (std::is_signed_v<Value>)
+                    key ^= Key(Key(1) << (sizeof(Key) * 8 - 1));
+                return key;
+            }
+        };
+
+        template<typename Value>
+        struct RadixTraits<Value, std::enable_if_t<std::is_floating_point_v<Value> && std::numeric_limits<Value>::is_iec559 && (sizeof(Value) == 4 || sizeof(Value) == 8)>>
+        {
+            static constexpr bool isSupported = true;
+
+            using Key = std::conditional_t<sizeof(Value) == 4, uint32_t, uint64_t>;
+
+            static Key toKey(Value value)
+            {
+                Key key;
+                std::memcpy(&key, &value, sizeof(Key));
+
+                constexpr Key signBit = Key(Key(1) << (sizeof(Key) * 8 - 1));
+                return (key & signBit) ? Key(~key) : Key(key ^ signBit);
+            }
+        };
+
+        // the radix sort give the order of std::less
+        template<typename Value, typename Compare>
+        constexpr bool isRadixSortable()
+        {
+            return (
+                RadixTraits<Value>::isSupported &&
+                (std::is_same_v<Compare, std::less<Value>> || std::is_same_v<Compare, std::less<>>)
+            );
+        }
+
+        constexpr std::size_t k_radixBits = 8;
+        constexpr std::size_t k_radixSize = 1 << k_radixBits;
+
+        using RadixCounts = std::array<std::size_t, k_radixSize>;
+
+        // one stable scatter pass of the digit "digitIndex", from src to dst
+        // => per chunk histogram, digit major offsets (chunk c after chunk c - 1: stable)
+        template<typename SrcIterator, typename DstIterator>
+        void radixSortPass(Producer& producer, const ChunkLayout& layout, std::size_t digitIndex, SrcIterator src, DstIterator dst)
+        {
+            using Value = std::decay_t<decltype(*src)>;
+            using Traits = RadixTraits<Value>;
+
+            const std::size_t shift = digitIndex * k_radixBits;
+
+            std::vector<RadixCounts> chunkOffsets(layout.totalChunks);
+
+            auto histogramCallback = [&src, &chunkOffsets, shift](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+            {
+                RadixCounts& counts = chunkOffsets[chunkIndex];
+                counts.fill(0);
+
+                SrcIterator it = src + chunkFirst;
+                for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+                    ++counts[(Traits::toKey(*it) >> shift) & (k_radixSize - 1)];
+            };
+
+            forEachChunk(producer, layout, histogramCallback);
+
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < k_radixSize; ++digit)
+                for (RadixCounts& counts : chunkOffsets)
+                {
+                    const std::size_t count = counts[digit];
+                    counts[digit] = offset;
+                    offset += count;
+                }
+
+            auto scatterCallback = [&src, &dst, &chunkOffsets, shift](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+            {
+                RadixCounts& offsets = chunkOffsets[chunkIndex];
+
+                SrcIterator it = src + chunkFirst;
+                for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+                    *(dst + offsets[(Traits::toKey(*it) >> shift) & (k_radixSize - 1)]++) = std::move(*it);
+            };
+
+            forEachChunk(producer, layout, scatterCallback);
+        }
+
+        // sample sort bucket of a value
+        // => even bucket 2k: between the splitters k - 1 and k (to sort)
+        // => odd bucket 2k + 1: equal to the splitter k (already sorted, no skew with many duplicates)
+        template<typename Value, typename Compare>
+        std::size_t findSampleSortBucket(const std::vector<Value>& splitters, const Value& value, Compare& comp)
+        {
+            const std::size_t upperIndex = std::size_t(std::upper_bound(splitters.begin(), splitters.end(), value, comp) - splitters.begin());
+
+            if (upperIndex > 0 && !comp(splitters[upperIndex - 1], value))
+                return upperIndex * 2 - 1;
+
+            return upperIndex * 2;
+        }
+    };
+
+    //
+    //
+
+    // LSD radix sort (8 bits digits) of integer or float values, ascending order
+    // => the passes where every value has the same digit are skipped
+    template<typename Iterator>
+    void parallelRadixSort(Producer& producer, Iterator begin, Iterator end)
+    {
+        using Value = std::decay_t<decltype(*begin)>;
+        using Traits = detail::RadixTraits<Value>;
+
+        static_assert(Traits::isSupported, "parallelRadixSort need integer or iec559 float values");
+
+        const std::size_t totalElements = std::size_t(end - begin);
+        if (totalElements < detail::k_sortSequentialThreshold)
+        {
+            std::sort(begin, end);
+            return;
+        }
+
+        constexpr std::size_t totalDigits = sizeof(typename Traits::Key) * 8 / detail::k_radixBits;
+
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, detail::k_sortSequentialThreshold, ChunkingMode::Static);
+
+        //
+        // one read of the input: digits shared by every value
+
+        using DigitCounts = std::array<detail::RadixCounts, totalDigits>;
+
+        std::vector<DigitCounts> chunkCounts(layout.totalChunks);
+
+        auto countCallback = [&begin, &chunkCounts](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            DigitCounts& counts = chunkCounts[chunkIndex];
+            for (detail::RadixCounts& digitCounts : counts)
+                digitCounts.fill(0);
+
+            Iterator it = begin + chunkFirst;
+            for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+            {
+                const typename Traits::Key key = Traits::toKey(*it);
+                for (std::size_t digitIndex = 0; digitIndex < totalDigits; ++digitIndex)
+                    ++counts[digitIndex][(key >> (digitIndex * detail::k_radixBits)) & (detail::k_radixSize - 1)];
+            }
+        };
+
+        detail::forEachChunk(producer, layout, countCallback);
+
+        std::vector<std::size_t> digitsToSort;
+        for (std::size_t digitIndex = 0; digitIndex < totalDigits; ++digitIndex)
+        {
+            bool isShared = false;
+            for (std::size_t digit = 0; digit < detail::k_radixSize && !isShared; ++digit)
+            {
+                std::size_t total = 0;
+                for (const DigitCounts& counts : chunkCounts)
+                    total += counts[digitIndex][digit];
+                isShared = (total == totalElements);
+            }
+
+            if (!isShared)
+                digitsToSort.push_back(digitIndex);
+        }
+
+        if (digitsToSort.empty())
+            return; // all equal
+
+        //
+        // ping-pong between the input and the buffer
+
+        std::vector<Value> buffer(totalElements);
+
+        bool isInBuffer = false;
+        for (std::size_t digitIndex : digitsToSort)
+        {
+            if (isInBuffer)
+                detail::radixSortPass(producer, layout, digitIndex, buffer.begin(), begin);
+            else
+                detail::radixSortPass(producer, layout, digitIndex, begin, buffer.begin());
+
+            isInBuffer = !isInBuffer;
+        }
+
+        if (isInBuffer)
+            detail::parallelMove(producer, buffer.begin(), begin, totalElements);
+    }
+
+    // sample sort, not stable
+    // => splitters from a sorted sample, parallel classification, scatter to a buffer
+    // => the buckets are then sorted in parallel (largest first) and moved back
+    template<typename Iterator, typename Compare = std::less<>>
+    void parallelSampleSort(Producer& producer, Iterator begin, Iterator end, Compare comp = Compare())
+    {
+        using Value = std::decay_t<decltype(*begin)>;
+
+        const std::size_t totalElements = std::size_t(end - begin);
+        const std::size_t totalThreads = detail::getTotalSortThreads(producer);
+
+        if (totalElements < detail::k_sortSequentialThreshold || totalThreads == 1)
+        {
+            std::sort(begin, end, comp);
+            return;
+        }
+
+        //
+        // splitters (deterministic sample: same input, same buckets)
+
+        const std::size_t totalBuckets = std::min(totalThreads * detail::k_sortBucketsPerThread, totalElements / detail::k_sortSequentialThreshold + 1);
+        const std::size_t totalSamples = totalBuckets * detail::k_sortOversampling;
+
+        std::vector<Value> samples;
+        samples.reserve(totalSamples);
+
+        uint64_t seed = 0x9e3779b97f4a7c15ULL;
+        for (std::size_t ii = 0; ii < totalSamples; ++ii)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            samples.push_back(*(begin + std::size_t(seed % totalElements)));
+        }
+
+        std::sort(samples.begin(), samples.end(), comp);
+
+        std::vector<Value> splitters;
+        for (std::size_t bucketIndex = 1; bucketIndex < totalBuckets; ++bucketIndex)
+        {
+            const Value& candidate = samples[bucketIndex * detail::k_sortOversampling];
+            if (splitters.empty() || comp(splitters.back(), candidate))
+                splitters.push_back(candidate);
+        }
+
+        const std::size_t totalClasses = splitters.size() * 2 + 1;
+
+        //
+        // classification: per chunk class counts, then class major offsets
+
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, detail::k_sortSequentialThreshold, ChunkingMode::Static);
+
+        std::vector<std::size_t> chunkOffsets(layout.totalChunks * totalClasses, 0);
+
+        auto countCallback = [&](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            std::size_t* counts = chunkOffsets.data() + chunkIndex * totalClasses;
+
+            Iterator it = begin + chunkFirst;
+            for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+                ++counts[detail::findSampleSortBucket(splitters, *it, comp)];
+        };
+
+        detail::forEachChunk(producer, layout, countCallback);
+
+        std::vector<std::size_t> classBounds(totalClasses + 1, 0);
+
+        std::size_t offset = 0;
+        for (std::size_t classIndex = 0; classIndex < totalClasses; ++classIndex)
+        {
+            classBounds[classIndex] = offset;
+            for (std::size_t chunkIndex = 0; chunkIndex < layout.totalChunks; ++chunkIndex)
+            {
+                std::size_t& currOffset = chunkOffsets[chunkIndex * totalClasses + classIndex];
+                const std::size_t count = currOffset;
+                currOffset = offset;
+                offset += count;
+            }
+        }
+        classBounds[totalClasses] = offset;
+
+        //
+        // scatter (chunk order kept inside a class)
+
+        std::vector<Value> buffer(totalElements);
+
+        auto scatterCallback = [&](std::size_t chunkIndex, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            std::size_t* offsets = chunkOffsets.data() + chunkIndex * totalClasses;
+
+            Iterator it = begin + chunkFirst;
+            for (std::size_t index = chunkFirst; index < chunkLast; ++index, ++it)
+                buffer[offsets[detail::findSampleSortBucket(splitters, *it, comp)]++] = std::move(*it);
+        };
+
+        detail::forEachChunk(producer, layout, scatterCallback);
+
+        //
+        // sort the buckets, largest first (the small ones fill the gaps at the end)
+
+        std::vector<std::size_t> classOrder(totalClasses);
+        for (std::size_t classIndex = 0; classIndex < totalClasses; ++classIndex)
+            classOrder[classIndex] = classIndex;
+
+        std::sort(classOrder.begin(), classOrder.end(), [&classBounds](std::size_t classA, std::size_t classB)
+        {
+            return (classBounds[classA + 1] - classBounds[classA]) > (classBounds[classB + 1] - classBounds[classB]);
+        });
+
+        parallelForIndex(producer, 0, totalClasses, 1, [&](std::size_t orderIndex)
+        {
+            const std::size_t classIndex = classOrder[orderIndex];
+            const std::size_t first = classBounds[classIndex];
+            const std::size_t last = classBounds[classIndex + 1];
+
+            // odd class: every value is equal to a splitter
+            if ((classIndex & 1) == 0)
+                std::sort(buffer.begin() + first, buffer.begin() + last, comp);
+
+            std::move(buffer.begin() + first, buffer.begin() + last, begin + first);
+        });
+    }
+
+    // radix sort when the values and the order allow it, sample sort otherwise (not stable)
+    template<typename Iterator, typename Compare = std::less<>>
+    void parallelSort(Producer& producer, Iterator begin, Iterator end, Compare comp = Compare())
+    {
+        using Value = std::decay_t<decltype(*begin)>;
+
+        if constexpr (detail::isRadixSortable<Value, Compare>())
+            parallelRadixSort(producer, begin, end);
+        else
+            parallelSampleSort(producer, begin, end, comp);
+    }
+
+    // merge [first1, last1) and [first2, last2) to out, like std::merge (stable)
+    // => the output is cut in segments, merge path find where each segment start in both inputs
+    template<typename Iterator1, typename Iterator2, typename OutputIterator, typename Compare = std::less<>>
+    OutputIterator parallelMerge(Producer& producer, Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2, OutputIterator out, Compare comp = Compare())
+    {
+        const std::size_t size1 = std::size_t(last1 - first1);
+        const std::size_t size2 = std::size_t(last2 - first2);
+
+        const std::size_t totalSegments = detail::getTotalSortThreads(producer) * detail::k_mergeSegmentsPerThread;
+        const std::size_t segmentSize = std::max(detail::k_sortSequentialThreshold, (size1 + size2 + totalSegments - 1) / totalSegments);
+        const std::size_t totalSegmentsUsed = (size1 + size2 + segmentSize - 1) / segmentSize;
+
+        parallelForIndex(producer, 0, totalSegmentsUsed, 1, [&](std::size_t segmentIndex)
+        {
+            const std::size_t firstDiagonal = segmentIndex * segmentSize;
+            const std::size_t lastDiagonal = std::min(firstDiagonal + segmentSize, size1 + size2);
+
+            const std::size_t firstIndex1 = detail::findMergePath(first1, size1, first2, size2, firstDiagonal, comp);
+            const std::size_t lastIndex1 = detail::findMergePath(first1, size1, first2, size2, lastDiagonal, comp);
+
+            std::merge(
+                first1 + firstIndex1, first1 + lastIndex1,
+                first2 + (firstDiagonal - firstIndex1), first2 + (lastDiagonal - lastIndex1),
+                out + firstDiagonal,
+                comp);
+        });
+
+        return out + (size1 + size2);
+    }
+
+    // stable sort: one std::stable_sort per chunk, then merge rounds (merge path, all the merges of a round at once)
+    template<typename Iterator, typename Compare = std::less<>>
+    void parallelStableSort(Producer& producer, Iterator begin, Iterator end, Compare comp = Compare())
+    {
+        using Value = std::decay_t<decltype(*begin)>;
+
+        const std::size_t totalElements = std::size_t(end - begin);
+        const std::size_t totalThreads = detail::getTotalSortThreads(producer);
+
+        if (totalElements < detail::k_sortSequentialThreshold || totalThreads == 1)
+        {
+            std::stable_sort(begin, end, comp);
+            return;
+        }
+
+        const detail::ChunkLayout layout = detail::makeChunkLayout(producer, totalElements, detail::k_sortSequentialThreshold, ChunkingMode::Static);
+
+        auto sortCallback = [&begin, &comp](std::size_t, std::size_t chunkFirst, std::size_t chunkLast)
+        {
+            std::stable_sort(begin + chunkFirst, begin + chunkLast, comp);
+        };
+
+        detail::forEachChunk(producer, layout, sortCallback);
+
+        std::vector<std::size_t> runBounds;
+        for (std::size_t chunkIndex = 0; chunkIndex < layout.totalChunks; ++chunkIndex)
+            runBounds.push_back(layout.getBounds(chunkIndex).first);
+        runBounds.push_back(totalElements);
+
+        if (runBounds.size() <= 2)
+            return; // one run
+
+        std::vector<Value> buffer(totalElements);
+
+        bool isInBuffer = false;
+        while (runBounds.size() > 2)
+        {
+            if (isInBuffer)
+                runBounds = detail::mergeRunsRound(producer, runBounds, buffer.begin(), begin, comp);
+            else
+                runBounds = detail::mergeRunsRound(producer, runBounds, begin, buffer.begin(), comp);
+
+            isInBuffer = !isInBuffer;
+        }
+
+        if (isInBuffer)
+            detail::parallelMove(producer, buffer.begin(), begin, totalElements);
+    }
+
+};
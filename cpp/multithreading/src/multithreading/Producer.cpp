@@ -1,18 +1,13 @@
 
 #include "Producer.hpp"
 
-#include "utilities/ErrorHandler.hpp"
-
 #include <algorithm>
-#include <chrono>
+#include <bit>
+#include <iomanip>
 
 namespace multithreading
 {
 
-    Producer::Task::Task(const WorkCallback& work)
-        : work(work)
-    {}
-
     Producer::~Producer()
     {
         quit();
@@ -21,44 +16,84 @@ namespace multithreading
     //
     //
 
-    void Producer::initialise(unsigned int totalCores)
+    void Producer::initialise(unsigned int totalConsumers)
     {
-        // clamp [1..8]
-        const int totalConsumers = std::min(std::max(int(totalCores), 1), 8);
+        ProducerSettings settings;
+        settings.totalConsumers = std::max(totalConsumers, 1u);
+        initialise(settings);
+    }
 
-        //
-        // launch consumers
+    void Producer::initialise(const ProducerSettings& settings)
+    {
+        _topology = Topology::detect();
 
-        for (int ii = 0; ii < totalConsumers; ++ii)
+        std::size_t totalConsumers = settings.totalConsumers;
+        if (totalConsumers == 0)
         {
-            auto newConsumer = std::make_shared<Consumer>(*this);
+            if (settings.pinning == PinningStrategy::PhysicalCores)
+                totalConsumers = _topology.totalPhysicalCores();
+            else
+                totalConsumers = _topology.totalLogicalCpus();
+        }
 
-            _consumers.push_back(newConsumer);
-            _freeConsumers.push_back(newConsumer);
+        _lanePolicy = settings.lanePolicy;
+        _laneWeights = settings.laneWeights;
+        _totalLaneWeight = 0;
+        for (unsigned int weight : _laneWeights)
+            _totalLaneWeight += weight;
+        if (_lanePolicy == LanePolicy::Weighted && _totalLaneWeight == 0)
+            D_THROW(std::runtime_error, "weighted lanes: all the weights are zero");
+        _starvationInterval = settings.starvationInterval;
+
+        _waitStrategy = settings.waitStrategy;
+        _waitAllTask.setWaitStrategy(settings.waitStrategy);
+
+        _isElastic = (settings.minConsumers > 0 && settings.minConsumers < totalConsumers);
+        _minConsumers = (_isElastic ? settings.minConsumers : totalConsumers);
+        _spawnLatency = std::chrono::nanoseconds(settings.spawnLatency).count();
+        _retireTimeout = std::chrono::nanoseconds(settings.retireTimeout).count();
+
+        _startTime = ConsumerMetrics::now();
+        _metricsSamplingMask = std::bit_ceil(std::max(settings.metricsSamplingInterval, 1u)) - 1;
+        if (_isElastic)
+            _metricsSamplingMask = std::min(_metricsSamplingMask, k_maxElasticSamplingMask); // a backlog seen within a few tasks
+        if (settings.enableMetrics)
+        {
+            for (std::size_t ii = 0; ii < totalConsumers; ++ii)
+                _consumerMetrics.push_back(std::make_unique<ConsumerMetrics>(settings.traceCapacity));
         }
 
-        _running = false; // the producer's thread will set it to true
+        const std::vector<LogicalCpu> placement = _topology.getPlacement(settings.pinning, totalConsumers);
 
-        //
-        // launch producer thread
+        // the per node queues only make sense with consumers staying on their node
+        if (!placement.empty() && _topology.totalNumaNodes() > 1)
+        {
+            for (std::size_t ii = 0; ii < _topology.totalNumaNodes(); ++ii)
+                _nodeTasks.push_back(std::make_unique<MpmcTaskQueue>());
+        }
 
-        _thread = std::thread(&Producer::_threadedMethod, this);
+        _running = true; // before the consumers start to acquire
 
-        // here we wait for the thread to be running
-        while (!_running)
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+        //
+        // launch consumers
 
-    void Producer::push(const WorkCallback& work)
-    {
-        if (!_running)
-            D_THROW(std::runtime_error, "producer not running");
+        // all constructed before any start, the consumers steal from each other
+        // => elastic: only the first minConsumers start, the others are spawned under load
+        for (std::size_t ii = 0; ii < totalConsumers; ++ii)
+        {
+            const unsigned int index = static_cast<unsigned int>(ii);
+            ConsumerMetrics* metrics = _consumerMetrics.empty() ? nullptr : _consumerMetrics[ii].get();
 
-        auto lockNotifier = _waitOneTask.makeScopedLockNotifier();
+            if (placement.empty())
+                _consumers.push_back(std::make_unique<Consumer>(*this, index, -1, 0, metrics));
+            else
+                _consumers.push_back(std::make_unique<Consumer>(*this, index, int(placement[ii].id), placement[ii].numaNode, metrics));
+        }
 
-        // this part is locked and will notify at the end of the scope
+        _totalActiveConsumers = _minConsumers;
 
-        _plannedTasks.push_back(Task(work));
+        for (std::size_t ii = 0; ii < _minConsumers; ++ii)
+            _consumers[ii]->start();
     }
 
     void Producer::quit()
@@ -66,39 +101,64 @@ namespace multithreading
         if (!_running)
             return;
 
-        // clear the planned task(s) and wake up the running thread
+        // clear the planned task(s)
+        // => a dropped task run its drop callback, which may push (a future's continuation): cleared until empty
+        while (true)
         {
-            auto lockNotifier = _waitOneTask.makeScopedLockNotifier();
+            int64_t totalCleared = 0;
+
+            auto clearTask = [this, &totalCleared](Task* task)
+            {
+                if (task->completion != nullptr)
+                {
+                    task->completion->work.reset();
+                    _taskPool.release(task->completion);
+                }
+
+                task->work.reset();
+                if (task->drop)
+                    task->drop();
+
+                _taskPool.release(task);
+                ++totalCleared;
+            };
+
+            for (std::size_t ii = 0; ii < _lanes.size(); ++ii)
+                while (Task* task = _popLaneTask(ii))
+                    clearTask(task);
 
-            // this part is locked and will notify at the end of the scope
+            for (std::size_t ii = 0; ii < _nodeTasks.size(); ++ii)
+                while (Task* task = _popNodeTask(static_cast<unsigned int>(ii)))
+                    clearTask(task);
 
-            _plannedTasks.clear();
+            if (totalCleared == 0)
+                break;
+
+            _pendingTasks.fetch_sub(totalCleared, std::memory_order_acq_rel);
         }
 
         waitUntilAllCompleted();
 
-        // clear the planned task(s) and wake up the running thread
-        {
-            auto lockNotifier = _waitOneTask.makeScopedLockNotifier();
+        // stop and wake up all the consumers
+        _running = false;
 
-            // this part is locked and will notify at the end of the scope
+        // no consumer is spawned from now (and a spawn in progress is over)
+        std::unique_lock<std::mutex> elasticLock(_elasticMutex);
 
-            // _plannedTasks.clear();
-            _running = false;
-        }
+        for (auto& consumer : _consumers)
+            consumer->requestQuit();
 
-        if (_thread.joinable())
-            _thread.join();
+        _idleConsumers.notifyAll();
 
-        _freeConsumers.clear();
-        _busyConsumers.clear();
-        _consumers.clear();
+        // join them all before destroying any: a running consumer may still steal from the others
+        for (auto& consumer : _consumers)
+            consumer->quit();
 
-        // no more shared_ptr references are held
-        //
-        // the consumers destructor:
-        // => should have been called
-        // => will terminate their thread
+        _totalActiveConsumers = 0;
+
+        _consumers.clear();
+        _consumerMetrics.clear();
+        _nodeTasks.clear();
     }
 
     void Producer::waitUntilAllCompleted()
@@ -111,87 +171,564 @@ namespace multithreading
         // this part is locked
 
         // make the (main) thread wait for all tasks to be completed
-        while (!allCompleted())
+        // wait -> release the lock for other thread(s)
+        _waitAllTask.waitUntil(lock, [this]() { return allCompleted(); });
+    }
+
+    bool Producer::allCompleted() const
+    {
+        return _pendingTasks.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t Producer::update()
+    {
+        if (_completionBacklog == nullptr)
+            _completionBacklog = _completions.takeAll();
+
+        std::size_t totalRun = 0;
+
+        // no lock held: a completion may push, or throw (the rest of the batch wait for the next call)
+        while (Task* completion = _completionBacklog)
         {
-            // wait -> release the lock for other thread(s)
-            _waitAllTask.waitUntilNotified(lock);
+            _completionBacklog = completion->next;
+            completion->next = nullptr;
+
+            try
+            {
+                completion->work();
+            }
+            catch (...)
+            {
+                completion->work.reset();
+                _taskPool.release(completion);
+                throw;
+            }
+
+            completion->work.reset();
+            _taskPool.release(completion);
+            ++totalRun;
         }
+
+        return totalRun;
     }
 
-    bool Producer::allCompleted() const
+    bool Producer::runPendingTask()
     {
-        return (_plannedTasks.empty() && _runningTasks.empty());
+        if (!_running)
+            return false;
+
+        Consumer* currConsumer = Consumer::getCurrent();
+        if (currConsumer != nullptr && currConsumer->belongsTo(*this))
+            return currConsumer->runOneTask();
+
+        Task* task = _acquireExternalTask();
+        if (task == nullptr)
+            return false;
+
+        const bool isCancelled = task->cancellation.stop_requested();
+
+        if (!isCancelled)
+            task->work();
+        task->work.reset(); // the captures are released before the completion
+
+        if (isCancelled && task->drop)
+            task->drop();
+
+        _notifyWorkDone(nullptr, task);
+        return true;
     }
 
-    //
-    //
+    std::size_t Producer::totalConsumers() const
+    {
+        return _consumers.size();
+    }
 
-    void Producer::_notifyWorkDone(Consumer* consumer)
+    std::size_t Producer::totalActiveConsumers() const
     {
-        auto lockNotifier = _waitOneTask.makeScopedLockNotifier();
+        return _totalActiveConsumers.load(std::memory_order_relaxed);
+    }
 
-        // this part is locked and will notify at the end of the scope
+    std::size_t Producer::totalNumaNodes() const
+    {
+        return std::max<std::size_t>(_nodeTasks.size(), 1);
+    }
 
-        // find the task per consumer in the "running" list
-        auto comparison = [consumer](const Task& task) { return task.consumer.get() == consumer; };
-        auto itTask = std::find_if(_runningTasks.begin(), _runningTasks.end(), comparison);
+    WaitStrategy Producer::getWaitStrategy() const
+    {
+        return _waitStrategy;
+    }
 
-        if (itTask == _runningTasks.end())
-            return; // <= this should never fail
+    SchedulerStats Producer::getStats() const
+    {
+        SchedulerStats stats;
+
+        stats.isMetricsEnabled = !_consumerMetrics.empty();
+        stats.uptimeSeconds = double(ConsumerMetrics::now() - _startTime) / 1e9;
+        stats.pendingTasks = _pendingTasks.load(std::memory_order_relaxed);
+        stats.activeConsumers = _totalActiveConsumers.load(std::memory_order_relaxed);
+        stats.totalSpawns = _totalSpawns.load(std::memory_order_relaxed);
+        stats.totalRetires = _totalRetires.load(std::memory_order_relaxed);
+
+        for (std::size_t ii = 0; ii < _lanes.size(); ++ii)
+            stats.laneDepths[ii] = _lanes[ii].approximateSize();
+
+        for (std::size_t ii = 0; ii < _consumers.size(); ++ii)
+        {
+            ConsumerStats consumerStats;
+            consumerStats.index = static_cast<unsigned int>(ii);
+            consumerStats.pinnedCpu = _consumers[ii]->getPinnedCpu();
+            consumerStats.isActive = _consumers[ii]->isRunning();
+            consumerStats.localQueueDepth = std::size_t(std::max<int64_t>(0, _consumers[ii]->getLocalQueueSize()));
 
-        // move consumer from free to busy
-        auto currConsumer = itTask->consumer;
-        _freeConsumers.push_back(currConsumer);
-        auto itConsumer = std::find(_busyConsumers.begin(), _busyConsumers.end(), currConsumer);
-        if (itConsumer != _busyConsumers.end()) // <= this should never fail
-            _busyConsumers.erase(itConsumer);
+            if (ii < _consumerMetrics.size())
+                _consumerMetrics[ii]->addTo(consumerStats, stats.queueLatency, stats.executionTime);
 
-        _runningTasks.erase(itTask);
+            stats.consumers.push_back(consumerStats);
+        }
 
-        // wake up potentially waiting (main) thread
-        if (_plannedTasks.empty() && _runningTasks.empty())
-            _waitAllTask.notify();
+        return stats;
     }
 
-    void Producer::_threadedMethod()
+    void Producer::writeChromeTrace(std::ostream& stream) const
     {
-        auto lock = _waitOneTask.makeScopedLock();
+        // microseconds since initialise()
+        auto toMicroseconds = [this](int64_t nanoseconds)
+        {
+            return double(nanoseconds - _startTime) / 1000.0;
+        };
 
-        // this part is locked
+        const auto flags = stream.flags();
+        const auto precision = stream.precision();
+        stream << std::fixed << std::setprecision(3);
 
-        _running = true;
+        stream << "{\"traceEvents\":[";
 
-        while (_running)
+        bool isFirst = true;
+        auto separate = [&stream, &isFirst]()
         {
-            // wait -> release the lock for other thread(s)
-            _waitOneTask.waitUntilNotified(lock);
+            stream << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+        };
+
+        for (std::size_t ii = 0; ii < _consumerMetrics.size(); ++ii)
+        {
+            separate();
+            stream
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ii
+                << ",\"args\":{\"name\":\"consumer " << ii << "\"}}";
+
+            for (const ConsumerMetrics::TraceEvent& event : _consumerMetrics[ii]->getTraceEvents())
+            {
+                separate();
+                stream
+                    << "{\"name\":\"task\",\"cat\":\"task\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ii
+                    << ",\"ts\":" << toMicroseconds(event.startTime)
+                    << ",\"dur\":" << double(event.endTime - event.startTime) / 1000.0
+                    << ",\"args\":{\"queued_us\":" << double(event.startTime - event.enqueueTime) / 1000.0 << "}}";
+            }
+        }
+
+        stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    const Topology& Producer::getTopology() const
+    {
+        return _topology;
+    }
+
+    //
+    //
+
+    Task* Producer::_acquireUrgentTask(Consumer& consumer)
+    {
+        if (_lanePolicy != LanePolicy::Strict)
+            return nullptr;
+
+        TaskLane& highLane = _lanes[std::size_t(TaskPriority::High)];
+        if (highLane.isEmpty())
+            return nullptr;
 
-            // this part is locked
+        // starvation protection: sometimes the consumer's own tasks (or the lower lanes) go first
+        if (_starvationInterval > 0 && consumer.getRandomValue() % _starvationInterval == 0)
+            return nullptr;
 
-            if (!_running)
-                break; // quit scenario
+        return _popLaneTask(std::size_t(TaskPriority::High));
+    }
 
-            while (!_plannedTasks.empty())
+    Task* Producer::_acquireTask(Consumer& consumer)
+    {
+        // shared lanes, the normal lane after the own node queue (memory local to the consumer)
+        for (std::size_t lane : _getLaneOrder(consumer))
+        {
+            if (lane == std::size_t(TaskPriority::Normal) && !_nodeTasks.empty())
             {
-                if (_freeConsumers.empty())
-                    break; // no consumer available, wait again
+                if (Task* task = _popNodeTask(consumer.getNumaNode()))
+                    return task;
+            }
 
-                // move consumer from free to busy
-                auto currConsumer = _freeConsumers.front();
-                _busyConsumers.push_back(currConsumer);
-                _freeConsumers.pop_front();
+            if (Task* task = _popLaneTask(lane))
+                return task;
+        }
 
-                Task& currentTask = _plannedTasks.front();
+        // the other node queues: a hint, not a reason to stay idle
+        for (std::size_t ii = 0; ii < _nodeTasks.size(); ++ii)
+        {
+            if (ii == consumer.getNumaNode())
+                continue;
 
-                // run task
-                currentTask.consumer = currConsumer;
-                currConsumer->execute(currentTask.work);
+            if (Task* task = _popNodeTask(static_cast<unsigned int>(ii)))
+                return task;
+        }
+
+        // then steal, start from a random victim
+        // => several nodes: the victims of the same node first
+        const std::size_t totalConsumers = _consumers.size();
+        const std::size_t startIndex = consumer.getRandomValue() % totalConsumers;
+        const int totalPasses = _nodeTasks.empty() ? 1 : 2;
+
+        for (int pass = 0; pass < totalPasses; ++pass)
+        {
+            for (std::size_t ii = 0; ii < totalConsumers; ++ii)
+            {
+                Consumer* victim = _consumers[(startIndex + ii) % totalConsumers].get();
+                if (victim == &consumer)
+                    continue;
+
+                if (totalPasses == 2 && (victim->getNumaNode() == consumer.getNumaNode()) != (pass == 0))
+                    continue;
 
-                // move task from planned to running
-                _runningTasks.push_back(currentTask);
-                _plannedTasks.pop_front();
+                if (Task* task = victim->steal())
+                {
+                    if (ConsumerMetrics* metrics = consumer.getMetrics())
+                        metrics->onTaskStolen();
+
+                    return task;
+                }
             }
         }
+
+        return nullptr;
+    }
+
+    void Producer::_stampEnqueueTime(Task* task) const
+    {
+        if (_consumerMetrics.empty() && !_isElastic)
+            return;
+
+        // sampled per pushing thread, the other tasks are only counted
+        static thread_local unsigned int tl_totalPushes = 0;
+
+        task->enqueueTime = ((tl_totalPushes++ & _metricsSamplingMask) == 0 ? ConsumerMetrics::now() : 0);
+    }
+
+    Task* Producer::_acquireExternalTask()
+    {
+        // a helping thread that is not a consumer: no node, no local queue, strict priorities
+        for (std::size_t ii = 0; ii < _lanes.size(); ++ii)
+            if (Task* task = _popLaneTask(ii))
+                return task;
+
+        for (std::size_t ii = 0; ii < _nodeTasks.size(); ++ii)
+            if (Task* task = _popNodeTask(static_cast<unsigned int>(ii)))
+                return task;
+
+        // spread the helpers over the victims
+        static thread_local std::size_t tl_stealIndex = 0;
+
+        const std::size_t totalConsumers = _consumers.size();
+        const std::size_t startIndex = tl_stealIndex++;
+
+        for (std::size_t ii = 0; ii < totalConsumers; ++ii)
+            if (Task* task = _consumers[(startIndex + ii) % totalConsumers]->steal())
+                return task;
+
+        return nullptr;
+    }
+
+    void Producer::_notifyTaskStart(Consumer& consumer, const Task* task)
+    {
+        static_cast<void>(consumer); // unused
+
+        if (!_isElastic || _totalActiveConsumers.load(std::memory_order_relaxed) >= _consumers.size())
+            return;
+
+        // the queued tasks wait too long -> more consumers
+        if (ConsumerMetrics::now() - task->enqueueTime < _spawnLatency)
+            return;
+
+        _spawnConsumers();
+    }
+
+    void Producer::_waitForTask(Consumer& consumer)
+    {
+        // never sleep: back to the idle rounds
+        if (_waitStrategy == WaitStrategy::Spin)
+        {
+            cpuRelax();
+            return;
+        }
+
+        const uint32_t key = _idleConsumers.prepareWait();
+
+        // re-check after announcing the wait, a push in between will wake us up
+        if (!consumer.isRunning() || _hasVisibleTask())
+        {
+            _idleConsumers.cancelWait();
+            return;
+        }
+
+        if (!_isElastic || _totalActiveConsumers.load(std::memory_order_relaxed) <= _minConsumers)
+        {
+            _idleConsumers.commitWait(key);
+            return;
+        }
+
+        // elastic: sleep until the end of the idle timeout at most, then retire
+        const int64_t idleDuration = ConsumerMetrics::now() - consumer.getIdleSince();
+        const int64_t timeout = std::max<int64_t>(_retireTimeout - idleDuration, 0);
+
+        if (_idleConsumers.commitWaitFor(key, std::chrono::nanoseconds(timeout)))
+            return;
+
+        _tryRetire(consumer);
+    }
+
+    void Producer::_notifyWorkDone(Consumer* consumer, Task* task)
+    {
+        static_cast<void>(consumer); // unused
+
+        // posted before the completion count: update() see it once waitUntilAllCompleted() return
+        if (task->completion != nullptr)
+            _completions.push(task->completion);
+
+        _taskPool.release(task);
+
+        if (_pendingTasks.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        // last task -> wake up potentially waiting (main) thread(s)
+        auto notifier = _waitAllTask.makeScopedLockAllNotifier();
+    }
+
+    //
+    //
+
+    void Producer::_discardTask(Task* task)
+    {
+        task->work.reset();
+        _taskPool.release(task);
+    }
+
+    void Producer::_schedule(Task* task)
+    {
+        _stampEnqueueTime(task);
+        _pendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+        Consumer* currConsumer = Consumer::getCurrent();
+        if (currConsumer != nullptr && currConsumer->belongsTo(*this))
+        {
+            // pushed from one of our consumers (nested task) -> local queue
+            currConsumer->push(task);
+        }
+        else
+        {
+            _lanes[std::size_t(TaskPriority::Normal)].push(task);
+        }
+
+        // no lock, no syscall when no consumer is sleeping
+        _idleConsumers.notifyOne();
+    }
+
+    void Producer::_scheduleBulk(Task** tasks, std::size_t totalTasks)
+    {
+        if (totalTasks == 0)
+            return;
+
+        for (std::size_t ii = 0; ii < totalTasks; ++ii)
+            _stampEnqueueTime(tasks[ii]);
+
+        _pendingTasks.fetch_add(int64_t(totalTasks), std::memory_order_relaxed);
+
+        Consumer* currConsumer = Consumer::getCurrent();
+        if (currConsumer != nullptr && currConsumer->belongsTo(*this))
+        {
+            // pushed from one of our consumers -> local queue, the woken up ones steal
+            for (std::size_t ii = 0; ii < totalTasks; ++ii)
+                currConsumer->push(tasks[ii]);
+        }
+        else
+        {
+            _lanes[std::size_t(TaskPriority::Normal)].pushBulk(tasks, totalTasks);
+        }
+
+        // one wake up for the batch, at most one consumer per task
+        _idleConsumers.notifyMany(int(std::min<std::size_t>(totalTasks, _consumers.size())));
+    }
+
+    void Producer::_scheduleToLane(TaskPriority priority, Task* task)
+    {
+        // normal -> usual path (local queue from a consumer)
+        if (priority == TaskPriority::Normal)
+        {
+            _schedule(task);
+            return;
+        }
+
+        _stampEnqueueTime(task);
+        _pendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+        _lanes[std::size_t(priority)].push(task);
+
+        _idleConsumers.notifyOne();
+    }
+
+    void Producer::_scheduleWithDeadline(TaskPriority priority, std::chrono::steady_clock::time_point deadline, Task* task)
+    {
+        _stampEnqueueTime(task);
+        _pendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+        _lanes[std::size_t(priority)].pushWithDeadline(task, deadline);
+
+        _idleConsumers.notifyOne();
+    }
+
+    void Producer::_scheduleToNumaNode(unsigned int numaNode, Task* task)
+    {
+        Consumer* currConsumer = Consumer::getCurrent();
+        const bool isOwnConsumer = (currConsumer != nullptr && currConsumer->belongsTo(*this));
+
+        // no node queue, unknown node, or already on the node -> usual path
+        if (numaNode >= _nodeTasks.size() || (isOwnConsumer && currConsumer->getNumaNode() == numaNode))
+        {
+            _schedule(task);
+            return;
+        }
+
+        _stampEnqueueTime(task);
+        _pendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+        if (!_nodeTasks[numaNode]->tryPush(task))
+        {
+            // full node queue -> usual path (not visible yet, no consumer could have run it)
+            _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+            _schedule(task);
+            return;
+        }
+
+        // any consumer may be woken up, the other nodes also take from this queue
+        _idleConsumers.notifyOne();
+    }
+
+    std::array<std::size_t, k_totalTaskPriorities> Producer::_getLaneOrder(Consumer& consumer) const
+    {
+        std::array<std::size_t, k_totalTaskPriorities> order = { 0, 1, 2 }; // high to low
+
+        if (_lanePolicy == LanePolicy::Weighted)
+        {
+            // the picked lane first, then the others from high to low
+            unsigned int pick = consumer.getRandomValue() % _totalLaneWeight;
+
+            std::size_t pickedLane = 0;
+            while (pick >= _laneWeights[pickedLane])
+                pick -= _laneWeights[pickedLane++];
+
+            std::rotate(order.begin(), order.begin() + pickedLane, order.begin() + pickedLane + 1);
+        }
+        else if (_starvationInterval > 0 && consumer.getRandomValue() % _starvationInterval == 0)
+        {
+            // starvation protection: low to high
+            std::reverse(order.begin(), order.end());
+        }
+
+        return order;
+    }
+
+    Task* Producer::_popLaneTask(std::size_t lane)
+    {
+        Task* task = _lanes[lane].tryPop();
+
+        // more work -> chain wake up an other sleeping consumer
+        if (task != nullptr && !_lanes[lane].isEmpty())
+            _idleConsumers.notifyOne();
+
+        return task;
+    }
+
+    Task* Producer::_popNodeTask(unsigned int numaNode)
+    {
+        if (numaNode >= _nodeTasks.size())
+            return nullptr;
+
+        return _nodeTasks[numaNode]->tryPop();
+    }
+
+    bool Producer::_hasVisibleTask() const
+    {
+        for (const TaskLane& lane : _lanes)
+            if (!lane.isEmpty())
+                return true;
+
+        for (const auto& nodeTasks : _nodeTasks)
+            if (!nodeTasks->isEmpty())
+                return true;
+
+        for (const auto& consumer : _consumers)
+            if (consumer->hasLocalTasks())
+                return true;
+
+        return false;
+    }
+
+    void Producer::_spawnConsumers()
+    {
+        // one spawner at a time: a consumer seeing the same backlog meanwhile go on with its task
+        std::unique_lock<std::mutex> lock(_elasticMutex, std::try_to_lock);
+        if (!lock.owns_lock() || !_running)
+            return;
+
+        // double the active consumers: a burst reach the maximum in a few samples, the idle ones retire later
+        std::size_t totalToSpawn = std::max<std::size_t>(_totalActiveConsumers.load(std::memory_order_relaxed), 1);
+
+        for (auto& consumer : _consumers)
+        {
+            if (totalToSpawn == 0)
+                return;
+
+            if (consumer->isRunning())
+                continue;
+
+            _totalActiveConsumers.fetch_add(1, std::memory_order_relaxed);
+            _totalSpawns.fetch_add(1, std::memory_order_relaxed);
+
+            consumer->start(); // join the thread of its previous retirement first
+            --totalToSpawn;
+        }
+    }
+
+    void Producer::_tryRetire(Consumer& consumer)
+    {
+        std::size_t totalActive = _totalActiveConsumers.load(std::memory_order_relaxed);
+        do
+        {
+            if (totalActive <= _minConsumers)
+                return;
+        }
+        while (!_totalActiveConsumers.compare_exchange_weak(totalActive, totalActive - 1, std::memory_order_seq_cst));
+
+        // a task pushed in between may have found no sleeping consumer to wake up: stay for it
+        // (the other active consumers, at least minConsumers, follow the usual wait protocol)
+        if (_hasVisibleTask())
+        {
+            _totalActiveConsumers.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // the consumer's loop end with this wait, its local queue is empty (only its own thread push there)
+        consumer.requestQuit();
+        _totalRetires.fetch_add(1, std::memory_order_relaxed);
     }
 
 };
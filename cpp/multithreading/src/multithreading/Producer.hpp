@@ -2,62 +2,460 @@
 #pragma once
 
 #include "internals/IProducer.hpp"
+#include "internals/CompletionQueue.hpp"
 #include "internals/Consumer.hpp"
+#include "internals/EventCount.hpp"
+#include "internals/MpmcTaskQueue.hpp"
+#include "internals/TaskLane.hpp"
+#include "internals/TaskPool.hpp"
 #include "internals/ThreadSynchroniser.hpp"
 
+#include "CancellationToken.hpp"
+#include "SchedulerStats.hpp"
+#include "TaskPriority.hpp"
+#include "Topology.hpp"
+
+#include "utilities/ErrorHandler.hpp"
 #include "utilities/NonCopyable.hpp"
 
-#include <list>
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 namespace multithreading
 {
+    template<typename Result>
+    class TaskFuture;
+
+    class ScheduleAwaiter;
+
+    enum class LanePolicy
+    {
+        Strict, // the highest non empty lane first, the high lane even before the consumer's own tasks
+        Weighted, // the first lane tried is picked at random, proportionally to the lane weights
+    };
+
+    struct ProducerSettings
+    {
+    public:
+        unsigned int totalConsumers = 0; // 0: one per allowed cpu (per physical core with PinningStrategy::PhysicalCores)
+        PinningStrategy pinning = PinningStrategy::None;
+
+        LanePolicy lanePolicy = LanePolicy::Strict;
+        std::array<unsigned int, k_totalTaskPriorities> laneWeights = { 8, 4, 1 }; // LanePolicy::Weighted only
+        unsigned int starvationInterval = 32; // LanePolicy::Strict: about one pick in N start from the low lane (0: never)
+
+        // waitUntilAllCompleted() and TaskGraph waits, WaitStrategy::Spin also keep the idle consumers awake
+        WaitStrategy waitStrategy = WaitStrategy::Blocking;
+
+        // elastic worker count: minConsumers run at first, up to totalConsumers under load
+        // => 0 (or not under totalConsumers): fixed, all the consumers run until quit()
+        // => the active consumers doubled when a sampled task waited longer than spawnLatency before starting
+        // => a consumer idle for retireTimeout exit its thread, down to minConsumers (never with WaitStrategy::Spin)
+        unsigned int minConsumers = 0;
+        std::chrono::microseconds spawnLatency{1000};
+        std::chrono::milliseconds retireTimeout{200};
+
+        // per consumer counters, busy/idle time, latency histograms (see getStats())
+        bool enableMetrics = false;
+        unsigned int metricsSamplingInterval = 64; // push/start/end timestamps for one task in N (1: all, rounded up to a power of two), also the elastic latency samples (one in 8 at least)
+        std::size_t traceCapacity = 0; // sampled tasks kept per consumer for writeChromeTrace() (0: none)
+    };
+
+    // work stealing scheduler, no dispatcher thread:
+    // => each consumer has its own deque, a task pushed from a consumer's thread stay local
+    // => a task pushed from any other thread go in the shared lane of its priority (lock free)
+    // => an idle consumer take from the shared lanes (see LanePolicy), then steal from a random consumer
+    // => pinned consumers on several NUMA nodes: one more shared queue per node (pushToNumaNode())
     class Producer
         : public IProducer
         , public NonCopyable
     {
     private:
-        struct Task
-        {
-        public:
-            WorkCallback work = nullptr;
-            std::shared_ptr<Consumer> consumer = nullptr;
-
-        public:
-            Task(const WorkCallback& work);
-        };
+        static constexpr std::size_t k_bulkBatchSize = 256;
+        static constexpr unsigned int k_maxElasticSamplingMask = 7; // elastic: one task in 8 sampled at least
 
     private:
-        std::thread _thread;
-        ThreadSynchroniser _waitOneTask;
+        TaskPool _taskPool; // must outlive the queues and the consumers
+
+        EventCount _idleConsumers;
         ThreadSynchroniser _waitAllTask;
 
-        bool _running = false;
+        std::atomic<bool> _running{false};
+
+        // the maximum count, all constructed by initialise(): a retired consumer keep its slot (and stay a stealing victim)
+        std::vector<std::unique_ptr<Consumer>> _consumers;
+
+        // elastic worker count (see ProducerSettings::minConsumers)
+        bool _isElastic = false;
+        std::size_t _minConsumers = 0;
+        int64_t _spawnLatency = 0; // nanoseconds
+        int64_t _retireTimeout = 0; // nanoseconds
+        std::mutex _elasticMutex; // start/join of the consumer threads after initialise()
+        std::atomic<std::size_t> _totalActiveConsumers{0};
+        std::atomic<uint64_t> _totalSpawns{0};
+        std::atomic<uint64_t> _totalRetires{0};
+
+        // one per TaskPriority
+        std::array<TaskLane, k_totalTaskPriorities> _lanes;
+
+        LanePolicy _lanePolicy = LanePolicy::Strict;
+        std::array<unsigned int, k_totalTaskPriorities> _laneWeights = { 1, 1, 1 };
+        unsigned int _totalLaneWeight = 3;
+        unsigned int _starvationInterval = 0;
+
+        WaitStrategy _waitStrategy = WaitStrategy::Blocking;
 
-        std::list<std::shared_ptr<Consumer>> _consumers;
-        std::list<std::shared_ptr<Consumer>> _freeConsumers;
-        std::list<std::shared_ptr<Consumer>> _busyConsumers;
+        // one per consumer, empty when disabled
+        std::vector<std::unique_ptr<ConsumerMetrics>> _consumerMetrics;
+        unsigned int _metricsSamplingMask = 0; // sampling interval - 1
+        int64_t _startTime = 0; // see ConsumerMetrics::now()
 
-        std::list<Task> _plannedTasks;
-        std::list<Task> _runningTasks;
+        std::atomic<int64_t> _pendingTasks{0}; // planned + in a local queue + running
+
+        // pushWithCompletion(): posted by the consumers, run by update()
+        CompletionQueue _completions;
+        Task* _completionBacklog = nullptr; // update() thread only, left by a throwing completion
+
+        Topology _topology;
+
+        // one per NUMA node, empty when the consumers are not pinned or on one node
+        std::vector<std::unique_ptr<MpmcTaskQueue>> _nodeTasks;
 
     public:
         Producer() = default;
         virtual ~Producer();
 
     public:
-        void initialise(unsigned int totalCores);
-        void push(const WorkCallback& work);
+        void initialise(unsigned int totalConsumers); // not pinned
+        void initialise(const ProducerSettings& settings);
+
+        // the callable is constructed in a pooled task, no copy and no allocation
+        // (as long as its captures fit in the WorkCallback inline storage)
+        template<typename Callable>
+        void push(Callable&& callable)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            _schedule(_makeTask(std::forward<Callable>(callable)));
+        }
+
+        // same as push(), "ondrop" is run instead of the callable if the task never run:
+        // => still queued in a shared lane when quit() is called
+        // => the push itself failed (not running, the callable construction threw), then rethrown
+        // (how a future, a group or a graph waiting for the task learn it will never be done)
+        template<typename Callable, typename OnDrop>
+        void pushWithDrop(Callable&& callable, OnDrop ondrop)
+        {
+            if (!_running)
+            {
+                ondrop();
+                D_THROW(std::runtime_error, "producer not running");
+            }
+
+            Task* newTask = nullptr;
+
+            try
+            {
+                newTask = _fillTask(
+                    [&callable, &ondrop](Task* task)
+                    {
+                        task->work.assign(std::forward<Callable>(callable));
+                        task->drop.assign(ondrop);
+                    });
+            }
+            catch (...)
+            {
+                ondrop();
+                throw;
+            }
+
+            _schedule(newTask);
+        }
+
+        // a high priority task is not delayed by the normal ones, even pushed from a consumer
+        template<typename Callable>
+        void push(TaskPriority priority, Callable&& callable)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            _scheduleToLane(priority, _makeTask(std::forward<Callable>(callable)));
+        }
+
+        // run before the tasks of the same priority without a deadline, earliest deadline first
+        // => an ordering only: a task past its deadline is still run
+        template<typename Callable>
+        void pushWithDeadline(TaskPriority priority, std::chrono::steady_clock::time_point deadline, Callable&& callable)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            _scheduleWithDeadline(priority, deadline, _makeTask(std::forward<Callable>(callable)));
+        }
+
+        // dropped without running when the token is cancelled (or past its deadline) before the task start
+        // => a callable taking a const CancellationToken& receive it, to poll stop_requested() while running
+        template<typename Callable>
+        void push(const CancellationToken& token, Callable&& callable)
+        {
+            push(TaskPriority::Normal, token, std::forward<Callable>(callable));
+        }
+
+        template<typename Callable>
+        void push(TaskPriority priority, const CancellationToken& token, Callable&& callable)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            Task* newTask = _fillTask(
+                [&token, &callable](Task* task)
+                {
+                    _assignCancellable(task, token, std::forward<Callable>(callable));
+                });
+            _scheduleToLane(priority, newTask);
+        }
+
+        // "work" run on a consumer, then "oncomplete" run on the thread calling update() (the owner thread)
+        // => both callables go in pooled tasks, no allocation
+        template<typename Work, typename OnComplete>
+        void pushWithCompletion(Work&& work, OnComplete&& oncomplete)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            Task* completion = _makeTask(std::forward<OnComplete>(oncomplete));
+            Task* newTask = nullptr;
+
+            try
+            {
+                newTask = _makeTask(std::forward<Work>(work));
+            }
+            catch (...)
+            {
+                _discardTask(completion);
+                throw;
+            }
+
+            newTask->completion = completion;
+            _schedule(newTask);
+        }
+
+        // makeCallable(index) give the callable of the task "index", for index in [0, totalTasks)
+        // => the tasks are published by batches: one queue claim and one batched wake up per batch
+        template<typename Generator>
+        void pushBulk(std::size_t totalTasks, Generator&& makeCallable)
+        {
+            _pushBulk(totalTasks, makeCallable, nullptr);
+        }
+
+        // same, "ondrop" (copied in every task) is run once per task that never run (see pushWithDrop())
+        // => a throwing makeCallable() leave the earlier batches queued, "ondrop" is run for all the others
+        template<typename Generator, typename OnDrop>
+        void pushBulk(std::size_t totalTasks, Generator&& makeCallable, const OnDrop& ondrop)
+        {
+            _pushBulk(totalTasks, makeCallable, ondrop);
+        }
+
+        // the callables are moved from
+        template<typename Callable>
+        void pushBulk(std::span<Callable> callables)
+        {
+            pushBulk(callables.size(), [&callables](std::size_t index) -> Callable&& { return std::move(callables[index]); });
+        }
+
+        // same as push() but the task is preferably run by a consumer of this NUMA node
+        // (same as push() when there is no per node queue or the node is unknown)
+        template<typename Callable>
+        void pushToNumaNode(unsigned int numaNode, Callable&& callable)
+        {
+            if (!_running)
+                D_THROW(std::runtime_error, "producer not running");
+
+            _scheduleToNumaNode(numaNode, _makeTask(std::forward<Callable>(callable)));
+        }
+
+        // same as push() but the result (or the exception) reach the returned TaskFuture
+        // (defined in TaskFuture.hpp)
+        template<typename Callable>
+        auto submit(Callable&& callable);
+
+        // co_await producer.schedule(): the coroutine continue on a consumer
+        // (defined in Coroutine.hpp)
+        ScheduleAwaiter schedule();
+
         void quit();
-        void waitUntilAllCompleted();
+        void waitUntilAllCompleted(); // the work only: the completions wait for update()
+
         bool allCompleted() const;
 
+        // run the completions of the finished tasks (see pushWithCompletion()) on the calling thread
+        // => every completion posted so far is taken at once, an oncomplete may push new tasks
+        // => one thread at a time (the owner thread), also after quit(), return the number run
+        std::size_t update();
+
+        // run one queued task on the calling thread (help while waiting), false if none was found
+        // => from one of the consumers: same as Consumer::runOneTask()
+        // => also false once quit() is called: a helping waiter is left waiting for the dropped tasks
+        bool runPendingTask();
+
+        std::size_t totalConsumers() const; // the maximum with an elastic worker count
+        std::size_t totalActiveConsumers() const; // with a running thread
+        std::size_t totalNumaNodes() const; // with a per node queue, 1 otherwise
+        WaitStrategy getWaitStrategy() const;
+
+        // snapshot from any thread (the counters of a running consumer may be a bit behind)
+        SchedulerStats getStats() const;
+        // the sampled tasks as a chrome://tracing (or Perfetto) timeline, one row per consumer
+        // => call it once the tasks are completed (waitUntilAllCompleted())
+        void writeChromeTrace(std::ostream& stream) const;
+        const Topology& getTopology() const;
+
     private:
-        virtual void _notifyWorkDone(Consumer* consumer) override;
-        void _threadedMethod();
+        virtual Task* _acquireUrgentTask(Consumer& consumer) override;
+        virtual Task* _acquireTask(Consumer& consumer) override;
+        virtual void _notifyTaskStart(Consumer& consumer, const Task* task) override;
+        virtual void _waitForTask(Consumer& consumer) override;
+        virtual void _notifyWorkDone(Consumer* consumer, Task* task) override;
+
+        // a pooled task filled by fill(task), released if fill() throw (a throwing copy/move, a bad_alloc)
+        template<typename Fill>
+        Task* _fillTask(Fill&& fill)
+        {
+            Task* newTask = _taskPool.acquire();
+
+            try
+            {
+                fill(newTask);
+            }
+            catch (...)
+            {
+                _discardTask(newTask);
+                throw;
+            }
+
+            return newTask;
+        }
+
+        template<typename Callable>
+        Task* _makeTask(Callable&& callable)
+        {
+            return _fillTask(
+                [&callable](Task* task)
+                {
+                    task->work.assign(std::forward<Callable>(callable));
+                });
+        }
+
+        void _discardTask(Task* task); // never scheduled: no drop run
+
+        template<typename Callable>
+        static void _assignCancellable(Task* task, const CancellationToken& token, Callable&& callable)
+        {
+            task->cancellation = token;
+
+            if constexpr (std::is_invocable<std::decay_t<Callable>&, const CancellationToken&>::value)
+            {
+                // the task record outlive the run: its token can be handed by reference
+                task->work.assign([task, callable = std::decay_t<Callable>(std::forward<Callable>(callable))]() mutable
+                {
+                    callable(static_cast<const CancellationToken&>(task->cancellation));
+                });
+            }
+            else
+            {
+                task->work.assign(std::forward<Callable>(callable));
+            }
+        }
+
+        // ondrop: nullptr for none
+        template<typename Generator, typename OnDrop>
+        void _pushBulk(std::size_t totalTasks, Generator& makeCallable, const OnDrop& ondrop)
+        {
+            constexpr bool hasDrop = !std::is_same<OnDrop, std::nullptr_t>::value;
+
+            if (!_running)
+            {
+                if constexpr (hasDrop)
+                {
+                    for (std::size_t ii = 0; ii < totalTasks; ++ii)
+                        ondrop();
+                }
+                D_THROW(std::runtime_error, "producer not running");
+            }
+
+            Task* batch[k_bulkBatchSize];
+            std::size_t totalAcquired = 0; // in the batch being built
+            std::size_t totalQueued = 0;
+
+            try
+            {
+                for (std::size_t firstIndex = 0; firstIndex < totalTasks; firstIndex += k_bulkBatchSize)
+                {
+                    const std::size_t batchSize = std::min(k_bulkBatchSize, totalTasks - firstIndex);
+
+                    for (std::size_t ii = 0; ii < batchSize; ++ii)
+                    {
+                        batch[ii] = _taskPool.acquire();
+                        ++totalAcquired;
+
+                        batch[ii]->work.assign(makeCallable(firstIndex + ii));
+                        if constexpr (hasDrop)
+                            batch[ii]->drop.assign(ondrop);
+                    }
+
+                    _scheduleBulk(batch, batchSize);
+                    totalQueued += batchSize;
+                    totalAcquired = 0;
+                }
+            }
+            catch (...)
+            {
+                // makeCallable() (or a callable construction) threw: the earlier batches are queued, not this one
+                for (std::size_t ii = 0; ii < totalAcquired; ++ii)
+                    _discardTask(batch[ii]);
+
+                if constexpr (hasDrop)
+                {
+                    for (std::size_t ii = totalQueued; ii < totalTasks; ++ii)
+                        ondrop();
+                }
+                throw;
+            }
+        }
+
+        void _schedule(Task* task);
+        void _scheduleBulk(Task** tasks, std::size_t totalTasks);
+        void _scheduleToLane(TaskPriority priority, Task* task);
+        void _scheduleWithDeadline(TaskPriority priority, std::chrono::steady_clock::time_point deadline, Task* task);
+        void _scheduleToNumaNode(unsigned int numaNode, Task* task);
+        void _stampEnqueueTime(Task* task) const;
+        Task* _acquireExternalTask();
+        std::array<std::size_t, k_totalTaskPriorities> _getLaneOrder(Consumer& consumer) const;
+        Task* _popLaneTask(std::size_t lane);
+        Task* _popNodeTask(unsigned int numaNode); // nullptr when empty or unknown node
+        bool _hasVisibleTask() const;
+        void _spawnConsumers();
+        void _tryRetire(Consumer& consumer);
     };
 
 };
+
+// submit() and the TaskFuture definitions
+#include "TaskFuture.hpp"
+
+// schedule() and the coroutine types
+#include "Coroutine.hpp"
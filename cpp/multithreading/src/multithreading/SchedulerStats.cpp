@@ -0,0 +1,160 @@
+
+#include "SchedulerStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+
+namespace multithreading
+{
+
+    namespace
+    {
+        void printHistogram(std::ostream& stream, const char* name, const HistogramSnapshot& histogram)
+        {
+            stream << "  " << std::left << std::setw(16) << name << std::right;
+
+            if (histogram.totalSamples == 0)
+            {
+                stream << "no sample" << std::endl;
+                return;
+            }
+
+            stream
+                << "p50 " << std::setw(9) << double(histogram.getPercentile(50.0)) / 1000.0 << "us"
+                << "  p90 " << std::setw(9) << double(histogram.getPercentile(90.0)) / 1000.0 << "us"
+                << "  p99 " << std::setw(9) << double(histogram.getPercentile(99.0)) / 1000.0 << "us"
+                << "  max " << std::setw(9) << double(histogram.getMax()) / 1000.0 << "us"
+                << "  (" << histogram.totalSamples << " samples)" << std::endl;
+        }
+    };
+
+    //
+    //
+
+    std::size_t HistogramSnapshot::getBucketIndex(uint64_t nanoseconds)
+    {
+        if (nanoseconds < k_subBuckets)
+            return std::size_t(nanoseconds);
+
+        // the 3 bits after the most significant one select the sub bucket
+        const std::size_t highestBit = std::size_t(63 - std::countl_zero(nanoseconds));
+        const std::size_t subBucket = std::size_t(nanoseconds >> (highestBit - 3)) & (k_subBuckets - 1);
+        return (highestBit - 2) * k_subBuckets + subBucket;
+    }
+
+    uint64_t HistogramSnapshot::getBucketUpperBound(std::size_t index)
+    {
+        if (index < k_subBuckets)
+            return uint64_t(index);
+
+        const std::size_t highestBit = index / k_subBuckets + 2;
+        const uint64_t subBucket = uint64_t(index % k_subBuckets);
+        const uint64_t lowerBound = (k_subBuckets + subBucket) << (highestBit - 3);
+        return lowerBound + ((uint64_t(1) << (highestBit - 3)) - 1);
+    }
+
+    uint64_t HistogramSnapshot::getPercentile(double percentile) const
+    {
+        if (totalSamples == 0)
+            return 0;
+
+        const double clamped = std::clamp(percentile, 0.0, 100.0);
+        const uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(clamped / 100.0 * double(totalSamples))));
+
+        uint64_t cumulated = 0;
+        for (std::size_t ii = 0; ii < buckets.size(); ++ii)
+        {
+            cumulated += buckets[ii];
+            if (cumulated >= rank)
+                return getBucketUpperBound(ii);
+        }
+
+        return getMax();
+    }
+
+    uint64_t HistogramSnapshot::getMax() const
+    {
+        for (std::size_t ii = buckets.size(); ii > 0; --ii)
+            if (buckets[ii - 1] > 0)
+                return getBucketUpperBound(ii - 1);
+
+        return 0;
+    }
+
+    void HistogramSnapshot::merge(const HistogramSnapshot& other)
+    {
+        for (std::size_t ii = 0; ii < buckets.size() && ii < other.buckets.size(); ++ii)
+            buckets[ii] += other.buckets[ii];
+
+        totalSamples += other.totalSamples;
+    }
+
+    //
+    //
+
+    double SchedulerStats::getUtilisation() const
+    {
+        double busySeconds = 0.0;
+        double totalSeconds = 0.0;
+        for (const ConsumerStats& consumer : consumers)
+        {
+            busySeconds += consumer.busySeconds;
+            totalSeconds += consumer.busySeconds + consumer.idleSeconds;
+        }
+
+        return totalSeconds > 0.0 ? busySeconds / totalSeconds : 0.0;
+    }
+
+    void SchedulerStats::print(std::ostream& stream) const
+    {
+        const auto flags = stream.flags();
+        const auto precision = stream.precision();
+
+        stream << std::fixed << std::setprecision(1);
+
+        stream
+            << "scheduler: " << consumers.size() << " consumers, up " << uptimeSeconds << "s"
+            << ", pending " << pendingTasks
+            << ", lanes high/normal/low " << laneDepths[0] << "/" << laneDepths[1] << "/" << laneDepths[2]
+            << std::endl;
+
+        if (activeConsumers != consumers.size() || totalSpawns > 0 || totalRetires > 0)
+            stream << "  elastic: " << activeConsumers << " active, " << totalSpawns << " spawns, " << totalRetires << " retires" << std::endl;
+
+        if (!isMetricsEnabled)
+        {
+            stream << "  (metrics disabled, gauges only)" << std::endl;
+            stream.flags(flags);
+            stream.precision(precision);
+            return;
+        }
+
+        stream << "  utilisation " << getUtilisation() * 100.0 << "%" << std::endl;
+
+        printHistogram(stream, "queue latency", queueLatency);
+        printHistogram(stream, "execution time", executionTime);
+
+        for (const ConsumerStats& consumer : consumers)
+        {
+            const double totalSeconds = consumer.busySeconds + consumer.idleSeconds;
+            const double busyRatio = totalSeconds > 0.0 ? consumer.busySeconds / totalSeconds : 0.0;
+
+            stream
+                << "  consumer " << std::setw(3) << consumer.index
+                << "  tasks " << std::setw(10) << consumer.totalTasksRun
+                << "  stolen " << std::setw(8) << consumer.totalTasksStolen
+                << "  cancelled " << std::setw(8) << consumer.totalTasksCancelled
+                << "  parks " << std::setw(7) << consumer.totalParks
+                << "  busy " << std::setw(5) << busyRatio * 100.0 << "%"
+                << "  local depth " << consumer.localQueueDepth
+                << (consumer.isActive ? "" : "  (retired)")
+                << std::endl;
+        }
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+};
@@ -0,0 +1,77 @@
+
+#pragma once
+
+#include "TaskPriority.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace multithreading
+{
+    // log linear buckets (HDR style): exact under 8ns, then 8 buckets per power of two (~12% precision)
+    struct HistogramSnapshot
+    {
+    public:
+        static constexpr std::size_t k_subBuckets = 8;
+        static constexpr std::size_t k_totalBuckets = 496; // up to 2^63ns
+
+    public:
+        std::vector<uint64_t> buckets = std::vector<uint64_t>(k_totalBuckets, 0);
+        uint64_t totalSamples = 0;
+
+    public:
+        static std::size_t getBucketIndex(uint64_t nanoseconds);
+        static uint64_t getBucketUpperBound(std::size_t index);
+
+    public:
+        // upper bound of the bucket holding the percentile (0 without sample), percentile in [0, 100]
+        uint64_t getPercentile(double percentile) const;
+        uint64_t getMax() const;
+        void merge(const HistogramSnapshot& other);
+    };
+
+    struct ConsumerStats
+    {
+    public:
+        unsigned int index = 0;
+        int pinnedCpu = -1;
+        bool isActive = true; // false: retired or not spawned yet (elastic worker count)
+        uint64_t totalTasksRun = 0;
+        uint64_t totalTasksStolen = 0; // taken from an other consumer
+        uint64_t totalTasksCancelled = 0; // dropped when dequeued (see CancellationToken), not in totalTasksRun
+        uint64_t totalParks = 0; // went to sleep (or tried to) after its idle rounds
+        double busySeconds = 0.0; // running tasks back to back
+        double idleSeconds = 0.0; // looking for a task, yielding or sleeping
+        std::size_t localQueueDepth = 0; // gauge
+    };
+
+    // Producer::getStats()
+    // => the gauges are always there, the counters and histograms need ProducerSettings::enableMetrics
+    // => the histograms only see the sampled tasks (ProducerSettings::metricsSamplingInterval)
+    struct SchedulerStats
+    {
+    public:
+        bool isMetricsEnabled = false;
+        double uptimeSeconds = 0.0;
+
+        // gauges (approximate while running)
+        int64_t pendingTasks = 0;
+        std::size_t activeConsumers = 0; // with a running thread, the elastic worker count only change it
+        uint64_t totalSpawns = 0; // elastic: started after initialise()
+        uint64_t totalRetires = 0; // elastic: exited after their idle timeout
+        std::array<std::size_t, k_totalTaskPriorities> laneDepths = {};
+
+        std::vector<ConsumerStats> consumers;
+
+        HistogramSnapshot queueLatency; // push -> start
+        HistogramSnapshot executionTime; // start -> end
+
+    public:
+        double getUtilisation() const; // busy / (busy + idle) over all the consumers
+        void print(std::ostream& stream) const;
+    };
+
+};
@@ -0,0 +1,462 @@
+
+#pragma once
+
+#include "Producer.hpp"
+
+#include "internals/FutureSharedState.hpp"
+
+#include "utilities/ErrorHandler.hpp"
+
+#include <atomic>
+#include <exception>
+#include <future> // std::future_error
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multithreading
+{
+    template<typename Result>
+    class TaskFuture;
+
+    //
+    //
+
+    namespace detail
+    {
+        template<typename Result>
+        class FutureAwaiter; // co_await future (Coroutine.hpp)
+
+        // run the callable, store its result (or its exception) in the state
+        // => only the callable is guarded: the state is made ready (and its continuation run) once, outside
+        template<typename Result, typename Callable, typename... Args>
+        void fulfil(FutureSharedState<Result>& state, Callable& callable, Args&&... args)
+        {
+            if constexpr (std::is_void<Result>::value)
+            {
+                try
+                {
+                    callable(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    state.setException(std::current_exception());
+                    return;
+                }
+
+                state.setValue();
+            }
+            else
+            {
+                std::optional<Result> value;
+
+                try
+                {
+                    value.emplace(callable(std::forward<Args>(args)...));
+                }
+                catch (...)
+                {
+                    state.setException(std::current_exception());
+                    return;
+                }
+
+                state.setValue(std::move(*value));
+            }
+        }
+
+        // the task of the state will never run (dropped by quit(), or its push failed)
+        inline void breakPromise(FutureSharedStateBase& state)
+        {
+            state.setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        }
+
+        // on the producer's consumers, inline if there is no producer
+        // => "ondrop" instead of the callable when the task never run (see Producer::pushWithDrop())
+        // => never throw: called by the thread making a state ready
+        template<typename Callable, typename OnDrop>
+        void dispatch(Producer* producer, Callable&& callable, OnDrop&& ondrop)
+        {
+            if (producer == nullptr)
+            {
+                callable();
+                return;
+            }
+
+            try
+            {
+                producer->pushWithDrop(std::forward<Callable>(callable), std::forward<OnDrop>(ondrop));
+            }
+            catch (...)
+            {
+                // not pushed: "ondrop" already broke the promise
+            }
+        }
+
+        template<typename Callable, typename Result>
+        struct ContinuationResult
+        {
+            using type = std::invoke_result_t<Callable&, Result>;
+        };
+
+        template<typename Callable>
+        struct ContinuationResult<Callable, void>
+        {
+            using type = std::invoke_result_t<Callable&>;
+        };
+    };
+
+    //
+    //
+
+    // move only handle on the result of a submitted task
+    // => get(): block until ready, rethrow the task exception
+    // => then(): schedule a continuation on the pool, never block
+    template<typename Result>
+    class TaskFuture
+    {
+        template<typename OtherResult>
+        friend class TaskFuture;
+
+        template<typename OtherResult>
+        friend auto whenAll(std::vector<TaskFuture<OtherResult>> futures);
+        template<typename OtherResult>
+        friend auto whenAny(std::vector<TaskFuture<OtherResult>> futures);
+        template<typename OtherResult>
+        friend class detail::FutureAwaiter;
+
+    private:
+        FutureSharedState<Result>* _state = nullptr;
+
+    public:
+        TaskFuture() = default;
+
+        // adopt one reference
+        explicit TaskFuture(FutureSharedState<Result>* state)
+            : _state(state)
+        {}
+
+        TaskFuture(TaskFuture&& other) noexcept
+            : _state(std::exchange(other._state, nullptr))
+        {}
+
+        TaskFuture& operator=(TaskFuture&& other) noexcept
+        {
+            if (this != &other)
+            {
+                _release();
+                _state = std::exchange(other._state, nullptr);
+            }
+            return *this;
+        }
+
+        // move only
+        TaskFuture(const TaskFuture& other) = delete;
+        TaskFuture& operator=(const TaskFuture& other) = delete;
+
+        ~TaskFuture()
+        {
+            _release();
+        }
+
+    public:
+        bool isValid() const
+        {
+            return _state != nullptr;
+        }
+
+        bool isReady() const
+        {
+            _ensureIsValid();
+            return _state->isReady();
+        }
+
+        void wait() const
+        {
+            _ensureIsValid();
+            _state->wait();
+        }
+
+        // consume the future
+        // => do not call from a task of a single consumer producer waiting on its own pool
+        Result get()
+        {
+            _ensureIsValid();
+            _state->wait();
+
+            FutureSharedState<Result>* state = std::exchange(_state, nullptr);
+
+            if (state->hasException())
+            {
+                std::exception_ptr exception = state->getException();
+                state->removeReference();
+                std::rethrow_exception(exception);
+            }
+
+            if constexpr (std::is_void<Result>::value)
+            {
+                state->removeReference();
+            }
+            else
+            {
+                Result value = state->takeValue();
+                state->removeReference();
+                return value;
+            }
+        }
+
+        // consume the future, the callable receive the result (nothing for void)
+        // => an exception skip the callable and reach the returned future
+        template<typename Callable>
+        auto then(Callable&& callable)
+        {
+            using NextResult = typename detail::ContinuationResult<std::decay_t<Callable>, Result>::type;
+
+            _ensureIsValid();
+
+            FutureSharedState<Result>* state = std::exchange(_state, nullptr); // reference moved to the continuation
+            Producer* producer = state->getProducer();
+
+            auto* nextState = new FutureSharedState<NextResult>(producer);
+            nextState->addReference(); // held by the continuation
+
+            state->setContinuation(
+                [producer, state, nextState, callable = std::decay_t<Callable>(std::forward<Callable>(callable))]() mutable
+                {
+                    detail::dispatch(producer, [state, nextState, callable = std::move(callable)]() mutable
+                    {
+                        if (state->hasException())
+                            nextState->setException(state->getException());
+                        else if constexpr (std::is_void<Result>::value)
+                            detail::fulfil(*nextState, callable);
+                        else
+                            detail::fulfil(*nextState, callable, state->takeValue());
+
+                        state->removeReference();
+                        nextState->removeReference();
+                    },
+                    [state, nextState]()
+                    {
+                        detail::breakPromise(*nextState);
+                        state->removeReference();
+                        nextState->removeReference();
+                    });
+                });
+
+            return TaskFuture<NextResult>(nextState);
+        }
+
+    private:
+        void _ensureIsValid() const
+        {
+            if (_state == nullptr)
+                D_THROW(std::runtime_error, "invalid future");
+        }
+
+        void _release()
+        {
+            if (_state != nullptr)
+                std::exchange(_state, nullptr)->removeReference();
+        }
+    };
+
+    //
+    //
+
+    template<typename Callable>
+    auto Producer::submit(Callable&& callable)
+    {
+        using Result = std::invoke_result_t<std::decay_t<Callable>&>;
+
+        if (!_running)
+            D_THROW(std::runtime_error, "producer not running");
+
+        auto* state = new FutureSharedState<Result>(this);
+        state->addReference(); // held by the task
+
+        TaskFuture<Result> future(state); // released if the push throw
+
+        // dropped by quit(): get() throw std::future_error (broken_promise) instead of waiting forever
+        pushWithDrop(
+            [state, callable = std::decay_t<Callable>(std::forward<Callable>(callable))]() mutable
+            {
+                detail::fulfil(*state, callable);
+                state->removeReference();
+            },
+            [state]()
+            {
+                detail::breakPromise(*state);
+                state->removeReference();
+            });
+
+        return future;
+    }
+
+    //
+    //
+
+    template<typename Result>
+    using WhenAllResult = std::conditional_t<std::is_void<Result>::value, void, std::vector<Result>>;
+
+    // ready when all the futures are ready (values in the input order)
+    // => the first exception (in completion order) reach the returned future
+    template<typename Result>
+    auto whenAll(std::vector<TaskFuture<Result>> futures)
+    {
+        using OutResult = WhenAllResult<Result>;
+
+        struct Gather
+        {
+            std::atomic<std::size_t> totalRemaining;
+            std::atomic<bool> hasException{false};
+            std::exception_ptr exception;
+            std::vector<std::optional<std::conditional_t<std::is_void<Result>::value, bool, Result>>> values;
+            FutureSharedState<OutResult>* outState;
+        };
+
+        // all checked before the first continuation: a throw leave the futures untouched
+        for (const TaskFuture<Result>& future : futures)
+            future._ensureIsValid();
+
+        Producer* producer = futures.empty() ? nullptr : futures.front()._state->getProducer();
+        auto* outState = new FutureSharedState<OutResult>(producer);
+
+        if (futures.empty())
+        {
+            if constexpr (std::is_void<OutResult>::value)
+                outState->setValue();
+            else
+                outState->setValue(OutResult());
+            return TaskFuture<OutResult>(outState);
+        }
+
+        outState->addReference(); // held by the gather
+
+        auto* gather = new Gather{ {futures.size()}, {false}, nullptr, {}, outState };
+        gather->values.resize(futures.size());
+
+        for (std::size_t ii = 0; ii < futures.size(); ++ii)
+        {
+            FutureSharedState<Result>* state = std::exchange(futures[ii]._state, nullptr);
+
+            // inline: only moves the value, no task scheduled per input
+            state->setContinuation([gather, state, ii]()
+            {
+                if (state->hasException())
+                {
+                    if (!gather->hasException.exchange(true, std::memory_order_acq_rel))
+                        gather->exception = state->getException();
+                }
+                else if constexpr (std::is_void<Result>::value)
+                {
+                    gather->values[ii].emplace(true);
+                }
+                else
+                {
+                    gather->values[ii].emplace(state->takeValue());
+                }
+
+                state->removeReference();
+
+                if (gather->totalRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    return;
+
+                // last one
+                if (gather->exception != nullptr)
+                {
+                    gather->outState->setException(gather->exception);
+                }
+                else if constexpr (std::is_void<Result>::value)
+                {
+                    gather->outState->setValue();
+                }
+                else
+                {
+                    OutResult values;
+                    values.reserve(gather->values.size());
+                    for (auto& value : gather->values)
+                        values.push_back(std::move(*value));
+                    gather->outState->setValue(std::move(values));
+                }
+
+                gather->outState->removeReference();
+                delete gather;
+            });
+        }
+
+        return TaskFuture<OutResult>(outState);
+    }
+
+    //
+    //
+
+    template<typename Result>
+    struct WhenAnyResult
+    {
+        std::size_t index;
+        Result value;
+    };
+
+    template<>
+    struct WhenAnyResult<void>
+    {
+        std::size_t index;
+    };
+
+    // ready when the first future is ready (its index and its value, or its exception)
+    template<typename Result>
+    auto whenAny(std::vector<TaskFuture<Result>> futures)
+    {
+        using OutResult = WhenAnyResult<Result>;
+
+        struct Gather
+        {
+            std::atomic<std::size_t> totalRemaining;
+            std::atomic<bool> isDone{false};
+            FutureSharedState<OutResult>* outState;
+        };
+
+        if (futures.empty())
+            D_THROW(std::runtime_error, "whenAny: no future");
+
+        // all checked before the first continuation: a throw leave the futures untouched
+        for (const TaskFuture<Result>& future : futures)
+            future._ensureIsValid();
+
+        auto* outState = new FutureSharedState<OutResult>(futures.front()._state->getProducer());
+        outState->addReference(); // held by the gather
+
+        auto* gather = new Gather{ {futures.size()}, {false}, outState };
+
+        for (std::size_t ii = 0; ii < futures.size(); ++ii)
+        {
+            FutureSharedState<Result>* state = std::exchange(futures[ii]._state, nullptr);
+
+            state->setContinuation([gather, state, ii]()
+            {
+                if (!gather->isDone.exchange(true, std::memory_order_acq_rel))
+                {
+                    if (state->hasException())
+                        gather->outState->setException(state->getException());
+                    else if constexpr (std::is_void<Result>::value)
+                        gather->outState->setValue(OutResult{ ii });
+                    else
+                        gather->outState->setValue(OutResult{ ii, state->takeValue() });
+                }
+
+                state->removeReference();
+
+                if (gather->totalRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    return;
+
+                // last one
+                gather->outState->removeReference();
+                delete gather;
+            });
+        }
+
+        return TaskFuture<OutResult>(outState);
+    }
+
+};
@@ -0,0 +1,254 @@
+
+#include "TaskGraph.hpp"
+
+#include "utilities/ErrorHandler.hpp"
+
+namespace multithreading
+{
+
+    TaskGraph::~TaskGraph()
+    {
+        // no throw from here, the failure is lost
+        if (isRunning())
+            _waitUntilCompleted();
+    }
+
+    //
+    //
+
+    void TaskGraph::addDependency(NodeId before, NodeId after)
+    {
+        _ensureIsNotRunning();
+
+        if (before >= _nodes.size() || after >= _nodes.size())
+            D_THROW(std::runtime_error, "task graph: unknown node");
+        if (before == after)
+            D_THROW(std::runtime_error, "task graph: node depending on itself");
+
+        _nodes[before]->successors.push_back(_nodes[after].get());
+        ++_nodes[after]->totalPredecessors;
+        _isValidated = false;
+    }
+
+    void TaskGraph::clear()
+    {
+        _ensureIsNotRunning();
+
+        _nodes.clear();
+        _rootNodes.clear();
+        _isValidated = false;
+    }
+
+    //
+    //
+
+    void TaskGraph::execute(Producer& producer)
+    {
+        _ensureIsNotRunning();
+
+        if (!_isValidated)
+            _validate();
+
+        if (_nodes.empty())
+            return;
+
+        {
+            auto lock = _waitCompleted.makeScopedLock();
+
+            // this part is locked
+
+            // the last node may still be notifying the previous execution
+            if (!_isCompleted)
+                D_THROW(std::runtime_error, "task graph already running");
+
+            _isCompleted = false;
+        }
+
+        // wait the way the producer does (no thread is waiting for this graph here)
+        _waitCompleted.setWaitStrategy(producer.getWaitStrategy());
+
+        for (auto& node : _nodes)
+            node->remainingPredecessors.store(node->totalPredecessors, std::memory_order_relaxed);
+
+        _producer = &producer;
+        _hasFailed.store(false, std::memory_order_relaxed);
+        _failure = nullptr;
+        _remainingNodes.store(_nodes.size(), std::memory_order_release);
+
+        for (Node* rootNode : _rootNodes)
+            _dispatch(rootNode);
+    }
+
+    void TaskGraph::waitUntilCompleted()
+    {
+        _waitUntilCompleted();
+
+        if (_failure != nullptr)
+            std::rethrow_exception(_failure);
+    }
+
+    void TaskGraph::run(Producer& producer)
+    {
+        execute(producer);
+        waitUntilCompleted();
+    }
+
+    //
+    //
+
+    bool TaskGraph::isRunning() const
+    {
+        return _remainingNodes.load(std::memory_order_acquire) > 0;
+    }
+
+    bool TaskGraph::hasFailed() const
+    {
+        return _hasFailed.load(std::memory_order_acquire);
+    }
+
+    std::size_t TaskGraph::totalNodes() const
+    {
+        return _nodes.size();
+    }
+
+    //
+    //
+
+    void TaskGraph::_ensureIsNotRunning() const
+    {
+        if (isRunning())
+            D_THROW(std::runtime_error, "task graph already running");
+    }
+
+    void TaskGraph::_validate()
+    {
+        _rootNodes.clear();
+
+        for (auto& node : _nodes)
+            if (node->totalPredecessors == 0)
+                _rootNodes.push_back(node.get());
+
+        // Kahn's algorithm: every node must be reachable from the roots
+        std::vector<uint32_t> remainingPredecessors;
+        remainingPredecessors.reserve(_nodes.size());
+        for (auto& node : _nodes)
+            remainingPredecessors.push_back(node->totalPredecessors);
+
+        std::vector<const Node*> readyNodes(_rootNodes.begin(), _rootNodes.end());
+        std::size_t totalVisited = 0;
+
+        while (!readyNodes.empty())
+        {
+            const Node* node = readyNodes.back();
+            readyNodes.pop_back();
+            ++totalVisited;
+
+            for (const Node* successor : node->successors)
+                if (--remainingPredecessors[successor->id] == 0)
+                    readyNodes.push_back(successor);
+        }
+
+        if (totalVisited != _nodes.size())
+            D_THROW(std::runtime_error, "task graph: cycle detected");
+
+        _isValidated = true;
+    }
+
+    void TaskGraph::_waitUntilCompleted()
+    {
+        auto lock = _waitCompleted.makeScopedLock();
+
+        // this part is locked
+
+        // wait -> release the lock for other thread(s)
+        _waitCompleted.waitUntil(lock, [this]() { return _isCompleted; });
+    }
+
+    void TaskGraph::_dispatch(Node* node)
+    {
+        // a failed execution skip its remaining nodes, they only count as done
+        if (_hasFailed.load(std::memory_order_acquire))
+        {
+            _onNodeDone(node);
+            return;
+        }
+
+        try
+        {
+            _producer->pushWithDrop(
+                [this, node]()
+                {
+                    try
+                    {
+                        node->work();
+                    }
+                    catch (...)
+                    {
+                        _setFailure(std::current_exception());
+                    }
+
+                    _onNodeDone(node);
+                },
+                [this, node]()
+                {
+                    _onNodeDropped(node);
+                });
+        }
+        catch (...)
+        {
+            // not running: already dropped, reported by waitUntilCompleted()
+        }
+    }
+
+    void TaskGraph::_setFailure(std::exception_ptr failure)
+    {
+        if (!_hasFailed.exchange(true, std::memory_order_acq_rel))
+            _failure = std::move(failure);
+    }
+
+    void TaskGraph::_onNodeDropped(Node* node)
+    {
+        _setFailure(std::make_exception_ptr(std::runtime_error("task graph: node dropped, the producer is not running")));
+
+        _onNodeDone(node);
+    }
+
+    void TaskGraph::_onNodeDone(Node* node)
+    {
+        // the nodes skipped by a failed execution are done in this loop, not recursively (long chains)
+        std::vector<Node*> skippedNodes; // no allocation unless the execution failed
+
+        while (true)
+        {
+            // release the successors, the last predecessor to finish push it
+            // (from a consumer's thread -> its local queue)
+            for (Node* successor : node->successors)
+            {
+                if (successor->remainingPredecessors.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+
+                if (_hasFailed.load(std::memory_order_acquire))
+                    skippedNodes.push_back(successor);
+                else
+                    _dispatch(successor);
+            }
+
+            if (_remainingNodes.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                break; // last node (nothing can be skipped anymore)
+
+            if (skippedNodes.empty())
+                return;
+
+            node = skippedNodes.back();
+            skippedNodes.pop_back();
+        }
+
+        // last node -> wake up the waiting thread(s)
+        auto notifier = _waitCompleted.makeScopedLockAllNotifier();
+
+        // this part is locked
+
+        _isCompleted = true;
+    }
+
+};
@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include "Producer.hpp"
+
+#include "internals/IProducer.hpp"
+#include "internals/ThreadSynchroniser.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace multithreading
+{
+    // dependency graph built once, executed many times
+    // => a node is pushed on the producer as soon as its last predecessor is done
+    // => atomic counters only, no barrier between the "phases"
+    //
+    // TaskGraph graph;
+    // auto physics = graph.addNode([]() { ... });
+    // auto ai = graph.addNode([]() { ... });
+    // graph.addDependency(physics, ai); // physics -> ai
+    // graph.run(producer); // every frame
+    //
+    // a throwing node, or a node dropped by the producer (quit() while it is queued), fail the execution:
+    // the remaining nodes are skipped, waitUntilCompleted() (and run()) rethrow the first failure
+    class TaskGraph
+        : public NonCopyable
+    {
+    public:
+        using NodeId = std::size_t;
+
+    private:
+        struct Node
+        {
+        public:
+            NodeId id = 0;
+            WorkCallback work;
+            std::vector<Node*> successors;
+            uint32_t totalPredecessors = 0;
+            std::atomic<uint32_t> remainingPredecessors{0};
+        };
+
+    private:
+        std::vector<std::unique_ptr<Node>> _nodes;
+        std::vector<Node*> _rootNodes; // no predecessor, rebuilt after a change
+        bool _isValidated = false;
+
+        Producer* _producer = nullptr;
+        std::atomic<std::size_t> _remainingNodes{0};
+        ThreadSynchroniser _waitCompleted;
+        bool _isCompleted = true; // locked by _waitCompleted (the waiter cannot leave before the notifier)
+        std::atomic<bool> _hasFailed{false};
+        std::exception_ptr _failure; // set by the first failed node, read once completed
+
+    public:
+        TaskGraph() = default;
+        ~TaskGraph();
+
+    public:
+        // the callable is kept and called once per execution
+        template<typename Callable>
+        NodeId addNode(Callable&& callable)
+        {
+            _ensureIsNotRunning();
+
+            _nodes.push_back(std::make_unique<Node>());
+            _nodes.back()->id = _nodes.size() - 1;
+            _nodes.back()->work.assign(std::forward<Callable>(callable));
+            _isValidated = false;
+
+            return _nodes.size() - 1;
+        }
+
+        // "before" must complete before "after" starts
+        void addDependency(NodeId before, NodeId after);
+        void clear();
+
+    public:
+        void execute(Producer& producer); // non blocking
+        void waitUntilCompleted(); // rethrow the failure of the execution
+        void run(Producer& producer); // execute + wait
+
+    public:
+        bool isRunning() const;
+        bool hasFailed() const; // the last execution, once completed
+        std::size_t totalNodes() const;
+
+    private:
+        void _ensureIsNotRunning() const;
+        void _validate();
+        void _waitUntilCompleted();
+        void _dispatch(Node* node);
+        void _setFailure(std::exception_ptr failure);
+        void _onNodeDropped(Node* node);
+        void _onNodeDone(Node* node);
+    };
+
+};
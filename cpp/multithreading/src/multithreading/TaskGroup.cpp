@@ -0,0 +1,119 @@
+
+#include "TaskGroup.hpp"
+
+#include "internals/Consumer.hpp"
+
+#include <thread>
+
+namespace multithreading
+{
+
+    namespace
+    {
+        // helping rounds without finding a task before sleeping
+        constexpr int k_totalIdleRounds = 64;
+    };
+
+    //
+    //
+
+    TaskGroup::TaskGroup(Producer& producer)
+        : _producer(producer)
+    {}
+
+    TaskGroup::~TaskGroup()
+    {
+        wait();
+    }
+
+    //
+    //
+
+    void TaskGroup::wait() noexcept
+    {
+        Consumer* currConsumer = Consumer::getCurrent();
+        const bool isOwnConsumer = (currConsumer != nullptr && currConsumer->belongsTo(_producer));
+
+        int idleRounds = 0;
+
+        while (true)
+        {
+            const int64_t pendingTasks = _pendingTasks.load(std::memory_order_acquire);
+            if (pendingTasks == 0)
+                return;
+
+            // runPendingTask() is false once the producer quit: its dropped tasks are counted as done
+            if (pendingTasks != k_notifying && _producer.runPendingTask())
+            {
+                idleRounds = 0;
+                continue;
+            }
+
+            // a consumer must not block: the tasks it wait for may only be reachable by itself
+            if (isOwnConsumer || pendingTasks == k_notifying || ++idleRounds < k_totalIdleRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // the remaining tasks are running elsewhere
+            const uint32_t key = _completed.prepareWait();
+            if (_pendingTasks.load(std::memory_order_acquire) <= 0)
+            {
+                _completed.cancelWait();
+                continue;
+            }
+            _completed.commitWait(key);
+        }
+    }
+
+    bool TaskGroup::isCompleted() const
+    {
+        return _pendingTasks.load(std::memory_order_acquire) == 0;
+    }
+
+    //
+    //
+
+    void TaskGroup::_addPendingTasks(int64_t totalTasks)
+    {
+        int64_t pendingTasks = _pendingTasks.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            if (pendingTasks == k_notifying)
+            {
+                // the previous last task is still in _taskDone()
+                std::this_thread::yield();
+                pendingTasks = _pendingTasks.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (_pendingTasks.compare_exchange_weak(pendingTasks, pendingTasks + totalTasks, std::memory_order_acq_rel))
+                return;
+        }
+    }
+
+    void TaskGroup::_taskDone()
+    {
+        int64_t pendingTasks = _pendingTasks.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            if (pendingTasks > 1)
+            {
+                if (_pendingTasks.compare_exchange_weak(pendingTasks, pendingTasks - 1, std::memory_order_acq_rel))
+                    return;
+                continue;
+            }
+
+            // last task: the waiters see k_notifying until the group is no longer touched
+            if (_pendingTasks.compare_exchange_weak(pendingTasks, k_notifying, std::memory_order_acq_rel))
+                break;
+        }
+
+        _completed.notifyAll();
+        _pendingTasks.store(0, std::memory_order_release);
+    }
+
+};
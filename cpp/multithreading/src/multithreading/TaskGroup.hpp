@@ -0,0 +1,89 @@
+
+#pragma once
+
+#include "Producer.hpp"
+
+#include "internals/EventCount.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace multithreading
+{
+    // a scope of tasks on a shared producer, wait() only wait for the tasks of this group
+    // => the waiting thread run queued tasks (of any group) instead of sleeping
+    // => the destructor wait, the callables must not throw (same as Producer::push())
+    // => a task dropped by the producer's quit() count as done (never run), wait() never throw
+    //
+    // TaskGroup group(producer);
+    // group.push([]() { ... });
+    // group.pushBulk(std::span(callables));
+    // group.wait(); // the other groups' tasks may still be running
+    class TaskGroup
+        : public NonCopyable
+    {
+    private:
+        // the last task is notifying, the group must not be destroyed (nor reused) yet
+        static constexpr int64_t k_notifying = -1;
+
+    private:
+        Producer& _producer;
+        std::atomic<int64_t> _pendingTasks{0};
+        EventCount _completed;
+
+    public:
+        explicit TaskGroup(Producer& producer);
+        ~TaskGroup();
+
+    public:
+        template<typename Callable>
+        void push(Callable&& callable)
+        {
+            _addPendingTasks(1);
+
+            // also run when the push throw
+            _producer.pushWithDrop(_wrap(std::forward<Callable>(callable)), [this]() { _taskDone(); });
+        }
+
+        // the callables are moved from (see Producer::pushBulk())
+        template<typename Callable>
+        void pushBulk(std::span<Callable> callables)
+        {
+            _addPendingTasks(int64_t(callables.size()));
+
+            _producer.pushBulk(
+                callables.size(),
+                [this, &callables](std::size_t index) { return _wrap(std::move(callables[index])); },
+                [this]() { _taskDone(); });
+        }
+
+        void wait() noexcept; // also by the destructor
+        bool isCompleted() const;
+
+    private:
+        template<typename Callable>
+        auto _wrap(Callable&& callable)
+        {
+            using Function = std::decay_t<Callable>;
+
+            return [this, callable = Function(std::forward<Callable>(callable))]() mutable
+            {
+                {
+                    // the captures are released before the waiter can return
+                    Function function = std::move(callable);
+                    function();
+                }
+                _taskDone();
+            };
+        }
+
+        void _addPendingTasks(int64_t totalTasks);
+        void _taskDone();
+    };
+
+};
@@ -0,0 +1,18 @@
+
+#pragma once
+
+#include <cstddef>
+
+namespace multithreading
+{
+    // one shared lane per priority, push() without a priority use TaskPriority::Normal
+    enum class TaskPriority
+    {
+        High = 0,
+        Normal,
+        Low,
+    };
+
+    constexpr std::size_t k_totalTaskPriorities = 3;
+
+};
@@ -0,0 +1,309 @@
+
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace multithreading
+{
+
+    namespace
+    {
+        const std::string k_cpuPath = "/sys/devices/system/cpu/cpu";
+        const std::string k_nodePath = "/sys/devices/system/node/";
+
+        bool readInteger(const std::string& filepath, long& value)
+        {
+            std::ifstream file(filepath);
+            return bool(file >> value);
+        }
+
+        // "0-3,8,10-11" -> 0 1 2 3 8 10 11
+        bool readCpuList(const std::string& filepath, std::vector<unsigned int>& values)
+        {
+            std::ifstream file(filepath);
+            std::string content;
+            if (!std::getline(file, content))
+                return false;
+
+            std::stringstream stream(content);
+            std::string range;
+            while (std::getline(stream, range, ','))
+            {
+                if (range.empty())
+                    continue;
+
+                const std::size_t separator = range.find('-');
+
+                try
+                {
+                    const unsigned long first = std::stoul(range.substr(0, separator));
+                    const unsigned long last = separator == std::string::npos ? first : std::stoul(range.substr(separator + 1));
+
+                    for (unsigned long value = first; value <= last; ++value)
+                        values.push_back(static_cast<unsigned int>(value));
+                }
+                catch (const std::exception&)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<unsigned int> getAllowedCpus()
+        {
+            std::vector<unsigned int> cpus;
+
+#if defined(__linux__)
+
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+            {
+                for (unsigned int cpuId = 0; cpuId < CPU_SETSIZE; ++cpuId)
+                    if (CPU_ISSET(cpuId, &cpuSet))
+                        cpus.push_back(cpuId);
+            }
+
+#endif
+
+            if (cpus.empty())
+            {
+                const unsigned int totalCpus = std::max(1u, std::thread::hardware_concurrency());
+                for (unsigned int cpuId = 0; cpuId < totalCpus; ++cpuId)
+                    cpus.push_back(cpuId);
+            }
+
+            return cpus;
+        }
+    };
+
+    //
+    //
+
+    Topology Topology::detect()
+    {
+        Topology topology;
+
+        // cpu id -> OS node id
+        std::map<unsigned int, unsigned int> cpuNodes;
+
+        std::vector<unsigned int> nodeIds;
+        if (readCpuList(k_nodePath + "online", nodeIds))
+        {
+            for (unsigned int nodeId : nodeIds)
+            {
+                std::vector<unsigned int> nodeCpus;
+                if (readCpuList(k_nodePath + "node" + std::to_string(nodeId) + "/cpulist", nodeCpus))
+                    for (unsigned int cpuId : nodeCpus)
+                        cpuNodes[cpuId] = nodeId;
+            }
+        }
+
+        for (unsigned int cpuId : getAllowedCpus())
+        {
+            const std::string cpuPath = k_cpuPath + std::to_string(cpuId) + "/topology/";
+
+            long coreId = -1;
+            long packageId = -1;
+            if (!readInteger(cpuPath + "core_id", coreId) || coreId < 0)
+                coreId = cpuId; // unknown -> its own core
+            if (!readInteger(cpuPath + "physical_package_id", packageId) || packageId < 0)
+                packageId = 0;
+
+            const auto itNode = cpuNodes.find(cpuId);
+
+            LogicalCpu cpu;
+            cpu.id = cpuId;
+            cpu.coreIndex = static_cast<unsigned int>(coreId); // raw core id, made dense in _finalise()
+            cpu.packageId = static_cast<unsigned int>(packageId);
+            cpu.numaNode = itNode != cpuNodes.end() ? itNode->second : 0; // raw node id, made dense in _finalise()
+            topology._cpus.push_back(cpu);
+        }
+
+        topology._finalise();
+        return topology;
+    }
+
+    Topology Topology::makeFlat(std::size_t totalCpus)
+    {
+        Topology topology;
+
+        for (std::size_t ii = 0; ii < std::max<std::size_t>(totalCpus, 1); ++ii)
+        {
+            LogicalCpu cpu;
+            cpu.id = static_cast<unsigned int>(ii);
+            cpu.coreIndex = static_cast<unsigned int>(ii);
+            topology._cpus.push_back(cpu);
+        }
+
+        topology._finalise();
+        return topology;
+    }
+
+    Topology Topology::makeFromCpus(std::vector<LogicalCpu> cpus)
+    {
+        if (cpus.empty())
+            return makeFlat(1);
+
+        Topology topology;
+        topology._cpus = std::move(cpus);
+        topology._finalise();
+        return topology;
+    }
+
+    bool Topology::pinCurrentThread(unsigned int cpuId)
+    {
+#if defined(__linux__)
+
+        if (cpuId >= CPU_SETSIZE)
+            return false;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuId, &cpuSet);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+
+#else
+
+        static_cast<void>(cpuId); // unused
+        return false;
+
+#endif
+    }
+
+    //
+    //
+
+    const std::vector<LogicalCpu>& Topology::getCpus() const
+    {
+        return _cpus;
+    }
+
+    std::size_t Topology::totalLogicalCpus() const
+    {
+        return _cpus.size();
+    }
+
+    std::size_t Topology::totalPhysicalCores() const
+    {
+        return _totalCores;
+    }
+
+    std::size_t Topology::totalPackages() const
+    {
+        return _totalPackages;
+    }
+
+    std::size_t Topology::totalNumaNodes() const
+    {
+        return _totalNumaNodes;
+    }
+
+    //
+    //
+
+    std::vector<LogicalCpu> Topology::getPlacement(PinningStrategy strategy, std::size_t totalConsumers) const
+    {
+        std::vector<LogicalCpu> order;
+
+        switch (strategy)
+        {
+        case PinningStrategy::None:
+            return order;
+
+        case PinningStrategy::Compact:
+            order = _cpus;
+            break;
+
+        case PinningStrategy::PhysicalCores:
+            for (const LogicalCpu& cpu : _cpus)
+                if (cpu.smtIndex == 0)
+                    order.push_back(cpu);
+            break;
+
+        case PinningStrategy::Scatter:
+        {
+            // per node: first SMT siblings of every core, then the second ones...
+            std::vector<std::vector<LogicalCpu>> nodeCpus(_totalNumaNodes);
+            for (const LogicalCpu& cpu : _cpus)
+                nodeCpus[cpu.numaNode].push_back(cpu);
+
+            for (auto& cpus : nodeCpus)
+                std::stable_sort(cpus.begin(), cpus.end(), [](const LogicalCpu& cpuA, const LogicalCpu& cpuB)
+                {
+                    return cpuA.smtIndex < cpuB.smtIndex;
+                });
+
+            // then one cpu of each node in turn
+            for (std::size_t rank = 0; order.size() < _cpus.size(); ++rank)
+                for (const auto& cpus : nodeCpus)
+                    if (rank < cpus.size())
+                        order.push_back(cpus[rank]);
+            break;
+        }
+        }
+
+        std::vector<LogicalCpu> placement;
+        if (order.empty())
+            return placement; // not detected
+
+        placement.reserve(totalConsumers);
+        for (std::size_t ii = 0; ii < totalConsumers; ++ii)
+            placement.push_back(order[ii % order.size()]);
+
+        return placement;
+    }
+
+    //
+    //
+
+    void Topology::_finalise()
+    {
+        // raw ids -> compact order
+        std::sort(_cpus.begin(), _cpus.end(), [](const LogicalCpu& cpuA, const LogicalCpu& cpuB)
+        {
+            return (
+                std::tie(cpuA.numaNode, cpuA.packageId, cpuA.coreIndex, cpuA.id) <
+                std::tie(cpuB.numaNode, cpuB.packageId, cpuB.coreIndex, cpuB.id)
+            );
+        });
+
+        std::map<unsigned int, unsigned int> nodeIndices;
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> coreIndices; // (package, core id)
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> coreThreads; // (package, core id) -> SMT siblings so far
+        std::map<unsigned int, unsigned int> packages;
+
+        for (LogicalCpu& cpu : _cpus)
+        {
+            const auto coreKey = std::make_pair(cpu.packageId, cpu.coreIndex);
+
+            const unsigned int nodeIndex = nodeIndices.emplace(cpu.numaNode, static_cast<unsigned int>(nodeIndices.size())).first->second;
+            const unsigned int coreIndex = coreIndices.emplace(coreKey, static_cast<unsigned int>(coreIndices.size())).first->second;
+            packages.emplace(cpu.packageId, 0);
+
+            cpu.smtIndex = coreThreads[coreKey]++;
+            cpu.numaNode = nodeIndex;
+            cpu.coreIndex = coreIndex;
+        }
+
+        _totalCores = coreIndices.size();
+        _totalPackages = packages.size();
+        _totalNumaNodes = nodeIndices.size();
+    }
+
+};
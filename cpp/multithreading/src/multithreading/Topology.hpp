@@ -0,0 +1,70 @@
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace multithreading
+{
+    // where the producer pin its consumers
+    enum class PinningStrategy
+    {
+        None, // not pinned, the OS scheduler place (and move) the consumers
+        Compact, // fill a core (its SMT siblings) then the next one, one NUMA node after the other
+        Scatter, // round robin over the NUMA nodes, the physical cores first and the SMT siblings last
+        PhysicalCores, // one consumer per physical core (its first SMT sibling)
+    };
+
+    struct LogicalCpu
+    {
+    public:
+        unsigned int id = 0; // OS index (affinity masks)
+        unsigned int coreIndex = 0; // dense index of its physical core
+        unsigned int packageId = 0; // socket
+        unsigned int numaNode = 0; // dense index of its NUMA node, in [0, totalNumaNodes)
+        unsigned int smtIndex = 0; // 0 for the first hardware thread of its core
+    };
+
+    // the logical cpus this process may run on (affinity mask), read from /sys on linux
+    // => any missing information fall back to "one core per cpu, one node"
+    class Topology
+    {
+    private:
+        std::vector<LogicalCpu> _cpus; // compact order: node, package, core, SMT sibling
+        std::size_t _totalCores = 0;
+        std::size_t _totalPackages = 0;
+        std::size_t _totalNumaNodes = 0;
+
+    public:
+        Topology() = default;
+
+    public:
+        static Topology detect();
+
+        // totalCpus cpus, one core each, one node (non linux systems)
+        static Topology makeFlat(std::size_t totalCpus);
+
+        // from raw ids (OS cpu, core, package and node ids, any order), made dense like detect() does
+        // => the smtIndex are computed, not read
+        static Topology makeFromCpus(std::vector<LogicalCpu> cpus);
+
+        // pin the calling thread to one logical cpu, false on failure (or non linux systems)
+        static bool pinCurrentThread(unsigned int cpuId);
+
+    public:
+        const std::vector<LogicalCpu>& getCpus() const;
+        std::size_t totalLogicalCpus() const;
+        std::size_t totalPhysicalCores() const;
+        std::size_t totalPackages() const;
+        std::size_t totalNumaNodes() const;
+
+    public:
+        // the cpu of each consumer (wrap around when more consumers than cpus)
+        // => empty with PinningStrategy::None
+        std::vector<LogicalCpu> getPlacement(PinningStrategy strategy, std::size_t totalConsumers) const;
+
+    private:
+        void _finalise(); // sort, dense indices and totals
+    };
+
+};
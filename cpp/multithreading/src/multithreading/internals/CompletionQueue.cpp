@@ -0,0 +1,44 @@
+
+#include "CompletionQueue.hpp"
+
+#include "IProducer.hpp"
+
+namespace multithreading
+{
+
+    void CompletionQueue::push(Task* task)
+    {
+        Task* head = _head.load(std::memory_order_relaxed);
+        do
+        {
+            task->next = head;
+        }
+        while (!_head.compare_exchange_weak(head, task, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    Task* CompletionQueue::takeAll()
+    {
+        // cheap check first: no locked instruction when nothing completed
+        if (_head.load(std::memory_order_relaxed) == nullptr)
+            return nullptr;
+
+        Task* latest = _head.exchange(nullptr, std::memory_order_acquire);
+
+        Task* oldest = nullptr;
+        while (latest != nullptr)
+        {
+            Task* next = latest->next;
+            latest->next = oldest;
+            oldest = latest;
+            latest = next;
+        }
+
+        return oldest;
+    }
+
+    bool CompletionQueue::isEmpty() const
+    {
+        return _head.load(std::memory_order_relaxed) == nullptr;
+    }
+
+};
@@ -0,0 +1,29 @@
+
+#pragma once
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+
+namespace multithreading
+{
+    struct Task;
+
+    // unbounded lock free multi producers single consumer queue, taken as a whole
+    // => push(): one CAS, intrusive (through Task::next), no allocation
+    // => takeAll(): one exchange for the whole batch, then reversed to the push order
+    class CompletionQueue
+        : public NonCopyable
+    {
+    private:
+        std::atomic<Task*> _head{nullptr}; // latest push first
+
+    public:
+        void push(Task* task); // any thread
+        Task* takeAll(); // the owner thread, oldest first (linked by Task::next), nullptr when empty
+
+    public:
+        bool isEmpty() const; // approximate when used concurrently
+    };
+
+};
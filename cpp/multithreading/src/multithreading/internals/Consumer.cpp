@@ -1,24 +1,26 @@
 
 #include "Consumer.hpp"
 
-#include <chrono>
+#include "multithreading/Topology.hpp"
 
 namespace multithreading
 {
 
-    Consumer::Consumer(IProducer& producer)
-        : _producer(producer)
+    namespace
     {
-        _running = false; // the consumer's thread will set it to true
+        thread_local Consumer* tl_currentConsumer = nullptr;
 
-        // launch consumer thread
+        // yield a few times before sleeping: a burst of push do not pay a wake up per task
+        constexpr int k_totalIdleRounds = 64;
+    };
 
-        _thread = std::thread(&Consumer::_threadedMethod, this);
-
-        // here we wait for the thread to be running
-        while (!_running)
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+    Consumer::Consumer(IProducer& producer, unsigned int index, int pinnedCpu, unsigned int numaNode, ConsumerMetrics* metrics)
+        : _randomSeed((index + 1) * 2654435761u) // xorshift: must not be zero
+        , _pinnedCpu(pinnedCpu)
+        , _numaNode(numaNode)
+        , _metrics(metrics)
+        , _producer(producer)
+    {}
 
     Consumer::~Consumer()
     {
@@ -28,27 +30,44 @@ namespace multithreading
     //
     //
 
-    void Consumer::execute(const WorkCallback& work)
+    void Consumer::start()
     {
-        auto lockNotifier = _waitProducer.makeScopedLockNotifier();
+        // retired: the previous thread is over (or about to be)
+        if (_thread.joinable())
+            _thread.join();
 
-        // this part is locked and will notify at the end of the scope
+        // set before the thread exist: a requestQuit() (or its own retirement) can only come after
+        _running = true;
+        _isStarted = false;
+        _idleSince = 0;
 
-        _work = work;
+        // launch consumer thread
+
+        _thread = std::thread(&Consumer::_threadedMethod, this);
+
+        // here we wait for the thread to be running (no sleep polling)
+        // => not on _running: the thread may already have retired and cleared it
+        _isStarted.wait(false);
     }
 
-    void Consumer::quit()
+    void Consumer::push(Task* task)
     {
-        if (!_running)
-            return;
+        _localTasks.push(task);
+    }
 
-        {
-            auto lockNotifier = _waitProducer.makeScopedLockNotifier();
+    Task* Consumer::steal()
+    {
+        return _localTasks.steal();
+    }
 
-            // this part is locked and will notify at the end of the scope
+    void Consumer::requestQuit()
+    {
+        _running = false;
+    }
 
-            _running = false;
-        }
+    void Consumer::quit()
+    {
+        requestQuit();
 
         if (_thread.joinable())
             _thread.join();
@@ -62,9 +81,96 @@ namespace multithreading
         return _running;
     }
 
-    bool Consumer::isAvailable() const
+    bool Consumer::hasLocalTasks() const
+    {
+        return !_localTasks.isEmpty();
+    }
+
+    int64_t Consumer::getLocalQueueSize() const
+    {
+        return _localTasks.size();
+    }
+
+    bool Consumer::belongsTo(const IProducer& producer) const
+    {
+        return &_producer == &producer;
+    }
+
+    int Consumer::getPinnedCpu() const
+    {
+        return _pinnedCpu;
+    }
+
+    unsigned int Consumer::getNumaNode() const
+    {
+        return _numaNode;
+    }
+
+    ConsumerMetrics* Consumer::getMetrics() const
     {
-        return !_waitProducer.isNotified();
+        return _metrics;
+    }
+
+    int64_t Consumer::getIdleSince() const
+    {
+        return _idleSince;
+    }
+
+    uint32_t Consumer::getRandomValue()
+    {
+        // xorshift32
+        _randomSeed ^= _randomSeed << 13;
+        _randomSeed ^= _randomSeed >> 17;
+        _randomSeed ^= _randomSeed << 5;
+        return _randomSeed;
+    }
+
+    bool Consumer::runOneTask()
+    {
+        // urgent tasks (high priority lane), then own tasks (LIFO, still hot in the cache)
+        Task* task = _producer._acquireUrgentTask(*this);
+
+        if (task == nullptr)
+            task = _localTasks.pop();
+
+        if (task == nullptr)
+            task = _producer._acquireTask(*this);
+
+        if (task == nullptr)
+            return false;
+
+        if (task->enqueueTime != 0)
+            _producer._notifyTaskStart(*this, task);
+
+        const bool isCancelled = task->cancellation.stop_requested();
+
+        if (isCancelled)
+        {
+            // dropped, never started
+            if (_metrics != nullptr)
+                _metrics->onTaskCancelled();
+        }
+        else if (_metrics != nullptr)
+        {
+            _runMeasured(task);
+        }
+        else
+        {
+            task->work();
+        }
+
+        task->work.reset(); // the captures are released before the completion
+
+        if (isCancelled && task->drop)
+            task->drop();
+
+        _producer._notifyWorkDone(this, task);
+        return true;
+    }
+
+    Consumer* Consumer::getCurrent()
+    {
+        return tl_currentConsumer;
     }
 
     //
@@ -72,26 +178,69 @@ namespace multithreading
 
     void Consumer::_threadedMethod()
     {
-        auto lock = _waitProducer.makeScopedLock();
+        tl_currentConsumer = this;
 
-        // this part is locked
+        // pinned before the first task: its memory is first touched on the right node
+        // (a failure only cost the locality)
+        if (_pinnedCpu >= 0)
+            Topology::pinCurrentThread(static_cast<unsigned int>(_pinnedCpu));
 
-        _running = true;
+        _isStarted = true;
+        _isStarted.notify_one();
+
+        int idleRounds = 0;
 
         while (_running)
         {
-            // wait -> release the lock for other thread(s)
-            _waitProducer.waitUntilNotified(lock);
-
-            // this part is locked
+            if (runOneTask())
+            {
+                if (_metrics != nullptr)
+                    _metrics->setBusy(true);
+
+                idleRounds = 0;
+                _idleSince = 0;
+                continue;
+            }
+
+            if (_metrics != nullptr)
+                _metrics->setBusy(false);
+
+            if (++idleRounds < k_totalIdleRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // nothing to do -> sleep (no lock held while running a task)
+            if (_metrics != nullptr)
+                _metrics->onPark();
+
+            if (_idleSince == 0)
+                _idleSince = ConsumerMetrics::now();
+
+            _producer._waitForTask(*this);
+            idleRounds = 0;
+        }
 
-            if (!_running)
-                break; // quit scenario
+        tl_currentConsumer = nullptr;
+    }
 
-            _work();
+    void Consumer::_runMeasured(Task* task)
+    {
+        _metrics->onTaskRun();
 
-            _producer._notifyWorkDone(this);
+        // not sampled: counted only
+        if (task->enqueueTime == 0)
+        {
+            task->work();
+            return;
         }
+
+        const int64_t startTime = ConsumerMetrics::now();
+        task->work();
+        const int64_t endTime = ConsumerMetrics::now();
+
+        _metrics->onSampledTask(task->enqueueTime, startTime, endTime);
     }
 
 };
@@ -1,13 +1,14 @@
 
 #pragma once
 
+#include "ConsumerMetrics.hpp"
 #include "IProducer.hpp"
-#include "ThreadSynchroniser.hpp"
+#include "WorkStealingQueue.hpp"
 
 #include "utilities/NonCopyable.hpp"
 
-#include <functional>
-
+#include <atomic>
+#include <cstdint>
 #include <thread>
 
 namespace multithreading
@@ -17,28 +18,52 @@ namespace multithreading
     {
     private:
         std::thread _thread;
-        ThreadSynchroniser _waitProducer;
 
-        bool _running = false;
+        std::atomic<bool> _running{false};
+        std::atomic<bool> _isStarted{false}; // set once by the thread of each start()
+
+        WorkStealingQueue _localTasks;
+        uint32_t _randomSeed;
+
+        const int _pinnedCpu; // -1: not pinned
+        const unsigned int _numaNode;
 
-        WorkCallback _work;
+        ConsumerMetrics* const _metrics; // nullptr: disabled (owned by the producer)
+
+        int64_t _idleSince = 0; // consumer's thread only, first park since the last task (see ConsumerMetrics::now())
 
         IProducer& _producer;
 
     public:
-        explicit Consumer(IProducer& producer);
+        Consumer(IProducer& producer, unsigned int index, int pinnedCpu = -1, unsigned int numaNode = 0, ConsumerMetrics* metrics = nullptr);
         ~Consumer();
 
     public:
-        void execute(const WorkCallback& work);
+        void start(); // also restart a retired consumer (elastic producer)
+        void push(Task* task); // consumer's thread only
+        bool runOneTask(); // consumer's thread only, false if no task was found
+        Task* steal(); // any thread
+        void requestQuit(); // the producer must wake up the consumer (or the consumer's thread retire itself)
         void quit();
 
     public:
         bool isRunning() const;
-        bool isAvailable() const;
+        bool hasLocalTasks() const;
+        int64_t getLocalQueueSize() const; // approximate from an other thread
+        bool belongsTo(const IProducer& producer) const;
+        int getPinnedCpu() const;
+        unsigned int getNumaNode() const;
+        ConsumerMetrics* getMetrics() const; // nullptr when disabled
+        uint32_t getRandomValue(); // consumer's thread only
+        int64_t getIdleSince() const; // consumer's thread only
+
+    public:
+        // the consumer running the calling thread, nullptr if not a consumer's thread
+        static Consumer* getCurrent();
 
     private:
         void _threadedMethod();
+        void _runMeasured(Task* task);
     };
 
 };
@@ -0,0 +1,153 @@
+
+#include "ConsumerMetrics.hpp"
+
+#include <algorithm>
+
+namespace multithreading
+{
+
+    namespace
+    {
+        // single writer: a load and a store, no locked instruction
+        void increment(std::atomic<uint64_t>& counter, uint64_t value = 1)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void add(std::atomic<int64_t>& counter, int64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void record(const std::unique_ptr<std::atomic<uint64_t>[]>& histogram, int64_t nanoseconds)
+        {
+            increment(histogram[HistogramSnapshot::getBucketIndex(uint64_t(std::max<int64_t>(nanoseconds, 0)))]);
+        }
+
+        void readHistogram(const std::unique_ptr<std::atomic<uint64_t>[]>& histogram, HistogramSnapshot& snapshot)
+        {
+            for (std::size_t ii = 0; ii < HistogramSnapshot::k_totalBuckets; ++ii)
+            {
+                const uint64_t count = histogram[ii].load(std::memory_order_relaxed);
+                snapshot.buckets[ii] += count;
+                snapshot.totalSamples += count;
+            }
+        }
+    };
+
+    //
+    //
+
+    ConsumerMetrics::ConsumerMetrics(std::size_t traceCapacity)
+        : _stateSince(now())
+        , _queueLatency(std::make_unique<std::atomic<uint64_t>[]>(HistogramSnapshot::k_totalBuckets))
+        , _executionTime(std::make_unique<std::atomic<uint64_t>[]>(HistogramSnapshot::k_totalBuckets))
+        , _traceEvents(traceCapacity)
+    {
+        for (std::size_t ii = 0; ii < HistogramSnapshot::k_totalBuckets; ++ii)
+        {
+            _queueLatency[ii].store(0, std::memory_order_relaxed);
+            _executionTime[ii].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //
+    //
+
+    void ConsumerMetrics::onTaskRun()
+    {
+        increment(_totalTasksRun);
+    }
+
+    void ConsumerMetrics::onTaskStolen()
+    {
+        increment(_totalTasksStolen);
+    }
+
+    void ConsumerMetrics::onTaskCancelled()
+    {
+        increment(_totalTasksCancelled);
+    }
+
+    void ConsumerMetrics::onPark()
+    {
+        increment(_totalParks);
+    }
+
+    void ConsumerMetrics::onSampledTask(int64_t enqueueTime, int64_t startTime, int64_t endTime)
+    {
+        record(_queueLatency, startTime - enqueueTime);
+        record(_executionTime, endTime - startTime);
+
+        if (_traceEvents.empty())
+            return;
+
+        const uint64_t eventIndex = _totalTraceEvents.load(std::memory_order_relaxed);
+        _traceEvents[eventIndex % _traceEvents.size()] = TraceEvent{ enqueueTime, startTime, endTime };
+        _totalTraceEvents.store(eventIndex + 1, std::memory_order_release);
+    }
+
+    void ConsumerMetrics::setBusy(bool isBusy)
+    {
+        if (_isBusy == isBusy)
+            return;
+
+        const int64_t currentTime = now();
+        const int64_t elapsed = currentTime - _stateSince.load(std::memory_order_relaxed);
+
+        add(_isBusy ? _busyNanoseconds : _idleNanoseconds, elapsed);
+
+        _isBusy = isBusy;
+        _stateSince.store(currentTime, std::memory_order_relaxed);
+        _isBusyShared.store(isBusy, std::memory_order_relaxed);
+    }
+
+    //
+    //
+
+    void ConsumerMetrics::addTo(ConsumerStats& stats, HistogramSnapshot& queueLatency, HistogramSnapshot& executionTime) const
+    {
+        stats.totalTasksRun = _totalTasksRun.load(std::memory_order_relaxed);
+        stats.totalTasksStolen = _totalTasksStolen.load(std::memory_order_relaxed);
+        stats.totalTasksCancelled = _totalTasksCancelled.load(std::memory_order_relaxed);
+        stats.totalParks = _totalParks.load(std::memory_order_relaxed);
+
+        int64_t busyNanoseconds = _busyNanoseconds.load(std::memory_order_relaxed);
+        int64_t idleNanoseconds = _idleNanoseconds.load(std::memory_order_relaxed);
+
+        // the current state is not accounted yet (approximate: the fields are read one by one)
+        const int64_t currentStateNanoseconds = std::max<int64_t>(0, now() - _stateSince.load(std::memory_order_relaxed));
+        if (_isBusyShared.load(std::memory_order_relaxed))
+            busyNanoseconds += currentStateNanoseconds;
+        else
+            idleNanoseconds += currentStateNanoseconds;
+
+        stats.busySeconds = double(busyNanoseconds) / 1e9;
+        stats.idleSeconds = double(idleNanoseconds) / 1e9;
+
+        readHistogram(_queueLatency, queueLatency);
+        readHistogram(_executionTime, executionTime);
+    }
+
+    std::vector<ConsumerMetrics::TraceEvent> ConsumerMetrics::getTraceEvents() const
+    {
+        std::vector<TraceEvent> events;
+        if (_traceEvents.empty())
+            return events;
+
+        const uint64_t totalEvents = _totalTraceEvents.load(std::memory_order_acquire);
+        const uint64_t firstEvent = totalEvents > _traceEvents.size() ? totalEvents - _traceEvents.size() : 0;
+
+        events.reserve(std::size_t(totalEvents - firstEvent));
+        for (uint64_t ii = firstEvent; ii < totalEvents; ++ii)
+            events.push_back(_traceEvents[ii % _traceEvents.size()]);
+
+        return events;
+    }
+
+    int64_t ConsumerMetrics::now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+};
@@ -0,0 +1,77 @@
+
+#pragma once
+
+#include "multithreading/SchedulerStats.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace multithreading
+{
+    // the counters, histograms and trace events of one consumer
+    // => written by the consumer's thread only (no read-modify-write), read from any thread
+    class ConsumerMetrics
+        : public NonCopyable
+    {
+    public:
+        struct TraceEvent
+        {
+        public:
+            int64_t enqueueTime = 0; // nanoseconds (see now())
+            int64_t startTime = 0;
+            int64_t endTime = 0;
+        };
+
+    private:
+        using Histogram = std::unique_ptr<std::atomic<uint64_t>[]>;
+
+    private:
+        std::atomic<uint64_t> _totalTasksRun{0};
+        std::atomic<uint64_t> _totalTasksStolen{0};
+        std::atomic<uint64_t> _totalTasksCancelled{0};
+        std::atomic<uint64_t> _totalParks{0};
+
+        // busy/idle time, updated when the state change only
+        bool _isBusy = false; // consumer's thread only
+        std::atomic<bool> _isBusyShared{false};
+        std::atomic<int64_t> _stateSince{0};
+        std::atomic<int64_t> _busyNanoseconds{0};
+        std::atomic<int64_t> _idleNanoseconds{0};
+
+        Histogram _queueLatency;
+        Histogram _executionTime;
+
+        // ring buffer, the oldest events are overwritten
+        std::vector<TraceEvent> _traceEvents;
+        std::atomic<uint64_t> _totalTraceEvents{0};
+
+    public:
+        explicit ConsumerMetrics(std::size_t traceCapacity);
+
+    public:
+        // consumer's thread only
+        void onTaskRun();
+        void onTaskStolen();
+        void onTaskCancelled();
+        void onPark();
+        void onSampledTask(int64_t enqueueTime, int64_t startTime, int64_t endTime);
+        void setBusy(bool isBusy); // no clock read when the state did not change
+
+    public:
+        // any thread
+        void addTo(ConsumerStats& stats, HistogramSnapshot& queueLatency, HistogramSnapshot& executionTime) const;
+        // only meaningful once the consumer is not running tasks (torn events otherwise)
+        std::vector<TraceEvent> getTraceEvents() const;
+
+    public:
+        // steady clock, nanoseconds
+        static int64_t now();
+    };
+
+};
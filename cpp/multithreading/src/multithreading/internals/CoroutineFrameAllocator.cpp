@@ -0,0 +1,77 @@
+
+#include "CoroutineFrameAllocator.hpp"
+
+#include <new>
+
+namespace multithreading
+{
+
+    namespace
+    {
+        struct FreeFrame
+        {
+            FreeFrame* next;
+        };
+
+        struct ThreadFrameCache
+        {
+            FreeFrame* heads[CoroutineFrameAllocator::k_totalClasses] = {};
+            std::size_t totalFrames[CoroutineFrameAllocator::k_totalClasses] = {};
+
+            ~ThreadFrameCache()
+            {
+                for (FreeFrame* head : heads)
+                    while (head != nullptr)
+                    {
+                        FreeFrame* next = head->next;
+                        ::operator delete(head);
+                        head = next;
+                    }
+            }
+        };
+
+        thread_local ThreadFrameCache tl_frameCache;
+
+        // size class index, k_totalClasses if too big
+        std::size_t getClassIndex(std::size_t size)
+        {
+            return (size + CoroutineFrameAllocator::k_classSize - 1) / CoroutineFrameAllocator::k_classSize - 1;
+        }
+    };
+
+    void* CoroutineFrameAllocator::allocate(std::size_t size)
+    {
+        const std::size_t classIndex = getClassIndex(size);
+        if (classIndex >= k_totalClasses)
+            return ::operator new(size);
+
+        ThreadFrameCache& cache = tl_frameCache;
+        if (FreeFrame* frame = cache.heads[classIndex])
+        {
+            cache.heads[classIndex] = frame->next;
+            --cache.totalFrames[classIndex];
+            return frame;
+        }
+
+        // the whole class size: the frame can be reused by any size of its class
+        return ::operator new((classIndex + 1) * k_classSize);
+    }
+
+    void CoroutineFrameAllocator::deallocate(void* frame, std::size_t size)
+    {
+        const std::size_t classIndex = getClassIndex(size);
+
+        ThreadFrameCache& cache = tl_frameCache;
+        if (classIndex >= k_totalClasses || cache.totalFrames[classIndex] >= k_maxCachedFrames)
+        {
+            ::operator delete(frame);
+            return;
+        }
+
+        FreeFrame* freeFrame = static_cast<FreeFrame*>(frame);
+        freeFrame->next = cache.heads[classIndex];
+        cache.heads[classIndex] = freeFrame;
+        ++cache.totalFrames[classIndex];
+    }
+
+};
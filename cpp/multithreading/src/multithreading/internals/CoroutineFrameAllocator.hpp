@@ -0,0 +1,25 @@
+
+#pragma once
+
+#include <cstddef>
+
+namespace multithreading
+{
+    // recycle the coroutine frames (see CoroutineTask)
+    // => size classes of 64 bytes up to 1KB, bigger frames use operator new
+    // => one cache per thread, no lock and no atomic: a frame released on an
+    //    other thread than its allocating one simply join that thread's cache
+    // => each thread cache keep a bounded number of frames, freed at thread exit
+    class CoroutineFrameAllocator
+    {
+    public:
+        static constexpr std::size_t k_classSize = 64;
+        static constexpr std::size_t k_totalClasses = 16;
+        static constexpr std::size_t k_maxCachedFrames = 256; // per class and per thread
+
+    public:
+        static void* allocate(std::size_t size);
+        static void deallocate(void* frame, std::size_t size);
+    };
+
+};
@@ -0,0 +1,131 @@
+
+#include "EventCount.hpp"
+
+#include <climits>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace multithreading
+{
+
+    uint32_t EventCount::prepareWait()
+    {
+        // announce the wait before reading the epoch: pairs with the fence in notifyOne()
+        _totalWaiters.fetch_add(1, std::memory_order_seq_cst);
+        return _epoch.load(std::memory_order_seq_cst);
+    }
+
+    void EventCount::cancelWait()
+    {
+        _totalWaiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void EventCount::commitWait(uint32_t key)
+    {
+#if defined(__linux__)
+
+        // the kernel compare the epoch with the key -> no lost wake up
+        while (_epoch.load(std::memory_order_acquire) == key)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, key, nullptr, nullptr, 0);
+
+#else
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condVar.wait(lock, [this, key]() { return _epoch.load(std::memory_order_acquire) != key; });
+
+#endif
+
+        _totalWaiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    bool EventCount::commitWaitFor(uint32_t key, std::chrono::nanoseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+#if defined(__linux__)
+
+        // relative timeout, recomputed after a spurious wake up
+        while (_epoch.load(std::memory_order_acquire) == key)
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+                break;
+
+            timespec relativeTimeout;
+            relativeTimeout.tv_sec = time_t(remaining.count() / 1000000000);
+            relativeTimeout.tv_nsec = long(remaining.count() % 1000000000);
+
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, key, &relativeTimeout, nullptr, 0);
+        }
+
+#else
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condVar.wait_until(lock, deadline, [this, key]() { return _epoch.load(std::memory_order_acquire) != key; });
+        }
+
+#endif
+
+        // notified at the last moment: still a notification
+        const bool isNotified = (_epoch.load(std::memory_order_acquire) != key);
+
+        _totalWaiters.fetch_sub(1, std::memory_order_seq_cst);
+
+        return isNotified;
+    }
+
+    //
+    //
+
+    void EventCount::notifyOne()
+    {
+        _wake(1);
+    }
+
+    void EventCount::notifyMany(int totalThreads)
+    {
+        _wake(totalThreads);
+    }
+
+    void EventCount::notifyAll()
+    {
+        _wake(INT_MAX);
+    }
+
+    //
+    //
+
+    void EventCount::_wake(int totalThreads)
+    {
+        // the work published by the caller must be visible before reading the waiters
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_totalWaiters.load(std::memory_order_relaxed) == 0)
+            return; // fast path: nobody is sleeping
+
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+
+#if defined(__linux__)
+
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAKE_PRIVATE, totalThreads, nullptr, nullptr, 0);
+
+#else
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex); // the waiter may be between its check and its wait
+        }
+        if (totalThreads == 1)
+            _condVar.notify_one();
+        else
+            _condVar.notify_all();
+
+#endif
+    }
+
+};
@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if !defined(__linux__)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace multithreading
+{
+    // let idle threads sleep without a lock on the notifying side
+    // => the notifier only pay a fence and a load when nobody is waiting
+    //
+    // waiting thread:
+    //   const uint32_t key = eventCount.prepareWait();
+    //   if (workAvailable()) { eventCount.cancelWait(); return; } // re-check after prepareWait()
+    //   eventCount.commitWait(key);
+    //
+    // notifying thread:
+    //   publishWork();
+    //   eventCount.notifyOne();
+    class EventCount
+        : public NonCopyable
+    {
+    private:
+        std::atomic<uint32_t> _epoch{0}; // futex word
+        std::atomic<uint32_t> _totalWaiters{0};
+
+#if !defined(__linux__)
+        std::mutex _mutex;
+        std::condition_variable _condVar;
+#endif
+
+    public:
+        EventCount() = default;
+
+    public:
+        uint32_t prepareWait();
+        void cancelWait();
+        void commitWait(uint32_t key); // return at once if notified since prepareWait()
+        bool commitWaitFor(uint32_t key, std::chrono::nanoseconds timeout); // false: timed out without a notification
+
+    public:
+        void notifyOne();
+        void notifyMany(int totalThreads); // wake min(totalThreads, waiting) threads
+        void notifyAll();
+
+    private:
+        void _wake(int totalThreads);
+    };
+
+};
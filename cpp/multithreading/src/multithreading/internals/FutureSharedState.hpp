@@ -0,0 +1,177 @@
+
+#pragma once
+
+#include "EventCount.hpp"
+#include "IProducer.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace multithreading
+{
+    class Producer;
+
+    // state shared by a TaskFuture and the task fulfilling it
+    // => intrusive reference count, one allocation per future
+    // => one continuation at most (a future is consumed by then()/get())
+    // => no mutex: a status word, the waiting threads sleep on an EventCount
+    class FutureSharedStateBase
+        : public NonCopyable
+    {
+    private:
+        enum Status : uint32_t
+        {
+            k_pending = 0,
+            k_hasContinuation,
+            k_ready,
+        };
+
+    private:
+        std::atomic<uint32_t> _totalReferences{1};
+        std::atomic<uint32_t> _status{k_pending};
+        EventCount _readyEvent;
+
+        WorkCallback _continuation;
+        std::exception_ptr _exception;
+
+        Producer* _producer;
+
+    public:
+        explicit FutureSharedStateBase(Producer* producer)
+            : _producer(producer)
+        {}
+
+        virtual ~FutureSharedStateBase() = default;
+
+    public:
+        void addReference()
+        {
+            _totalReferences.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void removeReference()
+        {
+            if (_totalReferences.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete this;
+        }
+
+    public:
+        bool isReady() const
+        {
+            return _status.load(std::memory_order_acquire) == k_ready;
+        }
+
+        void wait()
+        {
+            while (!isReady())
+            {
+                const uint32_t key = _readyEvent.prepareWait();
+                if (isReady())
+                {
+                    _readyEvent.cancelWait();
+                    return;
+                }
+                _readyEvent.commitWait(key);
+            }
+        }
+
+        // called at once (on the calling thread) if already ready,
+        // otherwise on the thread making the state ready
+        void setContinuation(WorkCallback&& continuation)
+        {
+            _continuation = std::move(continuation);
+
+            uint32_t expected = k_pending;
+            if (_status.compare_exchange_strong(expected, k_hasContinuation, std::memory_order_acq_rel))
+                return;
+
+            WorkCallback readyContinuation = std::move(_continuation);
+            readyContinuation();
+        }
+
+        void setException(std::exception_ptr exception)
+        {
+            _exception = std::move(exception);
+            _markReady();
+        }
+
+        bool hasException() const
+        {
+            return _exception != nullptr;
+        }
+
+        const std::exception_ptr& getException() const
+        {
+            return _exception;
+        }
+
+        Producer* getProducer() const
+        {
+            return _producer;
+        }
+
+    protected:
+        void _markReady()
+        {
+            const uint32_t previousStatus = _status.exchange(k_ready, std::memory_order_acq_rel);
+
+            _readyEvent.notifyAll();
+
+            if (previousStatus != k_hasContinuation)
+                return;
+
+            WorkCallback continuation = std::move(_continuation);
+            continuation();
+        }
+    };
+
+    //
+    //
+
+    template<typename Result>
+    class FutureSharedState
+        : public FutureSharedStateBase
+    {
+    private:
+        std::optional<Result> _value;
+
+    public:
+        using FutureSharedStateBase::FutureSharedStateBase;
+
+    public:
+        template<typename Value>
+        void setValue(Value&& value)
+        {
+            _value.emplace(std::forward<Value>(value));
+            _markReady();
+        }
+
+        Result takeValue()
+        {
+            return std::move(*_value);
+        }
+    };
+
+    template<>
+    class FutureSharedState<void>
+        : public FutureSharedStateBase
+    {
+    public:
+        using FutureSharedStateBase::FutureSharedStateBase;
+
+    public:
+        void setValue()
+        {
+            _markReady();
+        }
+
+        void takeValue()
+        {}
+    };
+
+};
@@ -1,25 +1,53 @@
 
 #pragma once
 
-#include <functional>
-#include <memory>
+#include "InlineCallback.hpp"
+
+#include "multithreading/CancellationToken.hpp"
+
+#include <cstdint>
 
 namespace multithreading
 {
-    using WorkCallback = std::function<void()>;
+    // 64 bytes of captures before falling back to the heap
+    using WorkCallback = InlineCallback<64>;
+
+    // a pointer or two: the state to notify when a task will never run
+    using DropCallback = InlineCallback<16>;
+
+    // pooled record (see TaskPool), moved end to end as a pointer
+    struct Task
+    {
+    public:
+        WorkCallback work;
+        Task* next = nullptr; // intrusive link, used by the overflow lists (see TaskLane) and the CompletionQueue
+        Task* completion = nullptr; // posted to the producer's CompletionQueue once done (see Producer::pushWithCompletion())
+        int64_t enqueueTime = 0; // sampled push time (see ConsumerMetrics::now()), 0: not sampled
+        CancellationToken cancellation; // checked when dequeued: a cancelled task is dropped, not run
+        DropCallback drop; // run instead of "work" when the task is discarded (cancelled, cleared by quit()), may be empty
+    };
 
     class Consumer;
 
     class IProducer
     {
-        // friendship so the consumers can call _notifyWorkDone()
+        // friendship so the consumers can call _acquireUrgentTask(), _acquireTask(), _notifyTaskStart(), _waitForTask() and _notifyWorkDone()
         friend Consumer;
 
     public:
         virtual ~IProducer() = default;
 
     protected:
-        virtual void _notifyWorkDone(Consumer* consumer) = 0;
+        // before the local queue of the consumer -> a task that must not wait behind it, nullptr if none
+        virtual Task* _acquireUrgentTask(Consumer& consumer) = 0;
+        // when the local queue of the consumer is empty -> shared lanes then stealing, nullptr if none
+        virtual Task* _acquireTask(Consumer& consumer) = 0;
+        // a sampled task (enqueueTime set) is about to run -> its queue latency can be observed
+        virtual void _notifyTaskStart(Consumer& consumer, const Task* task) = 0;
+        // when there was nothing to acquire -> sleep until some work may be available
+        virtual void _waitForTask(Consumer& consumer) = 0;
+        // the task (callback already reset) go back to the producer's pool
+        virtual void _notifyWorkDone(Consumer* consumer, Task* task) = 0;
     };
 
 };
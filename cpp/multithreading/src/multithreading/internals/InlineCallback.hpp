@@ -0,0 +1,150 @@
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace multithreading
+{
+    // move only "void()" callable stored in place (no heap allocation)
+    // => the callables bigger than "Capacity" (or not nothrow movable) fall back to the heap
+    template<std::size_t Capacity>
+    class InlineCallback
+    {
+    private:
+        struct Operations
+        {
+            void (*invoke)(void* storage);
+            void (*moveTo)(void* source, void* destination); // also destroy the source
+            void (*destroy)(void* storage);
+        };
+
+        template<typename Callable>
+        struct InlineOperations
+        {
+            static void invoke(void* storage) { (*static_cast<Callable*>(storage))(); }
+            static void moveTo(void* source, void* destination)
+            {
+                new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+                static_cast<Callable*>(source)->~Callable();
+            }
+            static void destroy(void* storage) { static_cast<Callable*>(storage)->~Callable(); }
+
+            static constexpr Operations k_operations = { &invoke, &moveTo, &destroy };
+        };
+
+        template<typename Callable>
+        struct HeapOperations
+        {
+            static Callable*& get(void* storage) { return *static_cast<Callable**>(storage); }
+
+            static void invoke(void* storage) { (*get(storage))(); }
+            static void moveTo(void* source, void* destination) { new (destination) Callable*(get(source)); }
+            static void destroy(void* storage) { delete get(storage); }
+
+            static constexpr Operations k_operations = { &invoke, &moveTo, &destroy };
+        };
+
+    public:
+        template<typename Callable>
+        static constexpr bool isStoredInline =
+            sizeof(Callable) <= Capacity &&
+            alignof(Callable) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible<Callable>::value;
+
+    private:
+        alignas(std::max_align_t) unsigned char _storage[Capacity];
+        const Operations* _operations = nullptr;
+
+    public:
+        InlineCallback() = default;
+        InlineCallback(std::nullptr_t) {}
+
+        template<
+            typename Callable,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<Callable>, InlineCallback>::value>
+        >
+        InlineCallback(Callable&& callable)
+        {
+            assign(std::forward<Callable>(callable));
+        }
+
+        InlineCallback(InlineCallback&& other) noexcept
+        {
+            _moveFrom(other);
+        }
+
+        InlineCallback& operator=(InlineCallback&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                _moveFrom(other);
+            }
+            return *this;
+        }
+
+        // move only
+        InlineCallback(const InlineCallback& other) = delete;
+        InlineCallback& operator=(const InlineCallback& other) = delete;
+
+        ~InlineCallback()
+        {
+            reset();
+        }
+
+    public:
+        template<typename Callable>
+        void assign(Callable&& callable)
+        {
+            using StoredType = std::decay_t<Callable>;
+
+            reset();
+
+            if constexpr (isStoredInline<StoredType>)
+            {
+                new (_storage) StoredType(std::forward<Callable>(callable));
+                _operations = &InlineOperations<StoredType>::k_operations;
+            }
+            else
+            {
+                new (_storage) StoredType*(new StoredType(std::forward<Callable>(callable)));
+                _operations = &HeapOperations<StoredType>::k_operations;
+            }
+        }
+
+        void reset()
+        {
+            if (_operations == nullptr)
+                return;
+
+            _operations->destroy(_storage);
+            _operations = nullptr;
+        }
+
+    public:
+        void operator()()
+        {
+            _operations->invoke(_storage);
+        }
+
+        explicit operator bool() const
+        {
+            return _operations != nullptr;
+        }
+
+    private:
+        void _moveFrom(InlineCallback& other)
+        {
+            if (other._operations == nullptr)
+                return;
+
+            other._operations->moveTo(other._storage, _storage);
+            _operations = other._operations;
+            other._operations = nullptr;
+        }
+    };
+
+};
@@ -0,0 +1,160 @@
+
+#include "MpmcTaskQueue.hpp"
+
+#include <cstdint>
+#include <thread>
+
+namespace multithreading
+{
+
+    MpmcTaskQueue::MpmcTaskQueue(std::size_t capacity /*= 4096*/)
+        : _mask([capacity]()
+        {
+            // the capacity must be a power of two (index masking)
+            std::size_t powerOfTwo = 2;
+            while (powerOfTwo < capacity)
+                powerOfTwo *= 2;
+            return powerOfTwo - 1;
+        }())
+        , _cells(std::make_unique<Cell[]>(_mask + 1))
+    {
+        for (std::size_t ii = 0; ii <= _mask; ++ii)
+            _cells[ii].sequence.store(ii, std::memory_order_relaxed);
+    }
+
+    //
+    //
+
+    bool MpmcTaskQueue::tryPush(Task* task)
+    {
+        std::size_t position = _pushPosition.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = _cells[position & _mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = intptr_t(sequence) - intptr_t(position);
+
+            if (difference == 0)
+            {
+                // the cell is free for this lap -> try to claim it
+                if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.task = task;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+                // position was reloaded by the failed exchange
+            }
+            else if (difference < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                position = _pushPosition.load(std::memory_order_relaxed); // an other producer was faster
+            }
+        }
+    }
+
+    bool MpmcTaskQueue::tryPushBulk(Task* const* tasks, std::size_t totalTasks)
+    {
+        if (totalTasks == 0)
+            return true;
+        if (totalTasks > capacity())
+            return false;
+
+        std::size_t position = _pushPosition.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            // the last cell free for this lap -> the pops of all the cells before it were claimed
+            const std::size_t lastPosition = position + totalTasks - 1;
+            const std::size_t sequence = _cells[lastPosition & _mask].sequence.load(std::memory_order_acquire);
+            const intptr_t difference = intptr_t(sequence) - intptr_t(lastPosition);
+
+            if (difference == 0)
+            {
+                if (_pushPosition.compare_exchange_weak(position, position + totalTasks, std::memory_order_relaxed))
+                    break;
+                // position was reloaded by the failed exchange
+            }
+            else if (difference < 0)
+            {
+                return false; // not enough room
+            }
+            else
+            {
+                position = _pushPosition.load(std::memory_order_relaxed); // an other producer was faster
+            }
+        }
+
+        // the cells are ours, only a pop claimed but not finished can still hold one
+        for (std::size_t ii = 0; ii < totalTasks; ++ii)
+        {
+            Cell& cell = _cells[(position + ii) & _mask];
+            while (cell.sequence.load(std::memory_order_acquire) != position + ii)
+                std::this_thread::yield();
+
+            cell.task = tasks[ii];
+            cell.sequence.store(position + ii + 1, std::memory_order_release);
+        }
+
+        return true;
+    }
+
+    Task* MpmcTaskQueue::tryPop()
+    {
+        std::size_t position = _popPosition.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = _cells[position & _mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = intptr_t(sequence) - intptr_t(position + 1);
+
+            if (difference == 0)
+            {
+                // the cell hold a task for this lap -> try to claim it
+                if (_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    Task* task = cell.task;
+                    cell.sequence.store(position + _mask + 1, std::memory_order_release); // free for the next lap
+                    return task;
+                }
+                // position was reloaded by the failed exchange
+            }
+            else if (difference < 0)
+            {
+                return nullptr; // empty
+            }
+            else
+            {
+                position = _popPosition.load(std::memory_order_relaxed); // an other consumer was faster
+            }
+        }
+    }
+
+    //
+    //
+
+    bool MpmcTaskQueue::isEmpty() const
+    {
+        const std::size_t popPosition = _popPosition.load(std::memory_order_seq_cst);
+        const std::size_t pushPosition = _pushPosition.load(std::memory_order_seq_cst);
+        return pushPosition <= popPosition;
+    }
+
+    std::size_t MpmcTaskQueue::approximateSize() const
+    {
+        const std::size_t popPosition = _popPosition.load(std::memory_order_relaxed);
+        const std::size_t pushPosition = _pushPosition.load(std::memory_order_relaxed);
+        return pushPosition > popPosition ? pushPosition - popPosition : 0;
+    }
+
+    std::size_t MpmcTaskQueue::capacity() const
+    {
+        return _mask + 1;
+    }
+
+};
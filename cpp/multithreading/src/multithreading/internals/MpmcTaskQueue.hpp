@@ -0,0 +1,50 @@
+
+#pragma once
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace multithreading
+{
+    struct Task;
+
+    // bounded lock free multi producers multi consumers queue (Dmitry Vyukov's design)
+    // => one sequence number per cell, a push and a pop only contend on their own position
+    // => tryPush() fail when full, tryPop() fail when empty (no blocking)
+    class MpmcTaskQueue
+        : public NonCopyable
+    {
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            Task* task;
+        };
+
+    private:
+        const std::size_t _mask;
+        std::unique_ptr<Cell[]> _cells;
+
+        // the producers and the consumers do not share a cache line
+        alignas(64) std::atomic<std::size_t> _pushPosition{0};
+        alignas(64) std::atomic<std::size_t> _popPosition{0};
+
+    public:
+        explicit MpmcTaskQueue(std::size_t capacity = 4096);
+
+    public:
+        bool tryPush(Task* task);
+        // all or nothing, one claim for the whole batch (false when there is no room for all of them)
+        bool tryPushBulk(Task* const* tasks, std::size_t totalTasks);
+        Task* tryPop(); // nullptr when empty
+
+    public:
+        bool isEmpty() const; // approximate when used concurrently
+        std::size_t approximateSize() const; // claimed pushes - claimed pops
+        std::size_t capacity() const;
+    };
+
+};
@@ -0,0 +1,140 @@
+
+#include "TaskLane.hpp"
+
+#include "IProducer.hpp"
+
+#include <algorithm>
+
+namespace multithreading
+{
+
+    namespace
+    {
+        struct LaterDeadline
+        {
+            template<typename Entry>
+            bool operator()(const Entry& entryA, const Entry& entryB) const
+            {
+                if (entryA.deadline != entryB.deadline)
+                    return entryA.deadline > entryB.deadline;
+                return entryA.order > entryB.order;
+            }
+        };
+    };
+
+    //
+    //
+
+    void TaskLane::push(Task* task)
+    {
+        if (!_tasks.tryPush(task))
+            _pushOverflowTasks(&task, 1); // full -> slow path
+    }
+
+    void TaskLane::pushBulk(Task** tasks, std::size_t totalTasks)
+    {
+        if (_tasks.tryPushBulk(tasks, totalTasks))
+            return;
+
+        // no room for the whole batch -> what fit, one by one, then the slow path
+        std::size_t totalPushed = 0;
+        while (totalPushed < totalTasks && _tasks.tryPush(tasks[totalPushed]))
+            ++totalPushed;
+
+        if (totalPushed < totalTasks)
+            _pushOverflowTasks(tasks + totalPushed, totalTasks - totalPushed);
+    }
+
+    void TaskLane::pushWithDeadline(Task* task, Clock::time_point deadline)
+    {
+        std::lock_guard<std::mutex> lock(_deadlineMutex);
+
+        _deadlineTasks.push_back(DeadlineTask{ deadline, _totalDeadlinePushes++, task });
+        std::push_heap(_deadlineTasks.begin(), _deadlineTasks.end(), LaterDeadline());
+
+        _totalDeadlineTasks.fetch_add(1, std::memory_order_release);
+    }
+
+    Task* TaskLane::tryPop()
+    {
+        if (_totalDeadlineTasks.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_deadlineMutex);
+
+            if (!_deadlineTasks.empty())
+            {
+                std::pop_heap(_deadlineTasks.begin(), _deadlineTasks.end(), LaterDeadline());
+                Task* task = _deadlineTasks.back().task;
+                _deadlineTasks.pop_back();
+
+                _totalDeadlineTasks.fetch_sub(1, std::memory_order_release);
+                return task;
+            }
+        }
+
+        if (Task* task = _tasks.tryPop())
+            return task;
+
+        return _popOverflowTask();
+    }
+
+    bool TaskLane::isEmpty() const
+    {
+        return (
+            _tasks.isEmpty() &&
+            _totalOverflowTasks.load(std::memory_order_acquire) == 0 &&
+            _totalDeadlineTasks.load(std::memory_order_acquire) == 0
+        );
+    }
+
+    std::size_t TaskLane::approximateSize() const
+    {
+        return (
+            _tasks.approximateSize() +
+            _totalOverflowTasks.load(std::memory_order_relaxed) +
+            _totalDeadlineTasks.load(std::memory_order_relaxed)
+        );
+    }
+
+    //
+    //
+
+    void TaskLane::_pushOverflowTasks(Task** tasks, std::size_t totalTasks)
+    {
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+
+        for (std::size_t ii = 0; ii < totalTasks; ++ii)
+        {
+            Task* task = tasks[ii];
+
+            task->next = nullptr;
+            if (_overflowTail != nullptr)
+                _overflowTail->next = task;
+            else
+                _overflowHead = task;
+            _overflowTail = task;
+        }
+
+        _totalOverflowTasks.fetch_add(uint32_t(totalTasks), std::memory_order_release);
+    }
+
+    Task* TaskLane::_popOverflowTask()
+    {
+        if (_totalOverflowTasks.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+
+        if (_overflowHead == nullptr)
+            return nullptr;
+
+        Task* task = _overflowHead;
+        _overflowHead = task->next;
+        if (_overflowHead == nullptr)
+            _overflowTail = nullptr;
+        task->next = nullptr;
+        _totalOverflowTasks.fetch_sub(1, std::memory_order_release);
+        return task;
+    }
+
+};
@@ -0,0 +1,69 @@
+
+#pragma once
+
+#include "MpmcTaskQueue.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace multithreading
+{
+    struct Task;
+
+    // the shared tasks of one priority level
+    // => tasks with a deadline first, earliest deadline first (locked heap, only touched when used)
+    // => then the other tasks, fifo (lock free queue, intrusive overflow list when full)
+    class TaskLane
+        : public NonCopyable
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        struct DeadlineTask
+        {
+        public:
+            Clock::time_point deadline;
+            uint64_t order; // fifo between equal deadlines
+            Task* task;
+        };
+
+    private:
+        MpmcTaskQueue _tasks;
+
+        // only used when _tasks is full
+        std::mutex _overflowMutex;
+        Task* _overflowHead = nullptr; // locked by _overflowMutex (intrusive, no allocation)
+        Task* _overflowTail = nullptr; // locked by _overflowMutex
+        std::atomic<uint32_t> _totalOverflowTasks{0}; // checked before locking
+
+        std::mutex _deadlineMutex;
+        std::vector<DeadlineTask> _deadlineTasks; // locked by _deadlineMutex (min heap)
+        uint64_t _totalDeadlinePushes = 0; // locked by _deadlineMutex
+        std::atomic<uint32_t> _totalDeadlineTasks{0}; // checked before locking
+
+    public:
+        TaskLane() = default;
+
+    public:
+        void push(Task* task);
+        void pushBulk(Task** tasks, std::size_t totalTasks); // one claim when the batch fit
+        void pushWithDeadline(Task* task, Clock::time_point deadline);
+        Task* tryPop(); // nullptr when empty
+
+    public:
+        bool isEmpty() const; // approximate when used concurrently
+        std::size_t approximateSize() const;
+
+    private:
+        void _pushOverflowTasks(Task** tasks, std::size_t totalTasks);
+        Task* _popOverflowTask();
+    };
+
+};
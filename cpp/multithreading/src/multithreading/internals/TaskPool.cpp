@@ -0,0 +1,74 @@
+
+#include "TaskPool.hpp"
+
+#include "IProducer.hpp"
+
+namespace multithreading
+{
+
+    TaskPool::TaskPool(std::size_t slabSize /*= 256*/, std::size_t freeListCapacity /*= 8192*/)
+        : _slabSize(slabSize)
+        , _freeTasks(freeListCapacity)
+    {}
+
+    TaskPool::~TaskPool() = default;
+
+    //
+    //
+
+    Task* TaskPool::acquire()
+    {
+        if (Task* task = _freeTasks.tryPop())
+            return task;
+
+        return _acquireSlow();
+    }
+
+    void TaskPool::release(Task* task)
+    {
+        task->cancellation = CancellationToken();
+        task->completion = nullptr;
+        task->drop.reset();
+
+        if (_freeTasks.tryPush(task))
+            return;
+
+        std::lock_guard<std::mutex> lock(_slabsMutex);
+        _spareTasks.push_back(task);
+    }
+
+    //
+    //
+
+    std::size_t TaskPool::totalSlabs()
+    {
+        std::lock_guard<std::mutex> lock(_slabsMutex);
+        return _slabs.size();
+    }
+
+    //
+    //
+
+    Task* TaskPool::_acquireSlow()
+    {
+        std::lock_guard<std::mutex> lock(_slabsMutex);
+
+        if (!_spareTasks.empty())
+        {
+            Task* task = _spareTasks.back();
+            _spareTasks.pop_back();
+            return task;
+        }
+
+        _slabs.push_back(std::make_unique<Task[]>(_slabSize));
+        Task* slab = _slabs.back().get();
+
+        // keep the first one, share the others
+        for (std::size_t ii = 1; ii < _slabSize; ++ii)
+            if (!_freeTasks.tryPush(&slab[ii]))
+                _spareTasks.push_back(&slab[ii]);
+
+        return &slab[0];
+    }
+
+};
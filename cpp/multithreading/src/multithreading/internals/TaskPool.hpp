@@ -0,0 +1,47 @@
+
+#pragma once
+
+#include "MpmcTaskQueue.hpp"
+
+#include "utilities/NonCopyable.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace multithreading
+{
+    struct Task;
+
+    // recycle the task records, allocated by slabs, never freed before the pool
+    // => acquire()/release() are lock free while the free list is not empty/full
+    // => any thread can release a task acquired by an other thread
+    class TaskPool
+        : public NonCopyable
+    {
+    private:
+        const std::size_t _slabSize;
+
+        MpmcTaskQueue _freeTasks;
+
+        // slow path: new slab, or free list full
+        std::mutex _slabsMutex;
+        std::vector<std::unique_ptr<Task[]>> _slabs; // locked by _slabsMutex
+        std::vector<Task*> _spareTasks; // locked by _slabsMutex
+
+    public:
+        explicit TaskPool(std::size_t slabSize = 256, std::size_t freeListCapacity = 8192);
+        ~TaskPool();
+
+    public:
+        Task* acquire();
+        void release(Task* task); // the task callback must have been reset (the cancellation token and the completion are reset here)
+
+    public:
+        std::size_t totalSlabs();
+
+    private:
+        Task* _acquireSlow();
+    };
+
+};
@@ -2,6 +2,14 @@
 #include "ThreadSynchroniser.hpp"
 
 #include <chrono>
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
 
 namespace multithreading
 {
@@ -10,8 +18,9 @@ namespace multithreading
     //
     // ScopedLockedNotifier
 
-    ThreadSynchroniser::ScopedLockedNotifier::ScopedLockedNotifier(ThreadSynchroniser& synchroniser)
+    ThreadSynchroniser::ScopedLockedNotifier::ScopedLockedNotifier(ThreadSynchroniser& synchroniser, bool notifyAll)
         : _synchroniser(synchroniser)
+        , _notifyAll(notifyAll)
     {
         _synchroniser._mutex.lock(); // scoped lock part
     }
@@ -20,44 +29,85 @@ namespace multithreading
     {
         // added value compared to a simple scoped lock
         // -> we notify before unlocking the mutex
-        _synchroniser.notify();
+        _synchroniser._notified = true;
+        _synchroniser._prepareNotify(_notifyAll);
+
+        const bool isFutex = (_synchroniser.getWaitStrategy() == WaitStrategy::Futex);
+
+#if !defined(__linux__)
+        // the fallback touch the memory of the synchroniser -> before the unlock too
+        if (isFutex)
+            _synchroniser._futexWake(_notifyAll);
+#endif
 
         _synchroniser._mutex.unlock(); // scoped lock part
+
+#if defined(__linux__)
+        // -> except the futex: the woken thread do not have to block on the mutex
+        // (the waiting thread may already have destroyed the synchroniser: a futex wake
+        //  only use the address, the memory is not touched)
+        if (isFutex)
+            _synchroniser._futexWake(_notifyAll);
+#endif
     }
 
     // ScopedLockedNotifier
     //
     //
 
+    ThreadSynchroniser::ThreadSynchroniser(WaitStrategy strategy /*= WaitStrategy::Blocking*/)
+        : _strategy(strategy)
+    {}
+
+    //
+    //
+
+    void ThreadSynchroniser::setWaitStrategy(WaitStrategy strategy)
+    {
+        _strategy.store(strategy, std::memory_order_relaxed);
+    }
+
+    WaitStrategy ThreadSynchroniser::getWaitStrategy() const
+    {
+        return _strategy.load(std::memory_order_relaxed);
+    }
+
+    //
+    //
+
     bool ThreadSynchroniser::waitUntilNotified(std::unique_lock<std::mutex>& lock, float seconds /*= 0.0f*/)
     {
         _notified = false;
 
+        auto isNotified = [this]() { return _notified; };
+
         // no need to wait for a timeout
         if (seconds <= 0.0f)
-        {
-            while (!_notified) // loop to avoid spurious wakeups
-                _condVar.wait(lock);
-
-            return true;
-        }
+            return _wait(lock, isNotified, nullptr);
 
         // we need to wait for a timeout
-        const long long millisecondsToWait = seconds * 1000.0f;
-        auto timeoutPoint = std::chrono::system_clock::now();
-        timeoutPoint += std::chrono::milliseconds(millisecondsToWait);
-
-        while (!_notified) // loop to avoid spurious wakeups
-            if (_condVar.wait_until(lock, timeoutPoint) == std::cv_status::timeout)
-                return false; // we did time out
+        const long long microsecondsToWait = static_cast<long long>(seconds * 1000000.0f);
+        const Clock::time_point timeoutPoint = Clock::now() + std::chrono::microseconds(microsecondsToWait);
 
-        return true; // we did not time out
+        return _wait(lock, isNotified, &timeoutPoint);
     }
 
     void ThreadSynchroniser::notify()
     {
         _notified = true;
-        _condVar.notify_one();
+        _prepareNotify(false);
+
+        if (getWaitStrategy() == WaitStrategy::Futex)
+            _futexWake(false);
+    }
+
+    void ThreadSynchroniser::notifyAll()
+    {
+        _notified = true;
+        _prepareNotify(true);
+
+        if (getWaitStrategy() == WaitStrategy::Futex)
+            _futexWake(true);
     }
 
     std::unique_lock<std::mutex> ThreadSynchroniser::makeScopedLock()
@@ -67,7 +117,12 @@ namespace multithreading
 
     ThreadSynchroniser::ScopedLockedNotifier ThreadSynchroniser::makeScopedLockNotifier()
     {
-        return ScopedLockedNotifier(*this);
+        return ScopedLockedNotifier(*this, false);
+    }
+
+    ThreadSynchroniser::ScopedLockedNotifier ThreadSynchroniser::makeScopedLockAllNotifier()
+    {
+        return ScopedLockedNotifier(*this, true);
     }
 
     bool ThreadSynchroniser::isNotified() const
@@ -75,4 +130,75 @@ namespace multithreading
         return _notified;
     }
 
+    //
+    //
+
+    void ThreadSynchroniser::_prepareNotify(bool notifyAll)
+    {
+        switch (getWaitStrategy())
+        {
+        case WaitStrategy::Blocking:
+        case WaitStrategy::Hybrid:
+            if (notifyAll)
+                _condVar.notify_all();
+            else
+                _condVar.notify_one();
+            break;
+
+        case WaitStrategy::Spin:
+            break; // the waiting threads check by themselves
+
+        case WaitStrategy::Futex:
+            _epoch.fetch_add(1, std::memory_order_relaxed); // the mutex order it with the waiters
+            break;
+        }
+    }
+
+    void ThreadSynchroniser::_futexWait(uint32_t epoch, const Clock::time_point* timeoutPoint)
+    {
+#if defined(__linux__)
+
+        // the kernel compare the epoch with the one read under the lock -> no lost wake up
+        if (timeoutPoint == nullptr)
+        {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+            return;
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(*timeoutPoint - Clock::now());
+        if (remaining.count() <= 0)
+            return;
+
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+        timeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, epoch, &timeout, nullptr, 0);
+
+#else
+
+        // no timed atomic wait: poll until the caller's timeout
+        if (timeoutPoint != nullptr)
+            std::this_thread::yield();
+        else
+            _epoch.wait(epoch, std::memory_order_relaxed);
+
+#endif
+    }
+
+    void ThreadSynchroniser::_futexWake(bool notifyAll)
+    {
+#if defined(__linux__)
+
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAKE_PRIVATE, notifyAll ? INT_MAX : 1, nullptr, nullptr, 0);
+
+#else
+
+        if (notifyAll)
+            _epoch.notify_all();
+        else
+            _epoch.notify_one();
+
+#endif
+    }
+
 };
@@ -1,25 +1,44 @@
 
 #pragma once
 
+#include "WaitStrategy.hpp"
+
 #include "utilities/NonCopyable.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 namespace multithreading
 {
 
     // this class handle all locking and conditional variable interactions
+    // => the way the waiting threads sleep depend on the WaitStrategy (Blocking by default)
+    // => the state checked by the waiting threads must be changed under the lock
     class ThreadSynchroniser
         : public NonCopyable
     {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        // Spin/Hybrid: pauses between two checks, checks before blocking (Hybrid)
+        static constexpr int k_totalPausesPerRound = 16;
+        static constexpr int k_totalSpinRounds = 256;
+
     private:
         std::mutex              _mutex;
         std::condition_variable _condVar;
         bool                    _notified = false;
 
+        std::atomic<WaitStrategy> _strategy; // read by the waiting threads between two checks
+        std::atomic<uint32_t>   _epoch{0}; // futex word (WaitStrategy::Futex), changed under the lock
+
     public:
-        // this class act like a scoped lock but notify before unlocking
+        // this class act like a scoped lock but notify when unlocking
+        // => before the unlock, the Futex strategy wake up the sleeping threads right after it
         class ScopedLockedNotifier
         {
             // friendship since we need access to the _mutex
@@ -27,25 +46,97 @@ namespace multithreading
 
         private:
             ThreadSynchroniser& _synchroniser;
+            const bool _notifyAll;
 
         private:
-            ScopedLockedNotifier(ThreadSynchroniser& synchroniser);
+            ScopedLockedNotifier(ThreadSynchroniser& synchroniser, bool notifyAll);
 
         public:
             ~ScopedLockedNotifier();
         };
 
     public:
-        ThreadSynchroniser() = default;
+        explicit ThreadSynchroniser(WaitStrategy strategy = WaitStrategy::Blocking);
+
+    public:
+        // for the next waits (a thread already waiting may finish its wait with the previous one)
+        void setWaitStrategy(WaitStrategy strategy);
+        WaitStrategy getWaitStrategy() const;
 
     public:
         bool waitUntilNotified(std::unique_lock<std::mutex>& lock, float seconds = 0.0f);
         void notify();
+        void notifyAll();
+
+        // safe with several waiting threads (no shared "_notified" flag)
+        template<typename Predicate>
+        void waitUntil(std::unique_lock<std::mutex>& lock, Predicate predicate)
+        {
+            _wait(lock, predicate, nullptr);
+        }
 
     public:
         std::unique_lock<std::mutex> makeScopedLock();
-        ScopedLockedNotifier makeScopedLockNotifier();
+        ScopedLockedNotifier makeScopedLockNotifier(); // notify one
+        ScopedLockedNotifier makeScopedLockAllNotifier(); // notify all
         bool isNotified() const;
+
+    private:
+        // false on timeout
+        template<typename Predicate>
+        bool _wait(std::unique_lock<std::mutex>& lock, Predicate& predicate, const Clock::time_point* timeoutPoint)
+        {
+            for (int round = 0; !predicate(); ++round)
+            {
+                if (timeoutPoint != nullptr && Clock::now() >= *timeoutPoint)
+                    return false;
+
+                const WaitStrategy strategy = _strategy.load(std::memory_order_relaxed);
+                const bool isSpinning = (
+                    strategy == WaitStrategy::Spin ||
+                    (strategy == WaitStrategy::Hybrid && round < k_totalSpinRounds)
+                );
+
+                if (isSpinning)
+                {
+                    lock.unlock();
+
+                    for (int ii = 0; ii < k_totalPausesPerRound; ++ii)
+                        cpuRelax();
+
+                    // the notifying thread may need this cpu
+                    if (round % 64 == 63 || !isSpinningUseful())
+                        std::this_thread::yield();
+
+                    lock.lock();
+                }
+                else if (strategy == WaitStrategy::Futex)
+                {
+                    // read under the lock: a notification after it change the epoch
+                    const uint32_t epoch = _epoch.load(std::memory_order_relaxed);
+
+                    lock.unlock();
+                    _futexWait(epoch, timeoutPoint);
+                    lock.lock();
+                }
+                else if (timeoutPoint != nullptr)
+                {
+                    _condVar.wait_until(lock, *timeoutPoint);
+                }
+                else
+                {
+                    _condVar.wait(lock);
+                }
+            }
+
+            return true;
+        }
+
+        void _futexWait(uint32_t epoch, const Clock::time_point* timeoutPoint);
+        void _futexWake(bool notifyAll);
+
+        // locked, the wake up part of a Futex notification is done after the unlock
+        void _prepareNotify(bool notifyAll);
     };
 
 };
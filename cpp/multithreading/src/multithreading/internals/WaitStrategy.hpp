@@ -0,0 +1,38 @@
+
+#pragma once
+
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace multithreading
+{
+    // how a thread wait for a notification (see ThreadSynchroniser, ProducerSettings)
+    enum class WaitStrategy
+    {
+        Blocking, // condition variable, notified under the lock (the woken thread may block on the mutex)
+        Spin, // never sleep: pause, re-check, yield now and then (lowest latency, burn the waiting cpu)
+        Hybrid, // spin for a bounded time, then block on the condition variable
+        Futex, // sleep on a futex word, woken after the unlock (no wake up then block on the mutex)
+    };
+
+    // spin loop hint: let the sibling hyper thread run, save power
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // a single cpu: the thread to wait for cannot run while spinning -> yield instead
+    inline bool isSpinningUseful()
+    {
+        static const bool s_isSpinningUseful = (std::thread::hardware_concurrency() > 1);
+        return s_isSpinningUseful;
+    }
+
+};
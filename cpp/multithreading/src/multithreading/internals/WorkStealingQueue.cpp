@@ -0,0 +1,138 @@
+
+#include "WorkStealingQueue.hpp"
+
+namespace multithreading
+{
+
+    //
+    //
+    // RingBuffer
+
+    WorkStealingQueue::RingBuffer::RingBuffer(int64_t capacity)
+        : _capacity(capacity)
+        , _mask(capacity - 1)
+        , _slots(std::make_unique<std::atomic<Task*>[]>(std::size_t(capacity)))
+    {}
+
+    int64_t WorkStealingQueue::RingBuffer::capacity() const
+    {
+        return _capacity;
+    }
+
+    Task* WorkStealingQueue::RingBuffer::get(int64_t index) const
+    {
+        return _slots[std::size_t(index & _mask)].load(std::memory_order_relaxed);
+    }
+
+    void WorkStealingQueue::RingBuffer::put(int64_t index, Task* task)
+    {
+        _slots[std::size_t(index & _mask)].store(task, std::memory_order_relaxed);
+    }
+
+    WorkStealingQueue::RingBuffer* WorkStealingQueue::RingBuffer::grow(int64_t bottom, int64_t top) const
+    {
+        RingBuffer* newBuffer = new RingBuffer(_capacity * 2);
+        for (int64_t ii = top; ii < bottom; ++ii)
+            newBuffer->put(ii, get(ii));
+        return newBuffer;
+    }
+
+    // RingBuffer
+    //
+    //
+
+    WorkStealingQueue::WorkStealingQueue(int64_t initialCapacity /*= 256*/)
+    {
+        // the capacity must be a power of two (index masking)
+        int64_t capacity = 1;
+        while (capacity < initialCapacity)
+            capacity *= 2;
+
+        _allBuffers.push_back(std::make_unique<RingBuffer>(capacity));
+        _buffer.store(_allBuffers.back().get(), std::memory_order_relaxed);
+    }
+
+    //
+    //
+
+    void WorkStealingQueue::push(Task* task)
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_acquire);
+        RingBuffer* buffer = _buffer.load(std::memory_order_relaxed);
+
+        if (bottom - top > buffer->capacity() - 1)
+        {
+            // full -> grow, the old buffer stay alive for the thieves
+            _allBuffers.push_back(std::unique_ptr<RingBuffer>(buffer->grow(bottom, top)));
+            buffer = _allBuffers.back().get();
+            _buffer.store(buffer, std::memory_order_release);
+        }
+
+        buffer->put(bottom, task);
+        _bottom.store(bottom + 1, std::memory_order_release); // publish the task to the thieves
+    }
+
+    Task* WorkStealingQueue::pop()
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        RingBuffer* buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Task* task = buffer->get(bottom);
+
+        if (top == bottom)
+        {
+            // last item -> race against the thieves
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr; // a thief got it
+
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return task;
+    }
+
+    Task* WorkStealingQueue::steal()
+    {
+        int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr; // empty
+
+        RingBuffer* buffer = _buffer.load(std::memory_order_acquire);
+        Task* task = buffer->get(top);
+
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr; // lost the race (the owner or an other thief)
+
+        return task;
+    }
+
+    //
+    //
+
+    bool WorkStealingQueue::isEmpty() const
+    {
+        return size() <= 0;
+    }
+
+    int64_t WorkStealingQueue::size() const
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_seq_cst);
+        const int64_t top = _top.load(std::memory_order_seq_cst);
+        return bottom - top;
+    }
+
+};
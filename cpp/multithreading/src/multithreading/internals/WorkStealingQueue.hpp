@@ -0,0 +1,62 @@
+
+#pragma once
+
+#include "utilities/NonCopyable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace multithreading
+{
+    struct Task;
+
+    // Chase-Lev work stealing deque (C11 version from Le, Pop, Cohen, Nardelli)
+    // => push()/pop() from the owner thread only (LIFO, cache friendly)
+    // => steal() from any other thread (FIFO, the oldest and usually biggest tasks)
+    class WorkStealingQueue
+        : public NonCopyable
+    {
+    private:
+        class RingBuffer
+        {
+        private:
+            const int64_t _capacity;
+            const int64_t _mask;
+            std::unique_ptr<std::atomic<Task*>[]> _slots;
+
+        public:
+            explicit RingBuffer(int64_t capacity);
+
+        public:
+            int64_t capacity() const;
+            Task* get(int64_t index) const;
+            void put(int64_t index, Task* task);
+            RingBuffer* grow(int64_t bottom, int64_t top) const;
+        };
+
+    private:
+        // top and bottom on their own cache line: the thieves only write top
+        alignas(64) std::atomic<int64_t> _top{0};
+        alignas(64) std::atomic<int64_t> _bottom{0};
+        alignas(64) std::atomic<RingBuffer*> _buffer;
+
+        // the thieves may still read an old buffer -> only freed with the queue
+        std::vector<std::unique_ptr<RingBuffer>> _allBuffers;
+
+    public:
+        explicit WorkStealingQueue(int64_t initialCapacity = 256);
+        ~WorkStealingQueue() = default;
+
+    public:
+        void push(Task* task); // owner thread only
+        Task* pop(); // owner thread only, nullptr when empty
+        Task* steal(); // any thread, nullptr when empty or when an other thread won the race
+
+    public:
+        bool isEmpty() const;
+        int64_t size() const;
+    };
+
+};
@@ -0,0 +1,316 @@
+
+#include "AsyncLogger.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+
+namespace
+{
+    // the background thread also wake up on flush(), on stop and on a full ring buffer
+    constexpr auto k_idleInterval = std::chrono::milliseconds(10);
+
+    // a thread gone only mark its buffer, the background thread drain and drop it
+    struct ThreadBufferHolder
+    {
+        std::shared_ptr<AsyncLogger::ThreadBuffer> buffer;
+
+        ~ThreadBufferHolder()
+        {
+            if (buffer)
+                buffer->setOrphan();
+        }
+    };
+
+    thread_local ThreadBufferHolder tl_bufferHolder;
+
+    int64_t computeSystemClockOffset()
+    {
+        const int64_t systemNow = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        return systemNow - AsyncLogger::now();
+    }
+
+    void appendPadded(std::string& output, long value, int width)
+    {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        output.append(std::size_t(std::max<long>(0, width - (result.ptr - digits))), '0');
+        output.append(digits, result.ptr);
+    }
+
+    // "hh:mm:ss"
+    void appendSeconds(std::string& output, int64_t second)
+    {
+        const time_t rawTime = time_t(second);
+        struct tm timeInfo;
+        localtime_r(&rawTime, &timeInfo);
+
+        appendPadded(output, timeInfo.tm_hour, 2);
+        output.push_back(':');
+        appendPadded(output, timeInfo.tm_min, 2);
+        output.push_back(':');
+        appendPadded(output, timeInfo.tm_sec, 2);
+    }
+
+    // "MYLOG [hh:mm:ss.uuuuuu] (file|function|line) -> message"
+    void appendLine(std::string& output, const std::string& time, int64_t systemTime, const AsyncLogger::RecordHeader& header, const char* payload)
+    {
+        const AsyncLogSite& site = *header.site;
+
+        output.append("MYLOG [");
+        output.append(time);
+        output.push_back('.');
+        appendPadded(output, long(systemTime % 1000000000 / 1000), 6);
+        output.append("] (");
+        output.append(site.filename);
+        output.push_back('|');
+        output.append(site.function);
+        output.push_back('|');
+        appendPadded(output, site.line, 0);
+        output.append(") -> ");
+
+        header.formatFunction(output, site.format, payload);
+
+        output.push_back('\n');
+    }
+};
+
+//
+//
+
+AsyncLogger::ThreadBuffer::ThreadBuffer(std::size_t capacity)
+    : _data(std::make_unique<uint64_t[]>(capacity / sizeof(uint64_t)))
+    , _capacity(capacity)
+{}
+
+void AsyncLogger::ThreadBuffer::setOrphan()
+{
+    _isOrphan.store(true, std::memory_order_release);
+}
+
+bool AsyncLogger::ThreadBuffer::isOrphan() const
+{
+    return _isOrphan.load(std::memory_order_acquire);
+}
+
+void AsyncLogger::ThreadBuffer::_waitForSpace(uint64_t endPosition)
+{
+    _cachedReadPosition = _readPosition.load(std::memory_order_acquire);
+    if (endPosition - _cachedReadPosition <= _capacity)
+        return;
+
+    AsyncLogger::get()._wake();
+
+    do
+    {
+        std::this_thread::yield();
+        _cachedReadPosition = _readPosition.load(std::memory_order_acquire);
+    }
+    while (endPosition - _cachedReadPosition > _capacity);
+}
+
+//
+//
+
+AsyncLogger::AsyncLogger()
+    : _output(&std::cout)
+    , _systemClockOffset(computeSystemClockOffset())
+{
+    _thread = std::thread(&AsyncLogger::_run, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _stopRequested = true;
+        _wakeCondition.notify_all();
+    }
+
+    _thread.join();
+}
+
+AsyncLogger& AsyncLogger::get()
+{
+    static AsyncLogger s_logger;
+    return s_logger;
+}
+
+//
+//
+
+void AsyncLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+
+    const uint64_t flushRequest = ++_totalFlushRequests;
+    _wakeCondition.notify_all();
+
+    _flushedCondition.wait(lock, [this, flushRequest]() { return _totalFlushed >= flushRequest; });
+}
+
+void AsyncLogger::setOutput(std::ostream& output)
+{
+    flush();
+
+    std::unique_lock<std::mutex> lock(_outputMutex);
+    _output = &output;
+}
+
+//
+//
+
+AsyncLogger::ThreadBuffer& AsyncLogger::_getThreadBuffer()
+{
+    if (!tl_bufferHolder.buffer)
+    {
+        tl_bufferHolder.buffer = std::make_shared<ThreadBuffer>(k_threadBufferCapacity);
+        get()._registerBuffer(tl_bufferHolder.buffer);
+    }
+
+    return *tl_bufferHolder.buffer;
+}
+
+const char* AsyncLogger::_appendLiteral(std::string& output, const char* format)
+{
+    const char* cursor = format;
+    while (*cursor && !(cursor[0] == '{' && cursor[1] == '}'))
+        ++cursor;
+
+    output.append(format, cursor);
+    return *cursor ? cursor + 2 : cursor;
+}
+
+void AsyncLogger::_registerBuffer(const std::shared_ptr<ThreadBuffer>& buffer)
+{
+    std::unique_lock<std::mutex> lock(_buffersMutex);
+    _buffers.push_back(buffer);
+}
+
+void AsyncLogger::_wake()
+{
+    _wakeCondition.notify_one();
+}
+
+//
+//
+
+void AsyncLogger::_run()
+{
+    while (true)
+    {
+        uint64_t flushRequest;
+        bool stopRequested;
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            flushRequest = _totalFlushRequests;
+            stopRequested = _stopRequested;
+        }
+
+        // everything logged before the flush request (or the stop) is drained here
+        const std::size_t totalRecords = _drainAll();
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+
+        if (flushRequest > _totalFlushed)
+        {
+            _totalFlushed = flushRequest;
+            _flushedCondition.notify_all();
+        }
+
+        if (totalRecords > 0)
+            continue;
+
+        if (stopRequested)
+            return;
+
+        _wakeCondition.wait_for(lock, k_idleInterval, [this]()
+        {
+            return _stopRequested || _totalFlushRequests > _totalFlushed;
+        });
+    }
+}
+
+std::size_t AsyncLogger::_drainAll()
+{
+    {
+        std::unique_lock<std::mutex> lock(_buffersMutex);
+        _drainedBuffers = _buffers;
+    }
+
+    _batch.clear();
+    _pendingLines.clear();
+
+    bool hasOrphans = false;
+    for (const auto& buffer : _drainedBuffers)
+    {
+        const bool isOrphan = buffer->isOrphan(); // before the drain: its last records are then visible
+        hasOrphans = hasOrphans || isOrphan;
+
+        buffer->drain([this](const RecordHeader& header, const char* payload)
+        {
+            const std::size_t offset = _batch.size();
+            _appendLine(_batch, header, payload);
+            _pendingLines.push_back({ header.timestamp, offset, _batch.size() - offset });
+        });
+
+        if (!isOrphan)
+            continue;
+
+        std::unique_lock<std::mutex> lock(_buffersMutex);
+        _buffers.erase(std::find(_buffers.begin(), _buffers.end(), buffer));
+    }
+
+    if (hasOrphans)
+        _drainedBuffers.clear(); // release the orphans now
+
+    if (_pendingLines.empty())
+        return 0;
+
+    // per thread order already, merged across the threads
+    std::stable_sort(_pendingLines.begin(), _pendingLines.end(), [](const PendingLine& lineA, const PendingLine& lineB)
+    {
+        return lineA.timestamp < lineB.timestamp;
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(_outputMutex);
+        for (const PendingLine& line : _pendingLines)
+            _output->write(_batch.data() + line.offset, std::streamsize(line.size));
+        _output->flush();
+    }
+
+    return _pendingLines.size();
+}
+
+void AsyncLogger::_appendLine(std::string& output, const RecordHeader& header, const char* payload)
+{
+    const int64_t systemTime = header.timestamp + _systemClockOffset;
+    const int64_t second = systemTime / 1000000000;
+
+    // localtime once per second
+    if (second != _cachedSecond)
+    {
+        _cachedTime.clear();
+        appendSeconds(_cachedTime, second);
+        _cachedSecond = second;
+    }
+
+    appendLine(output, _cachedTime, systemTime, header, payload);
+}
+
+// oversized record, on the logging thread
+void AsyncLogger::_writeNow(const RecordHeader& header, const char* payload)
+{
+    const int64_t systemTime = header.timestamp + _systemClockOffset;
+
+    std::string time;
+    appendSeconds(time, systemTime / 1000000000);
+
+    std::string line;
+    appendLine(line, time, systemTime, header, payload);
+
+    std::unique_lock<std::mutex> lock(_outputMutex);
+    _output->write(line.data(), std::streamsize(line.size()));
+    _output->flush();
+}
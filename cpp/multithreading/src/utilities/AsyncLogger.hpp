@@ -0,0 +1,485 @@
+
+#pragma once
+
+#include "NonCopyable.hpp"
+#include "TraceLogger.hpp"
+
+#include <atomic>
+#include <charconv> // <= std::to_chars()
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // <= memcpy()
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//
+// asynchronous logger, same lines as D_SYNC_LOG without formatting or writing on the calling thread (D_MYLOG is built on it)
+// => the format string and the call site (filename, function, line) are static, built at compile time
+// => the caller only copy its arguments in its own ring buffer (single producer/consumer, lock free)
+// => a background thread format the records (timestamp order) and write them in batches, one flush per batch
+// => "{}" placeholders, their number is checked at compile time against the arguments
+// => arguments: arithmetic types, enums, pointers, strings (copied)
+// => a full ring buffer make the caller wait: nothing is dropped
+//
+
+struct AsyncLogSite
+{
+    const char* format;
+    const char* filename;
+    const char* function;
+    int line;
+};
+
+// how an argument is stored in a record and appended to a line (unsupported types -> no specialisation)
+template<typename Value, typename Enable = void>
+struct AsyncLogArgument;
+
+class AsyncLogger
+    : public NonCopyable
+{
+public:
+    using FormatFunction = void (*)(std::string& output, const char* format, const char* payload);
+
+    // record = header + payload (the arguments), padded to 8 bytes
+    struct RecordHeader
+    {
+        uint32_t totalSize; // padding included
+        uint32_t isPadding; // skipped end of the ring buffer
+        const AsyncLogSite* site;
+        FormatFunction formatFunction;
+        int64_t timestamp; // steady clock (nanoseconds)
+    };
+
+    // one per logging thread, kept until drained once the thread is gone
+    class ThreadBuffer
+        : public NonCopyable
+    {
+    private:
+        std::unique_ptr<uint64_t[]> _data; // 8 bytes aligned
+        const std::size_t _capacity;
+
+        // logging thread
+        alignas(64) std::atomic<uint64_t> _writePosition{0};
+        uint64_t _cachedReadPosition = 0;
+        uint64_t _pendingSize = 0;
+
+        // background thread
+        alignas(64) std::atomic<uint64_t> _readPosition{0};
+
+        std::atomic<bool> _isOrphan{false};
+
+    public:
+        explicit ThreadBuffer(std::size_t capacity);
+
+    public:
+        // logging thread: reserve() then commit(), size multiple of 8 and at most half the capacity
+        char* reserve(std::size_t size)
+        {
+            const uint64_t writePosition = _writePosition.load(std::memory_order_relaxed);
+            const std::size_t offset = std::size_t(writePosition % _capacity);
+
+            // a record is never split: the end of the ring buffer is skipped
+            const std::size_t padding = offset + size > _capacity ? _capacity - offset : 0;
+
+            if (writePosition + padding + size - _cachedReadPosition > _capacity)
+                _waitForSpace(writePosition + padding + size);
+
+            if (padding > 0)
+            {
+                const RecordHeader paddingHeader{ uint32_t(padding), 1, nullptr, nullptr, 0 };
+                std::memcpy(_getBytes() + offset, &paddingHeader, sizeof(uint64_t)); // only the first 8 bytes are read
+            }
+
+            _pendingSize = padding + size;
+            return _getBytes() + (padding > 0 ? 0 : offset);
+        }
+
+        void commit()
+        {
+            _writePosition.store(_writePosition.load(std::memory_order_relaxed) + _pendingSize, std::memory_order_release);
+        }
+
+        void setOrphan();
+
+    public:
+        // background thread
+        bool isOrphan() const;
+
+        template<typename Callback>
+        std::size_t drain(Callback&& callback)
+        {
+            const uint64_t writePosition = _writePosition.load(std::memory_order_acquire);
+            uint64_t readPosition = _readPosition.load(std::memory_order_relaxed);
+
+            std::size_t totalRecords = 0;
+            while (readPosition < writePosition)
+            {
+                const char* record = _getBytes() + readPosition % _capacity;
+
+                RecordHeader header;
+                std::memcpy(&header, record, sizeof(uint64_t));
+                if (!header.isPadding)
+                {
+                    std::memcpy(&header, record, sizeof(header));
+                    callback(header, record + sizeof(header));
+                    ++totalRecords;
+                }
+
+                readPosition += header.totalSize;
+            }
+
+            _readPosition.store(readPosition, std::memory_order_release);
+            return totalRecords;
+        }
+
+    private:
+        char* _getBytes() const
+        {
+            return reinterpret_cast<char*>(_data.get());
+        }
+
+        void _waitForSpace(uint64_t endPosition);
+    };
+
+public:
+    static constexpr std::size_t k_threadBufferCapacity = 256 * 1024;
+
+private:
+    struct PendingLine
+    {
+        int64_t timestamp;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+private:
+    // logging threads
+    std::mutex _buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _flushedCondition;
+    uint64_t _totalFlushRequests = 0; // locked by _wakeMutex
+    uint64_t _totalFlushed = 0; // locked by _wakeMutex
+    bool _stopRequested = false; // locked by _wakeMutex
+
+    std::mutex _outputMutex;
+    std::ostream* _output;
+
+    // background thread
+    const int64_t _systemClockOffset; // steady -> system clock (nanoseconds)
+    std::vector<std::shared_ptr<ThreadBuffer>> _drainedBuffers;
+    std::string _batch;
+    std::vector<PendingLine> _pendingLines;
+    int64_t _cachedSecond = -1;
+    std::string _cachedTime; // "hh:mm:ss" of _cachedSecond
+
+    std::thread _thread;
+
+private:
+    AsyncLogger();
+
+public:
+    ~AsyncLogger();
+
+public:
+    // started on first use, drained and stopped at exit
+    static AsyncLogger& get();
+
+public:
+    // block until all the records logged so far are written
+    void flush();
+
+    // std::cout by default, flushed before the change
+    void setOutput(std::ostream& output);
+
+public:
+    // use D_ASYNC_LOG
+    template<std::size_t TotalPlaceholders, typename... Args>
+    static void log(const AsyncLogSite& site, const Args&... args)
+    {
+        static_assert(TotalPlaceholders == sizeof...(Args), "D_ASYNC_LOG: one argument per \"{}\" placeholder");
+
+        const std::size_t payloadSize = (std::size_t(0) + ... + AsyncLogArgument<std::decay_t<const Args&>>::getSize(args));
+        const std::size_t totalSize = (sizeof(RecordHeader) + payloadSize + 7) & ~std::size_t(7);
+
+        const RecordHeader header{ uint32_t(totalSize), 0, &site, &_formatPayload<std::decay_t<const Args&>...>, now() };
+
+        if (totalSize > k_threadBufferCapacity / 2)
+        {
+            // too big for a ring buffer (with the skipped end) -> formatted and written at once
+            std::vector<char> payload(payloadSize);
+            char* cursor = payload.data();
+            ((cursor = AsyncLogArgument<std::decay_t<const Args&>>::write(cursor, args)), ...);
+            static_cast<void>(cursor); // unused without argument
+            get()._writeNow(header, payload.data());
+            return;
+        }
+
+        ThreadBuffer& buffer = _getThreadBuffer();
+
+        char* record = buffer.reserve(totalSize);
+        std::memcpy(record, &header, sizeof(header));
+
+        char* cursor = record + sizeof(header);
+        ((cursor = AsyncLogArgument<std::decay_t<const Args&>>::write(cursor, args)), ...);
+        static_cast<void>(cursor); // unused without argument
+
+        buffer.commit();
+    }
+
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static constexpr std::size_t countPlaceholders(const char* format)
+    {
+        std::size_t total = 0;
+        for (; *format; ++format)
+        {
+            if (format[0] == '{' && format[1] == '}')
+            {
+                ++total;
+                ++format;
+            }
+        }
+        return total;
+    }
+
+private:
+    static ThreadBuffer& _getThreadBuffer();
+
+    // background thread: the arguments in the order of the placeholders
+    template<typename... Args>
+    static void _formatPayload(std::string& output, const char* format, const char* payload)
+    {
+        ((format = _appendLiteral(output, format), payload = AsyncLogArgument<Args>::append(output, payload)), ...);
+        static_cast<void>(payload); // unused without argument
+        _appendLiteral(output, format);
+    }
+
+    // up to the next placeholder (skipped), return what follow it
+    static const char* _appendLiteral(std::string& output, const char* format);
+
+private:
+    void _registerBuffer(const std::shared_ptr<ThreadBuffer>& buffer);
+    void _wake();
+
+    void _run();
+    std::size_t _drainAll();
+    void _appendLine(std::string& output, const RecordHeader& header, const char* payload);
+    void _writeNow(const RecordHeader& header, const char* payload);
+};
+
+//
+//
+
+// integers (and bool) -> 64 bits
+template<typename Value>
+struct AsyncLogArgument<Value, std::enable_if_t<std::is_integral<Value>::value && !std::is_same<Value, char>::value>>
+{
+    using Stored = std::conditional_t<std::is_signed<Value>::value, int64_t, uint64_t>;
+
+    static std::size_t getSize(Value)
+    {
+        return sizeof(Stored);
+    }
+
+    static char* write(char* cursor, Value value)
+    {
+        const Stored stored = Stored(value);
+        std::memcpy(cursor, &stored, sizeof(stored));
+        return cursor + sizeof(stored);
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        Stored stored;
+        std::memcpy(&stored, cursor, sizeof(stored));
+
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), stored);
+        output.append(digits, result.ptr);
+        return cursor + sizeof(stored);
+    }
+};
+
+// enums -> underlying integer
+template<typename Value>
+struct AsyncLogArgument<Value, std::enable_if_t<std::is_enum<Value>::value>>
+{
+    using Underlying = AsyncLogArgument<std::underlying_type_t<Value>>;
+
+    static std::size_t getSize(Value value)
+    {
+        return Underlying::getSize(std::underlying_type_t<Value>(value));
+    }
+
+    static char* write(char* cursor, Value value)
+    {
+        return Underlying::write(cursor, std::underlying_type_t<Value>(value));
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        return Underlying::append(output, cursor);
+    }
+};
+
+template<>
+struct AsyncLogArgument<char>
+{
+    static std::size_t getSize(char)
+    {
+        return 1;
+    }
+
+    static char* write(char* cursor, char value)
+    {
+        *cursor = value;
+        return cursor + 1;
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        output.push_back(*cursor);
+        return cursor + 1;
+    }
+};
+
+// floating points -> double, same digits as a default std::ostream
+template<typename Value>
+struct AsyncLogArgument<Value, std::enable_if_t<std::is_floating_point<Value>::value>>
+{
+    static std::size_t getSize(Value)
+    {
+        return sizeof(double);
+    }
+
+    static char* write(char* cursor, Value value)
+    {
+        const double stored = double(value);
+        std::memcpy(cursor, &stored, sizeof(stored));
+        return cursor + sizeof(stored);
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        double stored;
+        std::memcpy(&stored, cursor, sizeof(stored));
+
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), stored, std::chars_format::general, 6);
+        output.append(digits, result.ptr);
+        return cursor + sizeof(stored);
+    }
+};
+
+// pointers -> address (hexadecimal)
+template<typename Value>
+struct AsyncLogArgument<Value, std::enable_if_t<std::is_pointer<Value>::value>>
+{
+    static std::size_t getSize(Value)
+    {
+        return sizeof(uintptr_t);
+    }
+
+    static char* write(char* cursor, Value value)
+    {
+        const uintptr_t stored = reinterpret_cast<uintptr_t>(value);
+        std::memcpy(cursor, &stored, sizeof(stored));
+        return cursor + sizeof(stored);
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        uintptr_t stored;
+        std::memcpy(&stored, cursor, sizeof(stored));
+
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), stored, 16);
+        output.append("0x");
+        output.append(digits, result.ptr);
+        return cursor + sizeof(stored);
+    }
+};
+
+// strings -> length + characters (copied, the caller may free them at once)
+template<>
+struct AsyncLogArgument<std::string_view>
+{
+    static std::size_t getSize(std::string_view value)
+    {
+        return sizeof(uint32_t) + value.size();
+    }
+
+    static char* write(char* cursor, std::string_view value)
+    {
+        const uint32_t size = uint32_t(value.size());
+        std::memcpy(cursor, &size, sizeof(size));
+        std::memcpy(cursor + sizeof(size), value.data(), value.size());
+        return cursor + sizeof(size) + value.size();
+    }
+
+    static const char* append(std::string& output, const char* cursor)
+    {
+        uint32_t size;
+        std::memcpy(&size, cursor, sizeof(size));
+        output.append(cursor + sizeof(size), size);
+        return cursor + sizeof(size) + size;
+    }
+};
+
+template<>
+struct AsyncLogArgument<std::string>
+    : public AsyncLogArgument<std::string_view>
+{};
+
+template<>
+struct AsyncLogArgument<const char*>
+    : public AsyncLogArgument<std::string_view>
+{
+    static std::size_t getSize(const char* value)
+    {
+        return AsyncLogArgument<std::string_view>::getSize(value ? value : "(null)");
+    }
+
+    static char* write(char* cursor, const char* value)
+    {
+        return AsyncLogArgument<std::string_view>::write(cursor, value ? value : "(null)");
+    }
+};
+
+template<>
+struct AsyncLogArgument<char*>
+    : public AsyncLogArgument<const char*>
+{};
+
+//
+//
+
+// one line logging macro: D_ASYNC_LOG("task {} of {}", index, total);
+#define D_ASYNC_LOG(format, ...) \
+{ \
+    static constexpr AsyncLogSite k_asyncLogSite{ format, TraceLogger::getFilename(__FILE__), __func__, __LINE__ }; \
+    AsyncLogger::log<AsyncLogger::countPlaceholders(format)>(k_asyncLogSite __VA_OPT__(,) __VA_ARGS__); \
+}
+
+// one line logging macro: D_MYLOG("task " << index << " of " << total);
+// => the message is streamed on the calling thread, the line is written by the AsyncLogger
+#define D_MYLOG(streamMsg) \
+{ \
+    std::stringstream sstr; \
+    sstr << streamMsg; \
+    D_ASYNC_LOG("{}", sstr.str()); \
+}
@@ -4,10 +4,13 @@
 #include "TraceLogger.hpp"
 
 // one line exception macro
+// => the exception line is written and flushed at once, on the throwing thread (it may never be caught)
+// => no wait on the AsyncLogger: safe in a consumer, at exit, and before the logger is ever started
 #define D_THROW(exceptionType, exceptionMsg) \
 { \
     std::string log; \
     D_MYLOG_MAKE_PREFIXED_STRING(log, "[EXCEPTION] type: "#exceptionType << ", msg: " << exceptionMsg) \
     TraceLogger::log(log); \
+    TraceLogger::flush(); \
     throw exceptionType(log); \
 }
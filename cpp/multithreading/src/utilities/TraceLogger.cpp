@@ -10,24 +10,29 @@
 std::string TraceLogger::getTime()
 {
     time_t rawtime;
-    struct tm* timeinfo;
+    struct tm timeinfo;
     time(&rawtime);
-    timeinfo = localtime(&rawtime);
+    localtime_r(&rawtime, &timeinfo); // <= localtime() share a static buffer between threads
 
     std::stringstream sstr;
     sstr
         << std::setfill('0') << std::setw(2) // <= left pad (size=2)
-        << timeinfo->tm_hour << ":"
+        << timeinfo.tm_hour << ":"
         << std::setfill('0') << std::setw(2) // <= left pad (size=2)
-        << timeinfo->tm_min << ":"
+        << timeinfo.tm_min << ":"
         << std::setfill('0') << std::setw(2) // <= left pad (size=2)
-        << timeinfo->tm_sec;
+        << timeinfo.tm_sec;
 
     return sstr.str();
 }
 
 void TraceLogger::log(const std::string& msg)
 {
-    std::cout << msg << std::endl;
-    // std::cerr << msg << std::endl;
+    // no flush per line (std::endl), see flush()
+    std::cout << msg << '\n';
+}
+
+void TraceLogger::flush()
+{
+    std::cout.flush();
 }
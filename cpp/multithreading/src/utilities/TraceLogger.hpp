@@ -2,7 +2,6 @@
 #pragma once
 
 #include <sstream> // <= std::stringstream
-#include <cstring> // <= strrchr()
 
 #include <ostream>
 
@@ -13,10 +12,22 @@ public:
 
 public:
     static void log(const std::string& msg);
+    static void flush();
+
+public:
+    // "path/to/file.cpp" -> "file.cpp", evaluated at compile time on "__FILE__"
+    static constexpr const char* getFilename(const char* filepath)
+    {
+        const char* filename = filepath;
+        for (const char* cursor = filepath; *cursor; ++cursor)
+            if (*cursor == '/')
+                filename = cursor + 1;
+        return filename;
+    }
 };
 
 // this will reduce the "__FILE__" macro to it's filename -> friendlier to read
-#define D_MYLOG_FILENAME (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
+#define D_MYLOG_FILENAME ([]() { constexpr const char* filename = TraceLogger::getFilename(__FILE__); return filename; }())
 
 // this is just to make the "D_MYLOG" macro source code easier to read
 #define D_MYLOG_STACK D_MYLOG_FILENAME << "|" << __func__ << "|" << __LINE__
@@ -31,8 +42,9 @@ public:
     resultString = sstr.str(); \
 }
 
-// one line logging macro
-#define D_MYLOG(streamMsg) \
+// synchronous logging macro: formatted and written on the calling thread
+// => D_MYLOG (see AsyncLogger.hpp) only format on the calling thread
+#define D_SYNC_LOG(streamMsg) \
 { \
     std::string log; \
     D_MYLOG_MAKE_PREFIXED_STRING(log, streamMsg) \
@@ -0,0 +1,96 @@
+#include "headers.hpp"
+
+namespace {
+
+enum class colour : short { red = -2, blue = 7 };
+
+} // namespace
+
+TEST_F(async_logger_fixture, line_prefix) {
+
+  D_ASYNC_LOG("value {}", 42);
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 1);
+  ASSERT_EQ(messages[0], "value 42");
+
+  const std::string line = _output.str();
+  ASSERT_EQ(line.rfind("MYLOG [", 0), 0);
+  ASSERT_NE(line.find("(formatting.cpp|TestBody|"), std::string::npos);
+  ASSERT_EQ(line.back(), '\n');
+}
+
+TEST_F(async_logger_fixture, integer_placeholders) {
+
+  D_ASYNC_LOG("{} {} {} {}", 0, -12, 4000000000u, uint64_t(18446744073709551615ull));
+  D_ASYNC_LOG("{}/{}", int64_t(-9223372036854775807ll - 1), short(-3));
+  D_ASYNC_LOG("{} {}", true, false);
+  D_ASYNC_LOG("{} {}", colour::red, colour::blue);
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 4);
+  ASSERT_EQ(messages[0], "0 -12 4000000000 18446744073709551615");
+  ASSERT_EQ(messages[1], "-9223372036854775808/-3");
+  ASSERT_EQ(messages[2], "1 0");
+  ASSERT_EQ(messages[3], "-2 7");
+}
+
+TEST_F(async_logger_fixture, char_and_floating_point_placeholders) {
+
+  D_ASYNC_LOG("[{}{}]", 'o', 'k');
+  D_ASYNC_LOG("{} {} {} {}", 1.5, 0.1f, 1e20, -0.000123456789);
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 2);
+  ASSERT_EQ(messages[0], "[ok]");
+
+  // same digits as a default std::ostream
+  std::ostringstream expected;
+  expected << 1.5 << " " << double(0.1f) << " " << 1e20 << " " << -0.000123456789;
+  ASSERT_EQ(messages[1], expected.str());
+}
+
+TEST_F(async_logger_fixture, pointer_placeholders) {
+
+  const void* nullPointer = nullptr;
+  const int* pointer = reinterpret_cast<const int*>(uintptr_t(0xbeef0));
+  D_ASYNC_LOG("{} {}", nullPointer, pointer);
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 1);
+  ASSERT_EQ(messages[0], "0x0 0xbeef0");
+}
+
+TEST_F(async_logger_fixture, string_placeholders) {
+
+  std::string temporary = "copied";
+  const char* nullString = nullptr;
+  char buffer[] = "mutable";
+
+  D_ASYNC_LOG("{}|{}|{}|{}|{}|{}", temporary, std::string_view("view"), "literal", nullString, buffer, std::string());
+  temporary.assign("changed"); // the record hold its own copy
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 1);
+  ASSERT_EQ(messages[0], "copied|view|literal|(null)|mutable|");
+}
+
+TEST_F(async_logger_fixture, literal_around_placeholders) {
+
+  D_ASYNC_LOG("no placeholder");
+  D_ASYNC_LOG("{}", 1);
+  D_ASYNC_LOG("{}{}", 1, 2);
+  D_ASYNC_LOG("a{}b{}c", 1, 2);
+  D_ASYNC_LOG("{ } {x} { {}", 3);
+
+  static_assert(AsyncLogger::countPlaceholders("{ } {x} { {}") == 1);
+  static_assert(AsyncLogger::countPlaceholders("{}}{}") == 2);
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), 5);
+  ASSERT_EQ(messages[0], "no placeholder");
+  ASSERT_EQ(messages[1], "1");
+  ASSERT_EQ(messages[2], "12");
+  ASSERT_EQ(messages[3], "a1b2c");
+  ASSERT_EQ(messages[4], "{ } {x} { 3");
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "utilities/AsyncLogger.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// the logger write in a string stream for the test, std::cout again after it
+class async_logger_fixture : public ::testing::Test {
+protected:
+  std::ostringstream _output;
+
+protected:
+  void SetUp() override {
+    AsyncLogger::get().setOutput(_output);
+  }
+
+  void TearDown() override {
+    AsyncLogger::get().setOutput(std::cout);
+  }
+
+protected:
+  // the messages written so far ("MYLOG [time] (site) -> message")
+  std::vector<std::string> get_messages() {
+    std::vector<std::string> messages;
+
+    std::istringstream lines(_output.str());
+    for (std::string line; std::getline(lines, line);) {
+      const std::size_t separator = line.find(" -> ");
+      messages.push_back(separator == std::string::npos ? line : line.substr(separator + 4));
+    }
+    return messages;
+  }
+
+  std::vector<std::string> flush_and_get_messages() {
+    AsyncLogger::get().flush();
+    return get_messages();
+  }
+};
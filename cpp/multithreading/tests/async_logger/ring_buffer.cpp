@@ -0,0 +1,113 @@
+#include "headers.hpp"
+
+namespace {
+
+constexpr std::size_t k_recordSize = 96;
+
+// a record of k_recordSize bytes, its payload filled with "value"
+void write_record(AsyncLogger::ThreadBuffer& buffer, char value) {
+  char* record = buffer.reserve(k_recordSize);
+
+  const AsyncLogger::RecordHeader header{ uint32_t(k_recordSize), 0, nullptr, nullptr, 0 };
+  std::memcpy(record, &header, sizeof(header));
+  std::memset(record + sizeof(header), value, k_recordSize - sizeof(header));
+
+  buffer.commit();
+}
+
+std::string drain_values(AsyncLogger::ThreadBuffer& buffer) {
+  std::string values;
+  buffer.drain([&values](const AsyncLogger::RecordHeader& header, const char* payload) {
+    EXPECT_EQ(header.isPadding, 0);
+    EXPECT_EQ(header.totalSize, k_recordSize);
+    for (std::size_t ii = 0; ii < k_recordSize - sizeof(header); ++ii) {
+      EXPECT_EQ(payload[ii], payload[0]);
+    }
+    values.push_back(payload[0]);
+  });
+  return values;
+}
+
+} // namespace
+
+TEST(async_logger_ring_buffer, wrap_with_padding_record) {
+
+  AsyncLogger::ThreadBuffer buffer(256);
+
+  write_record(buffer, 'a'); // [0, 96)
+  write_record(buffer, 'b'); // [96, 192)
+  ASSERT_EQ(drain_values(buffer), "ab");
+
+  // [192, 256) skipped with a padding record, the record start at 0 again
+  write_record(buffer, 'c');
+  write_record(buffer, 'd');
+  ASSERT_EQ(drain_values(buffer), "cd");
+
+  ASSERT_EQ(drain_values(buffer), "");
+
+  for (char value = 'e'; value < 'z'; ++value) {
+    write_record(buffer, value);
+    ASSERT_EQ(drain_values(buffer), std::string(1, value));
+  }
+}
+
+TEST_F(async_logger_fixture, lines_wrap_the_thread_buffer) {
+
+  // a few times the ring buffer capacity, written in order
+  const std::string padding(100, '-');
+  const int totalLines = int(4 * AsyncLogger::k_threadBufferCapacity / (sizeof(AsyncLogger::RecordHeader) + padding.size()));
+
+  for (int ii = 0; ii < totalLines; ++ii) {
+    D_ASYNC_LOG("{} {}", ii, padding);
+  }
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(int(messages.size()), totalLines);
+  for (int ii = 0; ii < totalLines; ++ii) {
+    ASSERT_EQ(messages[std::size_t(ii)], std::to_string(ii) + " " + padding);
+  }
+}
+
+TEST_F(async_logger_fixture, orphan_buffer_is_drained) {
+
+  constexpr int k_totalThreads = 4;
+  constexpr int k_totalLines = 100;
+
+  // each thread is gone before the flush: its buffer is only drained (then dropped) by the background thread
+  for (int thread = 0; thread < k_totalThreads; ++thread) {
+    std::thread logging([thread]() {
+      for (int ii = 0; ii < k_totalLines; ++ii) {
+        D_ASYNC_LOG("thread {} line {}", thread, ii);
+      }
+    });
+    logging.join();
+  }
+
+  const std::vector<std::string> messages = flush_and_get_messages();
+  ASSERT_EQ(messages.size(), std::size_t(k_totalThreads * k_totalLines));
+  for (int thread = 0; thread < k_totalThreads; ++thread) {
+    for (int ii = 0; ii < k_totalLines; ++ii) {
+      const std::size_t index = std::size_t(thread * k_totalLines + ii); // timestamp order
+      ASSERT_EQ(messages[index], "thread " + std::to_string(thread) + " line " + std::to_string(ii));
+    }
+  }
+
+  // a new thread get a new buffer
+  std::thread([]() { D_ASYNC_LOG("after"); }).join();
+  ASSERT_EQ(flush_and_get_messages().back(), "after");
+}
+
+TEST_F(async_logger_fixture, oversized_record_is_written_at_once) {
+
+  const std::string message(AsyncLogger::k_threadBufferCapacity, 'x');
+
+  D_ASYNC_LOG("big {}", message);
+
+  // written on the calling thread, no flush needed
+  const std::vector<std::string> messages = get_messages();
+  ASSERT_EQ(messages.size(), 1);
+  ASSERT_EQ(messages[0], "big " + message);
+
+  D_ASYNC_LOG("small");
+  ASSERT_EQ(flush_and_get_messages().back(), "small");
+}
@@ -0,0 +1,49 @@
+#include "headers.hpp"
+
+using frame_allocator = multithreading::CoroutineFrameAllocator;
+
+TEST(coroutine, frame_freed_on_an_other_thread_join_its_cache) {
+
+  constexpr std::size_t k_size = 200;
+
+  void* frame = frame_allocator::allocate(k_size);
+  ASSERT_NE(frame, nullptr);
+
+  void* reused = nullptr;
+  std::thread other([frame, &reused]() {
+    frame_allocator::deallocate(frame, k_size);
+    // the same size class (193 to 256 bytes), from the cache of this thread
+    reused = frame_allocator::allocate(k_size - 4);
+    frame_allocator::deallocate(reused, k_size - 4);
+  }); // the frame is freed with the cache of the thread
+  other.join();
+
+  ASSERT_EQ(reused, frame);
+
+  // too big for the classes: plain operator new/delete, from any thread
+  void* bigFrame = frame_allocator::allocate(frame_allocator::k_classSize * frame_allocator::k_totalClasses + 1);
+  std::thread bigOther([bigFrame]() { frame_allocator::deallocate(bigFrame, frame_allocator::k_classSize * frame_allocator::k_totalClasses + 1); });
+  bigOther.join();
+}
+
+TEST(coroutine, frames_created_here_destroyed_on_a_consumer) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  constexpr int k_totalTasks = 10000;
+  std::atomic<int> total{0};
+
+  auto work = [](std::atomic<int>& total) -> multithreading::CoroutineTask<void> {
+    total.fetch_add(1);
+    co_return;
+  };
+
+  // the frames come from this thread's cache, the consumers run them and free them with the task
+  for (int ii = 0; ii < k_totalTasks; ++ii) {
+    producer.push([task = work(total)]() mutable { multithreading::syncWait(std::move(task)); });
+  }
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(total.load(), k_totalTasks);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/internals/CoroutineFrameAllocator.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
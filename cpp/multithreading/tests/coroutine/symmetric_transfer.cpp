@@ -0,0 +1,41 @@
+#include "headers.hpp"
+
+// compiled with optimisations (see CMakeLists.txt): gcc only emit the symmetric transfer tail call then
+
+namespace {
+
+multithreading::CoroutineTask<int> count_down(int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return 1 + co_await count_down(depth - 1);
+}
+
+multithreading::CoroutineTask<int> one() {
+  co_return 1;
+}
+
+multithreading::CoroutineTask<int> await_in_a_loop(int total) {
+  int sum = 0;
+  for (int ii = 0; ii < total; ++ii) {
+    sum += co_await one();
+  }
+  co_return sum;
+}
+
+} // namespace
+
+TEST(coroutine, long_recursive_chain_do_not_grow_the_stack) {
+
+  // all the frames alive at once, far past what the stack could hold without the tail calls
+  constexpr int k_depth = 100000;
+
+  ASSERT_EQ(multithreading::syncWait(count_down(k_depth)), k_depth);
+}
+
+TEST(coroutine, long_sequence_of_synchronous_awaits) {
+
+  constexpr int k_total = 1000000;
+
+  ASSERT_EQ(multithreading::syncWait(await_in_a_loop(k_total)), k_total);
+}
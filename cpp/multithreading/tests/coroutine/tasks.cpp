@@ -0,0 +1,153 @@
+#include "headers.hpp"
+
+namespace {
+
+multithreading::CoroutineTask<int> make_value(int value) {
+  co_return value;
+}
+
+multithreading::CoroutineTask<int> make_exception() {
+  throw std::logic_error("boom");
+  co_return 0;
+}
+
+multithreading::CoroutineTask<void> increment(std::atomic<int>& counter) {
+  counter.fetch_add(1);
+  co_return;
+}
+
+multithreading::CoroutineTask<int> add_on_consumer(multithreading::Producer& producer, int lhs, int rhs, std::thread::id& resumedOn) {
+  co_await producer.schedule();
+  resumedOn = std::this_thread::get_id();
+  co_return co_await make_value(lhs) + co_await make_value(rhs);
+}
+
+} // namespace
+
+TEST(coroutine, task_return_a_value) {
+
+  multithreading::CoroutineTask<int> task = make_value(42);
+
+  ASSERT_TRUE(task.isValid());
+  ASSERT_FALSE(task.isDone()); // lazy
+
+  ASSERT_EQ(multithreading::syncWait(std::move(task)), 42);
+}
+
+TEST(coroutine, task_rethrow_its_exception) {
+
+  try {
+    multithreading::syncWait(make_exception());
+    FAIL() << "no exception";
+  } catch (const std::logic_error& error) {
+    ASSERT_EQ(std::string(error.what()), "boom");
+  }
+}
+
+TEST(coroutine, task_with_a_void_result) {
+
+  std::atomic<int> counter{0};
+
+  multithreading::syncWait(increment(counter));
+
+  ASSERT_EQ(counter.load(), 1);
+}
+
+TEST(coroutine, schedule_resume_on_a_consumer) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::thread::id resumedOn;
+  ASSERT_EQ(multithreading::syncWait(add_on_consumer(producer, 20, 22, resumedOn)), 42);
+
+  ASSERT_NE(resumedOn, std::this_thread::get_id());
+}
+
+TEST(coroutine, await_a_future) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  common::gate gate;
+  auto future = producer.submit([&gate]() {
+    gate.make_task()();
+    return 7;
+  });
+
+  // suspended until the task fulfil the future, then resumed by that consumer
+  auto awaitFuture = [](multithreading::TaskFuture<int> future) -> multithreading::CoroutineTask<int> {
+    co_return (co_await std::move(future)) * 6;
+  };
+  auto task = awaitFuture(std::move(future));
+
+  std::thread opener([&gate]() {
+    gate.wait_until_entered();
+    gate.open();
+  });
+  ASSERT_EQ(multithreading::syncWait(std::move(task)), 42);
+  opener.join();
+
+  auto awaitFailing = [](multithreading::TaskFuture<int> future) -> multithreading::CoroutineTask<int> {
+    co_return co_await std::move(future);
+  };
+  ASSERT_THROW(multithreading::syncWait(awaitFailing(producer.submit([]() -> int { throw std::runtime_error("failed"); }))), std::runtime_error);
+}
+
+TEST(coroutine, when_all_join_n_tasks) {
+
+  multithreading::Producer producer;
+  producer.initialise(4);
+
+  constexpr int k_totalTasks = 64;
+
+  auto square = [](multithreading::Producer& producer, int value) -> multithreading::CoroutineTask<int> {
+    co_await producer.schedule();
+    co_return value * value;
+  };
+
+  std::vector<multithreading::CoroutineTask<int>> tasks;
+  for (int ii = 0; ii < k_totalTasks; ++ii) {
+    tasks.push_back(square(producer, ii));
+  }
+
+  const std::vector<int> values = multithreading::syncWait(multithreading::whenAll(std::move(tasks)));
+
+  ASSERT_EQ(values.size(), std::size_t(k_totalTasks));
+  for (int ii = 0; ii < k_totalTasks; ++ii) {
+    ASSERT_EQ(values[std::size_t(ii)], ii * ii); // input order
+  }
+}
+
+TEST(coroutine, when_all_of_void_tasks_and_an_exception) {
+
+  multithreading::Producer producer;
+  producer.initialise(4);
+
+  std::atomic<int> counter{0};
+
+  auto work = [](multithreading::Producer& producer, std::atomic<int>& counter, bool doThrow) -> multithreading::CoroutineTask<void> {
+    co_await producer.schedule();
+    counter.fetch_add(1);
+    if (doThrow) {
+      throw std::runtime_error("one failed");
+    }
+  };
+
+  std::vector<multithreading::CoroutineTask<void>> tasks;
+  for (int ii = 0; ii < 16; ++ii) {
+    tasks.push_back(work(producer, counter, false));
+  }
+  multithreading::syncWait(multithreading::whenAll(std::move(tasks)));
+  ASSERT_EQ(counter.load(), 16);
+
+  std::vector<multithreading::CoroutineTask<void>> failing;
+  for (int ii = 0; ii < 16; ++ii) {
+    failing.push_back(work(producer, counter, ii == 5));
+  }
+  // every task still run to its end before the rethrow
+  ASSERT_THROW(multithreading::syncWait(multithreading::whenAll(std::move(failing))), std::runtime_error);
+  ASSERT_EQ(counter.load(), 32);
+
+  ASSERT_TRUE(multithreading::syncWait(multithreading::whenAll(std::vector<multithreading::CoroutineTask<int>>())).empty());
+}
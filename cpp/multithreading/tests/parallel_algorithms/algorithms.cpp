@@ -0,0 +1,89 @@
+#include "headers.hpp"
+
+#include <atomic>
+
+TEST(parallel_algorithms, for_index_visit_every_index_once) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  for (const auto mode : { multithreading::ChunkingMode::Static, multithreading::ChunkingMode::Adaptive }) {
+    std::vector<std::atomic<int>> visits(10007);
+    multithreading::parallelForIndex(producer, 0, visits.size(), 0, [&visits](std::size_t index) { visits[index].fetch_add(1); }, mode);
+
+    for (const auto& visit : visits) {
+      ASSERT_EQ(visit.load(), 1);
+    }
+  }
+}
+
+TEST(parallel_algorithms, for_each_value) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  std::vector<int64_t> values = make_random_values(5000, 1);
+  std::vector<int64_t> expected = values;
+  for (auto& value : expected) {
+    value *= 3;
+  }
+
+  multithreading::parallelFor(producer, values.begin(), values.end(), 64, [](int64_t& value) { value *= 3; });
+
+  ASSERT_EQ(values, expected);
+}
+
+TEST(parallel_algorithms, reduce_match_std_accumulate) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  const std::vector<int64_t> values = make_random_values(12345, 2);
+
+  const int64_t expectedSum = std::accumulate(values.begin(), values.end(), int64_t(7));
+  ASSERT_EQ(multithreading::parallelReduce(producer, values.begin(), values.end(), 0, int64_t(7), std::plus<>()), expectedSum);
+
+  // ordered combination: a non commutative operation
+  std::vector<std::string> words;
+  for (int ii = 0; ii < 300; ++ii) {
+    words.push_back(std::to_string(ii) + ",");
+  }
+  const std::string expectedText = std::accumulate(words.begin(), words.end(), std::string());
+  ASSERT_EQ(multithreading::parallelReduce(producer, words.begin(), words.end(), 7, std::string(), std::plus<>()), expectedText);
+
+  const int64_t expectedSquares = std::transform_reduce(values.begin(), values.end(), int64_t(0), std::plus<>(), [](int64_t value) { return value * value; });
+  ASSERT_EQ(multithreading::parallelTransformReduce(producer, values.begin(), values.end(), 0, int64_t(0), std::plus<>(), [](int64_t value) { return value * value; }), expectedSquares);
+}
+
+TEST(parallel_algorithms, inclusive_scan_match_std) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  const std::vector<int64_t> values = make_random_values(9999, 3);
+
+  std::vector<int64_t> expected(values.size());
+  std::inclusive_scan(values.begin(), values.end(), expected.begin());
+
+  std::vector<int64_t> result(values.size());
+  const auto resultEnd = multithreading::parallelInclusiveScan(producer, values.begin(), values.end(), result.begin(), 0, std::plus<>());
+
+  ASSERT_EQ(resultEnd, result.end());
+  ASSERT_EQ(result, expected);
+}
+
+TEST(parallel_algorithms, called_from_a_consumer) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  const std::vector<int64_t> values = make_random_values(4000, 4);
+  int64_t result = 0;
+
+  producer.push([&]() {
+    result = multithreading::parallelReduce(producer, values.begin(), values.end(), 16, int64_t(0), std::plus<>());
+  });
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(result, std::accumulate(values.begin(), values.end(), int64_t(0)));
+}
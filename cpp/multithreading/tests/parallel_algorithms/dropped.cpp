@@ -0,0 +1,51 @@
+#include "headers.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <thread>
+
+TEST(parallel_algorithms, helpers_dropped_by_quit_leave_the_chunks_to_the_caller) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  std::vector<std::atomic<int>> visits(1000);
+  std::atomic<bool> isCallerStarted{false};
+
+  // the helper is queued behind the gate, the caller hold the first chunk until quit() has dropped it
+  std::thread caller([&]() {
+    multithreading::parallelForIndex(producer, 0, visits.size(), 100, [&](std::size_t index) {
+      if (!isCallerStarted.exchange(true)) {
+        common::wait_for([&gate]() { return gate.is_open.load(); });
+      }
+      visits[index].fetch_add(1);
+    });
+  });
+
+  ASSERT_TRUE(common::wait_for([&isCallerStarted]() { return isCallerStarted.load(); }));
+
+  common::quit_behind_gate(producer, gate);
+  caller.join();
+
+  for (const auto& visit : visits) {
+    ASSERT_EQ(visit.load(), 1);
+  }
+}
+
+TEST(parallel_algorithms, stopped_producer_run_on_the_caller) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+  producer.quit();
+
+  // no consumer left: no helper
+  const std::vector<int64_t> values = make_random_values(10000, 10);
+
+  const int64_t sum = multithreading::parallelReduce(producer, values.begin(), values.end(), 16, int64_t(0), std::plus<>());
+  ASSERT_EQ(sum, std::accumulate(values.begin(), values.end(), int64_t(0)));
+}
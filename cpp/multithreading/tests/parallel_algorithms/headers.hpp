@@ -0,0 +1,27 @@
+#pragma once
+
+#include "multithreading/ParallelAlgorithms.hpp"
+#include "multithreading/ParallelSort.hpp"
+#include "multithreading/Producer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+inline std::vector<int64_t> make_random_values(std::size_t totalValues, uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int64_t> distribution(-1000000, 1000000);
+
+  std::vector<int64_t> values(totalValues);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
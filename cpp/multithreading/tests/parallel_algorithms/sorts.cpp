@@ -0,0 +1,90 @@
+#include "headers.hpp"
+
+TEST(parallel_algorithms, sorts_match_std_sort) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  for (const std::size_t totalValues : { std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(200003) }) {
+    const std::vector<int64_t> values = make_random_values(totalValues, 5);
+
+    std::vector<int64_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<int64_t> radixSorted = values;
+    multithreading::parallelRadixSort(producer, radixSorted.begin(), radixSorted.end());
+    ASSERT_EQ(radixSorted, expected);
+
+    std::vector<int64_t> sampleSorted = values;
+    multithreading::parallelSampleSort(producer, sampleSorted.begin(), sampleSorted.end());
+    ASSERT_EQ(sampleSorted, expected);
+
+    std::vector<int64_t> sorted = values;
+    multithreading::parallelSort(producer, sorted.begin(), sorted.end());
+    ASSERT_EQ(sorted, expected);
+
+    // descending: not radix sortable
+    std::vector<int64_t> descending = values;
+    multithreading::parallelSort(producer, descending.begin(), descending.end(), std::greater<>());
+    ASSERT_TRUE(std::equal(descending.begin(), descending.end(), expected.rbegin()));
+  }
+}
+
+TEST(parallel_algorithms, radix_sort_of_floats) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  std::vector<double> values;
+  for (const int64_t value : make_random_values(100000, 6)) {
+    values.push_back(double(value) / 7.0);
+  }
+
+  std::vector<double> expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  multithreading::parallelRadixSort(producer, values.begin(), values.end());
+
+  ASSERT_EQ(values, expected);
+}
+
+TEST(parallel_algorithms, stable_sort_match_std_stable_sort) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  // few keys: many equal ones, their original order must be kept
+  std::vector<std::pair<int, int>> values;
+  for (const int64_t value : make_random_values(150000, 7)) {
+    values.emplace_back(int(value % 16), int(values.size()));
+  }
+
+  const auto byKey = [](const std::pair<int, int>& left, const std::pair<int, int>& right) { return left.first < right.first; };
+
+  std::vector<std::pair<int, int>> expected = values;
+  std::stable_sort(expected.begin(), expected.end(), byKey);
+
+  multithreading::parallelStableSort(producer, values.begin(), values.end(), byKey);
+
+  ASSERT_EQ(values, expected);
+}
+
+TEST(parallel_algorithms, merge_match_std_merge) {
+
+  multithreading::Producer producer;
+  producer.initialise(3);
+
+  std::vector<int64_t> left = make_random_values(70000, 8);
+  std::vector<int64_t> right = make_random_values(50000, 9);
+  std::sort(left.begin(), left.end());
+  std::sort(right.begin(), right.end());
+
+  std::vector<int64_t> expected(left.size() + right.size());
+  std::merge(left.begin(), left.end(), right.begin(), right.end(), expected.begin());
+
+  std::vector<int64_t> result(left.size() + right.size());
+  const auto resultEnd = multithreading::parallelMerge(producer, left.begin(), left.end(), right.begin(), right.end(), result.begin());
+
+  ASSERT_EQ(resultEnd, result.end());
+  ASSERT_EQ(result, expected);
+}
@@ -0,0 +1,54 @@
+#include "headers.hpp"
+
+#include <stop_token>
+
+TEST(producer, cancelled_queued_task_is_dropped) {
+
+  multithreading::ProducerSettings settings = make_ordered_settings();
+  settings.enableMetrics = true;
+
+  multithreading::Producer producer;
+  producer.initialise(settings);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  std::stop_source source;
+  std::atomic<int> totalRun{0};
+
+  producer.push(source.get_token(), [&totalRun]() { totalRun.fetch_add(1); });
+  producer.push(multithreading::CancellationToken::withTimeout(std::chrono::nanoseconds(0)), [&totalRun]() { totalRun.fetch_add(1); });
+  producer.push(multithreading::CancellationToken(), [&totalRun]() { totalRun.fetch_add(10); });
+
+  source.request_stop();
+  gate.open();
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(totalRun.load(), 10);
+  ASSERT_EQ(producer.getStats().consumers.at(0).totalTasksCancelled, 2);
+}
+
+TEST(producer, running_task_receive_its_token) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::stop_source source;
+  std::atomic<bool> isStarted{false};
+  std::atomic<bool> sawStop{false};
+
+  producer.push(source.get_token(), [&isStarted, &sawStop](const multithreading::CancellationToken& token) {
+    isStarted.store(true);
+    while (!token.stop_requested()) {
+      std::this_thread::yield();
+    }
+    sawStop.store(true);
+  });
+
+  ASSERT_TRUE(common::wait_for([&isStarted]() { return isStarted.load(); }));
+  source.request_stop();
+  producer.waitUntilAllCompleted();
+
+  ASSERT_TRUE(sawStop.load());
+}
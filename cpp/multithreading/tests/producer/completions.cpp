@@ -0,0 +1,51 @@
+#include "headers.hpp"
+
+TEST(producer, completions_run_on_update_in_completion_order) {
+
+  multithreading::Producer producer;
+  producer.initialise(make_ordered_settings());
+
+  std::vector<int> order; // update() thread only
+  std::atomic<int> totalWorkDone{0};
+
+  for (int ii = 0; ii < 10; ++ii) {
+    producer.pushWithCompletion(
+      [&totalWorkDone]() { totalWorkDone.fetch_add(1); },
+      [&order, &totalWorkDone, ii]() {
+        // the work is done before its completion
+        ASSERT_GT(totalWorkDone.load(), ii);
+        order.push_back(ii);
+      });
+  }
+
+  producer.waitUntilAllCompleted();
+
+  // nothing run before update()
+  ASSERT_TRUE(order.empty());
+
+  std::size_t totalRun = 0;
+  ASSERT_TRUE(common::wait_for([&]() {
+    totalRun += producer.update();
+    return totalRun == 10;
+  }));
+
+  ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  ASSERT_EQ(producer.update(), 0);
+}
+
+TEST(producer, a_completion_can_push) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::atomic<int> total{0};
+
+  producer.pushWithCompletion(
+    [&total]() { total.fetch_add(1); },
+    [&producer, &total]() { producer.push([&total]() { total.fetch_add(10); }); });
+
+  ASSERT_TRUE(common::wait_for([&producer]() { return producer.update() == 1; }));
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(total.load(), 11);
+}
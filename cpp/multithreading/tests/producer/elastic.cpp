@@ -0,0 +1,68 @@
+#include "headers.hpp"
+
+TEST(producer, elastic_consumers_spawn_under_load_and_retire_when_idle) {
+
+  multithreading::ProducerSettings settings;
+  settings.totalConsumers = 4;
+  settings.minConsumers = 1;
+  settings.spawnLatency = std::chrono::microseconds(100);
+  settings.retireTimeout = std::chrono::milliseconds(20);
+
+  multithreading::Producer producer;
+  producer.initialise(settings);
+
+  ASSERT_EQ(producer.totalConsumers(), 4);
+  ASSERT_EQ(producer.totalActiveConsumers(), 1);
+
+  // blocking tasks: the backlog wait long enough to be sampled
+  for (int ii = 0; ii < 200; ++ii) {
+    producer.push([]() { std::this_thread::sleep_for(std::chrono::microseconds(500)); });
+  }
+  producer.waitUntilAllCompleted();
+
+  ASSERT_GT(producer.getStats().totalSpawns, 0);
+
+  // back to the minimum once idle
+  ASSERT_TRUE(common::wait_for([&producer]() { return producer.totalActiveConsumers() == 1; }));
+  ASSERT_GT(producer.getStats().totalRetires, 0);
+
+  // a retired consumer can be spawned again
+  const uint64_t totalSpawns = producer.getStats().totalSpawns;
+  for (int ii = 0; ii < 200; ++ii) {
+    producer.push([]() { std::this_thread::sleep_for(std::chrono::microseconds(500)); });
+  }
+  producer.waitUntilAllCompleted();
+
+  ASSERT_GT(producer.getStats().totalSpawns, totalSpawns);
+}
+
+TEST(producer, elastic_consumers_retiring_right_after_their_spawn) {
+
+  // a retire timeout shorter than a time slice: a spawned thread may retire before its spawner wake up
+  multithreading::ProducerSettings settings;
+  settings.totalConsumers = 4;
+  settings.minConsumers = 1;
+  settings.spawnLatency = std::chrono::microseconds(1);
+  settings.retireTimeout = std::chrono::milliseconds(1);
+
+  multithreading::Producer producer;
+  producer.initialise(settings);
+
+  std::atomic<int> total{0};
+  for (int round = 0; round < 50; ++round) {
+    for (int ii = 0; ii < 20; ++ii) {
+      producer.push([&total]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        total.fetch_add(1);
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+
+  producer.waitUntilAllCompleted();
+  ASSERT_EQ(total.load(), 50 * 20);
+
+  // neither a spawn nor quit() is left blocked
+  producer.quit();
+  ASSERT_EQ(producer.totalActiveConsumers(), 0);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// one consumer: the tasks queued behind a gate run in the scheduler's order
+inline multithreading::ProducerSettings make_ordered_settings() {
+  multithreading::ProducerSettings settings;
+  settings.totalConsumers = 1;
+  settings.starvationInterval = 0; // strict lanes, no low lane pick
+  return settings;
+}
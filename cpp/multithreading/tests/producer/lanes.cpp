@@ -0,0 +1,65 @@
+#include "headers.hpp"
+
+namespace {
+
+struct order_recorder {
+
+  std::mutex mutex;
+  std::vector<int> order;
+
+  auto make_task(int id) {
+    return [this, id]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      order.push_back(id);
+    };
+  }
+};
+
+} // namespace
+
+TEST(producer, higher_lanes_run_first) {
+
+  multithreading::Producer producer;
+  producer.initialise(make_ordered_settings());
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  order_recorder recorder;
+  producer.push(multithreading::TaskPriority::Low, recorder.make_task(3));
+  producer.push(multithreading::TaskPriority::Normal, recorder.make_task(2));
+  producer.push(multithreading::TaskPriority::High, recorder.make_task(1));
+  producer.push(multithreading::TaskPriority::Normal, recorder.make_task(22));
+  producer.push(multithreading::TaskPriority::High, recorder.make_task(11));
+
+  gate.open();
+  producer.waitUntilAllCompleted();
+
+  // fifo within a lane
+  ASSERT_EQ(recorder.order, (std::vector<int>{1, 11, 2, 22, 3}));
+}
+
+TEST(producer, earliest_deadline_first_within_a_lane) {
+
+  multithreading::Producer producer;
+  producer.initialise(make_ordered_settings());
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  const auto now = std::chrono::steady_clock::now();
+
+  order_recorder recorder;
+  producer.push(recorder.make_task(0)); // no deadline: after the ones with a deadline
+  producer.pushWithDeadline(multithreading::TaskPriority::Normal, now + std::chrono::seconds(3), recorder.make_task(3));
+  producer.pushWithDeadline(multithreading::TaskPriority::Normal, now + std::chrono::seconds(1), recorder.make_task(1));
+  producer.pushWithDeadline(multithreading::TaskPriority::Normal, now + std::chrono::seconds(2), recorder.make_task(2));
+  producer.pushWithDeadline(multithreading::TaskPriority::High, now + std::chrono::seconds(9), recorder.make_task(9));
+
+  gate.open();
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(recorder.order, (std::vector<int>{9, 1, 2, 3, 0}));
+}
@@ -0,0 +1,34 @@
+#include "headers.hpp"
+
+#include <stdexcept>
+
+TEST(producer, push_bulk_throwing_part_way_drop_the_unqueued_tasks) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> totalRun{0};
+  std::atomic<int> totalDropped{0};
+
+  // the first batch (256) is queued, the second one is being built when index 300 throw
+  ASSERT_THROW(producer.pushBulk(
+    1000,
+    [&totalRun](std::size_t index) {
+      if (index == 300) {
+        throw std::runtime_error("no callable");
+      }
+      return [&totalRun]() { totalRun.fetch_add(1); };
+    },
+    [&totalDropped]() { totalDropped.fetch_add(1); }), std::runtime_error);
+
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(totalRun.load(), 256);
+  ASSERT_EQ(totalDropped.load(), 1000 - 256);
+
+  // the tasks of the unqueued batch are back in the pool, the producer still work
+  producer.pushBulk(600, [&totalRun](std::size_t) { return [&totalRun]() { totalRun.fetch_add(1); }; });
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(totalRun.load(), 256 + 600);
+}
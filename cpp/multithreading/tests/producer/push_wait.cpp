@@ -0,0 +1,77 @@
+#include "headers.hpp"
+
+TEST(producer, push_and_wait_until_all_completed) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> total{0};
+  for (int ii = 0; ii < 1000; ++ii) {
+    producer.push([&total]() { total.fetch_add(1); });
+  }
+
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(total.load(), 1000);
+  ASSERT_TRUE(producer.allCompleted());
+}
+
+TEST(producer, push_bulk_run_every_task_once) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  // more than one batch
+  std::vector<std::atomic<int>> runs(1000);
+  producer.pushBulk(runs.size(), [&runs](std::size_t index) {
+    return [&runs, index]() { runs[index].fetch_add(1); };
+  });
+
+  producer.waitUntilAllCompleted();
+
+  for (const auto& run : runs) {
+    ASSERT_EQ(run.load(), 1);
+  }
+}
+
+TEST(producer, tasks_pushed_from_a_consumer_are_stolen) {
+
+  multithreading::ProducerSettings settings;
+  settings.totalConsumers = 3;
+  settings.enableMetrics = true;
+
+  multithreading::Producer producer;
+  producer.initialise(settings);
+
+  std::atomic<int> total{0};
+
+  // pushed from a consumer -> its local queue, it spin without helping: only the other consumers can run them
+  producer.push([&producer, &total]() {
+    for (int ii = 0; ii < 200; ++ii) {
+      producer.push([&total]() { total.fetch_add(1); });
+    }
+    while (total.load() < 200) {
+      std::this_thread::yield();
+    }
+  });
+
+  producer.waitUntilAllCompleted();
+
+  ASSERT_EQ(total.load(), 200);
+
+  const multithreading::SchedulerStats stats = producer.getStats();
+  uint64_t totalStolen = 0;
+  for (const auto& consumer : stats.consumers) {
+    totalStolen += consumer.totalTasksStolen;
+  }
+  ASSERT_EQ(totalStolen, 200);
+}
+
+TEST(producer, push_after_quit_throw) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+  producer.quit();
+
+  ASSERT_THROW(producer.push([]() {}), std::runtime_error);
+}
@@ -0,0 +1,39 @@
+#include "headers.hpp"
+
+TEST(producer, quit_drop_the_queued_tasks) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  std::atomic<int> totalRun{0};
+  for (int ii = 0; ii < 100; ++ii) {
+    producer.push([&totalRun]() { totalRun.fetch_add(1); });
+  }
+
+  // the running task is waited for, the queued ones are dropped
+  std::thread opener([&gate]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate.open();
+  });
+  producer.quit();
+  opener.join();
+
+  ASSERT_EQ(totalRun.load(), 0);
+  ASSERT_EQ(producer.totalActiveConsumers(), 0);
+}
+
+TEST(producer, quit_twice_is_harmless) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  producer.push([]() {});
+  producer.quit();
+  producer.quit();
+
+  ASSERT_EQ(producer.totalConsumers(), 0);
+}
@@ -0,0 +1,59 @@
+#include "headers.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// a copy throw, a move do not: pushed as an lvalue, the task construction fail
+struct throwing_copy {
+  throwing_copy() = default;
+  throwing_copy(const throwing_copy&) { throw std::runtime_error("copy"); }
+  throwing_copy(throwing_copy&&) noexcept = default;
+  void operator()() {}
+};
+
+} // namespace
+
+TEST(producer, a_throwing_callable_construction_on_every_push) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  throwing_copy callable;
+  const multithreading::CancellationToken token;
+
+  for (int ii = 0; ii < 1000; ++ii) {
+    ASSERT_THROW(producer.push(callable), std::runtime_error);
+    ASSERT_THROW(producer.push(multithreading::TaskPriority::High, callable), std::runtime_error);
+    ASSERT_THROW(producer.pushWithDeadline(multithreading::TaskPriority::Normal, std::chrono::steady_clock::now(), callable), std::runtime_error);
+    ASSERT_THROW(producer.push(token, callable), std::runtime_error);
+    ASSERT_THROW(producer.pushToNumaNode(0, callable), std::runtime_error);
+  }
+
+  // nothing queued, the producer still work
+  ASSERT_TRUE(producer.allCompleted());
+
+  std::atomic<int> totalRun{0};
+  for (int ii = 0; ii < 100; ++ii) {
+    producer.push([&totalRun]() { totalRun.fetch_add(1); });
+  }
+  producer.waitUntilAllCompleted();
+  ASSERT_EQ(totalRun.load(), 100);
+}
+
+TEST(producer, a_throwing_work_release_its_completion) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  auto tracker = std::make_shared<int>(0);
+  throwing_copy work;
+
+  ASSERT_THROW(producer.pushWithCompletion(work, [tracker]() {}), std::runtime_error);
+
+  // the completion task was released: its capture is gone, nothing to run
+  ASSERT_EQ(tracker.use_count(), 1);
+  ASSERT_TRUE(producer.allCompleted());
+  ASSERT_EQ(producer.update(), 0);
+}
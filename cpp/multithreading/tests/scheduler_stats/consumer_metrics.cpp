@@ -0,0 +1,97 @@
+#include "headers.hpp"
+
+using multithreading::ConsumerMetrics;
+using multithreading::ConsumerStats;
+using multithreading::HistogramSnapshot;
+
+TEST(consumer_metrics, counters) {
+
+  ConsumerMetrics metrics(0);
+  for (int ii = 0; ii < 3; ++ii) {
+    metrics.onTaskRun();
+  }
+  metrics.onTaskStolen();
+  metrics.onTaskStolen();
+  metrics.onTaskCancelled();
+  metrics.onPark();
+
+  ConsumerStats stats;
+  HistogramSnapshot queueLatency;
+  HistogramSnapshot executionTime;
+  metrics.addTo(stats, queueLatency, executionTime);
+
+  ASSERT_EQ(stats.totalTasksRun, 3);
+  ASSERT_EQ(stats.totalTasksStolen, 2);
+  ASSERT_EQ(stats.totalTasksCancelled, 1);
+  ASSERT_EQ(stats.totalParks, 1);
+  ASSERT_EQ(queueLatency.totalSamples, 0);
+  ASSERT_EQ(executionTime.totalSamples, 0);
+}
+
+TEST(consumer_metrics, sampled_task_histogram_buckets) {
+
+  ConsumerMetrics metrics(0);
+  metrics.onSampledTask(0, 100, 1100);
+  metrics.onSampledTask(500, 400, 400); // clock skew: clamped to 0
+
+  ConsumerStats stats;
+  HistogramSnapshot queueLatency;
+  HistogramSnapshot executionTime;
+  metrics.addTo(stats, queueLatency, executionTime);
+
+  ASSERT_EQ(queueLatency.totalSamples, 2);
+  ASSERT_EQ(queueLatency.buckets[HistogramSnapshot::getBucketIndex(100)], 1);
+  ASSERT_EQ(queueLatency.buckets[0], 1);
+
+  ASSERT_EQ(executionTime.totalSamples, 2);
+  ASSERT_EQ(executionTime.buckets[HistogramSnapshot::getBucketIndex(1000)], 1);
+  ASSERT_EQ(executionTime.buckets[0], 1);
+
+  // added to the snapshots (merged over the consumers)
+  metrics.addTo(stats, queueLatency, executionTime);
+  ASSERT_EQ(queueLatency.totalSamples, 4);
+}
+
+TEST(consumer_metrics, busy_and_idle_time) {
+
+  ConsumerMetrics metrics(0);
+  metrics.setBusy(true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  metrics.setBusy(false);
+
+  ConsumerStats stats;
+  HistogramSnapshot queueLatency;
+  HistogramSnapshot executionTime;
+  metrics.addTo(stats, queueLatency, executionTime);
+
+  ASSERT_GE(stats.busySeconds, 0.009);
+  ASSERT_GE(stats.idleSeconds, 0.0);
+
+  // the current (idle) state is accounted by the snapshot
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  metrics.addTo(stats, queueLatency, executionTime);
+  ASSERT_GE(stats.idleSeconds, 0.009);
+}
+
+TEST(consumer_metrics, trace_ring_keep_the_latest_events) {
+
+  ConsumerMetrics metrics(4);
+  for (int64_t ii = 0; ii < 6; ++ii) {
+    metrics.onSampledTask(ii * 10, ii * 10 + 1, ii * 10 + 2);
+  }
+
+  const std::vector<ConsumerMetrics::TraceEvent> events = metrics.getTraceEvents();
+  ASSERT_EQ(events.size(), 4);
+  for (std::size_t ii = 0; ii < events.size(); ++ii) {
+    ASSERT_EQ(events[ii].enqueueTime, int64_t(ii + 2) * 10); // oldest first
+    ASSERT_EQ(events[ii].startTime, int64_t(ii + 2) * 10 + 1);
+    ASSERT_EQ(events[ii].endTime, int64_t(ii + 2) * 10 + 2);
+  }
+}
+
+TEST(consumer_metrics, no_trace_without_capacity) {
+
+  ConsumerMetrics metrics(0);
+  metrics.onSampledTask(0, 1, 2);
+  ASSERT_TRUE(metrics.getTraceEvents().empty());
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/SchedulerStats.hpp"
+#include "multithreading/internals/ConsumerMetrics.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+inline std::size_t count_occurrences(const std::string& text, const std::string& pattern) {
+  std::size_t total = 0;
+  for (std::size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+    ++total;
+  }
+  return total;
+}
+
+// every task sampled (push/start/end timestamps)
+inline multithreading::ProducerSettings make_metrics_settings(unsigned int totalConsumers, std::size_t traceCapacity = 0) {
+  multithreading::ProducerSettings settings;
+  settings.totalConsumers = totalConsumers;
+  settings.enableMetrics = true;
+  settings.metricsSamplingInterval = 1;
+  settings.traceCapacity = traceCapacity;
+  return settings;
+}
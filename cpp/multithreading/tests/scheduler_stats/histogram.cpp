@@ -0,0 +1,87 @@
+#include "headers.hpp"
+
+using multithreading::HistogramSnapshot;
+
+TEST(histogram_snapshot, exact_buckets_under_sub_buckets) {
+
+  for (uint64_t value = 0; value < HistogramSnapshot::k_subBuckets; ++value) {
+    ASSERT_EQ(HistogramSnapshot::getBucketIndex(value), std::size_t(value));
+    ASSERT_EQ(HistogramSnapshot::getBucketUpperBound(std::size_t(value)), value);
+  }
+}
+
+TEST(histogram_snapshot, bucket_hold_its_values) {
+
+  std::vector<uint64_t> values;
+  for (uint64_t value = 0; value < 5000; ++value) {
+    values.push_back(value);
+  }
+  for (int bit = 13; bit < 64; ++bit) {
+    const uint64_t power = uint64_t(1) << bit;
+    values.push_back(power - 1);
+    values.push_back(power);
+    values.push_back(power + power / 3);
+  }
+  values.push_back(std::numeric_limits<uint64_t>::max());
+
+  for (const uint64_t value : values) {
+    const std::size_t index = HistogramSnapshot::getBucketIndex(value);
+    ASSERT_LT(index, HistogramSnapshot::k_totalBuckets) << value;
+
+    // lower bound: one past the previous bucket
+    const uint64_t upperBound = HistogramSnapshot::getBucketUpperBound(index);
+    const uint64_t lowerBound = index == 0 ? 0 : HistogramSnapshot::getBucketUpperBound(index - 1) + 1;
+    ASSERT_LE(lowerBound, value);
+    ASSERT_GE(upperBound, value);
+
+    // ~12% precision: the width is at most an eighth of the lower bound
+    ASSERT_LE(upperBound - lowerBound, lowerBound / HistogramSnapshot::k_subBuckets) << value;
+  }
+
+  ASSERT_EQ(HistogramSnapshot::getBucketIndex(std::numeric_limits<uint64_t>::max()), HistogramSnapshot::k_totalBuckets - 1);
+  ASSERT_EQ(HistogramSnapshot::getBucketUpperBound(HistogramSnapshot::k_totalBuckets - 1), std::numeric_limits<uint64_t>::max());
+}
+
+TEST(histogram_snapshot, empty_percentile_and_max) {
+
+  HistogramSnapshot histogram;
+  ASSERT_EQ(histogram.getPercentile(50.0), 0);
+  ASSERT_EQ(histogram.getMax(), 0);
+}
+
+TEST(histogram_snapshot, percentile_is_bucket_upper_bound) {
+
+  HistogramSnapshot histogram;
+  histogram.buckets[HistogramSnapshot::getBucketIndex(5)] += 90;
+  histogram.buckets[HistogramSnapshot::getBucketIndex(1000)] += 10;
+  histogram.totalSamples = 100;
+
+  const uint64_t upperBound = HistogramSnapshot::getBucketUpperBound(HistogramSnapshot::getBucketIndex(1000));
+
+  ASSERT_EQ(histogram.getPercentile(0.0), 5);
+  ASSERT_EQ(histogram.getPercentile(50.0), 5);
+  ASSERT_EQ(histogram.getPercentile(90.0), 5);
+  ASSERT_EQ(histogram.getPercentile(91.0), upperBound);
+  ASSERT_EQ(histogram.getPercentile(100.0), upperBound);
+  ASSERT_EQ(histogram.getPercentile(250.0), upperBound); // clamped
+  ASSERT_EQ(histogram.getMax(), upperBound);
+}
+
+TEST(histogram_snapshot, merge) {
+
+  HistogramSnapshot histogramA;
+  histogramA.buckets[3] = 2;
+  histogramA.totalSamples = 2;
+
+  HistogramSnapshot histogramB;
+  histogramB.buckets[3] = 1;
+  histogramB.buckets[100] = 4;
+  histogramB.totalSamples = 5;
+
+  histogramA.merge(histogramB);
+
+  ASSERT_EQ(histogramA.buckets[3], 3);
+  ASSERT_EQ(histogramA.buckets[100], 4);
+  ASSERT_EQ(histogramA.totalSamples, 7);
+  ASSERT_EQ(histogramA.getMax(), HistogramSnapshot::getBucketUpperBound(100));
+}
@@ -0,0 +1,98 @@
+#include "headers.hpp"
+
+TEST(scheduler_stats, gauges_only_without_metrics) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  producer.push([]() {});
+  producer.waitUntilAllCompleted();
+
+  const multithreading::SchedulerStats stats = producer.getStats();
+  ASSERT_FALSE(stats.isMetricsEnabled);
+  ASSERT_EQ(stats.consumers.size(), 2);
+  ASSERT_EQ(stats.activeConsumers, 2);
+  ASSERT_EQ(stats.pendingTasks, 0);
+  for (const multithreading::ConsumerStats& consumer : stats.consumers) {
+    ASSERT_EQ(consumer.totalTasksRun, 0);
+  }
+  ASSERT_EQ(stats.queueLatency.totalSamples, 0);
+
+  std::ostringstream stream;
+  stats.print(stream);
+  ASSERT_NE(stream.str().find("metrics disabled"), std::string::npos);
+}
+
+TEST(scheduler_stats, counters_and_histograms) {
+
+  constexpr int k_totalTasks = 200;
+
+  multithreading::Producer producer;
+  producer.initialise(make_metrics_settings(2));
+
+  for (int ii = 0; ii < k_totalTasks; ++ii) {
+    producer.push([]() {});
+  }
+  producer.waitUntilAllCompleted();
+
+  const multithreading::SchedulerStats stats = producer.getStats();
+  ASSERT_TRUE(stats.isMetricsEnabled);
+  ASSERT_EQ(stats.consumers.size(), 2);
+
+  uint64_t totalTasksRun = 0;
+  for (const multithreading::ConsumerStats& consumer : stats.consumers) {
+    totalTasksRun += consumer.totalTasksRun;
+    ASSERT_GE(consumer.busySeconds + consumer.idleSeconds, 0.0);
+  }
+  ASSERT_EQ(totalTasksRun, k_totalTasks);
+  ASSERT_EQ(stats.queueLatency.totalSamples, k_totalTasks);
+  ASSERT_EQ(stats.executionTime.totalSamples, k_totalTasks);
+  ASSERT_GE(stats.getUtilisation(), 0.0);
+  ASSERT_LE(stats.getUtilisation(), 1.0);
+
+  std::ostringstream stream;
+  stats.print(stream);
+  ASSERT_NE(stream.str().find("utilisation"), std::string::npos);
+  ASSERT_NE(stream.str().find("queue latency"), std::string::npos);
+  ASSERT_EQ(count_occurrences(stream.str(), "  consumer "), 2);
+}
+
+TEST(scheduler_stats, chrome_trace_json_shape) {
+
+  constexpr std::size_t k_traceCapacity = 8;
+
+  multithreading::Producer producer;
+  producer.initialise(make_metrics_settings(1, k_traceCapacity));
+
+  for (int ii = 0; ii < 20; ++ii) {
+    producer.push([]() {});
+  }
+  producer.waitUntilAllCompleted();
+
+  std::ostringstream stream;
+  producer.writeChromeTrace(stream);
+  const std::string json = stream.str();
+
+  const std::string k_header = "{\"traceEvents\":[";
+  const std::string k_footer = "\n],\"displayTimeUnit\":\"ns\"}\n";
+  ASSERT_EQ(json.compare(0, k_header.size(), k_header), 0);
+  ASSERT_GE(json.size(), k_footer.size());
+  ASSERT_EQ(json.compare(json.size() - k_footer.size(), k_footer.size(), k_footer), 0);
+
+  // one thread name per consumer, the ring keep the latest sampled tasks
+  ASSERT_EQ(count_occurrences(json, "\"ph\":\"M\""), 1);
+  ASSERT_EQ(count_occurrences(json, "\"ph\":\"X\""), k_traceCapacity);
+  ASSERT_EQ(count_occurrences(json, "},\n{"), k_traceCapacity); // comma separated, no trailing comma
+  ASSERT_EQ(count_occurrences(json, "{"), count_occurrences(json, "}"));
+  ASSERT_EQ(count_occurrences(json, "\"queued_us\":"), k_traceCapacity);
+}
+
+TEST(scheduler_stats, chrome_trace_without_metrics) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::ostringstream stream;
+  producer.writeChromeTrace(stream);
+  ASSERT_EQ(stream.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
@@ -0,0 +1,81 @@
+#include "headers.hpp"
+
+namespace {
+
+bool is_broken_promise(multithreading::TaskFuture<int>& future) {
+  try {
+    future.get();
+  } catch (const std::future_error& error) {
+    return error.code() == std::future_errc::broken_promise;
+  }
+  return false;
+}
+
+} // namespace
+
+TEST(task_future, submit_dropped_by_quit_is_a_broken_promise) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  // queued behind the gate when quit() is called
+  auto future = producer.submit([]() { return 1; });
+  auto chained = producer.submit([]() { return 2; }).then([](int value) { return value * 10; });
+
+  std::vector<multithreading::TaskFuture<int>> futures;
+  futures.push_back(producer.submit([]() { return 3; }));
+  futures.push_back(producer.submit([]() { return 4; }));
+  auto gathered = multithreading::whenAll(std::move(futures));
+
+  common::quit_behind_gate(producer, gate);
+
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(is_broken_promise(future));
+
+  ASSERT_TRUE(chained.isReady());
+  ASSERT_TRUE(is_broken_promise(chained));
+
+  ASSERT_TRUE(gathered.isReady());
+  ASSERT_THROW(gathered.get(), std::future_error);
+}
+
+TEST(task_future, submit_after_quit_throw) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+  producer.quit();
+
+  ASSERT_THROW(producer.submit([]() { return 1; }), std::runtime_error);
+}
+
+TEST(task_future, continuation_on_a_stopped_producer_is_a_broken_promise) {
+
+  multithreading::Producer stopped;
+  stopped.initialise(1);
+  multithreading::Producer running;
+  running.initialise(1);
+
+  std::atomic<bool> isReleased{false};
+
+  // the gather (and its continuation) belong to the producer of the first future
+  std::vector<multithreading::TaskFuture<int>> futures;
+  futures.push_back(stopped.submit([]() { return 1; }));
+  futures.push_back(running.submit([&isReleased]() {
+    common::wait_for([&isReleased]() { return isReleased.load(); });
+    return 2;
+  }));
+  auto summed = multithreading::whenAll(std::move(futures)).then([](std::vector<int> values) { return values[0] + values[1]; });
+
+  stopped.quit();
+
+  // made ready on "running": its continuation cannot be pushed to "stopped"
+  isReleased.store(true);
+  running.waitUntilAllCompleted();
+
+  ASSERT_TRUE(summed.isReady());
+  ASSERT_TRUE(is_broken_promise(summed));
+}
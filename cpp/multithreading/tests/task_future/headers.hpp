@@ -0,0 +1,14 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskFuture.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
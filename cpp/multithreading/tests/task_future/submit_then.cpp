@@ -0,0 +1,67 @@
+#include "headers.hpp"
+
+TEST(task_future, submit_return_the_value) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  multithreading::TaskFuture<int> future = producer.submit([]() { return 42; });
+
+  ASSERT_TRUE(future.isValid());
+  ASSERT_EQ(future.get(), 42);
+  ASSERT_FALSE(future.isValid());
+}
+
+TEST(task_future, submit_rethrow_the_exception) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  auto future = producer.submit([]() -> int { throw std::runtime_error("boom"); });
+
+  ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(task_future, then_chain_the_values) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  auto future = producer.submit([]() { return 20; })
+    .then([](int value) { return value + 1; })
+    .then([](int value) { return std::to_string(value * 2); });
+
+  ASSERT_EQ(future.get(), "42");
+}
+
+TEST(task_future, an_exception_skip_the_continuations) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> totalRun{0};
+
+  auto future = producer.submit([]() -> int { throw std::logic_error("first"); })
+    .then([&totalRun](int value) { totalRun.fetch_add(1); return value; })
+    .then([&totalRun](int) { totalRun.fetch_add(1); });
+
+  try {
+    future.get();
+    FAIL() << "no exception";
+  } catch (const std::logic_error& error) {
+    ASSERT_EQ(std::string(error.what()), "first");
+  }
+  ASSERT_EQ(totalRun.load(), 0);
+}
+
+TEST(task_future, a_throwing_continuation_reach_the_last_future) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  auto future = producer.submit([]() {})
+    .then([]() -> int { throw std::runtime_error("second"); })
+    .then([](int value) { return value; });
+
+  ASSERT_THROW(future.get(), std::runtime_error);
+}
@@ -0,0 +1,105 @@
+#include "headers.hpp"
+
+TEST(task_future, when_all_keep_the_input_order) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::vector<multithreading::TaskFuture<int>> futures;
+  for (int ii = 0; ii < 20; ++ii) {
+    futures.push_back(producer.submit([ii]() { return ii * ii; }));
+  }
+
+  const std::vector<int> values = multithreading::whenAll(std::move(futures)).get();
+
+  ASSERT_EQ(values.size(), 20);
+  for (int ii = 0; ii < 20; ++ii) {
+    ASSERT_EQ(values[std::size_t(ii)], ii * ii);
+  }
+}
+
+TEST(task_future, when_all_propagate_an_exception) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::vector<multithreading::TaskFuture<void>> futures;
+  futures.push_back(producer.submit([]() {}));
+  futures.push_back(producer.submit([]() { throw std::runtime_error("one failed"); }));
+  futures.push_back(producer.submit([]() {}));
+
+  ASSERT_THROW(multithreading::whenAll(std::move(futures)).get(), std::runtime_error);
+}
+
+TEST(task_future, when_all_of_nothing_is_ready) {
+
+  auto future = multithreading::whenAll(std::vector<multithreading::TaskFuture<int>>());
+
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(future.get().empty());
+}
+
+TEST(task_future, when_any_give_the_first_ready) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<bool> isReleased{false};
+
+  std::vector<multithreading::TaskFuture<int>> futures;
+  futures.push_back(producer.submit([&isReleased]() {
+    common::wait_for([&isReleased]() { return isReleased.load(); });
+    return 1;
+  }));
+  futures.push_back(producer.submit([]() { return 2; }));
+
+  const auto result = multithreading::whenAny(std::move(futures)).get();
+  isReleased.store(true);
+
+  ASSERT_EQ(result.index, 1);
+  ASSERT_EQ(result.value, 2);
+}
+
+TEST(task_future, when_any_propagate_the_first_exception) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::vector<multithreading::TaskFuture<void>> futures;
+  futures.push_back(producer.submit([]() { throw std::runtime_error("first"); }));
+
+  ASSERT_THROW(multithreading::whenAny(std::move(futures)).get(), std::runtime_error);
+}
+
+TEST(task_future, when_all_with_an_invalid_future_throw) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::vector<multithreading::TaskFuture<int>> futures;
+  futures.push_back(producer.submit([]() { return 1; }));
+  futures.push_back(multithreading::TaskFuture<int>());
+  futures.push_back(producer.submit([]() { return 3; }));
+
+  // checked before any continuation is attached (nothing leaked)
+  ASSERT_THROW(multithreading::whenAll(std::move(futures)), std::runtime_error);
+
+  // first one invalid: no producer to read from it
+  std::vector<multithreading::TaskFuture<int>> others;
+  others.push_back(multithreading::TaskFuture<int>());
+  others.push_back(producer.submit([]() { return 2; }));
+
+  ASSERT_THROW(multithreading::whenAll(std::move(others)), std::runtime_error);
+}
+
+TEST(task_future, when_any_with_an_invalid_future_throw) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::vector<multithreading::TaskFuture<int>> futures;
+  futures.push_back(multithreading::TaskFuture<int>());
+  futures.push_back(producer.submit([]() { return 2; }));
+
+  ASSERT_THROW(multithreading::whenAny(std::move(futures)), std::runtime_error);
+}
@@ -0,0 +1,58 @@
+#include "headers.hpp"
+
+TEST(task_graph, dependencies_are_respected) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  // a -> b -> d, a -> c -> d
+  std::atomic<int> step{0};
+  std::vector<int> seen(4, -1);
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([&]() { seen[0] = step.fetch_add(1); });
+  const auto nodeB = graph.addNode([&]() { seen[1] = step.fetch_add(1); });
+  const auto nodeC = graph.addNode([&]() { seen[2] = step.fetch_add(1); });
+  const auto nodeD = graph.addNode([&]() { seen[3] = step.fetch_add(1); });
+  graph.addDependency(nodeA, nodeB);
+  graph.addDependency(nodeA, nodeC);
+  graph.addDependency(nodeB, nodeD);
+  graph.addDependency(nodeC, nodeD);
+
+  // built once, run many times
+  for (int run = 0; run < 3; ++run) {
+    step.store(0);
+    graph.run(producer);
+
+    ASSERT_FALSE(graph.isRunning());
+    ASSERT_EQ(seen[0], 0);
+    ASSERT_EQ(seen[3], 3);
+    ASSERT_TRUE((seen[1] == 1 && seen[2] == 2) || (seen[1] == 2 && seen[2] == 1));
+  }
+}
+
+TEST(task_graph, cycles_are_rejected) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([]() {});
+  const auto nodeB = graph.addNode([]() {});
+  const auto nodeC = graph.addNode([]() {});
+  graph.addDependency(nodeA, nodeB);
+  graph.addDependency(nodeB, nodeC);
+  graph.addDependency(nodeC, nodeB);
+
+  ASSERT_THROW(graph.execute(producer), std::runtime_error);
+  ASSERT_FALSE(graph.isRunning());
+}
+
+TEST(task_graph, invalid_dependencies_are_rejected) {
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([]() {});
+
+  ASSERT_THROW(graph.addDependency(nodeA, nodeA), std::runtime_error);
+  ASSERT_THROW(graph.addDependency(nodeA, 7), std::runtime_error);
+}
@@ -0,0 +1,52 @@
+#include "headers.hpp"
+
+TEST(task_graph, nodes_dropped_by_quit_fail_the_execution) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  std::atomic<int> totalRun{0};
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  const auto nodeB = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  const auto nodeC = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  graph.addDependency(nodeA, nodeC);
+  graph.addDependency(nodeB, nodeC);
+
+  // the roots are queued behind the gate when quit() is called
+  graph.execute(producer);
+  ASSERT_TRUE(graph.isRunning());
+
+  common::quit_behind_gate(producer, gate);
+
+  ASSERT_THROW(graph.waitUntilCompleted(), std::runtime_error);
+  ASSERT_FALSE(graph.isRunning());
+  ASSERT_TRUE(graph.hasFailed());
+  ASSERT_EQ(totalRun.load(), 0);
+}
+
+TEST(task_graph, run_on_a_stopped_producer_throw) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+  producer.quit();
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([]() {});
+  const auto nodeB = graph.addNode([]() {});
+  graph.addDependency(nodeA, nodeB);
+
+  ASSERT_THROW(graph.run(producer), std::runtime_error);
+  ASSERT_FALSE(graph.isRunning());
+
+  // a new execution start from a clean state
+  multithreading::Producer otherProducer;
+  otherProducer.initialise(1);
+  graph.run(otherProducer);
+  ASSERT_FALSE(graph.hasFailed());
+}
@@ -0,0 +1,76 @@
+#include "headers.hpp"
+
+TEST(task_graph, throwing_node_fail_the_execution) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> totalRun{0};
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([]() { throw std::logic_error("node A"); });
+  const auto nodeB = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  const auto nodeC = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  graph.addDependency(nodeA, nodeB);
+  graph.addDependency(nodeB, nodeC);
+
+  try {
+    graph.run(producer);
+    FAIL() << "no exception";
+  } catch (const std::logic_error& error) {
+    ASSERT_STREQ(error.what(), "node A");
+  }
+
+  ASSERT_FALSE(graph.isRunning());
+  ASSERT_TRUE(graph.hasFailed());
+  ASSERT_EQ(totalRun.load(), 0); // the successors are skipped
+
+  // the consumers are still there, a new execution start from a clean state
+  graph.clear();
+  graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+  graph.run(producer);
+  ASSERT_FALSE(graph.hasFailed());
+  ASSERT_EQ(totalRun.load(), 1);
+}
+
+TEST(task_graph, first_failure_is_rethrown) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  multithreading::TaskGraph graph;
+  const auto nodeA = graph.addNode([]() { throw std::logic_error("first"); });
+  const auto nodeB = graph.addNode([]() { throw std::logic_error("second"); });
+  graph.addDependency(nodeA, nodeB);
+
+  for (int ii = 0; ii < 3; ++ii) {
+    try {
+      graph.run(producer);
+      FAIL() << "no exception";
+    } catch (const std::logic_error& error) {
+      ASSERT_STREQ(error.what(), "first");
+    }
+  }
+}
+
+TEST(task_graph, long_chain_skipped_without_recursion) {
+
+  constexpr int k_totalNodes = 200000;
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::atomic<int> totalRun{0};
+
+  multithreading::TaskGraph graph;
+  multithreading::TaskGraph::NodeId previous = graph.addNode([]() { throw std::runtime_error("chain head"); });
+  for (int ii = 1; ii < k_totalNodes; ++ii) {
+    const auto node = graph.addNode([&totalRun]() { totalRun.fetch_add(1); });
+    graph.addDependency(previous, node);
+    previous = node;
+  }
+
+  ASSERT_THROW(graph.run(producer), std::runtime_error);
+  ASSERT_FALSE(graph.isRunning());
+  ASSERT_EQ(totalRun.load(), 0);
+}
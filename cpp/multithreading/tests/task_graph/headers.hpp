@@ -0,0 +1,12 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskGraph.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
@@ -0,0 +1,68 @@
+#include "headers.hpp"
+
+TEST(task_group, tasks_dropped_by_quit_count_as_done) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  common::gate gate;
+  producer.push(gate.make_task());
+  ASSERT_TRUE(gate.wait_until_entered());
+
+  std::atomic<int> totalRun{0};
+
+  {
+    multithreading::TaskGroup group(producer);
+
+    // queued behind the gate when quit() is called
+    for (int ii = 0; ii < 10; ++ii) {
+      group.push([&totalRun]() { totalRun.fetch_add(1); });
+    }
+    std::vector<std::function<void()>> callables(300, [&totalRun]() { totalRun.fetch_add(1); });
+    group.pushBulk(std::span(callables));
+
+    common::quit_behind_gate(producer, gate);
+
+    ASSERT_TRUE(group.isCompleted());
+    group.wait();
+
+    // and the destructor wait again, no throw
+  }
+
+  ASSERT_EQ(totalRun.load(), 0);
+}
+
+TEST(task_group, wait_while_the_producer_quit) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::atomic<int> totalRun{0};
+  multithreading::TaskGroup group(producer);
+  for (int ii = 0; ii < 2000; ++ii) {
+    group.push([&totalRun]() { totalRun.fetch_add(1); });
+  }
+
+  // run or dropped, the helping waiter must not throw nor hang
+  std::thread quitter([&producer]() { producer.quit(); });
+  group.wait();
+  quitter.join();
+
+  ASSERT_TRUE(group.isCompleted());
+  ASSERT_LE(totalRun.load(), 2000);
+}
+
+TEST(task_group, push_after_quit_throw_and_stay_completed) {
+
+  multithreading::Producer producer;
+  producer.initialise(1);
+  producer.quit();
+
+  multithreading::TaskGroup group(producer);
+  ASSERT_THROW(group.push([]() {}), std::runtime_error);
+
+  std::vector<std::function<void()>> callables(3, []() {});
+  ASSERT_THROW(group.pushBulk(std::span(callables)), std::runtime_error);
+
+  ASSERT_TRUE(group.isCompleted());
+}
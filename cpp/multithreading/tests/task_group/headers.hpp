@@ -0,0 +1,14 @@
+#pragma once
+
+#include "multithreading/Producer.hpp"
+#include "multithreading/TaskGroup.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <functional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
@@ -0,0 +1,54 @@
+#include "headers.hpp"
+
+#include <stdexcept>
+
+namespace {
+
+// throw when moved, once it reach the failing index
+struct throwing_callable {
+
+  std::size_t index = 0;
+  std::size_t failingIndex = 0;
+  std::atomic<int>* total = nullptr;
+
+  throwing_callable(std::size_t inIndex, std::size_t inFailingIndex, std::atomic<int>& inTotal)
+    : index(inIndex), failingIndex(inFailingIndex), total(&inTotal) {}
+
+  throwing_callable(const throwing_callable& other) = default;
+
+  throwing_callable(throwing_callable&& other)
+    : index(other.index), failingIndex(other.failingIndex), total(other.total) {
+    if (index == failingIndex) {
+      throw std::runtime_error("cannot move");
+    }
+  }
+
+  void operator()() {
+    total->fetch_add(1);
+  }
+};
+
+} // namespace
+
+TEST(task_group, push_bulk_throwing_part_way_count_only_the_unqueued_tasks) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> totalRun{0};
+
+  std::vector<throwing_callable> callables;
+  callables.reserve(1000);
+  for (std::size_t ii = 0; ii < 1000; ++ii) {
+    callables.emplace_back(ii, 300, totalRun);
+  }
+
+  multithreading::TaskGroup group(producer);
+  ASSERT_THROW(group.pushBulk(std::span(callables)), std::runtime_error);
+
+  // the queued ones run, the others are counted once as done
+  group.wait();
+
+  ASSERT_TRUE(group.isCompleted());
+  ASSERT_EQ(totalRun.load(), 256);
+}
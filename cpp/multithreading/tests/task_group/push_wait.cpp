@@ -0,0 +1,58 @@
+#include "headers.hpp"
+
+TEST(task_group, wait_for_its_own_tasks) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> total{0};
+
+  multithreading::TaskGroup group(producer);
+  for (int ii = 0; ii < 500; ++ii) {
+    group.push([&total]() { total.fetch_add(1); });
+  }
+  group.wait();
+
+  ASSERT_TRUE(group.isCompleted());
+  ASSERT_EQ(total.load(), 500);
+}
+
+TEST(task_group, push_bulk) {
+
+  multithreading::Producer producer;
+  producer.initialise(2);
+
+  std::atomic<int> total{0};
+  std::vector<std::function<void()>> callables;
+  for (int ii = 0; ii < 600; ++ii) {
+    callables.push_back([&total]() { total.fetch_add(1); });
+  }
+
+  multithreading::TaskGroup group(producer);
+  group.pushBulk(std::span(callables));
+  group.wait();
+
+  ASSERT_EQ(total.load(), 600);
+}
+
+TEST(task_group, nested_groups_from_a_consumer) {
+
+  // one consumer: the waiting task must run the nested ones itself
+  multithreading::Producer producer;
+  producer.initialise(1);
+
+  std::atomic<int> total{0};
+
+  multithreading::TaskGroup outerGroup(producer);
+  outerGroup.push([&producer, &total]() {
+    multithreading::TaskGroup innerGroup(producer);
+    for (int ii = 0; ii < 10; ++ii) {
+      innerGroup.push([&total]() { total.fetch_add(1); });
+    }
+    innerGroup.wait();
+    total.fetch_add(100);
+  });
+  outerGroup.wait();
+
+  ASSERT_EQ(total.load(), 110);
+}
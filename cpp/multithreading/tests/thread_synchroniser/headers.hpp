@@ -0,0 +1,33 @@
+#pragma once
+
+#include "multithreading/internals/ThreadSynchroniser.hpp"
+
+#include "utils/common.tests.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+inline const std::vector<multithreading::WaitStrategy>& get_all_wait_strategies() {
+  static const std::vector<multithreading::WaitStrategy> k_strategies = {
+    multithreading::WaitStrategy::Blocking,
+    multithreading::WaitStrategy::Spin,
+    multithreading::WaitStrategy::Hybrid,
+    multithreading::WaitStrategy::Futex,
+  };
+  return k_strategies;
+}
+
+inline std::string get_name(multithreading::WaitStrategy strategy) {
+  switch (strategy) {
+    case multithreading::WaitStrategy::Blocking: return "Blocking";
+    case multithreading::WaitStrategy::Spin: return "Spin";
+    case multithreading::WaitStrategy::Hybrid: return "Hybrid";
+    case multithreading::WaitStrategy::Futex: return "Futex";
+  }
+  return "unknown";
+}
@@ -0,0 +1,110 @@
+#include "headers.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+TEST(thread_synchroniser, set_wait_strategy) {
+
+  multithreading::ThreadSynchroniser synchroniser;
+  ASSERT_EQ(synchroniser.getWaitStrategy(), multithreading::WaitStrategy::Blocking);
+
+  for (const multithreading::WaitStrategy strategy : get_all_wait_strategies()) {
+    synchroniser.setWaitStrategy(strategy);
+    ASSERT_EQ(synchroniser.getWaitStrategy(), strategy);
+  }
+}
+
+TEST(thread_synchroniser, notified_wait_return_true) {
+
+  for (const multithreading::WaitStrategy strategy : get_all_wait_strategies()) {
+    SCOPED_TRACE(get_name(strategy));
+
+    multithreading::ThreadSynchroniser synchroniser(strategy);
+
+    // locked until the wait: the notification cannot come before it
+    auto lock = synchroniser.makeScopedLock();
+
+    std::thread notifier([&synchroniser]() { auto notifier = synchroniser.makeScopedLockNotifier(); });
+
+    ASSERT_TRUE(synchroniser.waitUntilNotified(lock, 5.0f));
+    ASSERT_TRUE(synchroniser.isNotified());
+
+    lock.unlock();
+    notifier.join();
+  }
+}
+
+TEST(thread_synchroniser, timeout_wait_return_false) {
+
+  for (const multithreading::WaitStrategy strategy : get_all_wait_strategies()) {
+    SCOPED_TRACE(get_name(strategy));
+
+    multithreading::ThreadSynchroniser synchroniser(strategy);
+    auto lock = synchroniser.makeScopedLock();
+
+    const Clock::time_point start = Clock::now();
+    ASSERT_FALSE(synchroniser.waitUntilNotified(lock, 0.02f));
+    ASSERT_GE(Clock::now() - start, std::chrono::milliseconds(19)); // the timeout itself, not an early return
+    ASSERT_FALSE(synchroniser.isNotified());
+  }
+}
+
+TEST(thread_synchroniser, notify_all_wake_every_waiting_thread) {
+
+  constexpr int k_totalWaiters = 4;
+
+  for (const multithreading::WaitStrategy strategy : get_all_wait_strategies()) {
+    SCOPED_TRACE(get_name(strategy));
+
+    multithreading::ThreadSynchroniser synchroniser(strategy);
+    bool isReady = false; // locked by the synchroniser
+    std::atomic<int> totalWoken{0};
+
+    std::vector<std::thread> waiters;
+    for (int ii = 0; ii < k_totalWaiters; ++ii) {
+      waiters.emplace_back([&synchroniser, &isReady, &totalWoken]() {
+        auto lock = synchroniser.makeScopedLock();
+        synchroniser.waitUntil(lock, [&isReady]() { return isReady; });
+        totalWoken.fetch_add(1);
+      });
+    }
+
+    {
+      auto notifier = synchroniser.makeScopedLockAllNotifier();
+      isReady = true;
+    }
+
+    for (std::thread& waiter : waiters) {
+      waiter.join();
+    }
+    ASSERT_EQ(totalWoken.load(), k_totalWaiters);
+  }
+}
+
+TEST(thread_synchroniser, ping_pong_lose_no_notification) {
+
+  constexpr int k_totalRounds = 2000;
+
+  for (const multithreading::WaitStrategy strategy : get_all_wait_strategies()) {
+    SCOPED_TRACE(get_name(strategy));
+
+    multithreading::ThreadSynchroniser synchroniser(strategy);
+    int turn = 0; // locked by the synchroniser, even: ping, odd: pong
+
+    auto play = [&synchroniser, &turn](int parity) {
+      for (int round = 0; round < k_totalRounds; ++round) {
+        {
+          auto lock = synchroniser.makeScopedLock();
+          synchroniser.waitUntil(lock, [&turn, parity]() { return turn % 2 == parity; });
+        }
+        auto notifier = synchroniser.makeScopedLockAllNotifier();
+        ++turn;
+      }
+    };
+
+    std::thread pong(play, 1);
+    play(0);
+    pong.join();
+
+    ASSERT_EQ(turn, 2 * k_totalRounds);
+  }
+}
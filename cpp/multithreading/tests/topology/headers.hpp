@@ -0,0 +1,40 @@
+#pragma once
+
+#include "multithreading/Topology.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// raw ids, as read from /sys
+inline multithreading::LogicalCpu make_cpu(unsigned int id, unsigned int coreId, unsigned int packageId, unsigned int nodeId) {
+  multithreading::LogicalCpu cpu;
+  cpu.id = id;
+  cpu.coreIndex = coreId;
+  cpu.packageId = packageId;
+  cpu.numaNode = nodeId;
+  return cpu;
+}
+
+// 2 NUMA nodes (OS ids 0 and 3), 2 cores per node, 2 SMT siblings per core
+// => numbered the linux way: the first siblings of all the cores, then the second ones
+inline multithreading::Topology make_two_nodes_smt_topology() {
+  return multithreading::Topology::makeFromCpus({
+    make_cpu(7, 1, 1, 3),
+    make_cpu(0, 0, 0, 0),
+    make_cpu(1, 1, 0, 0),
+    make_cpu(2, 0, 1, 3),
+    make_cpu(3, 1, 1, 3),
+    make_cpu(4, 0, 0, 0),
+    make_cpu(5, 1, 0, 0),
+    make_cpu(6, 0, 1, 3),
+  });
+}
+
+inline std::vector<unsigned int> get_cpu_ids(const std::vector<multithreading::LogicalCpu>& cpus) {
+  std::vector<unsigned int> cpuIds;
+  for (const multithreading::LogicalCpu& cpu : cpus) {
+    cpuIds.push_back(cpu.id);
+  }
+  return cpuIds;
+}
@@ -0,0 +1,87 @@
+#include "headers.hpp"
+
+using multithreading::PinningStrategy;
+
+TEST(topology, make_flat) {
+
+  const multithreading::Topology topology = multithreading::Topology::makeFlat(4);
+
+  ASSERT_EQ(topology.totalLogicalCpus(), 4);
+  ASSERT_EQ(topology.totalPhysicalCores(), 4);
+  ASSERT_EQ(topology.totalPackages(), 1);
+  ASSERT_EQ(topology.totalNumaNodes(), 1);
+
+  for (const multithreading::LogicalCpu& cpu : topology.getCpus()) {
+    ASSERT_EQ(cpu.smtIndex, 0);
+    ASSERT_EQ(cpu.numaNode, 0);
+  }
+
+  // at least one cpu
+  ASSERT_EQ(multithreading::Topology::makeFlat(0).totalLogicalCpus(), 1);
+}
+
+TEST(topology, dense_indices) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  ASSERT_EQ(topology.totalLogicalCpus(), 8);
+  ASSERT_EQ(topology.totalPhysicalCores(), 4);
+  ASSERT_EQ(topology.totalPackages(), 2);
+  ASSERT_EQ(topology.totalNumaNodes(), 2);
+
+  // compact order: node, package, core, SMT sibling
+  ASSERT_EQ(get_cpu_ids(topology.getCpus()), (std::vector<unsigned int>{0, 4, 1, 5, 2, 6, 3, 7}));
+
+  for (const multithreading::LogicalCpu& cpu : topology.getCpus()) {
+    ASSERT_EQ(cpu.numaNode, cpu.id % 4 < 2 ? 0u : 1u); // OS node 3 -> 1
+    ASSERT_EQ(cpu.coreIndex, cpu.id % 4);
+    ASSERT_EQ(cpu.smtIndex, cpu.id < 4 ? 0u : 1u);
+  }
+}
+
+TEST(topology, placement_compact) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  ASSERT_EQ(get_cpu_ids(topology.getPlacement(PinningStrategy::Compact, 4)), (std::vector<unsigned int>{0, 4, 1, 5}));
+}
+
+TEST(topology, placement_scatter) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  // one node after the other, the physical cores before their SMT siblings
+  ASSERT_EQ(get_cpu_ids(topology.getPlacement(PinningStrategy::Scatter, 8)), (std::vector<unsigned int>{0, 2, 1, 3, 4, 6, 5, 7}));
+}
+
+TEST(topology, placement_physical_cores) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  ASSERT_EQ(get_cpu_ids(topology.getPlacement(PinningStrategy::PhysicalCores, 4)), (std::vector<unsigned int>{0, 1, 2, 3}));
+}
+
+TEST(topology, placement_wrap_around) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  ASSERT_EQ(get_cpu_ids(topology.getPlacement(PinningStrategy::PhysicalCores, 6)), (std::vector<unsigned int>{0, 1, 2, 3, 0, 1}));
+  ASSERT_EQ(get_cpu_ids(topology.getPlacement(PinningStrategy::Compact, 10)), (std::vector<unsigned int>{0, 4, 1, 5, 2, 6, 3, 7, 0, 4}));
+}
+
+TEST(topology, placement_none) {
+
+  const multithreading::Topology topology = make_two_nodes_smt_topology();
+
+  ASSERT_TRUE(topology.getPlacement(PinningStrategy::None, 4).empty());
+}
+
+TEST(topology, detect) {
+
+  const multithreading::Topology topology = multithreading::Topology::detect();
+
+  ASSERT_GE(topology.totalLogicalCpus(), 1);
+  ASSERT_GE(topology.totalPhysicalCores(), 1);
+  ASSERT_LE(topology.totalPhysicalCores(), topology.totalLogicalCpus());
+  ASSERT_EQ(topology.getPlacement(PinningStrategy::Compact, 3).size(), 3);
+}
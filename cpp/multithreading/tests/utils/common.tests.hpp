@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace common {
+
+// poll until the predicate is true, false after the timeout (a hang is a failure, not a stuck run)
+template <typename Predicate>
+bool wait_for(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+// keep a consumer busy: push gate.make_task(), wait_until_entered(), queue the tasks under test, open()
+struct gate {
+
+  std::atomic<bool> is_entered{false};
+  std::atomic<bool> is_open{false};
+
+  auto make_task() {
+    return [this]() {
+      is_entered.store(true);
+      while (!is_open.load()) {
+        std::this_thread::yield();
+      }
+    };
+  }
+
+  bool wait_until_entered() {
+    return wait_for([this]() { return is_entered.load(); });
+  }
+
+  void open() {
+    is_open.store(true);
+  }
+};
+
+// quit() while the gate hold the only consumer: the gate is opened once quit() has dropped the queued tasks
+// => the drop pass decrement the pending count once its queues are empty (a drop callback push is counted before),
+//    only the gate task is then pending
+template <typename Producer>
+void quit_behind_gate(Producer& producer, gate& gate) {
+  std::thread opener([&producer, &gate]() {
+    wait_for([&producer]() { return producer.getStats().pendingTasks == 1; });
+    gate.open();
+  });
+  producer.quit();
+  opener.join();
+}
+
+} // namespace common